@@ -0,0 +1,125 @@
+// =============================================================================
+// box2dBenchmarkExample - Node sync cost with 10,000 bodies
+// =============================================================================
+// Compares the two ways body transforms reach the Node tree:
+//   Bulk:     World::syncBodies() walks the Box2D body list once
+//   Per body: every Body::update() reads its own transform
+// Contacts are counted with the batched onContactsStay event.
+// Timings are averaged over one second and logged.
+// =============================================================================
+
+#include "tcBaseApp.h"
+#include <tcxBox2d.h>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+
+using namespace tc;
+using namespace tcx;
+
+class tcApp : public tc::App {
+public:
+    static constexpr int kBodyCount = 10000;
+    static constexpr float radius = 2.5f;
+
+    box2d::World world;
+
+    // Not added to the Node tree: synced / drawn by hand so the sync can be timed
+    std::vector<std::shared_ptr<box2d::CircleBody>> bodies;
+
+    EventListener contactsListener;
+    size_t contacts = 0;
+
+    bool bulkSync = true;
+
+    // Accumulated over one second
+    double stepMicros = 0, syncMicros = 0;
+    int frames = 0;
+    double windowStart = 0;
+    double lastStepMs = 0, lastSyncMs = 0;
+
+    void setup() override {
+        world.setup(Vec2(0, 300));
+        world.createBounds();
+        world.setSyncBodies(false);     // Synced below, timed separately
+
+        world.getCollisionManager()->onContactsStay.listen(contactsListener,
+            [this](std::vector<box2d::ContactEvent>& batch) { contacts = batch.size(); });
+
+        // Grid of small circles filling the upper half of the window
+        int columns = static_cast<int>((getWindowWidth() - 20) / (radius * 2.2f));
+        for (int i = 0; i < kBodyCount; ++i) {
+            float x = 10 + radius + (i % columns) * radius * 2.2f;
+            float y = 10 + radius + (i / columns) * radius * 2.2f;
+            auto body = std::make_shared<box2d::CircleBody>();
+            body->setup(world, x + (float)rand() / RAND_MAX, y, radius);
+            bodies.push_back(body);
+        }
+        windowStart = getElapsedTime();
+    }
+
+    void update() override {
+        contacts = 0;
+
+        uint64_t t0 = getElapsedTimeMicros();
+        world.update();
+        uint64_t t1 = getElapsedTimeMicros();
+        if (bulkSync) {
+            world.syncBodies();
+        } else {
+            for (auto& body : bodies) body->update();
+        }
+        uint64_t t2 = getElapsedTimeMicros();
+
+        stepMicros += static_cast<double>(t1 - t0);
+        syncMicros += static_cast<double>(t2 - t1);
+        frames++;
+
+        if (getElapsedTime() - windowStart >= 1.0) {
+            lastStepMs = stepMicros / frames / 1000.0;
+            lastSyncMs = syncMicros / frames / 1000.0;
+            logNotice("benchmark") << (bulkSync ? "bulk" : "per body")
+                << " sync: " << lastSyncMs << " ms, step: " << lastStepMs
+                << " ms, contacts: " << contacts;
+            stepMicros = syncMicros = 0;
+            frames = 0;
+            windowStart = getElapsedTime();
+        }
+    }
+
+    void draw() override {
+        clear(0.12f);
+
+        setColor(1.0f, 0.78f, 0.4f);
+        for (auto& body : bodies) {
+            drawCircle(body->getX(), body->getY(), radius);
+        }
+
+        setColor(1.0f);
+        drawBitmapString("B: Toggle sync mode", 10, 20);
+        drawBitmapString(std::string("Sync: ") + (bulkSync ? "bulk (World::syncBodies)" : "per body (Body::update)"), 10, 36);
+        drawBitmapString("Bodies: " + std::to_string(world.getBodyCount()), 10, 52);
+        drawBitmapString("Contacts: " + std::to_string(contacts), 10, 68);
+        drawBitmapString("Step: " + std::to_string(lastStepMs) + " ms", 10, 84);
+        drawBitmapString("Sync: " + std::to_string(lastSyncMs) + " ms", 10, 100);
+        drawBitmapString("FPS: " + std::to_string(getFrameRate()), 10, 116);
+    }
+
+    void keyPressed(int key) override {
+        if (key == 'b' || key == 'B') {
+            bulkSync = !bulkSync;
+            stepMicros = syncMicros = 0;
+            frames = 0;
+            windowStart = getElapsedTime();
+        }
+    }
+};
+
+int main() {
+    WindowSettings settings;
+    settings.width = 1280;
+    settings.height = 800;
+    settings.title = "box2dBenchmarkExample";
+
+    return runApp<tcApp>(settings);
+}
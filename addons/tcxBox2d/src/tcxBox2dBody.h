@@ -30,14 +30,16 @@ public:
     Body(const Body&) = delete;
     Body& operator=(const Body&) = delete;
 
-    // Movable
+    // Movable (Box2D user data and the collider follow the new object)
     Body(Body&& other) noexcept
         : tc::Node()
         , world_(other.world_)
         , body_(other.body_)
+        , collider_(std::move(other.collider_))
     {
         other.world_ = nullptr;
         other.body_ = nullptr;
+        relink();
     }
 
     Body& operator=(Body&& other) noexcept {
@@ -45,8 +47,10 @@ public:
             destroy();
             world_ = other.world_;
             body_ = other.body_;
+            collider_ = std::move(other.collider_);
             other.world_ = nullptr;
             other.body_ = nullptr;
+            relink();
         }
         return *this;
     }
@@ -54,12 +58,13 @@ public:
     // -------------------------------------------------------------------------
     // Node Integration: sync Box2D position to Node each frame
     // -------------------------------------------------------------------------
+    // World::update() syncs all bodies in one pass (World::setSyncBodies());
+    // otherwise each body syncs itself here.
     void update() override {
-        if (body_) {
-            tc::Vec2 pos = World::toPixels(body_->GetPosition());
-            setPos(pos.x, pos.y);
-            setRot(body_->GetAngle());
-        }
+        if (world_ && world_->isSyncingBodies()) return;
+        std::unique_lock<std::recursive_mutex> lock;
+        if (world_ && world_->isThreaded() && !hasState_) lock = world_->lockSimulation();
+        syncNode();
     }
 
     // -------------------------------------------------------------------------
@@ -109,12 +114,14 @@ public:
     void setPhysicsPosition(float px, float py) {
         if (body_) {
             body_->SetTransform(World::toBox2d(px, py), body_->GetAngle());
+            hasState_ = false;
         }
     }
 
     void setPhysicsRotation(float radians) {
         if (body_) {
             body_->SetTransform(body_->GetPosition(), radians);
+            hasState_ = false;
         }
     }
 
@@ -125,6 +132,7 @@ public:
     void setPhysicsTransform(const tc::Vec2& pos, float radians) {
         if (body_) {
             body_->SetTransform(World::toBox2d(pos), radians);
+            hasState_ = false;
         }
     }
 
@@ -324,8 +332,11 @@ public:
     // -------------------------------------------------------------------------
     void destroy() {
         if (body_ && world_ && world_->getWorld()) {
+            auto lock = world_->lockSimulation();
             world_->getWorld()->DestroyBody(body_);
+            world_->onBodyDestroyed(this);
             body_ = nullptr;
+            hasState_ = false;
         }
     }
 
@@ -373,6 +384,42 @@ protected:
     World* world_ = nullptr;
     b2Body* body_ = nullptr;
     std::unique_ptr<Collider2D> collider_;
+
+private:
+    friend class World;
+
+    void relink() {
+        if (body_) body_->GetUserData().pointer = reinterpret_cast<uintptr_t>(this);
+        if (collider_) collider_->body_ = this;
+    }
+
+    // Transform shown this frame (Box2D units). Fixed-step / threaded World:
+    // the one stored by World::update(), interpolated between the last two
+    // steps. Threaded without a stored one: caller holds the simulation lock.
+    void syncNode() {
+        if (!body_) return;
+        b2Vec2 p;
+        float angle;
+        if (hasState_ && world_ && world_->isInterpolating()) {
+            float t = world_->getInterpolationAlpha();
+            p = prevPosition_ + t * (statePosition_ - prevPosition_);
+            angle = prevAngle_ + t * (stateAngle_ - prevAngle_);
+        } else if (hasState_ && world_ && world_->isThreaded()) {
+            p = statePosition_;
+            angle = stateAngle_;
+        } else {
+            p = body_->GetPosition();
+            angle = body_->GetAngle();
+        }
+        setPosRot(p.x * World::scale, p.y * World::scale, angle);
+    }
+
+    // Transforms around the last step (Box2D units), set by World::update()
+    b2Vec2 prevPosition_ = b2Vec2(0, 0);
+    b2Vec2 statePosition_ = b2Vec2(0, 0);
+    float prevAngle_ = 0;
+    float stateAngle_ = 0;
+    bool hasState_ = false;
 };
 
 } // namespace tcx::box2d
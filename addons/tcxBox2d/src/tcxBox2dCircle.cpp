@@ -26,6 +26,9 @@ void CircleBody::setup(World& world, float cx, float cy, float radius) {
     world_ = &world;
     radius_ = radius;
 
+    // Threaded World: keep the simulation thread out while creating
+    auto lock = world.lockSimulation();
+
     // Body definition
     b2BodyDef bodyDef;
     bodyDef.type = b2_dynamicBody;
@@ -30,6 +30,8 @@ void PolyShape::setup(World& world, const std::vector<tc::Vec2>& vertices, float
     world_ = &world;
     vertices_ = vertices;
 
+    auto lock = world.lockSimulation();
+
     // Body definition
     b2BodyDef bodyDef;
     bodyDef.type = b2_dynamicBody;
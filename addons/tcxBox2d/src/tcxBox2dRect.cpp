@@ -31,6 +31,8 @@ void RectBody::setup(World& world, float cx, float cy, float width, float height
     width_ = width;
     height_ = height;
 
+    auto lock = world.lockSimulation();
+
     // Body definition
     b2BodyDef bodyDef;
     bodyDef.type = b2_dynamicBody;
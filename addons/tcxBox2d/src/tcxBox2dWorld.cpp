@@ -5,6 +5,8 @@
 #include "tcxBox2dWorld.h"
 #include "tcxBox2dBody.h"
 #include "tcxCollisionManager.h"
+#include <algorithm>
+#include <cmath>
 
 namespace tcx::box2d {
 
@@ -17,22 +19,18 @@ float World::scale = 30.0f;
 World::World() = default;
 
 World::~World() {
+    stopThread();
     clear();
 }
 
-World::World(World&& other) noexcept
-    : world_(std::move(other.world_))
-    , collisionManager_(std::move(other.collisionManager_))
-    , timeStep_(other.timeStep_)
-    , velocityIterations_(other.velocityIterations_)
-    , positionIterations_(other.positionIterations_)
-    , groundBody_(other.groundBody_)
-{
-    other.groundBody_ = nullptr;
+World::World(World&& other) noexcept {
+    *this = std::move(other);
 }
 
 World& World::operator=(World&& other) noexcept {
     if (this != &other) {
+        stopThread();
+        other.stopThread();
         clear();
         world_ = std::move(other.world_);
         collisionManager_ = std::move(other.collisionManager_);
@@ -40,7 +38,14 @@ World& World::operator=(World&& other) noexcept {
         velocityIterations_ = other.velocityIterations_;
         positionIterations_ = other.positionIterations_;
         groundBody_ = other.groundBody_;
+        fixedTimestep_ = other.fixedTimestep_;
+        interpolation_ = other.interpolation_;
+        maxSubSteps_ = other.maxSubSteps_;
+        syncBodies_ = other.syncBodies_;
+        threaded_ = other.threaded_;
         other.groundBody_ = nullptr;
+        other.threaded_ = false;
+        if (threaded_) startThread();
     }
     return *this;
 }
@@ -53,6 +58,8 @@ void World::setup(const tc::Vec2& gravity) {
 }
 
 void World::setup(float gravityX, float gravityY) {
+    auto lock = lockSimulation();
+
     // Clean up existing state if setup() is called multiple times
     if (world_) {
         clear();
@@ -67,6 +74,7 @@ void World::setup(float gravityX, float gravityY) {
 
     // Create and register collision manager
     collisionManager_ = std::make_unique<CollisionManager>();
+    collisionManager_->setDeferred(threaded_);
     world_->SetContactListener(collisionManager_.get());
 }
 
@@ -74,27 +82,128 @@ void World::setup(float gravityX, float gravityY) {
 // Simulation
 // =============================================================================
 void World::update() {
-    if (world_) {
-        world_->Step(timeStep_, velocityIterations_, positionIterations_);
+    update(fixedTimestep_ ? static_cast<float>(tc::getDeltaTime()) : timeStep_);
+}
+
+void World::update(float deltaTime) {
+    if (threaded_) {
+        // Take the latest transforms from the simulation thread
+        bool fresh = false;
+        {
+            std::lock_guard<std::mutex> lock(publishMutex_);
+            if (readyNew_) {
+                std::swap(ready_, front_);
+                readyNew_ = false;
+                fresh = true;
+            }
+            stepCount_ = readySteps_;
+            readySteps_ = 0;
+        }
 
-        // Dispatch onCollisionStay events
+        auto lock = lockSimulation();
+        if (fresh) applySnapshot(front_);
+
+        // Shown one step behind the simulation
+        double since = std::chrono::duration<double>(std::chrono::steady_clock::now() - front_.time).count();
+        alpha_ = interpolation_ ? std::clamp(static_cast<float>(since / timeStep_), 0.0f, 1.0f) : 1.0f;
+
+        if (syncBodies_) syncBodies();
         if (collisionManager_) {
+            collisionManager_->flush();
             collisionManager_->update();
         }
+        return;
+    }
+
+    if (!world_) return;
+
+    if (!fixedTimestep_) {
+        step();
+        stepCount_ = 1;
+        alpha_ = 1.0f;
+    } else {
+        accumulator_ += std::max(0.0f, deltaTime);
+        int steps = static_cast<int>(accumulator_ / timeStep_);
+        if (steps > maxSubSteps_) {
+            // Can't keep up: drop the backlog instead of spiralling
+            steps = maxSubSteps_;
+            accumulator_ = std::fmod(accumulator_, static_cast<double>(timeStep_));
+        } else {
+            accumulator_ -= steps * static_cast<double>(timeStep_);
+        }
+
+        for (int i = 0; i < steps; i++) {
+            if (i == steps - 1 && interpolation_) capturePrevious(snapshot_);
+            step();
+        }
+        if (steps > 0 && interpolation_) {
+            captureCurrent(snapshot_);
+            applySnapshot(snapshot_);
+        }
+        stepCount_ = steps;
+        alpha_ = interpolation_ ? static_cast<float>(accumulator_ / timeStep_) : 1.0f;
+    }
+
+    if (syncBodies_) syncBodies();
+
+    // Dispatch onCollisionStay events
+    if (collisionManager_) {
+        collisionManager_->update();
     }
 }
 
 void World::setFPS(float fps) {
+    auto lock = lockSimulation();
     if (fps > 0) {
         timeStep_ = 1.0f / fps;
     }
 }
 
+void World::syncBodies() {
+    auto lock = lockSimulation();
+    if (!world_) return;
+    for (b2Body* b = world_->GetBodyList(); b; b = b->GetNext()) {
+        uintptr_t ptr = b->GetUserData().pointer;
+        if (ptr != 0) reinterpret_cast<Body*>(ptr)->syncNode();
+    }
+}
+
+void World::setFixedTimestep(bool enabled) {
+    fixedTimestep_ = enabled;
+    accumulator_ = 0.0;
+    alpha_ = 1.0f;
+}
+
+void World::setMaxSubSteps(int n) {
+    auto lock = lockSimulation();
+    maxSubSteps_ = std::max(1, n);
+}
+
+void World::setThreaded(bool enabled) {
+    if (enabled == threaded_) return;
+    if (enabled) {
+        threaded_ = true;
+        if (collisionManager_) collisionManager_->setDeferred(true);
+        startThread();
+    } else {
+        stopThread();
+        threaded_ = false;
+        if (collisionManager_) {
+            collisionManager_->flush();
+            collisionManager_->setDeferred(false);
+        }
+        accumulator_ = 0.0;
+        alpha_ = 1.0f;
+    }
+}
+
 void World::setVelocityIterations(int n) {
+    auto lock = lockSimulation();
     velocityIterations_ = n;
 }
 
 void World::setPositionIterations(int n) {
+    auto lock = lockSimulation();
     positionIterations_ = n;
 }
 
@@ -103,12 +212,14 @@ void World::setGravity(const tc::Vec2& gravity) {
 }
 
 void World::setGravity(float x, float y) {
+    auto lock = lockSimulation();
     if (world_) {
         world_->SetGravity(b2Vec2(x / scale, y / scale));
     }
 }
 
 tc::Vec2 World::getGravity() const {
+    auto lock = lockSimulation();
     if (world_) {
         b2Vec2 g = world_->GetGravity();
         return tc::Vec2(g.x * scale, g.y * scale);
@@ -120,6 +231,7 @@ tc::Vec2 World::getGravity() const {
 // Bounds
 // =============================================================================
 void World::createBounds(float x, float y, float width, float height) {
+    auto lock = lockSimulation();
     if (!world_) return;
 
     // Remove existing bounds
@@ -167,6 +279,7 @@ void World::createBounds() {
 }
 
 void World::createGround(float y, float width) {
+    auto lock = lockSimulation();
     if (!world_) return;
 
     if (groundBody_) {
@@ -192,6 +305,7 @@ void World::createGround() {
 // Body Management
 // =============================================================================
 void World::clear() {
+    auto lock = lockSimulation();
     if (world_) {
         // Destroy mouse joint
         endDrag();
@@ -205,10 +319,12 @@ void World::clear() {
         }
         groundBody_ = nullptr;
         dragAnchorBody_ = nullptr;
+        bodyEpoch_++;
     }
 }
 
 int World::getBodyCount() const {
+    auto lock = lockSimulation();
     return world_ ? world_->GetBodyCount() : 0;
 }
 
@@ -220,6 +336,7 @@ Body* World::getBodyAtPoint(const tc::Vec2& point) {
 }
 
 Body* World::getBodyAtPoint(float px, float py) {
+    auto lock = lockSimulation();
     if (!world_) return nullptr;
 
     b2Vec2 point = toBox2d(px, py);
@@ -249,6 +366,7 @@ void World::startDrag(Body* body, const tc::Vec2& target) {
 }
 
 void World::startDrag(Body* body, float tx, float ty) {
+    auto lock = lockSimulation();
     if (!world_ || !body || !body->getBody()) return;
 
     // Destroy existing joint if any
@@ -281,12 +399,14 @@ void World::updateDrag(const tc::Vec2& target) {
 }
 
 void World::updateDrag(float tx, float ty) {
+    auto lock = lockSimulation();
     if (mouseJoint_) {
         mouseJoint_->SetTarget(toBox2d(tx, ty));
     }
 }
 
 void World::endDrag() {
+    auto lock = lockSimulation();
     if (mouseJoint_ && world_) {
         world_->DestroyJoint(mouseJoint_);
         mouseJoint_ = nullptr;
@@ -298,12 +418,110 @@ bool World::isDragging() const {
 }
 
 tc::Vec2 World::getDragAnchor() const {
+    auto lock = lockSimulation();
     if (mouseJoint_) {
         return toPixels(mouseJoint_->GetAnchorB());
     }
     return tc::Vec2(0, 0);
 }
 
+void World::onBodyDestroyed(Body* body) {
+    bodyEpoch_++;
+    if (collisionManager_) collisionManager_->forgetBody(body);
+}
+
+// =============================================================================
+// Stepping (simulation locked)
+// =============================================================================
+void World::step() {
+    world_->Step(timeStep_, velocityIterations_, positionIterations_);
+}
+
+void World::capturePrevious(Snapshot& snapshot) {
+    snapshot.states.clear();
+    snapshot.bodyEpoch = bodyEpoch_;
+    for (b2Body* b = world_->GetBodyList(); b; b = b->GetNext()) {
+        uintptr_t ptr = b->GetUserData().pointer;
+        if (ptr == 0 || b->GetType() == b2_staticBody) continue;
+        b2Vec2 p = b->GetPosition();
+        float a = b->GetAngle();
+        snapshot.states.push_back({reinterpret_cast<Body*>(ptr), b, p, a, p, a});
+    }
+}
+
+void World::captureCurrent(Snapshot& snapshot) {
+    for (auto& state : snapshot.states) {
+        state.position = state.b2body->GetPosition();
+        state.angle = state.b2body->GetAngle();
+    }
+    snapshot.time = std::chrono::steady_clock::now();
+}
+
+void World::applySnapshot(const Snapshot& snapshot) {
+    if (snapshot.bodyEpoch != bodyEpoch_) return;  // Holds destroyed bodies
+    for (auto& state : snapshot.states) {
+        Body* body = state.body;
+        if (body->body_ != state.b2body) continue;
+        body->prevPosition_ = state.prevPosition;
+        body->prevAngle_ = state.prevAngle;
+        body->statePosition_ = state.position;
+        body->stateAngle_ = state.angle;
+        body->hasState_ = true;
+    }
+}
+
+// =============================================================================
+// Simulation Thread
+// =============================================================================
+void World::startThread() {
+    if (thread_.joinable()) return;
+    readyNew_ = false;
+    readySteps_ = 0;
+    threadStop_ = false;
+    thread_ = std::thread([this]() { threadLoop(); });
+}
+
+void World::stopThread() {
+    threadStop_ = true;
+    if (thread_.joinable()) thread_.join();
+}
+
+void World::threadLoop() {
+    using clock = std::chrono::steady_clock;
+    auto next = clock::now();
+    while (!threadStop_) {
+        std::this_thread::sleep_until(next);
+        if (threadStop_) break;
+
+        float dt;
+        int maxBehind;
+        bool stepped = false;
+        {
+            auto lock = lockSimulation();
+            dt = timeStep_;
+            maxBehind = maxSubSteps_;
+            if (world_) {
+                capturePrevious(back_);
+                step();
+                captureCurrent(back_);
+                stepped = true;
+            }
+        }
+        if (stepped) {
+            std::lock_guard<std::mutex> lock(publishMutex_);
+            std::swap(back_, ready_);
+            readyNew_ = true;
+            readySteps_++;
+        }
+
+        // Fixed rate; drop the backlog when a step takes too long
+        auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(dt));
+        next += period;
+        auto now = clock::now();
+        if (now - next > period * maxBehind) next = now;
+    }
+}
+
 // =============================================================================
 // Coordinate Conversion
 // =============================================================================
@@ -8,6 +8,10 @@
 #include <box2d/box2d.h>
 #include <memory>
 #include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
 
 namespace tcx::box2d {
 
@@ -48,14 +52,61 @@ public:
     // Simulation
     // -------------------------------------------------------------------------
 
-    // Advance physics simulation by one step
+    // Advance physics simulation (call once per frame)
+    // Default: one step per call. Fixed-step mode: as many steps of 1 / fps
+    // as the elapsed time needs (deltaTime: seconds, default getDeltaTime()).
+    // Threaded mode: takes the transforms published by the simulation thread.
     void update();
+    void update(float deltaTime);
 
     // Simulation parameters
     void setFPS(float fps);               // FPS (default: 60)
     void setVelocityIterations(int n);    // Velocity iterations (default: 8)
     void setPositionIterations(int n);    // Position iterations (default: 3)
 
+    // -------------------------------------------------------------------------
+    // Fixed Timestep / Threading
+    // -------------------------------------------------------------------------
+
+    // Step at a fixed rate independent of the frame rate (default: off)
+    void setFixedTimestep(bool enabled);
+    bool isFixedTimestep() const { return fixedTimestep_; }
+
+    // Steps per update() at most; time beyond that is dropped (default: 4)
+    void setMaxSubSteps(int n);
+
+    // Draw bodies between the last two steps (default: on, fixed / threaded)
+    void setInterpolation(bool enabled) { interpolation_ = enabled; }
+    bool isInterpolating() const { return interpolation_ && (fixedTimestep_ || threaded_); }
+    float getInterpolationAlpha() const { return alpha_; }
+
+    // Steps taken by the last update() (threaded: published since the last one)
+    int getStepCount() const { return stepCount_; }
+
+    // Run the simulation on a background thread at setFPS() rate.
+    // Collision events are still delivered on the main thread in update().
+    // While it runs, Body setters and other direct Box2D access from the
+    // main thread must hold lockSimulation(). Creating / destroying bodies
+    // and the World methods below lock by themselves.
+    void setThreaded(bool enabled);
+    bool isThreaded() const { return threaded_; }
+
+    std::unique_lock<std::recursive_mutex> lockSimulation() const {
+        return std::unique_lock<std::recursive_mutex>(simMutex_);
+    }
+
+    // -------------------------------------------------------------------------
+    // Node Sync
+    // -------------------------------------------------------------------------
+
+    // update() writes every body's transform into its Node in one pass over
+    // the Box2D body list (default: on). Off: each Body::update() syncs itself.
+    void setSyncBodies(bool enabled) { syncBodies_ = enabled; }
+    bool isSyncingBodies() const { return syncBodies_; }
+
+    // The pass itself (called by update())
+    void syncBodies();
+
     // Gravity
     void setGravity(const tc::Vec2& gravity);
     void setGravity(float x, float y);
@@ -134,7 +185,34 @@ public:
     // -------------------------------------------------------------------------
     CollisionManager* getCollisionManager() { return collisionManager_.get(); }
 
+    // Called by Body::destroy() (simulation locked)
+    void onBodyDestroyed(Body* body);
+
 private:
+    // Body transforms around one step (Box2D units)
+    struct BodyState {
+        Body* body;
+        b2Body* b2body;
+        b2Vec2 prevPosition;
+        float prevAngle;
+        b2Vec2 position;
+        float angle;
+    };
+
+    struct Snapshot {
+        std::vector<BodyState> states;
+        uint64_t bodyEpoch = 0;     // Destroyed bodies invalidate older snapshots
+        std::chrono::steady_clock::time_point time;
+    };
+
+    void step();
+    void capturePrevious(Snapshot& snapshot);
+    void captureCurrent(Snapshot& snapshot);
+    void applySnapshot(const Snapshot& snapshot);
+    void startThread();
+    void stopThread();
+    void threadLoop();
+
     std::unique_ptr<b2World> world_;
     std::unique_ptr<CollisionManager> collisionManager_;
 
@@ -146,6 +224,30 @@ private:
     // Bounds body
     b2Body* groundBody_ = nullptr;
 
+    bool syncBodies_ = true;
+
+    // Fixed timestep
+    bool fixedTimestep_ = false;
+    bool interpolation_ = true;
+    int maxSubSteps_ = 4;
+    double accumulator_ = 0.0;
+    float alpha_ = 1.0f;
+    int stepCount_ = 0;
+    Snapshot snapshot_;                 // Main thread (fixed-step mode)
+
+    // Simulation thread
+    bool threaded_ = false;
+    std::thread thread_;
+    std::atomic<bool> threadStop_{false};
+    mutable std::recursive_mutex simMutex_;     // Box2D world
+    std::mutex publishMutex_;                   // ready_
+    Snapshot back_;                             // Simulation thread
+    Snapshot ready_;                            // Latest published
+    Snapshot front_;                            // Main thread
+    bool readyNew_ = false;
+    int readySteps_ = 0;                        // Since the main thread last took ready_
+    std::atomic<uint64_t> bodyEpoch_{0};
+
     // Mouse drag
     b2MouseJoint* mouseJoint_ = nullptr;
     b2Body* dragAnchorBody_ = nullptr;  // Static body for joint anchor
@@ -24,4 +24,14 @@ struct CollisionEvent {
     bool hasContactPoint() const { return other != nullptr; }
 };
 
+// =============================================================================
+// ContactEvent - One contact in the batched CollisionManager events
+// =============================================================================
+struct ContactEvent {
+    Body* a = nullptr;
+    Body* b = nullptr;
+    tc::Vec2 contactPoint;         // Contact point in pixels
+    tc::Vec2 normal;               // From a to b
+};
+
 } // namespace tcx::box2d
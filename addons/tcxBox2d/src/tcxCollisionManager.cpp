@@ -13,20 +13,96 @@ namespace tcx::box2d {
 // =============================================================================
 
 void CollisionManager::update() {
+    if (!enterBatch_.empty()) {
+        onContactsEnter.notify(enterBatch_);
+        enterBatch_.clear();
+    }
+
     // Dispatch onCollisionStay for all active contacts
+    // (events are only built for colliders that listen)
     for (auto& pair : activeContacts_) {
         if (pair.a && pair.b && pair.contact) {
             // Notify A about collision with B
-            CollisionEvent eventA = createEvent(pair.contact, pair.a, pair.b);
-            pair.a->notifyStay(eventA);
+            if (!pair.a->onCollisionStay.empty()) {
+                CollisionEvent eventA = createEvent(pair.contact, pair.a, pair.b);
+                pair.a->notifyStay(eventA);
+            }
 
             // Notify B about collision with A
-            CollisionEvent eventB = createEvent(pair.contact, pair.b, pair.a);
-            pair.b->notifyStay(eventB);
+            if (!pair.b->onCollisionStay.empty()) {
+                CollisionEvent eventB = createEvent(pair.contact, pair.b, pair.a);
+                pair.b->notifyStay(eventB);
+            }
+        }
+    }
+
+    if (!onContactsStay.empty()) {
+        stayBatch_.clear();
+        for (auto& pair : activeContacts_) {
+            if (pair.a && pair.b && pair.contact) {
+                stayBatch_.push_back(createContact(pair.contact, pair.a, pair.b));
+            }
+        }
+        if (!stayBatch_.empty()) onContactsStay.notify(stayBatch_);
+    }
+
+    if (!exitBatch_.empty()) {
+        onContactsExit.notify(exitBatch_);
+        exitBatch_.clear();
+    }
+}
+
+// =============================================================================
+// Deferred Dispatch
+// =============================================================================
+
+void CollisionManager::flush() {
+    // Handlers may raise new events (e.g. by destroying bodies)
+    while (!pending_.empty()) {
+        std::swap(pending_, dispatching_);
+        for (size_t i = 0; i < dispatching_.size(); i++) {
+            PendingEvent& p = dispatching_[i];
+            if (!p.target) continue;    // Body destroyed by an earlier handler
+            if (p.enter) p.target->notifyEnter(p.event);
+            else p.target->notifyExit(p.event);
+        }
+        dispatching_.clear();
+    }
+}
+
+void CollisionManager::forgetBody(Body* body) {
+    pending_.erase(
+        std::remove_if(pending_.begin(), pending_.end(),
+            [body](const PendingEvent& p) { return p.target->getBody() == body; }),
+        pending_.end()
+    );
+    // Being dispatched: only mark
+    for (auto& p : dispatching_) {
+        if (p.target && p.target->getBody() == body) p.target = nullptr;
+    }
+    for (auto* events : {&pending_, &dispatching_}) {
+        for (auto& p : *events) {
+            if (p.event.other == body) p.event.other = nullptr;
+        }
+    }
+    for (auto* batch : {&enterBatch_, &exitBatch_}) {
+        for (auto& c : *batch) {
+            if (c.a == body) c.a = nullptr;
+            if (c.b == body) c.b = nullptr;
         }
     }
 }
 
+void CollisionManager::dispatch(Collider2D* target, CollisionEvent& event, bool enter) {
+    if (deferred_) {
+        pending_.push_back({target, event, enter});
+    } else if (enter) {
+        target->notifyEnter(event);
+    } else {
+        target->notifyExit(event);
+    }
+}
+
 // =============================================================================
 // b2ContactListener Implementation
 // =============================================================================
@@ -42,13 +118,14 @@ void CollisionManager::BeginContact(b2Contact* contact) {
 
     // Add to active contacts for Stay events
     activeContacts_.push_back({colliderA, colliderB, contact});
+    if (!onContactsEnter.empty()) enterBatch_.push_back(createContact(contact, colliderA, colliderB));
 
     // Dispatch onCollisionEnter
     CollisionEvent eventA = createEvent(contact, colliderA, colliderB);
-    colliderA->notifyEnter(eventA);
+    dispatch(colliderA, eventA, true);
 
     CollisionEvent eventB = createEvent(contact, colliderB, colliderA);
-    colliderB->notifyEnter(eventB);
+    dispatch(colliderB, eventB, true);
 }
 
 void CollisionManager::EndContact(b2Contact* contact) {
@@ -62,13 +139,14 @@ void CollisionManager::EndContact(b2Contact* contact) {
 
     // Remove from active contacts
     removeContactPair(colliderA, colliderB);
+    if (!onContactsExit.empty()) exitBatch_.push_back(createContact(contact, colliderA, colliderB));
 
     // Dispatch onCollisionExit
     CollisionEvent eventA = createEvent(contact, colliderA, colliderB);
-    colliderA->notifyExit(eventA);
+    dispatch(colliderA, eventA, false);
 
     CollisionEvent eventB = createEvent(contact, colliderB, colliderA);
-    colliderB->notifyExit(eventB);
+    dispatch(colliderB, eventB, false);
 }
 
 void CollisionManager::PreSolve(b2Contact* contact, const b2Manifold* oldManifold) {
@@ -119,6 +197,20 @@ CollisionEvent CollisionManager::createEvent(b2Contact* contact, Collider2D* sel
     return event;
 }
 
+ContactEvent CollisionManager::createContact(b2Contact* contact, Collider2D* a, Collider2D* b) {
+    ContactEvent event;
+    event.a = a->getBody();
+    event.b = b->getBody();
+
+    b2WorldManifold worldManifold;
+    contact->GetWorldManifold(&worldManifold);
+    if (contact->GetManifold()->pointCount > 0) {
+        event.contactPoint = World::toPixels(worldManifold.points[0]);
+        event.normal = tc::Vec2(worldManifold.normal.x, worldManifold.normal.y);
+    }
+    return event;
+}
+
 void CollisionManager::removeContactPair(Collider2D* a, Collider2D* b) {
     activeContacts_.erase(
         std::remove_if(activeContacts_.begin(), activeContacts_.end(),
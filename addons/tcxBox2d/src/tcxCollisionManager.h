@@ -14,6 +14,7 @@ namespace tcx::box2d {
 
 // Forward declarations
 class World;
+class Body;
 
 // =============================================================================
 // CollisionManager - Box2D Contact Listener
@@ -35,6 +36,26 @@ public:
     // -------------------------------------------------------------------------
     void update();
 
+    // -------------------------------------------------------------------------
+    // Batched Events
+    // -------------------------------------------------------------------------
+    // All contacts of one World::update() in one call each, delivered in
+    // update(). Nothing is collected while an event has no listeners.
+    tc::Event<std::vector<ContactEvent>> onContactsEnter;
+    tc::Event<std::vector<ContactEvent>> onContactsStay;
+    tc::Event<std::vector<ContactEvent>> onContactsExit;
+
+    // -------------------------------------------------------------------------
+    // Deferred Dispatch (threaded World)
+    // -------------------------------------------------------------------------
+    // Enter / Exit events raised during Step() are queued and dispatched by
+    // flush() on the main thread
+    void setDeferred(bool deferred) { deferred_ = deferred; }
+    void flush();
+
+    // Drop queued events for a destroyed body
+    void forgetBody(Body* body);
+
     // -------------------------------------------------------------------------
     // b2ContactListener Implementation
     // -------------------------------------------------------------------------
@@ -69,6 +90,20 @@ private:
 
     std::vector<ContactPair> activeContacts_;
 
+    struct PendingEvent {
+        Collider2D* target;
+        CollisionEvent event;
+        bool enter;
+    };
+
+    bool deferred_ = false;
+    std::vector<PendingEvent> pending_;
+    std::vector<PendingEvent> dispatching_;
+
+    std::vector<ContactEvent> enterBatch_;
+    std::vector<ContactEvent> stayBatch_;
+    std::vector<ContactEvent> exitBatch_;
+
     // -------------------------------------------------------------------------
     // Helper Methods
     // -------------------------------------------------------------------------
@@ -78,9 +113,13 @@ private:
 
     // Create CollisionEvent from contact
     static CollisionEvent createEvent(b2Contact* contact, Collider2D* self, Collider2D* other);
+    static ContactEvent createContact(b2Contact* contact, Collider2D* a, Collider2D* b);
 
     // Find and remove contact pair
     void removeContactPair(Collider2D* a, Collider2D* b);
+
+    // Notify now, or queue in deferred mode
+    void dispatch(Collider2D* target, CollisionEvent& event, bool enter);
 };
 
 } // namespace tcx::box2d
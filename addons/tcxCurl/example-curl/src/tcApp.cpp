@@ -1,7 +1,8 @@
 // =============================================================================
 // curlExample - tcxCurl HTTPS client example
 // =============================================================================
-// Fetches data from a public JSON API and displays the results.
+// Fetches data from a public JSON API (without blocking the frame)
+// and displays the results.
 // Press SPACE to fetch a new random entry.
 // =============================================================================
 
@@ -27,19 +28,23 @@ public:
     }
 
     void fetchEntry() {
+        // Non-blocking: the callback runs on the main thread when the response arrives
         status = "Fetching...";
-        auto res = client.get("/posts/" + to_string(entryId));
+        int id = entryId;
+        client.getAsync("/posts/" + to_string(id), [this, id](const HttpResponse& res) {
+            if (id != entryId) return;  // Stale response
 
-        if (res.ok()) {
-            auto data = res.json();
-            title = data.value("title", "(no title)");
-            body = data.value("body", "");
-            status = "OK (status " + to_string(res.statusCode) + ")";
-        } else {
-            title = "Error";
-            body = res.error.empty() ? "HTTP " + to_string(res.statusCode) : res.error;
-            status = "Failed";
-        }
+            if (res.ok()) {
+                auto data = res.json();
+                title = data.value("title", "(no title)");
+                body = data.value("body", "");
+                status = "OK (status " + to_string(res.statusCode) + ")";
+            } else {
+                title = "Error";
+                body = res.error.empty() ? "HTTP " + to_string(res.statusCode) : res.error;
+                status = "Failed";
+            }
+        });
     }
 
     void draw() override {
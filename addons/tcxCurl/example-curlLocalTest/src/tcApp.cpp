@@ -0,0 +1,243 @@
+// =============================================================================
+// curlLocalTest - tcxCurl async paths against a local server (headless)
+// =============================================================================
+//
+// Starts the bundled cpp-httplib server on 127.0.0.1 (random port) and runs
+// every async request type of HttpClient against it:
+//   - getAsync (callback and future), postAsync, postRawAsync, delAsync
+//   - HTTP error status, queueing beyond setMaxConcurrentRequests()
+//   - downloadAsync to a file
+//   - streamAsync with a chunked body, and aborting from onChunk
+//   - cancelAll() on slow requests in flight
+// Each check is logged as PASS / FAIL and the app exits when done.
+//
+// =============================================================================
+
+#include "tcApp.h"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+constexpr int STREAM_CHUNKS = 20;
+constexpr size_t DOWNLOAD_SIZE = 256 * 1024;
+constexpr int QUEUED_REQUESTS = 12;
+constexpr double PHASE_TIMEOUT = 10.0;
+
+string downloadBody() {
+    string body(DOWNLOAD_SIZE, '\0');
+    for (size_t i = 0; i < body.size(); i++) body[i] = static_cast<char>((i * 31) & 0xFF);
+    return body;
+}
+
+string streamChunk(int i) {
+    return "chunk-" + to_string(i) + "\n";
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Server
+// -----------------------------------------------------------------------------
+void tcApp::startServer() {
+    server_.Get("/hello", [](const httplib::Request& req, httplib::Response& res) {
+        res.set_content("hello " + req.get_param_value("i"), "text/plain");
+    });
+    server_.Post("/echo", [](const httplib::Request& req, httplib::Response& res) {
+        res.set_content(req.body, req.get_header_value("Content-Type"));
+    });
+    server_.Delete("/item", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content("deleted", "text/plain");
+    });
+    server_.Get("/file", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content(downloadBody(), "application/octet-stream");
+    });
+
+    // Chunked body, one piece every 10 ms
+    server_.Get("/stream", [this](const httplib::Request&, httplib::Response& res) {
+        res.set_chunked_content_provider("text/plain", [this](size_t, httplib::DataSink& sink) {
+            for (int n = 0; n < STREAM_CHUNKS && !stopping_; n++) {
+                string chunk = streamChunk(n);
+                if (!sink.write(chunk.data(), chunk.size())) return false;
+                this_thread::sleep_for(chrono::milliseconds(10));
+            }
+            sink.done();
+            return true;
+        });
+    });
+
+    // Answers after 3 seconds (cancel target)
+    server_.Get("/slow", [this](const httplib::Request&, httplib::Response& res) {
+        for (int i = 0; i < 300 && !stopping_; i++) {
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        res.set_content("late", "text/plain");
+    });
+
+    port_ = server_.bind_to_any_port("127.0.0.1");
+    serverThread_ = thread([this]() { server_.listen_after_bind(); });
+    server_.wait_until_ready();
+}
+
+// -----------------------------------------------------------------------------
+// Checks
+// -----------------------------------------------------------------------------
+void tcApp::check(const string& name, bool ok, const string& detail) {
+    if (ok) {
+        passed_++;
+        logNotice("curlLocalTest") << "PASS " << name;
+    } else {
+        failed_++;
+        logError("curlLocalTest") << "FAIL " << name << (detail.empty() ? "" : " (" + detail + ")");
+    }
+}
+
+HttpCallback tcApp::expect(const string& name, function<bool(const HttpResponse&)> test) {
+    outstanding_++;
+    return [this, name, test](const HttpResponse& res) {
+        outstanding_--;
+        string detail = "status " + to_string(res.statusCode) + (res.error.empty() ? "" : ", " + res.error);
+        check(name, test(res), detail);
+    };
+}
+
+// -----------------------------------------------------------------------------
+// Phase 1: every request type
+// -----------------------------------------------------------------------------
+void tcApp::startRequests() {
+    // Future: resolved on the network thread, fine to wait on here
+    auto future = client_.getAsync("/hello?i=future");
+    if (future.wait_for(chrono::seconds(5)) == future_status::ready) {
+        HttpResponse res = future.get();
+        check("getAsync (future)", res.ok() && res.body == "hello future");
+    } else {
+        check("getAsync (future)", false, "timeout");
+    }
+
+    client_.getAsync("/hello?i=cb", expect("getAsync (callback)", [](const HttpResponse& res) {
+        return res.ok() && res.body == "hello cb";
+    }));
+
+    client_.postAsync("/echo", nlohmann::json{{"value", 42}}, expect("postAsync (json)", [](const HttpResponse& res) {
+        return res.ok() && res.json().value("value", 0) == 42;
+    }));
+
+    string raw(1000, 'r');
+    client_.postRawAsync("/echo", raw, "application/octet-stream", expect("postRawAsync", [raw](const HttpResponse& res) {
+        return res.ok() && res.body == raw;
+    }));
+
+    client_.delAsync("/item", expect("delAsync", [](const HttpResponse& res) {
+        return res.ok() && res.body == "deleted";
+    }));
+
+    client_.getAsync("/missing", expect("HTTP 404", [](const HttpResponse& res) {
+        return res.statusCode == 404 && !res.ok() && res.error.empty();
+    }));
+
+    // More requests than slots: the rest wait in the queue
+    client_.setMaxConcurrentRequests(2);
+    for (int i = 0; i < QUEUED_REQUESTS; i++) {
+        string expected = "hello " + to_string(i);
+        client_.getAsync("/hello?i=" + to_string(i), expect("queued request " + to_string(i), [expected](const HttpResponse& res) {
+            return res.ok() && res.body == expected;
+        }));
+    }
+
+    client_.downloadAsync("/file", downloadPath_, expect("downloadAsync", [this](const HttpResponse& res) {
+        if (!res.ok() || !res.body.empty()) return false;
+        ifstream in(downloadPath_, ios::binary);
+        string data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        return data == downloadBody();
+    }));
+
+    client_.streamAsync("/stream",
+        [this](const char* data, size_t size) {
+            streamed_.append(data, size);
+            chunkCount_++;
+            return true;
+        },
+        expect("streamAsync", [this](const HttpResponse& res) {
+            string expected;
+            for (int i = 0; i < STREAM_CHUNKS; i++) expected += streamChunk(i);
+            // Paced chunks: more than one callback, same bytes in order
+            return res.ok() && res.body.empty() && streamed_ == expected && chunkCount_ > 1;
+        }));
+
+    client_.streamAsync("/stream",
+        [](const char*, size_t) { return false; },
+        expect("streamAsync abort from onChunk", [](const HttpResponse& res) {
+            return res.error == "Aborted";
+        }));
+}
+
+// -----------------------------------------------------------------------------
+// Phase 2: cancel requests in flight and queued
+// -----------------------------------------------------------------------------
+void tcApp::startCancel() {
+    client_.setMaxConcurrentRequests(1);
+    for (int i = 0; i < 2; i++) {
+        // First is in flight, second still queued when cancelAll() runs
+        client_.getAsync("/slow", expect("cancelAll " + string(i == 0 ? "(in flight)" : "(queued)"), [](const HttpResponse& res) {
+            return res.error == "Cancelled" && res.statusCode == 0;
+        }));
+    }
+}
+
+// -----------------------------------------------------------------------------
+// App
+// -----------------------------------------------------------------------------
+void tcApp::setup() {
+    logNotice("curlLocalTest") << "=== tcxCurl local test ===";
+
+    startServer();
+    if (port_ <= 0) {
+        logError("curlLocalTest") << "Failed to start local server";
+        requestExit();
+        return;
+    }
+    logNotice("curlLocalTest") << "server on 127.0.0.1:" << port_;
+
+    downloadPath_ = (filesystem::temp_directory_path() / "tcxCurlLocalTest.bin").string();
+    client_.setBaseUrl("http://127.0.0.1:" + to_string(port_));
+
+    phaseStart_ = headless::getElapsedTime();
+    startRequests();
+}
+
+void tcApp::update() {
+    if (phase_ == Phase::Done) return;
+
+    double elapsed = headless::getElapsedTime() - phaseStart_;
+    if (outstanding_ > 0 && elapsed > PHASE_TIMEOUT) {
+        check("phase timeout", false, to_string(outstanding_) + " callbacks missing");
+        outstanding_ = 0;
+    }
+
+    if (phase_ == Phase::Cancel && !cancelSent_ && elapsed > 0.2) {
+        client_.cancelAll();
+        cancelSent_ = true;
+    }
+
+    if (outstanding_ > 0) return;
+
+    if (phase_ == Phase::Requests) {
+        phase_ = Phase::Cancel;
+        phaseStart_ = headless::getElapsedTime();
+        startCancel();
+    } else {
+        // Cancelled requests must not wait for the server's 3 s answer
+        check("cancel is immediate", elapsed < 2.0, to_string(elapsed) + " s");
+        phase_ = Phase::Done;
+        logNotice("curlLocalTest") << "=== " << passed_ << " passed, " << failed_ << " failed ===";
+        requestExit();
+    }
+}
+
+void tcApp::cleanup() {
+    client_.cancelAll();
+    stopping_ = true;
+    server_.stop();
+    if (serverThread_.joinable()) serverThread_.join();
+    filesystem::remove(downloadPath_);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <TrussC.h>
+#include <tcxCurl.h>
+#include <impl/httplib.h>
+
+using namespace std;
+using namespace tc;
+using namespace tcx;
+
+class tcApp : public App {
+public:
+    void setup() override;
+    void update() override;
+    void cleanup() override;
+
+private:
+    // Local stand-in server (httplib on its own thread)
+    httplib::Server server_;
+    thread serverThread_;
+    atomic<bool> stopping_{false};
+    int port_ = 0;
+
+    HttpClient client_;
+
+    enum class Phase { Requests, Cancel, Done };
+    Phase phase_ = Phase::Requests;
+    int outstanding_ = 0;       // Callbacks still to arrive in this phase
+    int passed_ = 0;
+    int failed_ = 0;
+    double phaseStart_ = 0.0;
+    bool cancelSent_ = false;
+
+    string downloadPath_;
+    string streamed_;           // Written on the network thread, read in onComplete
+    int chunkCount_ = 0;
+
+    void startServer();
+    void startRequests();
+    void startCancel();
+    void check(const string& name, bool ok, const string& detail = "");
+    HttpCallback expect(const string& name, function<bool(const HttpResponse&)> test);
+};
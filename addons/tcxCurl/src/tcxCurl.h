@@ -21,13 +21,28 @@
 //   if (res.ok()) {
 //       auto& bytes = res.body;  // raw bytes
 //   }
+//
+//   // Non-blocking (callback is called on the main thread)
+//   client.getAsync("/api/photos", [](const HttpResponse& res) { ... });
+//
+//   // Non-blocking with future
+//   auto future = client.getAsync("/api/photos");
 // =============================================================================
 
 #include <string>
 #include <vector>
+#include <deque>
+#include <unordered_map>
 #include <algorithm>
 #include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <cstdio>
 #include <nlohmann/json.hpp>
+#include "tc/events/tcCoreEvents.h"
 
 #ifdef TCX_HTTP_CURL
 #include <curl/curl.h>
@@ -53,6 +68,12 @@ struct HttpResponse {
     }
 };
 
+// Completion callback (main thread)
+using HttpCallback = std::function<void(const HttpResponse&)>;
+
+// Response body chunk (network thread). Return false to abort the transfer
+using HttpChunkCallback = std::function<bool(const char* data, size_t size)>;
+
 // Process-wide curl init/cleanup (called once automatically)
 namespace detail {
     struct CurlGlobalGuard {
@@ -70,6 +91,382 @@ namespace detail {
     inline void ensureCurlInit() {
         static CurlGlobalGuard guard;
     }
+
+    // One queued async request
+    struct AsyncRequest {
+        std::string method;
+        std::string url;
+        std::string body;
+        std::string contentType;
+        std::vector<std::string> headers;   // "Key: Value"
+        long timeout = 30;                  // Seconds (0 = no limit)
+
+        // Body destination (memory unless one of these is set)
+        std::string filePath;
+        HttpChunkCallback onChunk;
+
+        // Completion: future (any thread) or callback (main thread)
+        bool usePromise = false;
+        std::promise<HttpResponse> promise;
+        HttpCallback onComplete;
+
+        HttpResponse response;
+
+#ifdef TCX_HTTP_CURL
+        // Transfer state (network thread only)
+        curl_slist* headerList = nullptr;
+        FILE* file = nullptr;
+        bool aborted = false;
+#endif
+    };
+
+    // -------------------------------------------------------------------------
+    // CompletionQueue - Finished callbacks waiting for the main thread
+    //
+    // Owned by HttpClient and created with it, so the update listener is
+    // registered from the thread that creates the client (normally the main
+    // thread), never from the network thread or whoever sends the first
+    // async request.
+    // -------------------------------------------------------------------------
+    class CompletionQueue {
+    public:
+        CompletionQueue() {
+            // Deliver callbacks on the main thread, before app update()
+            updateListener_ = trussc::events().update.listen([this]() {
+                process();
+            }, trussc::EventPriority::BeforeApp);
+        }
+
+        CompletionQueue(const CompletionQueue&) = delete;
+        CompletionQueue& operator=(const CompletionQueue&) = delete;
+
+        // Any thread
+        void push(HttpCallback callback, HttpResponse response) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            completed_.emplace_back(std::move(callback), std::move(response));
+        }
+
+        // Main thread
+        void process() {
+            std::vector<std::pair<HttpCallback, HttpResponse>> done;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (completed_.empty()) return;
+                done.swap(completed_);
+            }
+            for (auto& [callback, response] : done) {
+                callback(response);
+            }
+        }
+
+    private:
+        trussc::EventListener updateListener_;
+        std::mutex mutex_;
+        std::vector<std::pair<HttpCallback, HttpResponse>> completed_;
+    };
+
+#ifdef TCX_HTTP_CURL
+
+    // Set method, body and headers on an easy handle.
+    // Returns the header list (caller frees after the transfer)
+    inline curl_slist* setupRequest(CURL* curl, const std::string& method,
+                                    const std::string& body, const std::string& contentType,
+                                    const std::vector<std::string>& headerLines) {
+        if (method == "POST") {
+            curl_easy_setopt(curl, CURLOPT_POST, 1L);
+        } else if (method == "DELETE") {
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+        } else if (method == "PUT") {
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
+        }
+
+        struct curl_slist* headers = nullptr;
+        for (const auto& line : headerLines) {
+            headers = curl_slist_append(headers, line.c_str());
+        }
+        if (!body.empty()) {
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(body.size()));
+            std::string ct = "Content-Type: " + contentType;
+            headers = curl_slist_append(headers, ct.c_str());
+        }
+        if (headers) {
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        }
+        return headers;
+    }
+
+    // -------------------------------------------------------------------------
+    // CurlMulti - Async transfer engine
+    //
+    // One curl multi handle driven by one background thread. Easy handles
+    // are pooled and the multi handle's connection cache keeps connections
+    // (and TLS sessions) alive between requests. Requests beyond the
+    // concurrency limit wait in a FIFO queue.
+    // -------------------------------------------------------------------------
+    class CurlMulti {
+    public:
+        CurlMulti(int maxConcurrent, int maxHostConnections, CompletionQueue& completions)
+            : completions_(completions)
+            , maxConcurrent_(std::max(1, maxConcurrent))
+            , maxHostConnections_(maxHostConnections) {
+            multi_ = curl_multi_init();
+            running_ = true;
+            thread_ = std::thread(&CurlMulti::threadFunc, this);
+        }
+
+        ~CurlMulti() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                running_ = false;
+            }
+            curl_multi_wakeup(multi_);
+            if (thread_.joinable()) thread_.join();
+
+            for (CURL* easy : idleHandles_) curl_easy_cleanup(easy);
+            curl_multi_cleanup(multi_);
+        }
+
+        CurlMulti(const CurlMulti&) = delete;
+        CurlMulti& operator=(const CurlMulti&) = delete;
+
+        void submit(std::unique_ptr<AsyncRequest> req) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                pending_.push_back(std::move(req));
+            }
+            curl_multi_wakeup(multi_);
+        }
+
+        void setLimits(int maxConcurrent, int maxHostConnections) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                maxConcurrent_ = std::max(1, maxConcurrent);
+                maxHostConnections_ = maxHostConnections;
+                limitsChanged_ = true;
+            }
+            curl_multi_wakeup(multi_);
+        }
+
+        void cancelAll() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                cancelRequested_ = true;
+            }
+            curl_multi_wakeup(multi_);
+        }
+
+        // Queued + in flight
+        size_t getPendingCount() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return pending_.size() + activeCount_;
+        }
+
+    private:
+        void threadFunc() {
+            curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(maxHostConnections_));
+            std::vector<std::unique_ptr<AsyncRequest>> starting;
+            std::vector<std::unique_ptr<AsyncRequest>> cancelled;
+
+            while (true) {
+                bool stop = false;
+                bool cancel = false;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stop = !running_;
+                    cancel = cancelRequested_ || stop;
+                    cancelRequested_ = false;
+                    if (cancel) {
+                        for (auto& req : pending_) cancelled.push_back(std::move(req));
+                        pending_.clear();
+                    }
+                    if (limitsChanged_) {
+                        curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(maxHostConnections_));
+                        limitsChanged_ = false;
+                    }
+                    while (!pending_.empty() && active_.size() + starting.size() < static_cast<size_t>(maxConcurrent_)) {
+                        starting.push_back(std::move(pending_.front()));
+                        pending_.pop_front();
+                    }
+                    activeCount_ = active_.size() + starting.size();
+                }
+
+                if (cancel) {
+                    while (!active_.empty()) {
+                        CURL* easy = active_.begin()->first;
+                        active_.begin()->second->response.error = "Cancelled";
+                        finish(easy, CURLE_ABORTED_BY_CALLBACK);
+                    }
+                    for (auto& req : cancelled) {
+                        req->response.error = "Cancelled";
+                        deliver(*req);
+                    }
+                    cancelled.clear();
+                    if (stop) break;
+                }
+
+                for (auto& req : starting) start(std::move(req));
+                starting.clear();
+
+                int stillRunning = 0;
+                curl_multi_perform(multi_, &stillRunning);
+
+                bool finished = false;
+                int queued = 0;
+                while (CURLMsg* msg = curl_multi_info_read(multi_, &queued)) {
+                    if (msg->msg == CURLMSG_DONE) {
+                        finish(msg->easy_handle, msg->data.result);
+                        finished = true;
+                    }
+                }
+
+                // Freed slots: start queued requests without waiting
+                if (finished) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    activeCount_ = active_.size();
+                    if (!pending_.empty()) continue;
+                }
+
+                curl_multi_poll(multi_, nullptr, 0, 1000, nullptr);
+            }
+        }
+
+        void start(std::unique_ptr<AsyncRequest> req) {
+            CURL* easy = acquireHandle();
+            if (!easy) {
+                req->response.error = "Failed to initialize curl";
+                deliver(*req);
+                return;
+            }
+
+            if (!req->filePath.empty()) {
+                req->file = std::fopen(req->filePath.c_str(), "wb");
+                if (!req->file) {
+                    req->response.error = "Failed to open file: " + req->filePath;
+                    releaseHandle(easy);
+                    deliver(*req);
+                    return;
+                }
+            }
+
+            curl_easy_setopt(easy, CURLOPT_URL, req->url.c_str());
+            curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, writeBody);
+            curl_easy_setopt(easy, CURLOPT_WRITEDATA, req.get());
+            curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+            curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+            curl_easy_setopt(easy, CURLOPT_CONNECTTIMEOUT, 5L);
+            if (req->timeout > 0) {
+                curl_easy_setopt(easy, CURLOPT_TIMEOUT, req->timeout);
+            } else {
+                // No total limit (large downloads), but give up on a stalled transfer
+                curl_easy_setopt(easy, CURLOPT_LOW_SPEED_LIMIT, 1L);
+                curl_easy_setopt(easy, CURLOPT_LOW_SPEED_TIME, 30L);
+            }
+            req->headerList = setupRequest(easy, req->method, req->body, req->contentType, req->headers);
+
+            curl_multi_add_handle(multi_, easy);
+            active_[easy] = std::move(req);
+        }
+
+        void finish(CURL* easy, CURLcode result) {
+            auto it = active_.find(easy);
+            if (it == active_.end()) return;
+            std::unique_ptr<AsyncRequest> req = std::move(it->second);
+            active_.erase(it);
+            curl_multi_remove_handle(multi_, easy);
+
+            auto& response = req->response;
+            if (req->file) {
+                std::fclose(req->file);
+                req->file = nullptr;
+            }
+            if (!response.error.empty()) {
+                // Already set (cancelled)
+            } else if (req->aborted) {
+                response.error = "Aborted";
+            } else if (result != CURLE_OK) {
+                response.error = curl_easy_strerror(result);
+            } else {
+                long httpCode = 0;
+                curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &httpCode);
+                response.statusCode = static_cast<int>(httpCode);
+            }
+            // Don't leave partial downloads or error pages behind
+            if (!req->filePath.empty() && !response.ok()) {
+                std::remove(req->filePath.c_str());
+            }
+
+            if (req->headerList) {
+                curl_slist_free_all(req->headerList);
+                req->headerList = nullptr;
+            }
+            releaseHandle(easy);
+            deliver(*req);
+        }
+
+        void deliver(AsyncRequest& req) {
+            if (req.usePromise) {
+                req.promise.set_value(std::move(req.response));
+            } else if (req.onComplete) {
+                completions_.push(std::move(req.onComplete), std::move(req.response));
+            }
+        }
+
+        CURL* acquireHandle() {
+            if (!idleHandles_.empty()) {
+                CURL* easy = idleHandles_.back();
+                idleHandles_.pop_back();
+                return easy;
+            }
+            return curl_easy_init();
+        }
+
+        void releaseHandle(CURL* easy) {
+            curl_easy_reset(easy);
+            if (idleHandles_.size() < static_cast<size_t>(maxConcurrent_)) {
+                idleHandles_.push_back(easy);
+            } else {
+                curl_easy_cleanup(easy);
+            }
+        }
+
+        static size_t writeBody(char* ptr, size_t size, size_t nmemb, void* userp) {
+            auto* req = static_cast<AsyncRequest*>(userp);
+            size_t totalSize = size * nmemb;
+            if (req->file) {
+                return std::fwrite(ptr, 1, totalSize, req->file);
+            }
+            if (req->onChunk) {
+                if (!req->onChunk(ptr, totalSize)) {
+                    req->aborted = true;
+                    return 0;
+                }
+                return totalSize;
+            }
+            req->response.body.append(ptr, totalSize);
+            return totalSize;
+        }
+
+        CURLM* multi_ = nullptr;
+        std::thread thread_;
+        CompletionQueue& completions_;
+
+        // Shared with network thread (guarded by mutex_)
+        mutable std::mutex mutex_;
+        std::deque<std::unique_ptr<AsyncRequest>> pending_;
+        size_t activeCount_ = 0;
+        int maxConcurrent_;
+        int maxHostConnections_;
+        bool running_ = false;
+        bool cancelRequested_ = false;
+        bool limitsChanged_ = false;
+
+        // Network thread only
+        std::unordered_map<CURL*, std::unique_ptr<AsyncRequest>> active_;
+        std::vector<CURL*> idleHandles_;
+    };
+
+#endif // TCX_HTTP_CURL
 } // namespace detail
 
 // HTTP client
@@ -79,7 +476,16 @@ public:
         detail::ensureCurlInit();
     }
 
-    ~HttpClient() = default;
+    ~HttpClient() {
+#ifdef TCX_HTTP_CURL
+        multi_.reset();
+        if (syncHandle_) curl_easy_cleanup(syncHandle_);
+#endif
+    }
+
+    // Non-copyable (owns curl handles)
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
 
     // Set base URL (e.g. "https://server:8080")
     void setBaseUrl(const std::string& url) { baseUrl_ = url; }
@@ -125,7 +531,7 @@ public:
 
     // POST request with JSON body
     HttpResponse post(const std::string& path, const nlohmann::json& data) {
-        return request("POST", path, data.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace));
+        return request("POST", path, toJsonBody(data));
     }
 
     // POST request with raw body
@@ -142,14 +548,150 @@ public:
     // Upload file via multipart POST
     HttpResponse uploadFile(const std::string& path, const std::string& filePath);
 
+    // --- Async (non-blocking) ---
+    // Requests run on a background thread. Connections are kept alive and
+    // reused between requests. Callback versions call back on the main
+    // thread (before update()); future versions can be waited on anywhere.
+    // Create the client on the main thread: that is where callbacks are
+    // hooked into the frame loop.
+
+    std::future<HttpResponse> getAsync(const std::string& path) {
+        return submitFuture(makeRequest("GET", path, ""));
+    }
+    void getAsync(const std::string& path, HttpCallback callback) {
+        submitCallback(makeRequest("GET", path, ""), std::move(callback));
+    }
+
+    std::future<HttpResponse> postAsync(const std::string& path, const nlohmann::json& data) {
+        return submitFuture(makeRequest("POST", path, toJsonBody(data)));
+    }
+    void postAsync(const std::string& path, const nlohmann::json& data, HttpCallback callback) {
+        submitCallback(makeRequest("POST", path, toJsonBody(data)), std::move(callback));
+    }
+
+    std::future<HttpResponse> postRawAsync(const std::string& path, const std::string& body,
+                                           const std::string& contentType = "application/octet-stream") {
+        return submitFuture(makeRequest("POST", path, body, contentType));
+    }
+    void postRawAsync(const std::string& path, const std::string& body,
+                      const std::string& contentType, HttpCallback callback) {
+        submitCallback(makeRequest("POST", path, body, contentType), std::move(callback));
+    }
+
+    std::future<HttpResponse> delAsync(const std::string& path) {
+        return submitFuture(makeRequest("DELETE", path, ""));
+    }
+    void delAsync(const std::string& path, HttpCallback callback) {
+        submitCallback(makeRequest("DELETE", path, ""), std::move(callback));
+    }
+
+    // Stream response body to a file (response.body stays empty).
+    // The file is removed if the request fails
+    std::future<HttpResponse> downloadAsync(const std::string& path, const std::string& filePath) {
+        return submitFuture(makeDownload(path, filePath));
+    }
+    void downloadAsync(const std::string& path, const std::string& filePath, HttpCallback callback) {
+        submitCallback(makeDownload(path, filePath), std::move(callback));
+    }
+
+    // Hand response body over in chunks as it arrives.
+    // onChunk is called on the network thread (return false to abort);
+    // onComplete on the main thread
+    void streamAsync(const std::string& path, HttpChunkCallback onChunk, HttpCallback onComplete) {
+        auto req = makeRequest("GET", path, "");
+        req->timeout = 0;
+        req->onChunk = std::move(onChunk);
+        submitCallback(std::move(req), std::move(onComplete));
+    }
+
+    // Max async requests in flight; the rest wait in a queue (default: 8)
+    void setMaxConcurrentRequests(int count) {
+        maxConcurrent_ = count;
+        updateLimits();
+    }
+
+    // Max connections to one host (default: 4, 0 = unlimited)
+    void setMaxConnectionsPerHost(int count) {
+        maxHostConnections_ = count;
+        updateLimits();
+    }
+
+    // Async requests queued or in flight
+    size_t getPendingRequestCount() const;
+
+    // Cancel all async requests (they complete with error "Cancelled")
+    void cancelAll();
+
 private:
     std::string baseUrl_;
     std::vector<std::pair<std::string, std::string>> headers_;
 
+    int maxConcurrent_ = 8;
+    int maxHostConnections_ = 4;
+
+    // Callback delivery (listener registered here, on the creating thread)
+    detail::CompletionQueue completions_;
+
+#ifdef TCX_HTTP_CURL
+    // Blocking requests reuse one handle (keeps the connection alive)
+    CURL* syncHandle_ = nullptr;
+    std::mutex syncMutex_;
+
+    // Created on first async request
+    std::unique_ptr<detail::CurlMulti> multi_;
+#endif
+
     HttpResponse request(const std::string& method, const std::string& path,
                          const std::string& body,
                          const std::string& contentType = "application/json");
 
+    static std::string toJsonBody(const nlohmann::json& data) {
+        return data.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+    }
+
+    std::vector<std::string> headerLines() const {
+        std::vector<std::string> lines;
+        lines.reserve(headers_.size());
+        for (const auto& h : headers_) {
+            lines.push_back(h.first + ": " + h.second);
+        }
+        return lines;
+    }
+
+    std::unique_ptr<detail::AsyncRequest> makeRequest(const std::string& method, const std::string& path,
+                                                      const std::string& body,
+                                                      const std::string& contentType = "application/json") const {
+        auto req = std::make_unique<detail::AsyncRequest>();
+        req->method = method;
+        req->url = baseUrl_ + path;
+        req->body = body;
+        req->contentType = contentType;
+        req->headers = headerLines();
+        return req;
+    }
+
+    std::unique_ptr<detail::AsyncRequest> makeDownload(const std::string& path, const std::string& filePath) const {
+        auto req = makeRequest("GET", path, "");
+        req->timeout = 0;
+        req->filePath = filePath;
+        return req;
+    }
+
+    std::future<HttpResponse> submitFuture(std::unique_ptr<detail::AsyncRequest> req) {
+        req->usePromise = true;
+        auto future = req->promise.get_future();
+        submitAsync(std::move(req));
+        return future;
+    }
+
+    void submitCallback(std::unique_ptr<detail::AsyncRequest> req, HttpCallback callback) {
+        req->onComplete = std::move(callback);
+        submitAsync(std::move(req));
+    }
+
+    void submitAsync(std::unique_ptr<detail::AsyncRequest> req);
+    void updateLimits();
+
 #ifdef TCX_HTTP_CURL
     // libcurl write callback
     static size_t writeCallback(void* contents, size_t size, size_t nmemb, void* userp) {
@@ -158,6 +700,15 @@ private:
         response->append(static_cast<char*>(contents), totalSize);
         return totalSize;
     }
+
+    CURL* acquireSyncHandle() {
+        if (syncHandle_) {
+            curl_easy_reset(syncHandle_);
+        } else {
+            syncHandle_ = curl_easy_init();
+        }
+        return syncHandle_;
+    }
 #endif
 };
 
@@ -172,7 +723,8 @@ inline HttpResponse HttpClient::request(const std::string& method, const std::st
     HttpResponse response;
     std::string url = baseUrl_ + path;
 
-    CURL* curl = curl_easy_init();
+    std::lock_guard<std::mutex> lock(syncMutex_);
+    CURL* curl = acquireSyncHandle();
     if (!curl) {
         response.error = "Failed to initialize curl";
         return response;
@@ -185,30 +737,7 @@ inline HttpResponse HttpClient::request(const std::string& method, const std::st
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
     curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 5L);
 
-    // Set method
-    if (method == "POST") {
-        curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    } else if (method == "DELETE") {
-        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
-    } else if (method == "PUT") {
-        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
-    }
-
-    // Build headers
-    struct curl_slist* headers = nullptr;
-    for (const auto& h : headers_) {
-        std::string line = h.first + ": " + h.second;
-        headers = curl_slist_append(headers, line.c_str());
-    }
-    if (!body.empty()) {
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, body.size());
-        std::string ct = "Content-Type: " + contentType;
-        headers = curl_slist_append(headers, ct.c_str());
-    }
-    if (headers) {
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    }
+    struct curl_slist* headers = detail::setupRequest(curl, method, body, contentType, headerLines());
 
     CURLcode res = curl_easy_perform(curl);
 
@@ -222,7 +751,6 @@ inline HttpResponse HttpClient::request(const std::string& method, const std::st
     }
 
     if (headers) curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
     return response;
 }
 
@@ -230,7 +758,8 @@ inline HttpResponse HttpClient::uploadFile(const std::string& path, const std::s
     HttpResponse response;
     std::string url = baseUrl_ + path;
 
-    CURL* curl = curl_easy_init();
+    std::lock_guard<std::mutex> lock(syncMutex_);
+    CURL* curl = acquireSyncHandle();
     if (!curl) {
         response.error = "Failed to initialize curl";
         return response;
@@ -244,8 +773,7 @@ inline HttpResponse HttpClient::uploadFile(const std::string& path, const std::s
 
     // Custom headers
     struct curl_slist* headers = nullptr;
-    for (const auto& h : headers_) {
-        std::string line = h.first + ": " + h.second;
+    for (const auto& line : headerLines()) {
         headers = curl_slist_append(headers, line.c_str());
     }
     if (headers) {
@@ -273,10 +801,28 @@ inline HttpResponse HttpClient::uploadFile(const std::string& path, const std::s
 
     if (headers) curl_slist_free_all(headers);
     curl_mime_free(mime);
-    curl_easy_cleanup(curl);
     return response;
 }
 
+inline void HttpClient::submitAsync(std::unique_ptr<detail::AsyncRequest> req) {
+    if (!multi_) {
+        multi_ = std::make_unique<detail::CurlMulti>(maxConcurrent_, maxHostConnections_, completions_);
+    }
+    multi_->submit(std::move(req));
+}
+
+inline void HttpClient::updateLimits() {
+    if (multi_) multi_->setLimits(maxConcurrent_, maxHostConnections_);
+}
+
+inline size_t HttpClient::getPendingRequestCount() const {
+    return multi_ ? multi_->getPendingCount() : 0;
+}
+
+inline void HttpClient::cancelAll() {
+    if (multi_) multi_->cancelAll();
+}
+
 #elif defined(TCX_HTTP_EMSCRIPTEN)
 
 // TODO: Emscripten Fetch API implementation
@@ -293,6 +839,21 @@ inline HttpResponse HttpClient::uploadFile(const std::string& path, const std::s
     return response;
 }
 
+inline void HttpClient::submitAsync(std::unique_ptr<detail::AsyncRequest> req) {
+    req->response.error = "Emscripten HTTP not yet implemented";
+    if (req->usePromise) {
+        req->promise.set_value(std::move(req->response));
+    } else if (req->onComplete) {
+        req->onComplete(req->response);
+    }
+}
+
+inline void HttpClient::updateLimits() {}
+
+inline size_t HttpClient::getPendingRequestCount() const { return 0; }
+
+inline void HttpClient::cancelAll() {}
+
 #endif
 
 } // namespace tcx
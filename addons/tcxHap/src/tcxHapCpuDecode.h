@@ -0,0 +1,261 @@
+#pragma once
+
+// =============================================================================
+// tcxHapCpuDecode - BC/DXT frame to RGBA8 on the CPU
+// =============================================================================
+// Used by HapPlayer::getPixels() (export, computer vision).
+// The frame is split into bands of block rows that run on the shared
+// HapWorkerPool (the calling thread takes bands too).
+//   BC1 / BC3: palette kernels that write whole 16-byte pixel rows
+//   HAP Q:     YCoCg -> RGB fused into the BC3 kernel while the block is in
+//              cache; the chroma terms are computed once per palette entry
+//              in 16.16 fixed point, so pixels only add and clamp
+//   BC7 / BC4: bcdec
+// Partial blocks at the right / bottom edge go through a temporary block.
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <array>
+#include <algorithm>
+#include "tcxHapDecoder.h"
+#include "impl/bcdec.h"
+
+namespace tcx::hap {
+
+namespace cpu_decode {
+
+using BlockFunction = void (*)(const uint8_t* block, uint8_t* dst, int pitch);
+
+inline uint32_t load32(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+inline uint64_t load48(const uint8_t* p) {
+    return uint64_t(load32(p)) | (uint64_t(p[4]) << 32) | (uint64_t(p[5]) << 40);
+}
+
+// --- Palettes (same rounding as bcdec) ---
+
+// 0xAABBGGRR
+inline void colorPalette(const uint8_t* block, bool opaqueOnly, uint32_t pal[4]) {
+    uint32_t c0 = block[0] | (block[1] << 8);
+    uint32_t c1 = block[2] | (block[3] << 8);
+    uint32_t r0 = (c0 >> 11) & 0x1F, g0 = (c0 >> 5) & 0x3F, b0 = c0 & 0x1F;
+    uint32_t r1 = (c1 >> 11) & 0x1F, g1 = (c1 >> 5) & 0x3F, b1 = c1 & 0x1F;
+
+    auto pack = [](uint32_t r, uint32_t g, uint32_t b) {
+        return 0xFF000000u | (b << 16) | (g << 8) | r;
+    };
+    pal[0] = pack((r0 * 527 + 23) >> 6, (g0 * 259 + 33) >> 6, (b0 * 527 + 23) >> 6);
+    pal[1] = pack((r1 * 527 + 23) >> 6, (g1 * 259 + 33) >> 6, (b1 * 527 + 23) >> 6);
+
+    if (c0 > c1 || opaqueOnly) {
+        pal[2] = pack(((2 * r0 + r1) * 351 + 61) >> 7,
+                      ((2 * g0 + g1) * 2763 + 1039) >> 11,
+                      ((2 * b0 + b1) * 351 + 61) >> 7);
+        pal[3] = pack(((r0 + 2 * r1) * 351 + 61) >> 7,
+                      ((g0 + 2 * g1) * 2763 + 1039) >> 11,
+                      ((b0 + 2 * b1) * 351 + 61) >> 7);
+    } else {
+        // BC1A: 1/2 blend + transparent black
+        pal[2] = pack(((r0 + r1) * 1053 + 125) >> 8,
+                      ((g0 + g1) * 4145 + 1019) >> 11,
+                      ((b0 + b1) * 1053 + 125) >> 8);
+        pal[3] = 0;
+    }
+}
+
+inline void alphaPalette(const uint8_t* block, uint32_t a[8]) {
+    uint32_t a0 = block[0], a1 = block[1];
+    a[0] = a0;
+    a[1] = a1;
+    if (a0 > a1) {
+        for (uint32_t i = 1; i < 7; i++) a[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+    } else {
+        for (uint32_t i = 1; i < 5; i++) a[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+        a[6] = 0;
+        a[7] = 255;
+    }
+}
+
+// --- Block kernels ---
+
+inline void decodeBc1(const uint8_t* block, uint8_t* dst, int pitch) {
+    uint32_t pal[4];
+    colorPalette(block, false, pal);
+    uint32_t bits = load32(block + 4);
+    for (int y = 0; y < 4; y++, bits >>= 8) {
+        uint32_t row[4] = {pal[bits & 3], pal[(bits >> 2) & 3],
+                           pal[(bits >> 4) & 3], pal[(bits >> 6) & 3]};
+        std::memcpy(dst + y * pitch, row, sizeof(row));
+    }
+}
+
+inline void decodeBc3(const uint8_t* block, uint8_t* dst, int pitch) {
+    uint32_t alpha[8];
+    alphaPalette(block, alpha);
+    for (auto& a : alpha) a <<= 24;
+    uint64_t aBits = load48(block + 2);
+
+    uint32_t pal[4];
+    colorPalette(block + 8, true, pal);
+    for (auto& c : pal) c &= 0x00FFFFFF;
+    uint32_t bits = load32(block + 12);
+
+    for (int y = 0; y < 4; y++, bits >>= 8, aBits >>= 12) {
+        uint32_t a = static_cast<uint32_t>(aBits);
+        uint32_t row[4] = {pal[bits & 3] | alpha[a & 7],
+                           pal[(bits >> 2) & 3] | alpha[(a >> 3) & 7],
+                           pal[(bits >> 4) & 3] | alpha[(a >> 6) & 7],
+                           pal[(bits >> 6) & 3] | alpha[(a >> 9) & 7]};
+        std::memcpy(dst + y * pitch, row, sizeof(row));
+    }
+}
+
+// Scaled YCoCg-DXT5 (R = Co, G = Cg, B = scale, A = Y), must match ycocg.glsl:
+//   s = B / 8 + 1
+//   R = Y + (Co - Cg) / s,  G = Y + (Cg - 127.5) / s,  B = Y - (Co + Cg - 255) / s
+inline void decodeYCoCg(const uint8_t* block, uint8_t* dst, int pitch) {
+    uint32_t alpha[8];
+    alphaPalette(block, alpha);
+    uint64_t aBits = load48(block + 2);
+
+    uint32_t pal[4];
+    colorPalette(block + 8, true, pal);
+    uint32_t bits = load32(block + 12);
+
+    // 65536 / s for every scale byte
+    static const auto invScale = [] {
+        std::array<int32_t, 256> table{};
+        for (int i = 0; i < 256; i++) table[i] = int32_t(std::lround(65536.0 * 8.0 / (i + 8)));
+        return table;
+    }();
+
+    // Chroma terms per palette entry (16.16)
+    int32_t dr[4], dg[4], db[4];
+    for (int i = 0; i < 4; i++) {
+        int32_t co = pal[i] & 0xFF;
+        int32_t cg = (pal[i] >> 8) & 0xFF;
+        int32_t k = invScale[(pal[i] >> 16) & 0xFF];
+        dr[i] = (co - cg) * k;
+        dg[i] = ((2 * cg - 255) * k) >> 1;
+        db[i] = (255 - co - cg) * k;
+    }
+
+    auto pixel = [&](uint32_t c, uint32_t y) {
+        constexpr int32_t kMax = 255 << 16;
+        int32_t luma = int32_t(alpha[y]) << 16;
+        uint32_t r = uint32_t(std::clamp(luma + dr[c], 0, kMax)) >> 16;
+        uint32_t g = uint32_t(std::clamp(luma + dg[c], 0, kMax)) >> 16;
+        uint32_t b = uint32_t(std::clamp(luma + db[c], 0, kMax)) >> 16;
+        return 0xFF000000u | (b << 16) | (g << 8) | r;
+    };
+
+    for (int y = 0; y < 4; y++, bits >>= 8, aBits >>= 12) {
+        uint32_t a = static_cast<uint32_t>(aBits);
+        uint32_t row[4] = {pixel(bits & 3, a & 7), pixel((bits >> 2) & 3, (a >> 3) & 7),
+                           pixel((bits >> 4) & 3, (a >> 6) & 7), pixel((bits >> 6) & 3, (a >> 9) & 7)};
+        std::memcpy(dst + y * pitch, row, sizeof(row));
+    }
+}
+
+inline void decodeBc7(const uint8_t* block, uint8_t* dst, int pitch) {
+    bcdec_bc7(block, dst, pitch);
+}
+
+// Single channel -> gray RGBA
+inline void decodeBc4(const uint8_t* block, uint8_t* dst, int pitch) {
+    uint8_t gray[16];
+    bcdec_bc4(block, gray, 4);
+    for (int y = 0; y < 4; y++) {
+        uint32_t row[4];
+        for (int x = 0; x < 4; x++) {
+            uint32_t v = gray[y * 4 + x];
+            row[x] = 0xFF000000u | (v << 16) | (v << 8) | v;
+        }
+        std::memcpy(dst + y * pitch, row, sizeof(row));
+    }
+}
+
+// --- Bands ---
+
+struct Frame {
+    BlockFunction decode;
+    const uint8_t* src;
+    uint8_t* dst;
+    int width;
+    int height;
+    int pitch;
+    int blocksX;
+    int blocksY;
+    int blockBytes;
+    int bandRows;   // Block rows per band
+};
+
+inline void decodeBand(void* p, unsigned int index) {
+    const Frame& f = *static_cast<const Frame*>(p);
+    int byBegin = static_cast<int>(index) * f.bandRows;
+    int byEnd = std::min(f.blocksY, byBegin + f.bandRows);
+
+    for (int by = byBegin; by < byEnd; by++) {
+        const uint8_t* block = f.src + static_cast<size_t>(by) * f.blocksX * f.blockBytes;
+        uint8_t* row = f.dst + static_cast<size_t>(by) * 4 * f.pitch;
+        int rows = std::min(4, f.height - by * 4);
+
+        for (int bx = 0; bx < f.blocksX; bx++, block += f.blockBytes) {
+            int cols = std::min(4, f.width - bx * 4);
+            uint8_t* out = row + bx * 16;
+            if (rows == 4 && cols == 4) {
+                f.decode(block, out, f.pitch);
+            } else {
+                uint8_t tmp[64];
+                f.decode(block, tmp, 16);
+                for (int y = 0; y < rows; y++) {
+                    std::memcpy(out + y * f.pitch, tmp + y * 16, cols * 4);
+                }
+            }
+        }
+    }
+}
+
+} // namespace cpu_decode
+
+// Decode a whole BC/DXT frame to RGBA8 (dst: width * height * 4 bytes).
+// False for unknown formats or a short source buffer.
+inline bool decodeToRgba(HapFormat format, const uint8_t* src, size_t srcSize,
+                         int width, int height, uint8_t* dst, bool parallel = true) {
+    using namespace cpu_decode;
+    if (!src || !dst || width <= 0 || height <= 0) return false;
+
+    Frame f{};
+    switch (format) {
+        case HapFormat::DXT1:      f.decode = decodeBc1;   f.blockBytes = 8;  break;
+        case HapFormat::DXT5:      f.decode = decodeBc3;   f.blockBytes = 16; break;
+        case HapFormat::YCoCgDXT5: f.decode = decodeYCoCg; f.blockBytes = 16; break;
+        case HapFormat::BC7:       f.decode = decodeBc7;   f.blockBytes = 16; break;
+        case HapFormat::RGTC1:     f.decode = decodeBc4;   f.blockBytes = 8;  break;
+        default: return false;
+    }
+    f.src = src;
+    f.dst = dst;
+    f.width = width;
+    f.height = height;
+    f.pitch = width * 4;
+    f.blocksX = (width + 3) / 4;
+    f.blocksY = (height + 3) / 4;
+    if (srcSize < static_cast<size_t>(f.blocksX) * f.blocksY * f.blockBytes) return false;
+
+    // ~8K blocks per band: enough bands to balance, none too small (4K: 68 bands)
+    f.bandRows = std::clamp(8192 / f.blocksX, 1, 64);
+    unsigned int bands = static_cast<unsigned int>((f.blocksY + f.bandRows - 1) / f.bandRows);
+
+    if (parallel) {
+        hapWorkerPool().run(decodeBand, &f, bands);
+    } else {
+        for (unsigned int i = 0; i < bands; i++) decodeBand(&f, i);
+    }
+    return true;
+}
+
+} // namespace tcx::hap
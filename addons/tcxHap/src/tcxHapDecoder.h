@@ -5,11 +5,18 @@
 // =============================================================================
 // Wraps the Vidvox HAP reference decoder for easy use in TrussC.
 // Decodes HAP frames to DXT/BC compressed texture data.
+// Multi-chunk frames are decoded on a persistent worker pool shared by all
+// decoders (no threads are created per frame).
 
 #include <vector>
+#include <deque>
 #include <cstdint>
 #include <functional>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
 
 // HAP reference decoder (BSD-2-Clause)
 extern "C" {
@@ -85,6 +92,119 @@ struct HapDecodedFrame {
     }
 };
 
+// -----------------------------------------------------------------------------
+// Chunk worker pool
+// -----------------------------------------------------------------------------
+// run() spreads work(p, 0..count-1) over the workers and the calling thread
+// and returns when every index is done. Several threads may call run() at
+// once (one decode thread per player); their jobs share the workers.
+class HapWorkerPool {
+public:
+    explicit HapWorkerPool(unsigned threads = 0) {
+        if (threads == 0) {
+            threads = std::clamp(std::thread::hardware_concurrency(), 2u, 17u) - 1;
+        }
+        for (unsigned i = 0; i < threads; i++) {
+            workers_.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~HapWorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+
+    HapWorkerPool(const HapWorkerPool&) = delete;
+    HapWorkerPool& operator=(const HapWorkerPool&) = delete;
+
+    size_t getThreadCount() const { return workers_.size(); }
+
+    void run(HapDecodeWorkFunction work, void* p, unsigned int count) {
+        if (count <= 1 || workers_.empty()) {
+            for (unsigned int i = 0; i < count; i++) work(p, i);
+            return;
+        }
+
+        Job job{work, p, count};
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.push_back(&job);
+        }
+        cv_.notify_all();
+
+        // Help out instead of idling
+        while (runOne(job)) {}
+
+        // Wait for chunks still running on workers; no worker may touch the
+        // job once we return
+        std::unique_lock<std::mutex> lock(mutex_);
+        removeJob(&job);
+        doneCv_.wait(lock, [&job] { return job.done == job.count && job.users == 0; });
+    }
+
+private:
+    struct Job {
+        HapDecodeWorkFunction work;
+        void* p;
+        unsigned int count;
+        std::atomic<unsigned int> next{0};  // Next index to claim
+        unsigned int done = 0;              // Guarded by mutex_
+        unsigned int users = 0;             // Workers holding the job (mutex_)
+    };
+
+    bool runOne(Job& job) {
+        unsigned int i = job.next.fetch_add(1);
+        if (i >= job.count) return false;
+        job.work(job.p, i);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (++job.done == job.count) doneCv_.notify_all();
+        return true;
+    }
+
+    void removeJob(Job* job) {
+        auto it = std::find(jobs_.begin(), jobs_.end(), job);
+        if (it != jobs_.end()) jobs_.erase(it);
+    }
+
+    void workerLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+            if (stop_) return;
+
+            Job* job = jobs_.front();
+            if (job->next >= job->count) {
+                // Fully claimed; its owner waits for the running chunks
+                jobs_.pop_front();
+                continue;
+            }
+            job->users++;
+            lock.unlock();
+            while (runOne(*job)) {}
+            lock.lock();
+            removeJob(job);
+            if (--job->users == 0 && job->done == job->count) doneCv_.notify_all();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::deque<Job*> jobs_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable doneCv_;
+    bool stop_ = false;
+};
+
+// Process-wide pool (several players share the same workers)
+inline HapWorkerPool& hapWorkerPool() {
+    static HapWorkerPool pool;
+    return pool;
+}
+
 // -----------------------------------------------------------------------------
 // HAP Decoder
 // -----------------------------------------------------------------------------
@@ -196,7 +316,7 @@ public:
     }
 
 private:
-    mutable int lastChunkCount_ = -1;  // -1 = callback never called
+    std::atomic<int> lastChunkCount_{-1};  // -1 = callback never called
 
     // HAP decode callback for parallel decoding
     static void hapDecodeCallback(HapDecodeWorkFunction work, void* p, unsigned int count, void* info) {
@@ -206,27 +326,7 @@ private:
             decoder->lastChunkCount_ = static_cast<int>(count);
         }
 
-        if (count <= 1) {
-            // Single-threaded
-            for (unsigned int i = 0; i < count; i++) {
-                work(p, i);
-            }
-            return;
-        }
-
-        // Parallel decode using threads
-        std::vector<std::thread> threads;
-        threads.reserve(count);
-
-        for (unsigned int i = 0; i < count; i++) {
-            threads.emplace_back([work, p, i]() {
-                work(p, i);
-            });
-        }
-
-        for (auto& t : threads) {
-            t.join();
-        }
+        hapWorkerPool().run(work, p, count);
     }
 };
 
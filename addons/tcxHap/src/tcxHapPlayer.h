@@ -5,6 +5,8 @@
 // =============================================================================
 // VideoPlayerBase implementation for HAP/HAPQ codec playback.
 // Uses GPU-friendly DXT/BC compressed textures for efficient playback.
+// Upcoming frames are read and decoded ahead on background threads, so
+// update() normally just swaps in a finished frame (see setReadAhead()).
 //
 // Usage:
 //   tcx::hap::HapPlayer player;
@@ -18,8 +20,9 @@
 #include <TrussC.h>
 #include "tcxMovParser.h"
 #include "tcxHapDecoder.h"
+#include "tcxHapReadAhead.h"
+#include "tcxHapCpuDecode.h"
 #include "ycocg.glsl.h"
-#include "impl/bcdec.h"
 
 namespace tcx::hap {
 
@@ -58,18 +61,44 @@ public:
     // Performance stats
     // =========================================================================
 
+    // Average decode time per frame (background or on update())
     double getDecodeTimeMs() const {
         return decodeTimeMs_;
     }
 
     int getChunkCount() const {
-        return hapDecoder_.getLastChunkCount();
+        int count = readAhead_.getLastChunkCount();
+        return count >= 0 ? count : hapDecoder_.getLastChunkCount();
+    }
+
+    // Decoded frames waiting in the read-ahead ring
+    int getReadyFrameCount() const {
+        return readAhead_.getReadyCount();
+    }
+
+    // Frames that were not ready in time and were decoded on update()
+    uint64_t getReadAheadMissCount() const {
+        return readAhead_.getMissCount();
     }
 
     void resetStats() {
         decodeTimeMs_ = 0.0;
+        readAhead_.resetStats();
     }
 
+    // =========================================================================
+    // Read-ahead
+    // =========================================================================
+
+    // Frames decoded ahead of playback (0 = decode synchronously in update()).
+    // Each frame costs one DXT buffer (about 4-8 MB for 4K).
+    void setReadAhead(int frames) {
+        readAheadFrames_ = std::max(0, frames);
+        if (initialized_) startReadAhead();
+    }
+
+    int getReadAhead() const { return readAheadFrames_; }
+
     // =========================================================================
     // Load / Close
     // =========================================================================
@@ -147,12 +176,15 @@ public:
 
         initialized_ = true;
         currentFrame_ = 0;
+        startReadAhead();
         return true;
     }
 
     void close() override {
         if (!initialized_) return;
 
+        readAhead_.stop();
+
         // Stop audio
         if (hasAudio_) {
             audioPlayer_.stop();
@@ -188,7 +220,25 @@ public:
     // =========================================================================
 
     void update() override {
-        if (!initialized_) return;
+        // Nothing to show (closed, or a track without frames)
+        if (!initialized_ || duration_ <= 0 || totalFrames_ <= 0) return;
+
+        // Slaved to a MediaClock: show the frame for the clock's time
+        // (frames decode on demand, so seeking and pausing need nothing else)
+        if (clockSlave_) {
+            frameNew_ = false;
+            playbackTime_ = std::clamp(clockTime_, 0.0, (double)duration_);
+            int targetFrame = std::min(static_cast<int>(playbackTime_ / duration_ * totalFrames_),
+                                       totalFrames_ - 1);
+            if (targetFrame != currentFrame_ || !firstFrameReceived_) {
+                if (decodeFrame(targetFrame)) {
+                    currentFrame_ = targetFrame;
+                    updateTexture();
+                    markFrameNew();
+                }
+            }
+            return;
+        }
 
         // Only reset frameNew_ when actively playing
         // (preserve frameNew_ set by setFrame() for encoding workflows)
@@ -260,7 +310,7 @@ public:
     }
 
     void setFrame(int frame) override {
-        if (!initialized_) return;
+        if (!initialized_ || totalFrames_ <= 0) return;
         frame = std::max(0, std::min(frame, totalFrames_ - 1));
         if (decodeFrame(frame)) {
             currentFrame_ = frame;
@@ -284,6 +334,9 @@ public:
 
     HapFormat getHapFormat() const { return hapFormat_; }
 
+    // Random access decode: any frame can follow a MediaClock
+    bool supportsClock() const override { return true; }
+
     // Override setSpeed to allow negative values (reverse playback)
     void setSpeed(float speed) {
         speed_ = speed;  // Allow any value including negative
@@ -467,6 +520,12 @@ private:
     int currentFrame_ = 0;
     double playbackTime_ = 0;
 
+    // Background read / decode
+    HapReadAhead readAhead_;
+    int readAheadFrames_ = 4;
+    int lastDecodedFrame_ = -1;
+    int decodeStride_ = 1;      // Frame step observed during playback
+
     // Audio playback
     tc::Sound audioPlayer_;
     bool hasAudio_ = false;
@@ -486,6 +545,9 @@ private:
     // -------------------------------------------------------------------------
 
     void moveFrom(HapPlayer&& other) {
+        // The read-ahead threads point into other's parser
+        other.readAhead_.stop();
+
         // Move base class state
         width_ = other.width_;
         height_ = other.height_;
@@ -516,6 +578,9 @@ private:
         audioPlayer_ = std::move(other.audioPlayer_);
         hasAudio_ = other.hasAudio_;
         decodeTimeMs_ = other.decodeTimeMs_;
+        readAheadFrames_ = other.readAheadFrames_;
+        other.detachFromClock();
+        if (initialized_) startReadAhead();
 
         // Invalidate source
         other.initialized_ = false;
@@ -695,6 +760,15 @@ private:
         return true;
     }
 
+    void startReadAhead() {
+        readAhead_.stop();
+        if (readAheadFrames_ > 0 && videoTrack_) {
+            readAhead_.start(movParser_, *videoTrack_, width_, height_, frameBuffer_.size(),
+                             readAheadFrames_, readAheadFrames_ * 2);
+        }
+        lastDecodedFrame_ = -1;
+    }
+
     bool decodeFrame(int frameIndex) {
         auto startTime = std::chrono::high_resolution_clock::now();
 
@@ -703,27 +777,43 @@ private:
             return false;
         }
 
-        // Read sample data from MOV
-        if (!movParser_.readSample(*videoTrack_, frameIndex, sampleBuffer_)) {
-            return false;
-        }
+        double ms = 0.0;
+        if (readAhead_.acquire(frameIndex, frameBuffer_, &ms)) {
+            // Decoded in the background; frameBuffer_ was swapped in
+        } else {
+            // Read sample data from MOV
+            if (!movParser_.readSample(*videoTrack_, frameIndex, sampleBuffer_)) {
+                return false;
+            }
 
-        // Decode HAP frame to DXT data
-        HapFormat outFormat;
-        if (!hapDecoder_.decodeToBuffer(
-                sampleBuffer_.data(), sampleBuffer_.size(),
-                width_, height_,
-                frameBuffer_.data(), frameBuffer_.size(),
-                outFormat)) {
-            return false;
+            // Decode HAP frame to DXT data
+            HapFormat outFormat;
+            if (!hapDecoder_.decodeToBuffer(
+                    sampleBuffer_.data(), sampleBuffer_.size(),
+                    width_, height_,
+                    frameBuffer_.data(), frameBuffer_.size(),
+                    outFormat)) {
+                return false;
+            }
+
+            auto endTime = std::chrono::high_resolution_clock::now();
+            ms = std::chrono::duration<double, std::milli>(endTime - startTime).count();
         }
 
         // Invalidate RGBA cache - will be decoded on demand
         pixelsValid_ = false;
 
+        // Queue the frames that follow in the playback direction
+        int step = frameIndex - lastDecodedFrame_;
+        if (lastDecodedFrame_ >= 0 && step != 0 && std::abs(step) <= 8) {
+            decodeStride_ = step;
+        } else if ((speed_ < 0) != (decodeStride_ < 0)) {
+            decodeStride_ = speed_ < 0 ? -1 : 1;
+        }
+        lastDecodedFrame_ = frameIndex;
+        readAhead_.request(frameIndex + decodeStride_, decodeStride_, loop_);
+
         // Record decode time (low-pass filter)
-        auto endTime = std::chrono::high_resolution_clock::now();
-        double ms = std::chrono::duration<double, std::milli>(endTime - startTime).count();
         if (decodeTimeMs_ == 0.0) {
             decodeTimeMs_ = ms;  // First measurement after reset
         } else {
@@ -734,7 +824,7 @@ private:
         return true;
     }
 
-    // Decode BC/DXT frameBuffer to RGBA pixels
+    // Decode BC/DXT frameBuffer to RGBA pixels (row bands on the HAP worker pool)
     void decodeFrameToRgba() {
         if (frameBuffer_.empty() || width_ == 0 || height_ == 0) {
             return;
@@ -746,130 +836,16 @@ private:
             pixels_.resize(pixelCount);
         }
 
-        // Decode based on format
-        const uint8_t* src = frameBuffer_.data();
-        uint8_t* dst = pixels_.data();
-
-        // BC textures are 4x4 block compressed
-        int blocksX = (width_ + 3) / 4;
-        int blocksY = (height_ + 3) / 4;
-        int dstPitch = width_ * 4;  // bytes per row in output
-
-        switch (hapFormat_) {
-            case HapFormat::DXT1:
-                // BC1: 8 bytes per block
-                for (int by = 0; by < blocksY; by++) {
-                    for (int bx = 0; bx < blocksX; bx++) {
-                        uint8_t* blockDst = dst + (by * 4 * dstPitch) + (bx * 4 * 4);
-                        bcdec_bc1(src, blockDst, dstPitch);
-                        src += BCDEC_BC1_BLOCK_SIZE;
-                    }
-                }
-                break;
-
-            case HapFormat::DXT5:
-                // BC3: 16 bytes per block
-                for (int by = 0; by < blocksY; by++) {
-                    for (int bx = 0; bx < blocksX; bx++) {
-                        uint8_t* blockDst = dst + (by * 4 * dstPitch) + (bx * 4 * 4);
-                        bcdec_bc3(src, blockDst, dstPitch);
-                        src += BCDEC_BC3_BLOCK_SIZE;
-                    }
-                }
-                break;
-
-            case HapFormat::YCoCgDXT5:
-                // BC3 + YCoCg color transform: 16 bytes per block
-                for (int by = 0; by < blocksY; by++) {
-                    for (int bx = 0; bx < blocksX; bx++) {
-                        uint8_t* blockDst = dst + (by * 4 * dstPitch) + (bx * 4 * 4);
-                        bcdec_bc3(src, blockDst, dstPitch);
-                        src += BCDEC_BC3_BLOCK_SIZE;
-                    }
-                }
-                // Convert YCoCg to RGB
-                convertYCoCgToRgb();
-                break;
-
-            case HapFormat::BC7:
-                // BC7: 16 bytes per block
-                for (int by = 0; by < blocksY; by++) {
-                    for (int bx = 0; bx < blocksX; bx++) {
-                        uint8_t* blockDst = dst + (by * 4 * dstPitch) + (bx * 4 * 4);
-                        bcdec_bc7(src, blockDst, dstPitch);
-                        src += BCDEC_BC7_BLOCK_SIZE;
-                    }
-                }
-                break;
-
-            case HapFormat::RGTC1:
-                // BC4: 8 bytes per block, single channel -> expand to RGBA
-                for (int by = 0; by < blocksY; by++) {
-                    for (int bx = 0; bx < blocksX; bx++) {
-                        // Decode to temporary R buffer
-                        uint8_t rBlock[16];
-                        bcdec_bc4(src, rBlock, 4);
-                        // Expand R to RGBA
-                        for (int py = 0; py < 4; py++) {
-                            for (int px = 0; px < 4; px++) {
-                                int dstX = bx * 4 + px;
-                                int dstY = by * 4 + py;
-                                if (dstX < width_ && dstY < height_) {
-                                    uint8_t* pixel = dst + (dstY * dstPitch) + (dstX * 4);
-                                    uint8_t r = rBlock[py * 4 + px];
-                                    pixel[0] = r;
-                                    pixel[1] = r;
-                                    pixel[2] = r;
-                                    pixel[3] = 255;
-                                }
-                            }
-                        }
-                        src += BCDEC_BC4_BLOCK_SIZE;
-                    }
-                }
-                break;
-
-            default:
-                // Unknown format
-                std::fill(pixels_.begin(), pixels_.end(), 0);
-                break;
+        // HAP Q is converted from YCoCg to RGB on the way (matches ycocg.glsl)
+        if (!decodeToRgba(hapFormat_, frameBuffer_.data(), frameBuffer_.size(),
+                          width_, height_, pixels_.data())) {
+            // Unknown format
+            std::fill(pixels_.begin(), pixels_.end(), 0);
         }
 
         pixelsValid_ = true;
     }
 
-    // Convert YCoCg color space to RGB (for HAP-Q)
-    // Must match the GPU shader in ycocg.glsl
-    void convertYCoCgToRgb() {
-        size_t pixelCount = static_cast<size_t>(width_) * height_;
-        for (size_t i = 0; i < pixelCount; i++) {
-            uint8_t* pixel = pixels_.data() + i * 4;
-            // DXT5 texture channels: R=Co, G=Cg, B=Scale, A=Y
-            // Convert to 0-1 range
-            float coRaw = pixel[0] / 255.0f;
-            float cgRaw = pixel[1] / 255.0f;
-            float scaleRaw = pixel[2] / 255.0f;
-            float y = pixel[3] / 255.0f;
-
-            // Scale factor: (B * 255 / 8) + 1 = (B * 31.875) + 1
-            float scale = (scaleRaw * (255.0f / 8.0f)) + 1.0f;
-
-            // Chrominance values (centered at 0.5, divided by scale)
-            float co = (coRaw - 0.5f) / scale;
-            float cg = (cgRaw - 0.5f) / scale;
-
-            // YCoCg to RGB conversion
-            float r = y + co - cg;
-            float g = y + cg;
-            float b = y - co - cg;
-
-            pixel[0] = static_cast<uint8_t>(std::clamp(r * 255.0f, 0.0f, 255.0f));
-            pixel[1] = static_cast<uint8_t>(std::clamp(g * 255.0f, 0.0f, 255.0f));
-            pixel[2] = static_cast<uint8_t>(std::clamp(b * 255.0f, 0.0f, 255.0f));
-            pixel[3] = 255;
-        }
-    }
-
     bool createCompressedTexture() {
         // Map HAP format to sokol pixel format
         switch (hapFormat_) {
@@ -0,0 +1,309 @@
+#pragma once
+
+// =============================================================================
+// tcxHapReadAhead - Prefetch and decode HAP frames ahead of playback
+// =============================================================================
+// Two background threads feed the player:
+//   I/O thread:    reads the next samples from the MOV file (positional reads)
+//   Decode thread: decodes them into a ring of DXT/BC frames (chunks run on
+//                  the shared HapWorkerPool)
+// The player tells which frames it needs next with request() and takes a
+// finished frame with acquire(), which only swaps buffers.
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include "tcxMovParser.h"
+#include "tcxHapDecoder.h"
+
+namespace tcx::hap {
+
+class HapReadAhead {
+public:
+    HapReadAhead() = default;
+    ~HapReadAhead() { stop(); }
+
+    HapReadAhead(const HapReadAhead&) = delete;
+    HapReadAhead& operator=(const HapReadAhead&) = delete;
+
+    // decodeAhead: decoded frames kept ready, readAhead: samples read ahead
+    void start(MovParser& parser, const MovTrack& track, uint32_t width, uint32_t height,
+               size_t frameBytes, int decodeAhead = 4, int readAhead = 8) {
+        stop();
+        parser_ = &parser;
+        track_ = &track;
+        width_ = width;
+        height_ = height;
+        totalFrames_ = static_cast<int>(track.samples.size());
+        decodeAhead_ = std::max(1, decodeAhead);
+        readAhead_ = std::max(decodeAhead_, readAhead);
+
+        slots_.assign(decodeAhead_, Slot());
+        for (auto& slot : slots_) slot.data.resize(frameBytes);
+        samples_.assign(readAhead_, Sample());
+        window_.clear();
+        requestNext_ = -1;
+        requestStride_ = 0;
+        failedFrame_ = -1;
+        hits_ = 0;
+        misses_ = 0;
+
+        stop_ = false;
+        ioThread_ = std::thread([this]() { ioLoop(); });
+        decodeThread_ = std::thread([this]() { decodeLoop(); });
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        if (ioThread_.joinable()) ioThread_.join();
+        if (decodeThread_.joinable()) decodeThread_.join();
+        slots_.clear();
+        samples_.clear();
+        window_.clear();
+        parser_ = nullptr;
+        track_ = nullptr;
+    }
+
+    bool isRunning() const { return parser_ != nullptr; }
+
+    // Frames needed after the current one: next, next + stride, ...
+    // (negative stride for reverse playback)
+    void request(int next, int stride, bool loop) {
+        if (!isRunning() || totalFrames_ <= 0) return;
+        if (stride == 0) stride = 1;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (next == requestNext_ && stride == requestStride_ && loop == requestLoop_) return;
+            requestNext_ = next;
+            requestStride_ = stride;
+            requestLoop_ = loop;
+            failedFrame_ = -1;
+
+            window_.clear();
+            int frame = next;
+            for (int i = 0; i < readAhead_; i++) {
+                if (frame < 0 || frame >= totalFrames_) {
+                    if (!loop) break;
+                    frame = ((frame % totalFrames_) + totalFrames_) % totalFrames_;
+                }
+                if (std::find(window_.begin(), window_.end(), frame) != window_.end()) break;
+                window_.push_back(frame);
+                frame += stride;
+            }
+        }
+        cv_.notify_all();
+    }
+
+    // Take a decoded frame (swapped into buffer). False if it is not ready;
+    // decodeMs receives the worker's decode time.
+    bool acquire(int frame, std::vector<uint8_t>& buffer, double* decodeMs = nullptr) {
+        if (!isRunning()) return false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Slot* slot = findSlot(frame);
+            if (!slot || slot->state != Slot::Ready || slot->data.size() != buffer.size()) {
+                misses_++;
+                return false;
+            }
+            std::swap(slot->data, buffer);
+            if (decodeMs) *decodeMs = slot->decodeMs;
+            slot->state = Slot::Free;
+            slot->frame = -1;
+            hits_++;
+        }
+        cv_.notify_all();
+        return true;
+    }
+
+    // --- Stats ---
+
+    int getReadyCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        int n = 0;
+        for (auto& slot : slots_) n += slot.state == Slot::Ready;
+        return n;
+    }
+
+    int getLastChunkCount() const { return decoder_.getLastChunkCount(); }
+    uint64_t getHitCount() const { return hits_; }
+    uint64_t getMissCount() const { return misses_; }     // acquire() without a ready frame
+    void resetStats() { hits_ = 0; misses_ = 0; }
+
+private:
+    struct Slot {
+        enum State { Free, Decoding, Ready };
+        State state = Free;
+        int frame = -1;
+        double decodeMs = 0.0;
+        std::vector<uint8_t> data;
+    };
+
+    struct Sample {
+        int frame = -1;
+        bool loading = false;
+        std::vector<uint8_t> data;
+    };
+
+    // --- Helpers (caller holds mutex_) ---
+
+    // Position in the request window, or -1
+    int windowIndex(int frame) const {
+        auto it = std::find(window_.begin(), window_.end(), frame);
+        return it == window_.end() ? -1 : static_cast<int>(it - window_.begin());
+    }
+
+    bool wanted(int frame, int limit) const {
+        int i = windowIndex(frame);
+        return i >= 0 && i < limit;
+    }
+
+    Slot* findSlot(int frame) {
+        for (auto& slot : slots_) {
+            if (slot.state != Slot::Free && slot.frame == frame) return &slot;
+        }
+        return nullptr;
+    }
+
+    Sample* findSample(int frame) {
+        for (auto& sample : samples_) {
+            if (sample.frame == frame) return &sample;
+        }
+        return nullptr;
+    }
+
+    // Next sample to read and the entry to read it into
+    bool pickRead(int& frame, Sample*& entry) {
+        int limit = std::min<int>(readAhead_, static_cast<int>(window_.size()));
+        for (int i = 0; i < limit; i++) {
+            int f = window_[i];
+            if (f == failedFrame_ || findSlot(f) || findSample(f)) continue;
+            for (auto& sample : samples_) {
+                if (!sample.loading && (sample.frame < 0 || !wanted(sample.frame, readAhead_))) {
+                    frame = f;
+                    entry = &sample;
+                    return true;
+                }
+            }
+            return false;
+        }
+        return false;
+    }
+
+    // Next frame to decode (its sample is loaded) and the slot to decode into
+    bool pickDecode(Sample*& input, Slot*& output) {
+        int limit = std::min<int>(decodeAhead_, static_cast<int>(window_.size()));
+        for (int i = 0; i < limit; i++) {
+            int f = window_[i];
+            if (f == failedFrame_ || findSlot(f)) continue;
+            Sample* sample = findSample(f);
+            if (!sample || sample->loading) return false;  // Keep the order
+            for (auto& slot : slots_) {
+                if (slot.state == Slot::Free ||
+                    (slot.state == Slot::Ready && !wanted(slot.frame, decodeAhead_))) {
+                    input = sample;
+                    output = &slot;
+                    return true;
+                }
+            }
+            return false;
+        }
+        return false;
+    }
+
+    // --- Threads ---
+
+    void ioLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            int frame = -1;
+            Sample* entry = nullptr;
+            cv_.wait(lock, [&] { return stop_ || pickRead(frame, entry); });
+            if (stop_) return;
+
+            entry->frame = frame;
+            entry->loading = true;
+            lock.unlock();
+            bool ok = parser_->readSample(*track_, frame, entry->data);
+            lock.lock();
+            entry->loading = false;
+            if (!ok) {
+                // Skipped until the next request (the player decodes it itself)
+                entry->frame = -1;
+                failedFrame_ = frame;
+            }
+            cv_.notify_all();
+        }
+    }
+
+    void decodeLoop() {
+        std::vector<uint8_t> input;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            Sample* sample = nullptr;
+            Slot* slot = nullptr;
+            cv_.wait(lock, [&] { return stop_ || pickDecode(sample, slot); });
+            if (stop_) return;
+
+            // Take the sample; its entry can be reused right away
+            int frame = sample->frame;
+            std::swap(input, sample->data);
+            sample->frame = -1;
+            slot->frame = frame;
+            slot->state = Slot::Decoding;
+            cv_.notify_all();
+            lock.unlock();
+
+            auto start = std::chrono::steady_clock::now();
+            HapFormat format;
+            bool ok = decoder_.decodeToBuffer(input.data(), input.size(), width_, height_,
+                                              slot->data.data(), slot->data.size(), format);
+            double ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+
+            lock.lock();
+            slot->decodeMs = ms;
+            slot->state = ok ? Slot::Ready : Slot::Free;
+            if (!ok) {
+                slot->frame = -1;
+                failedFrame_ = frame;
+            }
+            cv_.notify_all();
+        }
+    }
+
+    MovParser* parser_ = nullptr;
+    const MovTrack* track_ = nullptr;
+    HapDecoder decoder_;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    int totalFrames_ = 0;
+    int decodeAhead_ = 4;
+    int readAhead_ = 8;
+
+    std::vector<Slot> slots_;
+    std::vector<Sample> samples_;
+    std::vector<int> window_;       // Frames needed next, in order
+    int requestNext_ = -1;
+    int requestStride_ = 0;
+    bool requestLoop_ = false;
+    int failedFrame_ = -1;          // Unreadable / undecodable, skipped
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+
+    std::thread ioThread_;
+    std::thread decodeThread_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+};
+
+} // namespace tcx::hap
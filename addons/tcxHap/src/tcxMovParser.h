@@ -5,6 +5,8 @@
 // =============================================================================
 // Parses MOV container to extract video/audio track information and frame data.
 // Designed for HAP codec support but works with any MOV file.
+// readSample() is thread-safe (positional reads), so samples can be
+// prefetched from another thread.
 
 #include <string>
 #include <vector>
@@ -12,6 +14,12 @@
 #include <cstdint>
 #include <memory>
 #include <cstring>
+#include <mutex>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace tcx::hap {
 
@@ -170,8 +178,10 @@ public:
     MovParser(MovParser&& other) noexcept
         : file_(std::move(other.file_))
         , fileSize_(other.fileSize_)
-        , info_(std::move(other.info_)) {
+        , info_(std::move(other.info_))
+        , fd_(other.fd_) {
         other.fileSize_ = 0;
+        other.fd_ = -1;
     }
 
     MovParser& operator=(MovParser&& other) noexcept {
@@ -180,7 +190,9 @@ public:
             file_ = std::move(other.file_);
             fileSize_ = other.fileSize_;
             info_ = std::move(other.info_);
+            fd_ = other.fd_;
             other.fileSize_ = 0;
+            other.fd_ = -1;
         }
         return *this;
     }
@@ -197,6 +209,11 @@ public:
         fileSize_ = file_.tellg();
         file_.seekg(0, std::ios::beg);
 
+#ifndef _WIN32
+        // Descriptor for positional sample reads (falls back to file_)
+        fd_ = ::open(path.c_str(), O_RDONLY);
+#endif
+
         return parse();
     }
 
@@ -204,6 +221,12 @@ public:
         if (file_.is_open()) {
             file_.close();
         }
+#ifndef _WIN32
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+#endif
         // Reset to fresh state by assigning default-constructed object
         file_ = std::ifstream();
         info_ = MovInfo();
@@ -212,13 +235,29 @@ public:
     bool isOpen() const { return file_.is_open(); }
     const MovInfo& getInfo() const { return info_; }
 
-    // Read sample data from file
+    // Read sample data from file (thread-safe)
     bool readSample(const MovTrack& track, size_t sampleIndex, std::vector<uint8_t>& data) {
         if (sampleIndex >= track.samples.size()) return false;
 
         const auto& sample = track.samples[sampleIndex];
         data.resize(sample.size);
 
+#ifndef _WIN32
+        if (fd_ >= 0) {
+            // pread: no shared file position, no lock
+            size_t done = 0;
+            while (done < sample.size) {
+                ssize_t n = ::pread(fd_, data.data() + done, sample.size - done,
+                                    static_cast<off_t>(sample.offset + done));
+                if (n <= 0) return false;
+                done += static_cast<size_t>(n);
+            }
+            return true;
+        }
+#endif
+
+        std::lock_guard<std::mutex> lock(readMutex_);
+        file_.clear();
         file_.seekg(sample.offset);
         file_.read(reinterpret_cast<char*>(data.data()), sample.size);
 
@@ -246,6 +285,8 @@ private:
     std::ifstream file_;
     uint64_t fileSize_ = 0;
     MovInfo info_;
+    int fd_ = -1;               // POSIX descriptor for pread (-1 = use file_)
+    std::mutex readMutex_;      // Guards file_ reads without pread
 
     // Read big-endian integers
     uint16_t readU16() {
@@ -7,27 +7,34 @@
 // Addon for TrussC. Add "tcxLut" to addons.make to use.
 //
 // Supports .cube file format (industry standard for color LUTs)
-// Uses 3D texture for GPU-accelerated color transformation
+// Uses 3D texture for GPU-accelerated color transformation; apply() grades
+// Pixels on the CPU (also in headless mode, where no texture is created)
 //
 // Usage example:
 //   tcx::lut::Lut3D lut;
-//   lut.load("data/luts/cinematic.cube");
+//   lut.load("data/luts/cinematic.cube", true);  // true: binary cache sidecar
 //
 //   // In shader, sample using: texture(lut3D, color.rgb)
+//   // Or on the CPU:
+//   lut.apply(pixels);
 //
 // =============================================================================
 
 #include <TrussC.h>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <fstream>
-#include <sstream>
 #include <filesystem>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
 #include <cmath>
 #include <algorithm>
 #include <iomanip>
 
 #include "shaders/lut.glsl.h"
+#include "tcLutCpu.h"
 
 namespace tcx {
 namespace lut {
@@ -36,6 +43,195 @@ using namespace tc;
 
 namespace fs = std::filesystem;
 
+// ---------------------------------------------------------------------------
+// .cube parsing and binary cache
+// ---------------------------------------------------------------------------
+// The file is read in one go and scanned in place (no per-line streams).
+// The cache sidecar ("<file>.cube.tclut") holds the parsed floats and is
+// only used while the source file's size and modification time match.
+namespace cube_detail {
+
+struct CubeData {
+    int size = 0;
+    std::string title;
+    std::vector<float> rgb;     // size^3 * 3, R fastest
+};
+
+inline bool readFile(const fs::path& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    std::streamoff bytes = file.tellg();
+    if (bytes < 0) return false;
+    out.resize(static_cast<size_t>(bytes));
+    file.seekg(0);
+    return static_cast<bool>(file.read(out.data(), bytes));
+}
+
+inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+// Number after optional spaces; p moves past it
+inline bool parseFloat(const char*& p, const char* end, float& value) {
+    while (p < end && isSpace(*p)) p++;
+    if (p < end && *p == '+') p++;
+    if (p >= end) return false;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto result = std::from_chars(p, end, value);
+    if (result.ec != std::errc()) return false;
+    p = result.ptr;
+#else
+    // No float from_chars (older libc++): the buffer is NUL-terminated
+    // and p is on a non-space character, so strtof stops inside the line
+    char* next = nullptr;
+    value = std::strtof(p, &next);
+    if (next == p || next > end) return false;
+    p = next;
+#endif
+    return true;
+}
+
+inline bool parseCube(const std::string& text, CubeData& cube) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!lineEnd) lineEnd = end;
+        const char* s = p;
+        p = lineEnd < end ? lineEnd + 1 : end;
+
+        // Skip empty lines and comments
+        while (s < lineEnd && isSpace(*s)) s++;
+        if (s == lineEnd || *s == '#') continue;
+
+        // RGB values
+        char c = *s;
+        if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.') {
+            float r, g, b;
+            if (parseFloat(s, lineEnd, r) && parseFloat(s, lineEnd, g) && parseFloat(s, lineEnd, b)) {
+                cube.rgb.push_back(r);
+                cube.rgb.push_back(g);
+                cube.rgb.push_back(b);
+            }
+            continue;
+        }
+
+        const char* k = s;
+        while (s < lineEnd && !isSpace(*s)) s++;
+        std::string_view keyword(k, s - k);
+
+        if (keyword == "TITLE") {
+            // Extract title (may be quoted)
+            std::string_view rest(s, lineEnd - s);
+            size_t start = rest.find_first_not_of(" \t\r\"");
+            size_t last = rest.find_last_not_of(" \t\r\"");
+            if (start != std::string_view::npos) {
+                cube.title.assign(rest.substr(start, last - start + 1));
+            }
+        } else if (keyword == "LUT_3D_SIZE") {
+            while (s < lineEnd && isSpace(*s)) s++;
+            int size = 0;
+            std::from_chars(s, lineEnd, size);
+            if (size < 2 || size > 256) {
+                logError() << "Lut3D: invalid LUT size " << size;
+                return false;
+            }
+            cube.size = size;
+            cube.rgb.reserve(static_cast<size_t>(size) * size * size * 3);
+        } else if (keyword == "LUT_1D_SIZE") {
+            logError() << "Lut3D: 1D LUT not supported";
+            return false;
+        }
+        // DOMAIN_MIN / DOMAIN_MAX and unknown keywords are ignored (domain 0-1)
+    }
+
+    size_t expected = static_cast<size_t>(cube.size) * cube.size * cube.size * 3;
+    if (cube.size == 0 || cube.rgb.size() != expected) {
+        logError() << "Lut3D: invalid .cube file (size=" << cube.size
+                   << ", data=" << cube.rgb.size() << " floats, expected " << expected << ")";
+        return false;
+    }
+    return true;
+}
+
+// --- Cache ---
+
+struct CacheHeader {
+    char magic[4];          // "TCLT"
+    uint32_t version;
+    uint32_t size;
+    uint32_t titleBytes;
+    uint64_t sourceBytes;   // Source file when the cache was written
+    int64_t sourceTime;
+};
+
+constexpr uint32_t kCacheVersion = 1;
+
+inline fs::path cachePath(const fs::path& source) {
+    fs::path path = source;
+    path += ".tclut";
+    return path;
+}
+
+inline bool sourceStamp(const fs::path& source, uint64_t& bytes, int64_t& time) {
+    std::error_code ec;
+    bytes = fs::file_size(source, ec);
+    if (ec) return false;
+    auto t = fs::last_write_time(source, ec);
+    if (ec) return false;
+    time = static_cast<int64_t>(t.time_since_epoch().count());
+    return true;
+}
+
+inline bool readCache(const fs::path& source, CubeData& cube) {
+    uint64_t bytes;
+    int64_t time;
+    if (!sourceStamp(source, bytes, time)) return false;
+
+    fs::path path = cachePath(source);
+    std::error_code ec;
+    uint64_t fileBytes = fs::file_size(path, ec);
+    if (ec) return false;
+    std::ifstream file(path, std::ios::binary);
+    CacheHeader header;
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+    if (std::memcmp(header.magic, "TCLT", 4) != 0 || header.version != kCacheVersion ||
+        header.sourceBytes != bytes || header.sourceTime != time ||
+        header.size < 2 || header.size > 256) {
+        return false;
+    }
+    size_t count = static_cast<size_t>(header.size) * header.size * header.size * 3;
+    if (fileBytes != sizeof(header) + header.titleBytes + count * sizeof(float)) return false;
+
+    cube.size = static_cast<int>(header.size);
+    cube.title.resize(header.titleBytes);
+    cube.rgb.resize(count);
+    file.read(cube.title.data(), header.titleBytes);
+    file.read(reinterpret_cast<char*>(cube.rgb.data()), count * sizeof(float));
+    return static_cast<bool>(file);
+}
+
+inline bool writeCache(const fs::path& source, const CubeData& cube) {
+    CacheHeader header = {{'T', 'C', 'L', 'T'}, kCacheVersion, static_cast<uint32_t>(cube.size),
+                          static_cast<uint32_t>(cube.title.size()), 0, 0};
+    if (!sourceStamp(source, header.sourceBytes, header.sourceTime)) return false;
+
+    fs::path path = cachePath(source);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(cube.title.data(), cube.title.size());
+    file.write(reinterpret_cast<const char*>(cube.rgb.data()), cube.rgb.size() * sizeof(float));
+    file.close();
+    if (!file) {
+        std::error_code ec;
+        fs::remove(path, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace cube_detail
+
 // ---------------------------------------------------------------------------
 // Lut3D class - 3D LUT texture for color grading
 // ---------------------------------------------------------------------------
@@ -66,96 +262,58 @@ public:
     // =========================================================================
 
     // Load from .cube file
-    bool load(const fs::path& path) {
-        std::ifstream file(path);
-        if (!file) {
-            logError() << "Lut3D: failed to open " << path.string();
-            return false;
-        }
-
-        std::string line;
-        int size = 0;
-        std::vector<float> data;
-        title_ = path.stem().string();
-
-        // Parse .cube file
-        while (std::getline(file, line)) {
-            // Skip empty lines and comments
-            if (line.empty() || line[0] == '#') continue;
-
-            // Remove trailing whitespace/carriage return
-            while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) {
-                line.pop_back();
-            }
-            if (line.empty()) continue;
-
-            std::istringstream iss(line);
-            std::string keyword;
-            iss >> keyword;
-
-            if (keyword == "TITLE") {
-                // Extract title (may be quoted)
-                std::string rest;
-                std::getline(iss, rest);
-                // Remove leading whitespace
-                size_t start = rest.find_first_not_of(" \t\"");
-                size_t end = rest.find_last_not_of(" \t\"");
-                if (start != std::string::npos && end != std::string::npos) {
-                    title_ = rest.substr(start, end - start + 1);
-                }
-            } else if (keyword == "LUT_3D_SIZE") {
-                iss >> size;
-                if (size < 2 || size > 256) {
-                    logError() << "Lut3D: invalid LUT size " << size;
-                    return false;
-                }
-                data.reserve(size * size * size * 3);
-            } else if (keyword == "DOMAIN_MIN" || keyword == "DOMAIN_MAX") {
-                // Ignore domain (assume 0-1)
-            } else if (keyword == "LUT_1D_SIZE") {
-                logError() << "Lut3D: 1D LUT not supported";
+    // useCache: read "<file>.tclut" when it is up to date, otherwise parse
+    // the .cube file and write it (a failed write only logs a warning)
+    bool load(const fs::path& path, bool useCache = false) {
+        cube_detail::CubeData cube;
+        if (!useCache || !cube_detail::readCache(path, cube)) {
+            cube = {};
+            std::string text;
+            if (!cube_detail::readFile(path, text)) {
+                logError() << "Lut3D: failed to open " << path.string();
                 return false;
-            } else {
-                // Try to parse as RGB values
-                float r, g, b;
-                std::istringstream dataIss(line);
-                if (dataIss >> r >> g >> b) {
-                    data.push_back(r);
-                    data.push_back(g);
-                    data.push_back(b);
-                }
             }
-        }
+            if (!cube_detail::parseCube(text, cube)) return false;
+            if (cube.title.empty()) cube.title = path.stem().string();
 
-        if (size == 0 || data.size() != size * size * size * 3) {
-            logError() << "Lut3D: invalid .cube file (size=" << size
-                       << ", data=" << data.size() << " floats, expected " << (size*size*size*3) << ")";
-            return false;
+            if (useCache && !cube_detail::writeCache(path, cube)) {
+                logWarning() << "Lut3D: failed to write cache " << cube_detail::cachePath(path).string();
+            }
         }
 
-        allocate(size, data.data());
+        allocate(cube.size, cube.rgb.data());
+        title_ = std::move(cube.title);
         return true;
     }
 
     // Allocate empty or with data
     void allocate(int size, const float* rgbData = nullptr) {
         clear();
+        if (size < 2) return;
 
         size_ = size;
 
-        // Convert RGB float data to RGBA8
+        // CPU copy for apply(): RGB + pad per entry
         // .cube format: R varies fastest, then G, then B (depth)
-        std::vector<unsigned char> rgba(size * size * size * 4);
-
+        size_t count = static_cast<size_t>(size) * size * size;
+        lattice_.assign(count * 4, 0.0f);
         if (rgbData) {
-            for (int i = 0; i < size * size * size; i++) {
-                rgba[i * 4 + 0] = static_cast<unsigned char>(std::clamp(rgbData[i * 3 + 0] * 255.0f, 0.0f, 255.0f));
-                rgba[i * 4 + 1] = static_cast<unsigned char>(std::clamp(rgbData[i * 3 + 1] * 255.0f, 0.0f, 255.0f));
-                rgba[i * 4 + 2] = static_cast<unsigned char>(std::clamp(rgbData[i * 3 + 2] * 255.0f, 0.0f, 255.0f));
-                rgba[i * 4 + 3] = 255;
+            for (size_t i = 0; i < count; i++) {
+                lattice_[i * 4 + 0] = rgbData[i * 3 + 0];
+                lattice_[i * 4 + 1] = rgbData[i * 3 + 1];
+                lattice_[i * 4 + 2] = rgbData[i * 3 + 2];
             }
-        } else {
-            std::fill(rgba.begin(), rgba.end(), 0);
+        }
+        allocated_ = true;
+
+        // No texture without a graphics context (headless, before setup)
+        if (headless::isActive() || !sg_isvalid()) return;
+
+        // Convert to RGBA8
+        std::vector<unsigned char> rgba(count * 4);
+        for (size_t i = 0; i < count * 4; i++) {
+            rgba[i] = (i & 3) == 3 ? 255
+                : static_cast<unsigned char>(std::clamp(lattice_[i] * 255.0f, 0.0f, 255.0f));
         }
 
         // Create 3D image
@@ -183,30 +341,49 @@ public:
 
         // Create sampler
         createSampler();
-
-        allocated_ = true;
     }
 
     // Release resources
     void clear() {
-        if (allocated_) {
+        if (image_.id) {
             sg_destroy_sampler(sampler_);
             sg_destroy_view(view_);
             sg_destroy_image(image_);
-            allocated_ = false;
         }
+        allocated_ = false;
         size_ = 0;
         title_.clear();
+        lattice_.clear();
+        lattice_.shrink_to_fit();
         image_ = {};
         view_ = {};
         sampler_ = {};
     }
 
+    // =========================================================================
+    // CPU apply
+    // =========================================================================
+
+    // Grade pixels in place (U8 / F32, 3 or 4 channels; alpha is kept).
+    // blend: 0 = original, 1 = full LUT effect. Rows run across threads.
+    bool apply(Pixels& pixels, float blend = 1.0f,
+               LutInterpolation interpolation = LutInterpolation::Tetrahedral) const {
+        if (!allocated_ || !pixels.isAllocated()) return false;
+        if (pixels.getChannels() < 3) {
+            logError() << "Lut3D: apply() needs RGB or RGBA pixels";
+            return false;
+        }
+        applyLut(lattice_.data(), size_, pixels.getDataVoid(), pixels.isFloat(),
+                 pixels.getWidth(), pixels.getHeight(), pixels.getChannels(), blend, interpolation);
+        return true;
+    }
+
     // =========================================================================
     // State
     // =========================================================================
 
     bool isAllocated() const { return allocated_; }
+    bool hasTexture() const { return image_.id != 0; }
     int getSize() const { return size_; }
     const std::string& getTitle() const { return title_; }
 
@@ -238,6 +415,7 @@ private:
 
     int size_ = 0;
     std::string title_;
+    std::vector<float> lattice_;    // size^3 * (R, G, B, pad)
     bool allocated_ = false;
     TextureFilter filter_ = TextureFilter::Linear;
 
@@ -253,7 +431,7 @@ private:
     }
 
     void recreateSampler() {
-        if (!allocated_) return;
+        if (!image_.id) return;
         sg_destroy_sampler(sampler_);
         createSampler();
     }
@@ -264,6 +442,7 @@ private:
         sampler_ = other.sampler_;
         size_ = other.size_;
         title_ = std::move(other.title_);
+        lattice_ = std::move(other.lattice_);
         allocated_ = other.allocated_;
         filter_ = other.filter_;
 
@@ -807,7 +986,7 @@ protected:
             bind.views[0] = sourceView;
             bind.samplers[0] = sourceSampler;
         }
-        if (currentLut && currentLut->isAllocated()) {
+        if (currentLut && currentLut->hasTexture()) {
             bind.views[1] = currentLut->getView();
             bind.samplers[1] = currentLut->getSampler();
         }
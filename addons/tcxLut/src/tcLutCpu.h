@@ -0,0 +1,203 @@
+#pragma once
+
+// =============================================================================
+// tcLutCpu - Apply a 3D LUT to pixels on the CPU
+// =============================================================================
+// Used by Lut3D::apply() (headless grading, thumbnails, exported frames).
+// The lattice is stored as RGB + pad floats so every lookup is one 4-lane
+// load (SSE2 / NEON, scalar elsewhere):
+//   Tetrahedral: 4 lattice points per pixel (same as most grading tools)
+//   Trilinear:   8 lattice points per pixel (same as the GPU sampler)
+// 8-bit input looks up index / fraction in a 256-entry table. Rows are split
+// into bands across threads; the calling thread takes the first band.
+
+#include <cstdint>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TC_LUT_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define TC_LUT_NEON 1
+#endif
+
+namespace tcx::lut {
+
+enum class LutInterpolation {
+    Tetrahedral,
+    Trilinear
+};
+
+namespace cpu_apply {
+
+// --- 4-lane float (r, g, b, pad) ---
+
+#if defined(TC_LUT_SSE2)
+struct Lane {
+    __m128 v;
+    static Lane load(const float* p) { return {_mm_loadu_ps(p)}; }
+    Lane operator+(Lane o) const { return {_mm_add_ps(v, o.v)}; }
+    Lane operator-(Lane o) const { return {_mm_sub_ps(v, o.v)}; }
+    Lane operator*(float s) const { return {_mm_mul_ps(v, _mm_set1_ps(s))}; }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+};
+#elif defined(TC_LUT_NEON)
+struct Lane {
+    float32x4_t v;
+    static Lane load(const float* p) { return {vld1q_f32(p)}; }
+    Lane operator+(Lane o) const { return {vaddq_f32(v, o.v)}; }
+    Lane operator-(Lane o) const { return {vsubq_f32(v, o.v)}; }
+    Lane operator*(float s) const { return {vmulq_n_f32(v, s)}; }
+    void store(float* p) const { vst1q_f32(p, v); }
+};
+#else
+struct Lane {
+    float v[4];
+    static Lane load(const float* p) { return {{p[0], p[1], p[2], p[3]}}; }
+    Lane operator+(Lane o) const { return {{v[0] + o.v[0], v[1] + o.v[1], v[2] + o.v[2], v[3] + o.v[3]}}; }
+    Lane operator-(Lane o) const { return {{v[0] - o.v[0], v[1] - o.v[1], v[2] - o.v[2], v[3] - o.v[3]}}; }
+    Lane operator*(float s) const { return {{v[0] * s, v[1] * s, v[2] * s, v[3] * s}}; }
+    void store(float* p) const { for (int i = 0; i < 4; i++) p[i] = v[i]; }
+};
+#endif
+
+// Lattice cell along one axis
+struct Axis {
+    int index;      // 0 .. size - 2
+    float frac;     // 0 .. 1
+};
+
+inline Axis axis(float v, int size) {
+    float x = std::clamp(v, 0.0f, 1.0f) * static_cast<float>(size - 1);
+    int i = std::min(static_cast<int>(x), size - 2);
+    return {i, x - static_cast<float>(i)};
+}
+
+struct Job {
+    const float* lattice;   // size^3 * 4 floats, R fastest
+    int size;
+    void* data;
+    bool isFloat;
+    int channels;           // 3 or 4 (alpha is left untouched)
+    int width;
+    int height;
+    float blend;
+    LutInterpolation interpolation;
+    const Axis* table8;     // 256 entries (8-bit input)
+};
+
+// --- Interpolation (strides in floats) ---
+
+inline void tetrahedral(const float* c000, float fr, float fg, float fb,
+                        int sr, int sg, int sb, float out[4]) {
+    // Walk from c000 to c111 along the largest fraction first
+    int a, b;
+    float f0, f1, f2;
+    if (fr >= fg) {
+        if (fg >= fb)      { a = sr; b = sr + sg; f0 = fr; f1 = fg; f2 = fb; }
+        else if (fr >= fb) { a = sr; b = sr + sb; f0 = fr; f1 = fb; f2 = fg; }
+        else               { a = sb; b = sb + sr; f0 = fb; f1 = fr; f2 = fg; }
+    } else {
+        if (fr >= fb)      { a = sg; b = sg + sr; f0 = fg; f1 = fr; f2 = fb; }
+        else if (fg >= fb) { a = sg; b = sg + sb; f0 = fg; f1 = fb; f2 = fr; }
+        else               { a = sb; b = sb + sg; f0 = fb; f1 = fg; f2 = fr; }
+    }
+    Lane p0 = Lane::load(c000);
+    Lane pa = Lane::load(c000 + a);
+    Lane pb = Lane::load(c000 + b);
+    Lane p1 = Lane::load(c000 + sr + sg + sb);
+    (p0 + (pa - p0) * f0 + (pb - pa) * f1 + (p1 - pb) * f2).store(out);
+}
+
+inline void trilinear(const float* c000, float fr, float fg, float fb,
+                      int sr, int sg, int sb, float out[4]) {
+    auto lerp = [](Lane x, Lane y, float t) { return x + (y - x) * t; };
+    auto edge = [&](const float* p) { return lerp(Lane::load(p), Lane::load(p + sr), fr); };
+    Lane c00 = edge(c000);
+    Lane c10 = edge(c000 + sg);
+    Lane c01 = edge(c000 + sb);
+    Lane c11 = edge(c000 + sg + sb);
+    lerp(lerp(c00, c10, fg), lerp(c01, c11, fg), fb).store(out);
+}
+
+// --- Rows ---
+
+inline void applyRows(const Job& job, int yBegin, int yEnd) {
+    const int size = job.size;
+    const int sr = 4, sg = 4 * size, sb = 4 * size * size;
+    const bool tetra = job.interpolation == LutInterpolation::Tetrahedral;
+    const float blend = job.blend;
+    const int ch = job.channels;
+
+    auto lookup = [&](Axis r, Axis g, Axis b, float out[4]) {
+        const float* c000 = job.lattice + r.index * sr + g.index * sg + b.index * sb;
+        if (tetra) tetrahedral(c000, r.frac, g.frac, b.frac, sr, sg, sb, out);
+        else trilinear(c000, r.frac, g.frac, b.frac, sr, sg, sb, out);
+    };
+
+    for (int y = yBegin; y < yEnd; y++) {
+        size_t rowStart = static_cast<size_t>(y) * job.width * ch;
+        if (job.isFloat) {
+            float* p = static_cast<float*>(job.data) + rowStart;
+            for (int x = 0; x < job.width; x++, p += ch) {
+                float out[4];
+                lookup(axis(p[0], size), axis(p[1], size), axis(p[2], size), out);
+                for (int c = 0; c < 3; c++) p[c] += (out[c] - p[c]) * blend;
+            }
+        } else {
+            uint8_t* p = static_cast<uint8_t*>(job.data) + rowStart;
+            for (int x = 0; x < job.width; x++, p += ch) {
+                float out[4];
+                lookup(job.table8[p[0]], job.table8[p[1]], job.table8[p[2]], out);
+                for (int c = 0; c < 3; c++) {
+                    float v = (p[c] + (out[c] * 255.0f - p[c]) * blend) + 0.5f;
+                    p[c] = static_cast<uint8_t>(std::clamp(v, 0.0f, 255.0f));
+                }
+            }
+        }
+    }
+}
+
+} // namespace cpu_apply
+
+// Apply a lattice (size^3 RGB + pad floats) to interleaved pixels in place.
+// Threads: one band per core (up to 8), or the caller alone for small images.
+inline void applyLut(const float* lattice, int size, void* data, bool isFloat,
+                     int width, int height, int channels, float blend,
+                     LutInterpolation interpolation, bool parallel = true) {
+    using namespace cpu_apply;
+    if (!lattice || size < 2 || !data || width <= 0 || height <= 0 || channels < 3) return;
+
+    Axis table[256];
+    if (!isFloat) {
+        for (int i = 0; i < 256; i++) table[i] = axis(i / 255.0f, size);
+    }
+
+    Job job{lattice, size, data, isFloat, channels, width, height,
+            std::clamp(blend, 0.0f, 1.0f), interpolation, table};
+
+    // ~64K pixels per band at least; thread start-up costs more below that
+    int bands = 1;
+    if (parallel) {
+        int cores = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, 8);
+        long long pixels = static_cast<long long>(width) * height;
+        bands = static_cast<int>(std::clamp<long long>(pixels / 65536, 1, cores));
+        bands = std::min(bands, height);
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(bands - 1);
+    for (int i = 1; i < bands; i++) {
+        int y0 = height * i / bands;
+        int y1 = height * (i + 1) / bands;
+        workers.emplace_back([&job, y0, y1] { applyRows(job, y0, y1); });
+    }
+    applyRows(job, 0, height / bands);
+    for (auto& t : workers) t.join();
+}
+
+} // namespace tcx::lut
@@ -6,6 +6,8 @@
 // =============================================================================
 
 #include "tcxOscMessage.h"
+#include "tcxOscMessageView.h"
 #include "tcxOscBundle.h"
+#include "tcxOscRouter.h"
 #include "tcxOscSender.h"
 #include "tcxOscReceiver.h"
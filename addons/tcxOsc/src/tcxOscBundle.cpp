@@ -9,38 +9,49 @@ using namespace osc_internal;
 // =============================================================================
 std::vector<uint8_t> OscBundle::toBytes() const {
     std::vector<uint8_t> result;
+    appendBytes(result);
+    return result;
+}
 
-    // "#bundle\0"
-    const char* bundleId = "#bundle";
-    result.insert(result.end(), bundleId, bundleId + 8);
+// =============================================================================
+// appendHeader - "#bundle\0" + timetag
+// =============================================================================
+void OscBundle::appendHeader(std::vector<uint8_t>& out, uint64_t timetag) {
+    size_t start = out.size();
+    out.resize(start + 16);
+    std::memcpy(out.data() + start, "#bundle", 8);
 
     // Timetag (8 bytes, big-endian)
-    uint64_t be = toBigEndian64(timetag_);
-    auto* p = reinterpret_cast<uint8_t*>(&be);
-    result.insert(result.end(), p, p + 8);
+    uint64_t be = toBigEndian64(timetag);
+    std::memcpy(out.data() + start + 8, &be, 8);
+}
 
-    // Each element
+// =============================================================================
+// appendBytes - Serialize bundle into existing buffer
+// =============================================================================
+size_t OscBundle::appendBytes(std::vector<uint8_t>& out) const {
+    size_t start = out.size();
+    appendHeader(out, timetag_);
+
+    // Each element: size (4 bytes, big-endian) + data
     for (const auto& element : elements_) {
-        std::vector<uint8_t> elementBytes;
+        size_t sizePos = out.size();
+        out.resize(sizePos + 4);
 
+        size_t elementSize = 0;
         if (auto* msg = std::get_if<OscMessage>(&element)) {
-            elementBytes = msg->toBytes();
+            elementSize = msg->appendBytes(out);
         }
         else if (auto* bundle = std::get_if<OscBundle>(&element)) {
-            elementBytes = bundle->toBytes();
+            elementSize = bundle->appendBytes(out);
         }
 
-        // Size (4 bytes, big-endian)
-        uint32_t size = static_cast<uint32_t>(elementBytes.size());
-        uint32_t sizeBe = toBigEndian(size);
-        auto* sp = reinterpret_cast<uint8_t*>(&sizeBe);
-        result.insert(result.end(), sp, sp + 4);
-
-        // Element data
-        result.insert(result.end(), elementBytes.begin(), elementBytes.end());
+        // Back-patch element size
+        uint32_t sizeBe = toBigEndian(static_cast<uint32_t>(elementSize));
+        std::memcpy(out.data() + sizePos, &sizeBe, 4);
     }
 
-    return result;
+    return out.size() - start;
 }
 
 // =============================================================================
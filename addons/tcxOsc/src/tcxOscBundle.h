@@ -2,6 +2,7 @@
 
 #include "tcxOscMessage.h"
 #include <variant>
+#include <chrono>
 
 namespace trussc {
 
@@ -26,6 +27,17 @@ public:
     void setTimetag(uint64_t timetag) { timetag_ = timetag; }
     uint64_t getTimetag() const { return timetag_; }
 
+    // NTP timetag for current time + offset (seconds)
+    static uint64_t makeTimetag(double secondsFromNow = 0.0) {
+        // NTP epoch (1900) to Unix epoch (1970)
+        constexpr uint64_t NTP_UNIX_OFFSET = 2208988800ULL;
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        double t = std::chrono::duration<double>(now).count() + secondsFromNow;
+        uint64_t seconds = static_cast<uint64_t>(t);
+        uint64_t fraction = static_cast<uint64_t>((t - static_cast<double>(seconds)) * 4294967296.0);
+        return ((seconds + NTP_UNIX_OFFSET) << 32) | (fraction & 0xFFFFFFFFULL);
+    }
+
     // -------------------------------------------------------------------------
     // Add elements
     // -------------------------------------------------------------------------
@@ -74,6 +86,13 @@ public:
     // Serialize
     // -------------------------------------------------------------------------
     std::vector<uint8_t> toBytes() const;
+
+    // Append encoded bundle to an existing buffer. Returns bytes appended
+    size_t appendBytes(std::vector<uint8_t>& out) const;
+
+    // Write "#bundle\0" + timetag header into buffer
+    static void appendHeader(std::vector<uint8_t>& out, uint64_t timetag);
+
     static OscBundle fromBytes(const uint8_t* data, size_t size, bool& ok);
 
     // -------------------------------------------------------------------------
@@ -5,58 +5,90 @@ namespace trussc {
 
 using namespace osc_internal;
 
+// =============================================================================
+// getByteSize - Encoded size
+// =============================================================================
+size_t OscMessage::getByteSize() const {
+    size_t size = alignTo4(address_.size() + 1);
+    size += alignTo4(typeTags_.size() + 2);  // ',' + tags + null
+
+    for (size_t i = 0; i < args_.size(); ++i) {
+        char type = typeTags_[i];
+        if (type == 'i' || type == 'f') {
+            size += 4;
+        }
+        else if (type == 's') {
+            size += alignTo4(std::get<std::string>(args_[i]).size() + 1);
+        }
+        else if (type == 'b') {
+            size += 4 + alignTo4(std::get<std::vector<uint8_t>>(args_[i]).size());
+        }
+        // 'T' and 'F' have no data
+    }
+    return size;
+}
+
 // =============================================================================
 // toBytes - Serialize message to byte array
 // =============================================================================
 std::vector<uint8_t> OscMessage::toBytes() const {
     std::vector<uint8_t> result;
+    appendBytes(result);
+    return result;
+}
+
+// =============================================================================
+// appendBytes - Serialize message into existing buffer
+// =============================================================================
+size_t OscMessage::appendBytes(std::vector<uint8_t>& out) const {
+    size_t start = out.size();
+    size_t total = getByteSize();
+
+    // Zero-filled, so padding and null terminators need no extra writes
+    out.resize(start + total, 0);
+    uint8_t* dst = out.data() + start;
+    size_t pos = 0;
+
+    auto writeUint32 = [&](uint32_t value) {
+        uint32_t be = toBigEndian(value);
+        std::memcpy(dst + pos, &be, 4);
+        pos += 4;
+    };
 
     // Address (null-terminated + padding)
-    result.insert(result.end(), address_.begin(), address_.end());
-    result.push_back(0);
-    while (result.size() % 4 != 0) result.push_back(0);
+    std::memcpy(dst, address_.data(), address_.size());
+    pos = alignTo4(address_.size() + 1);
 
     // Type tags (comma + tags + null-terminated + padding)
-    result.push_back(',');
-    result.insert(result.end(), typeTags_.begin(), typeTags_.end());
-    result.push_back(0);
-    while (result.size() % 4 != 0) result.push_back(0);
+    dst[pos] = ',';
+    std::memcpy(dst + pos + 1, typeTags_.data(), typeTags_.size());
+    pos += alignTo4(typeTags_.size() + 2);
 
     // Argument data
     for (size_t i = 0; i < args_.size(); ++i) {
         char type = typeTags_[i];
 
         if (type == 'i') {
-            int32_t value = std::get<int32_t>(args_[i]);
-            uint32_t be = toBigEndian(static_cast<uint32_t>(value));
-            auto* p = reinterpret_cast<uint8_t*>(&be);
-            result.insert(result.end(), p, p + 4);
+            writeUint32(static_cast<uint32_t>(std::get<int32_t>(args_[i])));
         }
         else if (type == 'f') {
-            float value = std::get<float>(args_[i]);
-            uint32_t be = toBigEndian(floatToUint32(value));
-            auto* p = reinterpret_cast<uint8_t*>(&be);
-            result.insert(result.end(), p, p + 4);
+            writeUint32(floatToUint32(std::get<float>(args_[i])));
         }
         else if (type == 's') {
             const std::string& str = std::get<std::string>(args_[i]);
-            result.insert(result.end(), str.begin(), str.end());
-            result.push_back(0);
-            while (result.size() % 4 != 0) result.push_back(0);
+            std::memcpy(dst + pos, str.data(), str.size());
+            pos += alignTo4(str.size() + 1);
         }
         else if (type == 'b') {
             const auto& blob = std::get<std::vector<uint8_t>>(args_[i]);
-            uint32_t size = static_cast<uint32_t>(blob.size());
-            uint32_t be = toBigEndian(size);
-            auto* p = reinterpret_cast<uint8_t*>(&be);
-            result.insert(result.end(), p, p + 4);
-            result.insert(result.end(), blob.begin(), blob.end());
-            while (result.size() % 4 != 0) result.push_back(0);
+            writeUint32(static_cast<uint32_t>(blob.size()));
+            if (!blob.empty()) std::memcpy(dst + pos, blob.data(), blob.size());
+            pos += alignTo4(blob.size());
         }
         // 'T' and 'F' have no data
     }
 
-    return result;
+    return total;
 }
 
 // =============================================================================
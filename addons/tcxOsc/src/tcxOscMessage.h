@@ -163,6 +163,14 @@ public:
     // Serialize
     // -------------------------------------------------------------------------
     std::vector<uint8_t> toBytes() const;
+
+    // Append encoded message to an existing buffer (no temporary allocation
+    // once the buffer has grown). Returns number of bytes appended.
+    size_t appendBytes(std::vector<uint8_t>& out) const;
+
+    // Encoded size in bytes
+    size_t getByteSize() const;
+
     static OscMessage fromBytes(const uint8_t* data, size_t size, bool& ok);
 
     // -------------------------------------------------------------------------
@@ -0,0 +1,228 @@
+#pragma once
+
+#include "tcxOscMessage.h"
+#include <array>
+#include <string_view>
+
+namespace trussc {
+
+// =============================================================================
+// OscMessageView - Zero-copy, read-only view over an encoded OSC message
+// Parses in place over the receive buffer. No heap allocation.
+// The view is only valid while the underlying buffer is alive.
+// =============================================================================
+class OscMessageView {
+public:
+    // Arguments beyond this count are located by walking the buffer
+    static constexpr size_t MAX_INDEXED_ARGS = 32;
+
+    OscMessageView() = default;
+
+    // -------------------------------------------------------------------------
+    // Parse (returns false on malformed data)
+    // -------------------------------------------------------------------------
+    bool parse(const uint8_t* data, size_t size) {
+        using namespace osc_internal;
+
+        data_ = data;
+        size_ = 0;
+        address_ = {};
+        typeTags_ = {};
+        argCount_ = 0;
+
+        if (!data || size < 4) return false;
+        if (data[0] != '/') return false;  // Address must start with '/'
+
+        size_t addrEnd = findNull(data, size, 0);
+        if (addrEnd == size_t(-1)) return false;
+        address_ = std::string_view(reinterpret_cast<const char*>(data), addrEnd);
+        size_t pos = alignTo4(addrEnd + 1);
+
+        // Messages without type tags are allowed (old OSC spec)
+        if (pos >= size || data[pos] != ',') {
+            size_ = size;
+            return true;
+        }
+
+        size_t typeTagStart = pos + 1;
+        size_t typeTagEnd = findNull(data, size, typeTagStart);
+        if (typeTagEnd == size_t(-1)) return false;
+        typeTags_ = std::string_view(reinterpret_cast<const char*>(data + typeTagStart),
+                                     typeTagEnd - typeTagStart);
+        pos = alignTo4(typeTagEnd + 1);
+
+        // Validate arguments and index their offsets
+        for (char type : typeTags_) {
+            size_t next = skipArg(type, pos, data, size);
+            if (next == size_t(-1)) break;  // Unknown type or truncated: stop here
+            if (argCount_ < MAX_INDEXED_ARGS) {
+                offsets_[argCount_] = static_cast<uint32_t>(pos);
+            }
+            ++argCount_;
+            pos = next;
+        }
+
+        size_ = size;
+        return true;
+    }
+
+    bool isValid() const { return size_ != 0; }
+
+    // -------------------------------------------------------------------------
+    // Address / type tags
+    // -------------------------------------------------------------------------
+    std::string_view getAddress() const { return address_; }
+    std::string_view getTypeTags() const { return typeTags_.substr(0, argCount_); }
+
+    size_t getArgCount() const { return argCount_; }
+
+    char getArgType(size_t index) const {
+        if (index >= argCount_) return '\0';
+        return typeTags_[index];
+    }
+
+    // -------------------------------------------------------------------------
+    // Typed argument access (same conversion rules as OscMessage)
+    // -------------------------------------------------------------------------
+    int32_t getArgAsInt(size_t index) const {
+        char type = getArgType(index);
+        if (type == 'i') return static_cast<int32_t>(readUint32(argOffset(index)));
+        if (type == 'f') return static_cast<int32_t>(osc_internal::uint32ToFloat(readUint32(argOffset(index))));
+        return 0;
+    }
+
+    float getArgAsFloat(size_t index) const {
+        char type = getArgType(index);
+        if (type == 'f') return osc_internal::uint32ToFloat(readUint32(argOffset(index)));
+        if (type == 'i') return static_cast<float>(static_cast<int32_t>(readUint32(argOffset(index))));
+        return 0.0f;
+    }
+
+    std::string_view getArgAsString(size_t index) const {
+        if (getArgType(index) != 's') return {};
+        size_t pos = argOffset(index);
+        size_t end = osc_internal::findNull(data_, size_, pos);
+        return std::string_view(reinterpret_cast<const char*>(data_ + pos), end - pos);
+    }
+
+    // Returns pointer into the buffer (nullptr if not a blob)
+    const uint8_t* getArgAsBlob(size_t index, size_t& blobSize) const {
+        blobSize = 0;
+        if (getArgType(index) != 'b') return nullptr;
+        size_t pos = argOffset(index);
+        blobSize = readUint32(pos);
+        return data_ + pos + 4;
+    }
+
+    bool getArgAsBool(size_t index) const {
+        return getArgType(index) == 'T';
+    }
+
+    // -------------------------------------------------------------------------
+    // Convert to an owning OscMessage (allocates)
+    // -------------------------------------------------------------------------
+    OscMessage toMessage() const {
+        OscMessage msg{std::string(address_)};
+        for (size_t i = 0; i < argCount_; ++i) {
+            switch (typeTags_[i]) {
+                case 'i': msg.addInt(getArgAsInt(i)); break;
+                case 'f': msg.addFloat(getArgAsFloat(i)); break;
+                case 's': msg.addString(std::string(getArgAsString(i))); break;
+                case 'b': {
+                    size_t n = 0;
+                    const uint8_t* p = getArgAsBlob(i, n);
+                    msg.addBlob(p, n);
+                    break;
+                }
+                case 'T': msg.addBool(true); break;
+                case 'F': msg.addBool(false); break;
+            }
+        }
+        return msg;
+    }
+
+    // -------------------------------------------------------------------------
+    // Walk a packet (message or nested bundles), calling fn(const OscMessageView&)
+    // for every valid message. Returns false if the packet is malformed.
+    // -------------------------------------------------------------------------
+    template<typename Fn>
+    static bool forEachMessage(const uint8_t* data, size_t size, Fn&& fn) {
+        using namespace osc_internal;
+
+        if (!data || size < 4) return false;
+
+        // "#bundle\0" + timetag
+        if (size >= 8 && std::memcmp(data, "#bundle", 8) == 0) {
+            if (size < 16) return false;
+            size_t pos = 16;
+            while (pos + 4 <= size) {
+                uint32_t sizeBe;
+                std::memcpy(&sizeBe, data + pos, 4);
+                uint32_t elementSize = fromBigEndian(sizeBe);
+                pos += 4;
+                if (pos + elementSize > size) break;
+                forEachMessage(data + pos, elementSize, fn);
+                pos += elementSize;
+            }
+            return true;
+        }
+
+        OscMessageView view;
+        if (!view.parse(data, size)) return false;
+        fn(static_cast<const OscMessageView&>(view));
+        return true;
+    }
+
+private:
+    // Returns position after the argument, or size_t(-1) if invalid
+    static size_t skipArg(char type, size_t pos, const uint8_t* data, size_t size) {
+        using namespace osc_internal;
+        switch (type) {
+            case 'i':
+            case 'f':
+                return (pos + 4 <= size) ? pos + 4 : size_t(-1);
+            case 's': {
+                size_t end = findNull(data, size, pos);
+                return (end == size_t(-1)) ? end : alignTo4(end + 1);
+            }
+            case 'b': {
+                if (pos + 4 > size) return size_t(-1);
+                uint32_t be;
+                std::memcpy(&be, data + pos, 4);
+                uint32_t blobSize = fromBigEndian(be);
+                if (pos + 4 + blobSize > size) return size_t(-1);
+                return alignTo4(pos + 4 + blobSize);
+            }
+            case 'T':
+            case 'F':
+                return pos;
+            default:
+                return size_t(-1);
+        }
+    }
+
+    size_t argOffset(size_t index) const {
+        if (index < MAX_INDEXED_ARGS) return offsets_[index];
+        // Walk from the last indexed argument
+        size_t pos = offsets_[MAX_INDEXED_ARGS - 1];
+        for (size_t i = MAX_INDEXED_ARGS - 1; i < index; ++i) {
+            pos = skipArg(typeTags_[i], pos, data_, size_);
+        }
+        return pos;
+    }
+
+    uint32_t readUint32(size_t pos) const {
+        uint32_t be;
+        std::memcpy(&be, data_ + pos, 4);
+        return osc_internal::fromBigEndian(be);
+    }
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::string_view address_;
+    std::string_view typeTags_;
+    size_t argCount_ = 0;
+    std::array<uint32_t, MAX_INDEXED_ARGS> offsets_{};
+};
+
+}  // namespace trussc
@@ -2,6 +2,7 @@
 
 #include "tcxOscMessage.h"
 #include "tcxOscBundle.h"
+#include "tcxOscRouter.h"
 #include "tc/network/tcUdpSocket.h"
 #include "tc/events/tcEvent.h"
 #include "tc/events/tcEventListener.h"
@@ -96,6 +97,15 @@ public:
 
     size_t getBufferSize() const { return bufferMax_; }
 
+    // -------------------------------------------------------------------------
+    // Zero-copy routing (handlers are called from the receive thread)
+    // -------------------------------------------------------------------------
+    // receiver.getRouter().on("/synth/*/freq", [](const OscMessageView& m) { ... });
+    //
+    // Routed messages are parsed in place without allocation. The OscMessage
+    // path (events / polling) only runs when it has listeners or is enabled.
+    OscRouter& getRouter() { return router_; }
+
 private:
     void handleReceive(UdpReceiveEventArgs& args) {
         if (args.data.empty()) return;
@@ -103,6 +113,21 @@ private:
         const uint8_t* data = reinterpret_cast<const uint8_t*>(args.data.data());
         size_t size = args.data.size();
 
+        bool needMessages = bufferEnabled_ ||
+                            onMessageReceived.listenerCount() > 0 ||
+                            onBundleReceived.listenerCount() > 0;
+
+        if (!router_.empty()) {
+            bool ok = OscMessageView::forEachMessage(data, size, [this](const OscMessageView& msg) {
+                router_.dispatch(msg);
+            });
+            if (!ok && !needMessages) {
+                std::string err = "Failed to parse packet";
+                onParseError.notify(err);
+            }
+            if (!needMessages) return;
+        }
+
         parsePacket(data, size);
     }
 
@@ -172,6 +197,7 @@ private:
     }
 
     UdpSocket socket_;
+    OscRouter router_;
     int port_ = 0;
     EventListener receiveListener_;
     EventListener errorListener_;
@@ -0,0 +1,338 @@
+#include "tcxOscRouter.h"
+#include <algorithm>
+
+namespace trussc {
+
+namespace {
+// Dispatches running on this thread (remove() from a handler must not wait)
+thread_local int dispatchDepth = 0;
+}
+
+// =============================================================================
+// Routes
+// =============================================================================
+OscRouter::OscRouter() : trie_(build({})) {}
+
+OscRouter::RouteId OscRouter::on(const std::string& pattern, Handler handler) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RouteId id = nextId_++;
+    routes_.push_back({id, pattern, std::move(handler)});
+    trie_ = build(routes_);
+    return id;
+}
+
+void OscRouter::remove(RouteId id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    routes_.erase(std::remove_if(routes_.begin(), routes_.end(),
+                                 [id](const Route& r) { return r.id == id; }),
+                  routes_.end());
+    trie_ = build(routes_);
+    waitForDispatches(lock);
+}
+
+void OscRouter::clear() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    routes_.clear();
+    trie_ = build(routes_);
+    waitForDispatches(lock);
+}
+
+void OscRouter::waitForDispatches(std::unique_lock<std::mutex>& lock) {
+    if (dispatchDepth > 0) return;
+    // The other epoch may still hold dispatches from before the last flip
+    int old = epoch_;
+    drained_.wait(lock, [&] { return active_[old ^ 1] == 0; });
+    // Only dispatches that took the previous trie are left in the old epoch
+    if (epoch_ == old) epoch_ ^= 1;
+    drained_.wait(lock, [&] { return active_[old] == 0; });
+}
+
+bool OscRouter::empty() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return routes_.empty();
+}
+
+// =============================================================================
+// Dispatch
+// =============================================================================
+OscRouter::DispatchScope::DispatchScope(const OscRouter& router) : router_(router) {
+    std::lock_guard<std::mutex> lock(router_.mutex_);
+    epoch_ = router_.epoch_;
+    router_.active_[epoch_]++;
+    trie = router_.trie_;
+    dispatchDepth++;
+}
+
+OscRouter::DispatchScope::~DispatchScope() {
+    dispatchDepth--;
+    std::lock_guard<std::mutex> lock(router_.mutex_);
+    if (--router_.active_[epoch_] == 0) router_.drained_.notify_all();
+}
+
+size_t OscRouter::dispatch(const OscMessageView& msg) const {
+    std::string_view address = msg.getAddress();
+    if (address.empty() || address[0] != '/') return 0;
+
+    DispatchScope scope(*this);
+    return walk(*scope.trie, 0, address.substr(1), msg);
+}
+
+size_t OscRouter::dispatchPacket(const uint8_t* data, size_t size) const {
+    DispatchScope scope(*this);
+    const Trie& trie = *scope.trie;
+    if (trie.routes.empty()) return 0;
+
+    size_t count = 0;
+    OscMessageView::forEachMessage(data, size, [&](const OscMessageView& msg) {
+        count += walk(trie, 0, msg.getAddress().substr(1), msg);
+    });
+    return count;
+}
+
+size_t OscRouter::walk(const Trie& trie, uint32_t nodeIndex, std::string_view rest,
+                       const OscMessageView& msg) const {
+    size_t slash = rest.find('/');
+    bool last = (slash == std::string_view::npos);
+    std::string_view segment = rest.substr(0, slash);
+    std::string_view remainder = last ? std::string_view() : rest.substr(slash + 1);
+
+    const TrieNode& node = trie.nodes[nodeIndex];
+    size_t count = 0;
+
+    auto visit = [&](uint32_t child) {
+        if (last) {
+            for (uint32_t r : trie.nodes[child].routes) {
+                trie.routes[r].handler(msg);
+                ++count;
+            }
+        }
+        else {
+            count += walk(trie, child, remainder, msg);
+        }
+    };
+
+    // Literal edges (binary search)
+    auto it = std::lower_bound(node.literals.begin(), node.literals.end(), segment,
+        [](const std::pair<std::string, uint32_t>& e, std::string_view s) {
+            return std::string_view(e.first) < s;
+        });
+    if (it != node.literals.end() && it->first == segment) {
+        visit(it->second);
+    }
+
+    // Wildcard edges
+    for (const auto& edge : node.patterns) {
+        if (matchTokens(edge.tokens, 0, segment)) {
+            visit(edge.node);
+        }
+    }
+
+    return count;
+}
+
+// =============================================================================
+// Trie build
+// =============================================================================
+std::shared_ptr<OscRouter::Trie> OscRouter::build(const std::vector<Route>& routes) {
+    auto trie = std::make_shared<Trie>();
+    trie->nodes.emplace_back();  // Root
+    trie->routes = routes;
+    for (size_t i = 0; i < routes.size(); ++i) {
+        insert(*trie, routes[i].pattern, static_cast<uint32_t>(i));
+    }
+    return trie;
+}
+
+void OscRouter::insert(Trie& trie, std::string_view pattern, uint32_t routeIndex) {
+    if (!pattern.empty() && pattern[0] == '/') pattern.remove_prefix(1);
+
+    uint32_t current = 0;
+    while (true) {
+        size_t slash = pattern.find('/');
+        std::string_view segment = pattern.substr(0, slash);
+        uint32_t next = 0;
+
+        if (isWildcardSegment(segment)) {
+            auto& edges = trie.nodes[current].patterns;
+            auto it = std::find_if(edges.begin(), edges.end(),
+                [&](const PatternEdge& e) { return e.source == segment; });
+            if (it != edges.end()) {
+                next = it->node;
+            }
+            else {
+                next = static_cast<uint32_t>(trie.nodes.size());
+                trie.nodes[current].patterns.push_back({std::string(segment), compileSegment(segment), next});
+                trie.nodes.emplace_back();
+            }
+        }
+        else {
+            auto& edges = trie.nodes[current].literals;
+            auto it = std::lower_bound(edges.begin(), edges.end(), segment,
+                [](const std::pair<std::string, uint32_t>& e, std::string_view s) {
+                    return std::string_view(e.first) < s;
+                });
+            if (it != edges.end() && it->first == segment) {
+                next = it->second;
+            }
+            else {
+                next = static_cast<uint32_t>(trie.nodes.size());
+                edges.insert(it, {std::string(segment), next});
+                trie.nodes.emplace_back();
+            }
+        }
+
+        current = next;
+        if (slash == std::string_view::npos) break;
+        pattern.remove_prefix(slash + 1);
+    }
+
+    trie.nodes[current].routes.push_back(routeIndex);
+}
+
+// =============================================================================
+// Segment pattern compile / match
+// =============================================================================
+bool OscRouter::isWildcardSegment(std::string_view seg) {
+    return seg.find_first_of("*?[{") != std::string_view::npos;
+}
+
+OscRouter::SegmentPattern OscRouter::compileSegment(std::string_view seg) {
+    SegmentPattern tokens;
+
+    auto appendLiteral = [&](char c) {
+        if (tokens.empty() || tokens.back().kind != Token::Literal) {
+            tokens.emplace_back();
+        }
+        tokens.back().text += c;
+    };
+
+    for (size_t i = 0; i < seg.size(); ++i) {
+        char c = seg[i];
+        if (c == '*') {
+            // Collapse consecutive '*'
+            if (tokens.empty() || tokens.back().kind != Token::AnyString) {
+                Token t;
+                t.kind = Token::AnyString;
+                tokens.push_back(std::move(t));
+            }
+        }
+        else if (c == '?') {
+            Token t;
+            t.kind = Token::AnyChar;
+            tokens.push_back(std::move(t));
+        }
+        else if (c == '[') {
+            size_t close = seg.find(']', i + 1);
+            if (close == std::string_view::npos) {
+                appendLiteral(c);  // Unterminated: treat as literal
+                continue;
+            }
+            Token t;
+            t.kind = Token::CharSet;
+            std::string_view spec = seg.substr(i + 1, close - i - 1);
+            if (!spec.empty() && spec[0] == '!') {
+                t.negate = true;
+                spec.remove_prefix(1);
+            }
+            t.text = std::string(spec);
+            tokens.push_back(std::move(t));
+            i = close;
+        }
+        else if (c == '{') {
+            size_t close = seg.find('}', i + 1);
+            if (close == std::string_view::npos) {
+                appendLiteral(c);
+                continue;
+            }
+            Token t;
+            t.kind = Token::Alternatives;
+            std::string_view list = seg.substr(i + 1, close - i - 1);
+            while (true) {
+                size_t comma = list.find(',');
+                t.alts.emplace_back(list.substr(0, comma));
+                if (comma == std::string_view::npos) break;
+                list.remove_prefix(comma + 1);
+            }
+            tokens.push_back(std::move(t));
+            i = close;
+        }
+        else {
+            appendLiteral(c);
+        }
+    }
+
+    return tokens;
+}
+
+bool OscRouter::matchTokens(const SegmentPattern& tokens, size_t ti, std::string_view str) {
+    if (ti == tokens.size()) return str.empty();
+
+    const Token& t = tokens[ti];
+    switch (t.kind) {
+        case Token::Literal:
+            if (str.substr(0, t.text.size()) != t.text) return false;
+            return matchTokens(tokens, ti + 1, str.substr(t.text.size()));
+
+        case Token::AnyChar:
+            if (str.empty()) return false;
+            return matchTokens(tokens, ti + 1, str.substr(1));
+
+        case Token::AnyString:
+            if (ti + 1 == tokens.size()) return true;  // Trailing '*'
+            for (size_t k = 0; k <= str.size(); ++k) {
+                if (matchTokens(tokens, ti + 1, str.substr(k))) return true;
+            }
+            return false;
+
+        case Token::CharSet: {
+            if (str.empty()) return false;
+            char c = str[0];
+            bool found = false;
+            const std::string& spec = t.text;
+            for (size_t k = 0; k < spec.size() && !found; ++k) {
+                if (k + 2 < spec.size() && spec[k + 1] == '-') {
+                    found = (c >= spec[k] && c <= spec[k + 2]);
+                    k += 2;
+                }
+                else {
+                    found = (c == spec[k]);
+                }
+            }
+            if (found == t.negate) return false;
+            return matchTokens(tokens, ti + 1, str.substr(1));
+        }
+
+        case Token::Alternatives:
+            for (const auto& alt : t.alts) {
+                if (str.substr(0, alt.size()) == alt &&
+                    matchTokens(tokens, ti + 1, str.substr(alt.size()))) {
+                    return true;
+                }
+            }
+            return false;
+    }
+    return false;
+}
+
+bool OscRouter::matchSegment(std::string_view pattern, std::string_view str) {
+    if (!isWildcardSegment(pattern)) return pattern == str;
+    return matchTokens(compileSegment(pattern), 0, str);
+}
+
+bool OscRouter::match(std::string_view pattern, std::string_view address) {
+    if (!pattern.empty() && pattern[0] == '/') pattern.remove_prefix(1);
+    if (!address.empty() && address[0] == '/') address.remove_prefix(1);
+
+    while (true) {
+        size_t ps = pattern.find('/');
+        size_t as = address.find('/');
+        if (!matchSegment(pattern.substr(0, ps), address.substr(0, as))) return false;
+        bool pLast = (ps == std::string_view::npos);
+        bool aLast = (as == std::string_view::npos);
+        if (pLast || aLast) return pLast == aLast;
+        pattern.remove_prefix(ps + 1);
+        address.remove_prefix(as + 1);
+    }
+}
+
+}  // namespace trussc
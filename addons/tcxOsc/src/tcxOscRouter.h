@@ -0,0 +1,134 @@
+#pragma once
+
+#include "tcxOscMessageView.h"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+namespace trussc {
+
+// =============================================================================
+// OscRouter - Address-pattern dispatch over a compiled trie
+//
+// Patterns are split on '/' and each segment becomes a trie edge.
+// Literal segments are looked up by binary search; wildcard segments
+// (*, ?, [a-z], [!0-9], {foo,bar}) are compiled once at registration.
+// Dispatch walks the trie per incoming address: O(depth), no allocation.
+//
+//   router.on("/synth/*/freq", [](const OscMessageView& m) { ... });
+//   router.dispatchPacket(data, size);
+//
+// Handlers are called on the dispatching thread (the receive thread
+// when used through OscReceiver).
+// =============================================================================
+class OscRouter {
+public:
+    using Handler = std::function<void(const OscMessageView&)>;
+    using RouteId = uint64_t;
+
+    OscRouter();
+
+    // -------------------------------------------------------------------------
+    // Routes (safe to call while dispatching on another thread)
+    // -------------------------------------------------------------------------
+
+    // Register handler for address pattern. Returns id for remove()
+    RouteId on(const std::string& pattern, Handler handler);
+
+    // Unregister handler. Waits until dispatches already running on other
+    // threads have finished, so the handler's captures may be freed after
+    // it returns. Called from inside a handler it returns at once.
+    void remove(RouteId id);
+
+    // Remove all handlers (waits like remove())
+    void clear();
+
+    bool empty() const;
+
+    // -------------------------------------------------------------------------
+    // Dispatch (returns number of handlers called)
+    // -------------------------------------------------------------------------
+    size_t dispatch(const OscMessageView& msg) const;
+
+    // Dispatch every message in a raw packet (message or bundle)
+    size_t dispatchPacket(const uint8_t* data, size_t size) const;
+
+    // -------------------------------------------------------------------------
+    // Utility: match a single address against a pattern (no trie)
+    // -------------------------------------------------------------------------
+    static bool match(std::string_view pattern, std::string_view address);
+
+private:
+    // Compiled segment pattern
+    struct Token {
+        enum Kind : uint8_t { Literal, AnyChar, AnyString, CharSet, Alternatives };
+        Kind kind = Literal;
+        bool negate = false;             // CharSet: [!...]
+        std::string text;                // Literal text / CharSet spec
+        std::vector<std::string> alts;   // Alternatives
+    };
+    using SegmentPattern = std::vector<Token>;
+
+    struct PatternEdge {
+        std::string source;       // Segment text (for de-duplication)
+        SegmentPattern tokens;
+        uint32_t node = 0;
+    };
+
+    struct TrieNode {
+        std::vector<std::pair<std::string, uint32_t>> literals;    // Sorted by name
+        std::vector<PatternEdge> patterns;
+        std::vector<uint32_t> routes;                              // Index into Trie::routes
+    };
+
+    struct Route {
+        RouteId id = 0;
+        std::string pattern;
+        Handler handler;
+    };
+
+    struct Trie {
+        std::vector<TrieNode> nodes;
+        std::vector<Route> routes;
+    };
+
+    static bool isWildcardSegment(std::string_view seg);
+    static SegmentPattern compileSegment(std::string_view seg);
+    static bool matchTokens(const SegmentPattern& tokens, size_t ti, std::string_view str);
+    static bool matchSegment(std::string_view pattern, std::string_view str);
+
+    static std::shared_ptr<Trie> build(const std::vector<Route>& routes);
+    static void insert(Trie& trie, std::string_view pattern, uint32_t routeIndex);
+
+    size_t walk(const Trie& trie, uint32_t nodeIndex, std::string_view rest,
+                const OscMessageView& msg) const;
+
+    // Copy-on-write: registration rebuilds the trie, dispatch takes a snapshot
+    mutable std::mutex mutex_;
+    std::vector<Route> routes_;
+    std::shared_ptr<const Trie> trie_;
+    RouteId nextId_ = 1;
+
+    // In-flight dispatches per epoch; remove() flips the epoch and waits for
+    // the old one to drain (new dispatches count in the new epoch)
+    mutable std::condition_variable drained_;
+    mutable int active_[2] = {0, 0};
+    int epoch_ = 0;
+
+    // Trie snapshot, counted in the current epoch while alive
+    class DispatchScope {
+    public:
+        explicit DispatchScope(const OscRouter& router);
+        ~DispatchScope();
+        std::shared_ptr<const Trie> trie;
+
+    private:
+        const OscRouter& router_;
+        int epoch_;
+    };
+
+    void waitForDispatches(std::unique_lock<std::mutex>& lock);
+};
+
+}  // namespace trussc
@@ -3,6 +3,10 @@
 #include "tcxOscMessage.h"
 #include "tcxOscBundle.h"
 #include "tc/network/tcUdpSocket.h"
+#include "tc/events/tcCoreEvents.h"
+#include <unordered_map>
+#include <chrono>
+#include <mutex>
 
 namespace trussc {
 
@@ -11,6 +15,9 @@ namespace trussc {
 // =============================================================================
 class OscSender {
 public:
+    // Ethernet MTU (1500) minus IPv4 (20) and UDP (8) headers
+    static constexpr size_t DEFAULT_MAX_PACKET_SIZE = 1472;
+
     OscSender() = default;
     ~OscSender() { close(); }
 
@@ -29,8 +36,9 @@ public:
         return socket_.connect(host, port);
     }
 
-    // Close
+    // Close (pending bundled messages are sent first)
     void close() {
+        setBundling(false);
         socket_.close();
         host_.clear();
         port_ = 0;
@@ -40,16 +48,100 @@ public:
     // Send
     // -------------------------------------------------------------------------
 
-    // Send message
+    // Send message (queued when bundling is enabled)
     bool send(const OscMessage& msg) {
-        auto bytes = msg.toBytes();
-        return socket_.send(bytes.data(), bytes.size());
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (bundling_) {
+            enqueue(msg);
+            return true;
+        }
+        sendBuffer_.clear();
+        msg.appendBytes(sendBuffer_);
+        return socket_.send(sendBuffer_.data(), sendBuffer_.size());
     }
 
-    // Send bundle
+    // Send bundle (always sent immediately)
     bool send(const OscBundle& bundle) {
-        auto bytes = bundle.toBytes();
-        return socket_.send(bytes.data(), bytes.size());
+        std::lock_guard<std::mutex> lock(mutex_);
+        sendBuffer_.clear();
+        bundle.appendBytes(sendBuffer_);
+        return socket_.send(sendBuffer_.data(), sendBuffer_.size());
+    }
+
+    // -------------------------------------------------------------------------
+    // Bundling mode
+    // -------------------------------------------------------------------------
+    // Messages passed to send() are collected and packed into MTU-sized
+    // bundles. Repeated addresses are coalesced (last value wins).
+    // Pending messages are flushed after draw (so messages sent from draw()
+    // go out the same frame) and when update starts (headless apps have no
+    // draw), or at the rate given by setFlushRate(). flush() can also be
+    // called manually. Turning bundling off sends what is pending.
+    // The settings below may be changed while other threads send.
+
+    void setBundling(bool enabled, size_t maxPacketSize = DEFAULT_MAX_PACKET_SIZE) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            maxPacketSize_ = maxPacketSize;
+            if (enabled == bundling_) return;
+            bundling_ = enabled;
+            if (!enabled) {
+                if (socket_.isValid()) flushLocked();
+                pending_.clear();
+                pendingIndex_.clear();
+            }
+        }
+        if (enabled) {
+            flushListener_ = events().afterDraw.listen([this]() {
+                autoFlush();
+            }, EventPriority::AfterApp);
+            updateFlushListener_ = events().update.listen([this]() {
+                autoFlush();
+            });
+        }
+        else {
+            flushListener_.disconnect();
+            updateFlushListener_.disconnect();
+        }
+    }
+
+    bool isBundling() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return bundling_;
+    }
+
+    // Coalesce repeated addresses within a flush interval (default: true)
+    void setCoalesce(bool enabled) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        coalesce_ = enabled;
+    }
+    bool isCoalesce() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return coalesce_;
+    }
+
+    // Automatic flush rate in Hz (0 = every frame)
+    void setFlushRate(double hz) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flushInterval_ = (hz > 0.0) ? 1.0 / hz : 0.0;
+    }
+
+    // Bundle timetag latency in seconds (0 = execute immediately)
+    void setBundleLatency(double seconds) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        latency_ = seconds;
+    }
+
+    // Send all pending messages now. Returns false if any packet failed
+    bool flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return flushLocked();
+    }
+
+    // Number of messages waiting for flush
+    size_t getPendingCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_.size();
     }
 
     // -------------------------------------------------------------------------
@@ -61,9 +153,97 @@ public:
     bool isConnected() const { return socket_.isValid(); }
 
 private:
+    // Caller holds mutex_
+    bool flushLocked() {
+        lastFlush_ = std::chrono::steady_clock::now();
+        if (pending_.empty()) return true;
+
+        uint64_t timetag = (latency_ > 0.0) ? OscBundle::makeTimetag(latency_)
+                                            : OscBundle::TIMETAG_IMMEDIATELY;
+        constexpr size_t HEADER_SIZE = 16;  // "#bundle\0" + timetag
+        bool ok = true;
+
+        sendBuffer_.clear();
+        for (const auto& msg : pending_) {
+            size_t msgSize = msg.getByteSize();
+
+            // Oversized message: send the bundle so far first (keeps order),
+            // then the message on its own
+            if (HEADER_SIZE + 4 + msgSize > maxPacketSize_) {
+                if (!sendBuffer_.empty()) {
+                    ok &= socket_.send(sendBuffer_.data(), sendBuffer_.size());
+                    sendBuffer_.clear();
+                }
+                scratch_.clear();
+                msg.appendBytes(scratch_);
+                ok &= socket_.send(scratch_.data(), scratch_.size());
+                continue;
+            }
+
+            // Current bundle full: send and start a new one
+            if (!sendBuffer_.empty() && sendBuffer_.size() + 4 + msgSize > maxPacketSize_) {
+                ok &= socket_.send(sendBuffer_.data(), sendBuffer_.size());
+                sendBuffer_.clear();
+            }
+            if (sendBuffer_.empty()) {
+                OscBundle::appendHeader(sendBuffer_, timetag);
+            }
+
+            uint32_t sizeBe = osc_internal::toBigEndian(static_cast<uint32_t>(msgSize));
+            auto* sp = reinterpret_cast<const uint8_t*>(&sizeBe);
+            sendBuffer_.insert(sendBuffer_.end(), sp, sp + 4);
+            msg.appendBytes(sendBuffer_);
+        }
+        if (!sendBuffer_.empty()) {
+            ok &= socket_.send(sendBuffer_.data(), sendBuffer_.size());
+        }
+
+        pending_.clear();
+        pendingIndex_.clear();
+        return ok;
+    }
+
+    // Caller holds mutex_
+    void enqueue(const OscMessage& msg) {
+        if (coalesce_) {
+            auto [it, inserted] = pendingIndex_.try_emplace(msg.getAddress(), pending_.size());
+            if (!inserted) {
+                pending_[it->second] = msg;  // Last value wins, original order kept
+                return;
+            }
+        }
+        pending_.push_back(msg);
+    }
+
+    void autoFlush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (flushInterval_ > 0.0) {
+            auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - lastFlush_).count();
+            if (elapsed < flushInterval_) return;
+        }
+        flushLocked();
+    }
+
     UdpSocket socket_;
     std::string host_;
     int port_ = 0;
+
+    // Bundling (guarded by mutex_)
+    bool bundling_ = false;
+    bool coalesce_ = true;
+    size_t maxPacketSize_ = DEFAULT_MAX_PACKET_SIZE;
+    double flushInterval_ = 0.0;
+    double latency_ = 0.0;
+    std::chrono::steady_clock::time_point lastFlush_ = std::chrono::steady_clock::now();
+    std::vector<OscMessage> pending_;
+    std::unordered_map<std::string, size_t> pendingIndex_;
+    EventListener flushListener_;
+    EventListener updateFlushListener_;
+
+    // Reusable serialization buffers
+    std::vector<uint8_t> sendBuffer_;
+    std::vector<uint8_t> scratch_;
+    mutable std::mutex mutex_;
 };
 
 }  // namespace trussc
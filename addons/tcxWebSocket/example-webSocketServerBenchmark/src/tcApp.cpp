@@ -0,0 +1,89 @@
+// =============================================================================
+// webSocketServerBenchmark - Loopback broadcast throughput
+// =============================================================================
+//
+// Starts a WebSocketServer and connects NUM_CLIENTS local WebSocketClients,
+// half of them with permessage-deflate. Every frame the server broadcasts
+// MESSAGES_PER_FRAME JSON messages; each broadcast is encoded (and
+// compressed) once and shared across all client queues.
+// Delivered messages/sec, queued bytes and dropped messages are logged
+// once per second.
+//
+// Usage:
+//   - Press Ctrl+C to exit
+//
+// =============================================================================
+
+#include "tcApp.h"
+
+void tcApp::setup() {
+    logNotice("benchmark") << "=== WebSocketServer Benchmark ===";
+
+    server_.setMaxQueuedBytes(8 * 1024 * 1024);
+    server_.setCompression(true);
+    connectListener_ = server_.onClientConnect.listen([this](WebSocketServerConnectEventArgs& e) {
+        if (e.compression) deflateClients_++;
+    });
+    if (!server_.start(PORT)) {
+        logError("benchmark") << "Failed to start server on port " << PORT;
+        requestExit();
+        return;
+    }
+
+    for (int i = 0; i < NUM_CLIENTS; i++) {
+        auto client = make_unique<WebSocketClient>();
+        client->setCompression(i % 2 == 0);
+        listeners_.push_back(client->onMessage.listen([this](WebSocketEventArgs&) {
+            received_++;
+        }));
+        client->connect("ws://127.0.0.1:" + to_string(PORT) + "/");
+        clients_.push_back(std::move(client));
+    }
+
+    payload_ = "[";
+    for (int i = 0; i < POINTS_PER_MESSAGE; i++) {
+        if (i > 0) payload_ += ",";
+        payload_ += "{\"id\":" + to_string(i) + ",\"x\":0.125,\"y\":0.5,\"label\":\"benchmark\"}";
+    }
+    payload_ += "]";
+    lastReport_ = headless::getElapsedTime();
+}
+
+void tcApp::update() {
+    if (server_.getClientCount() < NUM_CLIENTS) return;
+    if (sent_ == 0) {
+        logNotice("benchmark") << NUM_CLIENTS << " clients, " << deflateClients_ << " with permessage-deflate, "
+                               << payload_.size() << " byte messages";
+    }
+
+    for (int i = 0; i < MESSAGES_PER_FRAME; i++) {
+        server_.broadcast(payload_);
+    }
+    sent_ += MESSAGES_PER_FRAME;
+
+    double now = headless::getElapsedTime();
+    if (now - lastReport_ >= 1.0) {
+        uint64_t received = received_;
+        double rate = (received - lastReceived_) / (now - lastReport_);
+
+        size_t queued = 0;
+        for (int id : server_.getClientIds()) {
+            queued += server_.getQueuedBytes(id);
+        }
+
+        logNotice("benchmark") << "broadcasts: " << sent_
+                               << " | delivered: " << (uint64_t)rate << " msg/s"
+                               << " | queued: " << queued / 1024 << " KB"
+                               << " | dropped: " << server_.getDroppedMessageCount();
+
+        lastReceived_ = received;
+        lastReport_ = now;
+    }
+}
+
+void tcApp::cleanup() {
+    listeners_.clear();
+    clients_.clear();
+    server_.stop();
+    logNotice("benchmark") << "=== Done ===";
+}
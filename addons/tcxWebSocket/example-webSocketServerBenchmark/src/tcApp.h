@@ -0,0 +1,33 @@
+#pragma once
+
+#include <TrussC.h>
+#include "tcWebSocketServer.h"
+#include "tcWebSocketClient.h"
+
+using namespace std;
+using namespace tc;
+
+class tcApp : public App {
+public:
+    void setup() override;
+    void update() override;
+    void cleanup() override;
+
+private:
+    static constexpr int PORT = 9002;
+    static constexpr int NUM_CLIENTS = 8;
+    static constexpr int MESSAGES_PER_FRAME = 500;
+    static constexpr int POINTS_PER_MESSAGE = 16;   // ~700 bytes, above the compression threshold
+
+    WebSocketServer server_;
+    vector<unique_ptr<WebSocketClient>> clients_;
+    vector<EventListener> listeners_;
+    EventListener connectListener_;
+    std::atomic<int> deflateClients_{0};
+
+    std::atomic<uint64_t> received_{0};
+    uint64_t sent_ = 0;
+    uint64_t lastReceived_ = 0;
+    double lastReport_ = 0.0;
+    string payload_;
+};
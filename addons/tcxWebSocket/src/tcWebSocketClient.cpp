@@ -3,10 +3,16 @@
 #include <algorithm>
 #include <random>
 #include <cstring>
+#include <cstdlib>
 
 using namespace std;
 using namespace tc;
 
+#ifndef __EMSCRIPTEN__
+// Built-in zlib of stb (compiled in TrussC's stb_impl.cpp)
+extern "C" char* stbi_zlib_decode_noheader_malloc(const char* buffer, int len, int* outlen);
+#endif
+
 namespace trussc {
 
 // =============================================================================
@@ -69,6 +75,11 @@ namespace sha1 {
     }
 }
 
+std::string ws_internal::computeAcceptKey(const std::string& key) {
+    auto digest = sha1::calculate(key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11");
+    return toBase64(digest);
+}
+
 // =============================================================================
 // WebSocketClient Implementation
 // =============================================================================
@@ -147,7 +158,9 @@ void WebSocketClient::disconnect() {
     }
 #endif
     state_ = State::Disconnected;
-    receiveBuffer_.clear();
+    deflate_ = false;
+    handshakeBuffer_.clear();
+    parser_.clear();
 }
 
 void WebSocketClient::setupClient(bool useTls) {
@@ -193,8 +206,13 @@ void WebSocketClient::sendHandshake() {
 #ifndef __EMSCRIPTEN__
     // Generate Sec-WebSocket-Key
     unsigned char randomBytes[16];
-    std::random_device rd;
-    for (int i = 0; i < 16; ++i) randomBytes[i] = rd() & 0xFF;
+    {
+        std::lock_guard<std::mutex> lock(sendMutex_);
+        for (int i = 0; i < 16; i += 4) {
+            uint32_t r = entropy_();
+            std::memcpy(randomBytes + i, &r, 4);
+        }
+    }
     handshakeNonce_ = toBase64(randomBytes, 16);
 
     std::string handshake = 
@@ -203,8 +221,13 @@ void WebSocketClient::sendHandshake() {
         "Upgrade: websocket\r\n"
         "Connection: Upgrade\r\n"
         "Sec-WebSocket-Key: " + handshakeNonce_ + "\r\n"
-        "Sec-WebSocket-Version: 13\r\n"
-        "\r\n";
+        "Sec-WebSocket-Version: 13\r\n";
+    if (compression_) {
+        // Each message is inflated on its own, so no context takeover
+        handshake += "Sec-WebSocket-Extensions: permessage-deflate; "
+                     "server_no_context_takeover; client_no_context_takeover\r\n";
+    }
+    handshake += "\r\n";
 
     client_->send(handshake);
 #endif
@@ -212,19 +235,22 @@ void WebSocketClient::sendHandshake() {
 
 void WebSocketClient::handleRawReceive(TcpReceiveEventArgs& args) {
 #ifndef __EMSCRIPTEN__
-    receiveBuffer_.insert(receiveBuffer_.end(), args.data.begin(), args.data.end());
-
     if (state_ == State::Connecting) {
+        handshakeBuffer_.append(args.data.data(), args.data.size());
+
         // Look for end of HTTP header
-        std::string bufferStr(receiveBuffer_.begin(), receiveBuffer_.end());
-        size_t headerEnd = bufferStr.find("\r\n\r\n");
+        size_t headerEnd = handshakeBuffer_.find("\r\n\r\n");
         if (headerEnd != std::string::npos) {
-            std::string header = bufferStr.substr(0, headerEnd);
-            receiveBuffer_.erase(receiveBuffer_.begin(), receiveBuffer_.begin() + headerEnd + 4);
+            std::string header = handshakeBuffer_.substr(0, headerEnd);
+            // Anything after the header is already frame data
+            parser_.append(handshakeBuffer_.data() + headerEnd + 4,
+                           handshakeBuffer_.size() - headerEnd - 4);
+            handshakeBuffer_.clear();
             processHandshake(header);
         }
     } else if (state_ == State::Open) {
-        processFrame();
+        parser_.append(args.data.data(), args.data.size());
+        processFrames();
     }
 #endif
 }
@@ -232,12 +258,20 @@ void WebSocketClient::handleRawReceive(TcpReceiveEventArgs& args) {
 void WebSocketClient::processHandshake(const std::string& header) {
 #ifndef __EMSCRIPTEN__
     if (header.find("101 Switching Protocols") != std::string::npos) {
+        std::string extensions = ws_internal::findHeader(header, "Sec-WebSocket-Extensions");
+        deflate_ = extensions.find("permessage-deflate") != std::string::npos;
+        if (deflate_ && !compression_) {
+            logError() << "WebSocket handshake failed: server enabled an extension that was not offered";
+            disconnect();
+            return;
+        }
+        parser_.setAllowCompression(deflate_);
         state_ = State::Open;
         onOpen.notify();
-        
-        // If there's more data in buffer, process it as a frame
-        if (!receiveBuffer_.empty()) {
-            processFrame();
+
+        // If there's more data in buffer, process it as frames
+        if (parser_.getBufferedSize() > 0) {
+            processFrames();
         }
     } else {
         logError() << "WebSocket handshake failed:\n" << header;
@@ -246,72 +280,65 @@ void WebSocketClient::processHandshake(const std::string& header) {
 #endif
 }
 
-void WebSocketClient::processFrame() {
+void WebSocketClient::processFrames() {
 #ifndef __EMSCRIPTEN__
-    while (receiveBuffer_.size() >= 2) {
-        unsigned char b1 = (unsigned char)receiveBuffer_[0];
-        unsigned char b2 = (unsigned char)receiveBuffer_[1];
-
-        bool fin = (b1 & 0x80) != 0;
-        int opcode = b1 & 0x0F;
-        bool masked = (b2 & 0x80) != 0;
-        uint64_t payloadLen = b2 & 0x7F;
-
-        size_t headerSize = 2;
-        if (payloadLen == 126) {
-            if (receiveBuffer_.size() < 4) return;
-            payloadLen = ((unsigned char)receiveBuffer_[2] << 8) | (unsigned char)receiveBuffer_[3];
-            headerSize = 4;
-        } else if (payloadLen == 127) {
-            if (receiveBuffer_.size() < 10) return;
-            payloadLen = 0;
-            for (int i = 0; i < 8; ++i) {
-                payloadLen = (payloadLen << 8) | (unsigned char)receiveBuffer_[2 + i];
-            }
-            headerSize = 10;
-        }
-
-        uint8_t maskingKey[4] = {0, 0, 0, 0};
-        if (masked) {
-            if (receiveBuffer_.size() < headerSize + 4) return;
-            memcpy(maskingKey, &receiveBuffer_[headerSize], 4);
-            headerSize += 4;
-        }
-
-        if (receiveBuffer_.size() < headerSize + payloadLen) return;
-
-        std::vector<char> payload(payloadLen);
-        if (payloadLen > 0) {
-            memcpy(payload.data(), &receiveBuffer_[headerSize], payloadLen);
-            if (masked) {
-                for (size_t i = 0; i < payloadLen; ++i) {
-                    payload[i] ^= maskingKey[i % 4];
+    bool ok = parser_.parse([this](const WebSocketFrameParser::Frame& frame) {
+        switch (frame.opcode) {
+            case WebSocketOpcode::Text:
+            case WebSocketOpcode::Binary: {
+                const char* payload = frame.payload;
+                size_t size = frame.size;
+                char* inflated = nullptr;
+                if (frame.compressed) {
+                    // Append the empty stored block trailer removed by the sender (RFC 7692 7.2.2)
+                    inflateBuffer_.assign(frame.payload, frame.payload + frame.size);
+                    const char trailer[4] = {0x00, 0x00, static_cast<char>(0xFF), static_cast<char>(0xFF)};
+                    inflateBuffer_.insert(inflateBuffer_.end(), trailer, trailer + 4);
+                    int outLen = 0;
+                    inflated = stbi_zlib_decode_noheader_malloc(inflateBuffer_.data(),
+                                                                static_cast<int>(inflateBuffer_.size()), &outLen);
+                    if (!inflated || static_cast<size_t>(outLen) > WebSocketFrameParser::DEFAULT_MAX_MESSAGE_SIZE) {
+                        std::free(inflated);
+                        TcpErrorEventArgs err;
+                        err.message = "WebSocket: failed to inflate message";
+                        onError.notify(err);
+                        disconnect();
+                        return;
+                    }
+                    payload = inflated;
+                    size = static_cast<size_t>(outLen);
                 }
-            }
-        }
 
-        // Remove processed frame from buffer
-        receiveBuffer_.erase(receiveBuffer_.begin(), receiveBuffer_.begin() + headerSize + payloadLen);
-
-        // Handle Opcode
-        if (opcode == 0x1 || opcode == 0x2) { // Text or Binary
-            WebSocketEventArgs args;
-            args.isBinary = (opcode == 0x2);
-            args.data = payload;
-            if (!args.isBinary) {
-                args.message.assign(payload.begin(), payload.end());
+                // Reuse args buffers (no allocation once capacity is reached)
+                messageArgs_.isBinary = (frame.opcode == WebSocketOpcode::Binary);
+                messageArgs_.data.assign(payload, payload + size);
+                if (messageArgs_.isBinary) {
+                    messageArgs_.message.clear();
+                } else {
+                    messageArgs_.message.assign(payload, size);
+                }
+                std::free(inflated);
+                onMessage.notify(messageArgs_);
+                break;
             }
-            onMessage.notify(args);
-        } else if (opcode == 0x8) { // Close
-            disconnect();
-        } else if (opcode == 0x9) { // Ping
-            // Send Pong (not implemented yet)
+            case WebSocketOpcode::Ping:
+                sendFrame(WebSocketOpcode::Pong, frame.payload, frame.size);
+                break;
+            case WebSocketOpcode::Close:
+                // Echo close (status code only) before closing the socket
+                sendFrame(WebSocketOpcode::Close, frame.payload, frame.size >= 2 ? 2 : 0);
+                disconnect();
+                break;
+            default:
+                break;  // Pong: nothing to do
         }
+    });
 
-        if (!fin) {
-            // Continuation frame handling needed for full implementation
-            logWarning() << "WebSocket: Continuation frames not yet fully supported";
-        }
+    if (!ok) {
+        TcpErrorEventArgs err;
+        err.message = "WebSocket protocol error";
+        onError.notify(err);
+        disconnect();
     }
 #endif
 }
@@ -322,48 +349,53 @@ bool WebSocketClient::send(const std::string& message) {
     EMSCRIPTEN_RESULT res = emscripten_websocket_send_utf8_text(wsHandle_, message.c_str());
     return (res == EMSCRIPTEN_RESULT_SUCCESS);
 #else
-    return send(std::vector<char>(message.begin(), message.end()));
+    if (state_ != State::Open) return false;
+    return sendFrame(WebSocketOpcode::Text, message.data(), message.size());
 #endif
 }
 
 bool WebSocketClient::send(const std::vector<char>& data) {
+    return sendBinary(data.data(), data.size());
+}
+
+bool WebSocketClient::sendBinary(const void* data, size_t size) {
     if (state_ != State::Open) return false;
 
 #ifdef __EMSCRIPTEN__
     if (wsHandle_ <= 0) return false;
-    EMSCRIPTEN_RESULT res = emscripten_websocket_send_binary(wsHandle_, (void*)data.data(), data.size());
+    EMSCRIPTEN_RESULT res = emscripten_websocket_send_binary(wsHandle_, const_cast<void*>(data), size);
     return (res == EMSCRIPTEN_RESULT_SUCCESS);
 #else
-    std::vector<unsigned char> frame;
-    // FIN=1, Opcode=1 (Text) or 2 (Binary)
-    // We'll use 0x81 (FIN + Text) for now as common case
-    frame.push_back(0x81); 
-
-    size_t len = data.size();
-    if (len < 126) {
-        frame.push_back(0x80 | (unsigned char)len);
-    } else if (len < 65536) {
-        frame.push_back(0x80 | 126);
-        frame.push_back((len >> 8) & 0xFF);
-        frame.push_back(len & 0xFF);
-    } else {
-        frame.push_back(0x80 | 127);
-        for (int i = 7; i >= 0; --i) {
-            frame.push_back((len >> (i * 8)) & 0xFF);
-        }
-    }
+    return sendFrame(WebSocketOpcode::Binary, data, size);
+#endif
+}
 
-    // Client must mask payload
-    unsigned char mask[4];
-    std::random_device rd;
-    for (int i = 0; i < 4; ++i) mask[i] = rd() & 0xFF;
-    frame.insert(frame.end(), mask, mask + 4);
+bool WebSocketClient::sendPing(const std::string& payload) {
+#ifdef __EMSCRIPTEN__
+    return false;  // Browser handles ping/pong
+#else
+    if (state_ != State::Open || payload.size() > 125) return false;
+    return sendFrame(WebSocketOpcode::Ping, payload.data(), payload.size());
+#endif
+}
 
-    for (size_t i = 0; i < len; ++i) {
-        frame.push_back((unsigned char)data[i] ^ mask[i % 4]);
-    }
+bool WebSocketClient::sendFrame(WebSocketOpcode opcode, const void* data, size_t size) {
+#ifndef __EMSCRIPTEN__
+    if (!client_) return false;
+
+    // Called from main thread (send) and receive thread (pong/close)
+    std::lock_guard<std::mutex> lock(sendMutex_);
 
-    return client_->send(frame.data(), frame.size());
+    // Client must mask payload
+    uint32_t mask32 = static_cast<uint32_t>(entropy_());
+    uint8_t mask[4];
+    std::memcpy(mask, &mask32, 4);
+
+    sendBuffer_.clear();
+    ws_internal::encodeFrame(sendBuffer_, opcode, data, size, mask);
+    return client_->send(sendBuffer_.data(), sendBuffer_.size());
+#else
+    return false;
 #endif
 }
 
@@ -4,9 +4,12 @@
 #ifndef __EMSCRIPTEN__
 #include "tcTlsClient.h"
 #endif
+#include "tcWebSocketFrame.h"
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <random>
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten/websocket.h>
@@ -21,8 +24,8 @@ namespace trussc {
 // WebSocket Event Args
 // =============================================================================
 struct WebSocketEventArgs {
-    std::string message;
-    std::vector<char> data;
+    std::string message;        // Text payload (text messages only)
+    std::vector<char> data;     // Raw payload (text and binary)
     bool isBinary = false;
 };
 
@@ -58,8 +61,18 @@ public:
     bool connect(const std::string& url);
     void disconnect();
 
+    // Text message
     bool send(const std::string& message);
+    // Binary message
     bool send(const std::vector<char>& data);
+    bool sendBinary(const void* data, size_t size);
+
+    bool sendPing(const std::string& payload = "");
+
+    // Offer permessage-deflate (call before connect()). Compressed messages
+    // from the server are inflated; outgoing messages are sent as is.
+    void setCompression(bool enabled) { compression_ = enabled; }
+    bool isCompressed() const { return deflate_; }    // Negotiated
 
     State getState() const { return state_; }
     bool isConnected() const { return state_ == State::Open; }
@@ -72,7 +85,8 @@ private:
 
     void sendHandshake();
     void processHandshake(const std::string& header);
-    void processFrame();
+    void processFrames();
+    bool sendFrame(WebSocketOpcode opcode, const void* data, size_t size);
 
     std::unique_ptr<TcpClient> client_;
     EventListener receiveListener_;
@@ -85,8 +99,18 @@ private:
     int port_ = 80;
     bool useTls_ = false;
 
-    std::vector<char> receiveBuffer_;
+    std::string handshakeBuffer_;
     std::string handshakeNonce_;
+    bool compression_ = false;
+    bool deflate_ = false;
+    std::vector<char> inflateBuffer_;
+
+    // Frame I/O (buffers are reused across frames)
+    WebSocketFrameParser parser_;
+    WebSocketEventArgs messageArgs_;
+    std::vector<char> sendBuffer_;
+    std::mutex sendMutex_;
+    std::random_device entropy_;    // Masks and handshake key (RFC 6455 10.3), under sendMutex_
 
 #ifdef __EMSCRIPTEN__
     EMSCRIPTEN_WEBSOCKET_T wsHandle_ = 0;
@@ -0,0 +1,314 @@
+#pragma once
+
+// =============================================================================
+// tcWebSocketFrame - RFC 6455 frame codec shared by client and server
+// =============================================================================
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace trussc {
+
+enum class WebSocketOpcode : uint8_t {
+    Continuation = 0x0,
+    Text = 0x1,
+    Binary = 0x2,
+    Close = 0x8,
+    Ping = 0x9,
+    Pong = 0xA
+};
+
+namespace ws_internal {
+
+// Sec-WebSocket-Accept value for a Sec-WebSocket-Key
+// (SHA-1 + base64, defined in tcWebSocketClient.cpp)
+std::string computeAcceptKey(const std::string& key);
+
+// Case-insensitive header lookup in an HTTP request or response
+inline std::string findHeader(const std::string& header, const std::string& name) {
+    size_t pos = header.find("\r\n");
+    while (pos != std::string::npos) {
+        size_t lineStart = pos + 2;
+        size_t lineEnd = header.find("\r\n", lineStart);
+        std::string line = header.substr(lineStart, lineEnd == std::string::npos ? std::string::npos : lineEnd - lineStart);
+        size_t colon = line.find(':');
+        if (colon == name.size() &&
+            std::equal(name.begin(), name.end(), line.begin(), [](char a, char b) {
+                return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+            })) {
+            size_t valueStart = line.find_first_not_of(" \t", colon + 1);
+            if (valueStart == std::string::npos) return "";
+            size_t valueEnd = line.find_last_not_of(" \t");
+            return line.substr(valueStart, valueEnd - valueStart + 1);
+        }
+        pos = lineEnd;
+    }
+    return "";
+}
+
+// XOR payload with 4-byte masking key, 8 bytes at a time.
+// offset = position of data[0] within the frame payload (for split buffers)
+inline void applyMask(char* data, size_t size, const uint8_t key[4], size_t offset = 0) {
+    uint8_t k[4] = {key[offset & 3], key[(offset + 1) & 3], key[(offset + 2) & 3], key[(offset + 3) & 3]};
+    uint32_t k32;
+    std::memcpy(&k32, k, 4);
+    uint64_t k64 = (uint64_t(k32) << 32) | k32;
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, data + i, 8);
+        w ^= k64;
+        std::memcpy(data + i, &w, 8);
+    }
+    for (; i < size; ++i) {
+        data[i] ^= static_cast<char>(k[i & 3]);
+    }
+}
+
+// Header size for a payload of given length
+inline size_t frameHeaderSize(size_t payloadSize, bool masked) {
+    size_t size = 2;
+    if (payloadSize >= 65536) size += 8;
+    else if (payloadSize >= 126) size += 2;
+    if (masked) size += 4;
+    return size;
+}
+
+// Append one frame (header + payload) to out.
+// maskKey == nullptr sends unmasked (server -> client).
+// rsv1 marks a compressed payload (permessage-deflate).
+inline void encodeFrame(std::vector<char>& out, WebSocketOpcode opcode,
+                        const void* data, size_t size,
+                        const uint8_t* maskKey = nullptr, bool fin = true, bool rsv1 = false) {
+    size_t start = out.size();
+    size_t headerSize = frameHeaderSize(size, maskKey != nullptr);
+    out.resize(start + headerSize + size);
+    uint8_t* p = reinterpret_cast<uint8_t*>(out.data() + start);
+
+    p[0] = static_cast<uint8_t>((fin ? 0x80 : 0x00) | (rsv1 ? 0x40 : 0x00) | static_cast<uint8_t>(opcode));
+    uint8_t maskBit = maskKey ? 0x80 : 0x00;
+    size_t pos = 2;
+    if (size < 126) {
+        p[1] = maskBit | static_cast<uint8_t>(size);
+    }
+    else if (size < 65536) {
+        p[1] = maskBit | 126;
+        p[2] = static_cast<uint8_t>(size >> 8);
+        p[3] = static_cast<uint8_t>(size);
+        pos = 4;
+    }
+    else {
+        p[1] = maskBit | 127;
+        for (int i = 0; i < 8; ++i) {
+            p[2 + i] = static_cast<uint8_t>(uint64_t(size) >> ((7 - i) * 8));
+        }
+        pos = 10;
+    }
+    if (maskKey) {
+        std::memcpy(p + pos, maskKey, 4);
+        pos += 4;
+    }
+
+    if (size > 0) {
+        std::memcpy(p + pos, data, size);
+        if (maskKey) applyMask(out.data() + start + pos, size, maskKey);
+    }
+}
+
+} // namespace ws_internal
+
+// =============================================================================
+// WebSocketFrameParser - Streaming frame parser
+//
+// Bytes are appended as they arrive; parse() consumes every complete frame
+// by advancing a read offset (no per-frame erase), unmasks payloads in place
+// and reassembles fragmented messages. Consumed bytes are compacted away
+// only when they make up at least half of the buffer.
+// =============================================================================
+class WebSocketFrameParser {
+public:
+    static constexpr size_t DEFAULT_MAX_MESSAGE_SIZE = 64 * 1024 * 1024;
+
+    // Frame / message delivered to parse() callback.
+    // payload points into the parser and is valid only during the callback.
+    struct Frame {
+        WebSocketOpcode opcode = WebSocketOpcode::Binary;
+        const char* payload = nullptr;
+        size_t size = 0;
+        bool compressed = false;    // RSV1 set on first frame (permessage-deflate)
+    };
+
+    void append(const char* data, size_t size) {
+        if (readPos_ > 0 && readPos_ * 2 >= buffer_.size()) {
+            buffer_.erase(buffer_.begin(), buffer_.begin() + readPos_);
+            readPos_ = 0;
+        }
+        buffer_.insert(buffer_.end(), data, data + size);
+    }
+
+    // Drop all buffered data. Safe to call from inside a parse() callback
+    // (e.g. the connection was closed): parse() stops after that callback.
+    void clear() {
+        buffer_.clear();
+        readPos_ = 0;
+        fragment_.clear();
+        fragmenting_ = false;
+        error_ = false;
+        ++generation_;
+    }
+
+    // Server side: reject unmasked client frames (RFC 6455 5.1)
+    void setRequireMask(bool require) { requireMask_ = require; }
+
+    // Accept RSV1 (compressed) data frames; only when permessage-deflate
+    // was negotiated. Other RSV bits always fail the connection.
+    void setAllowCompression(bool allow) { allowCompression_ = allow; }
+
+    void setMaxMessageSize(size_t size) { maxMessageSize_ = size; }
+
+    size_t getBufferedSize() const { return buffer_.size() - readPos_; }
+    bool hasError() const { return error_; }
+
+    // Parse all complete frames. fn(const Frame&) receives each complete
+    // data message (after reassembly) and each control frame.
+    // Returns false on protocol error (connection should be closed).
+    template<typename Fn>
+    bool parse(Fn&& fn) {
+        if (error_) return false;
+        const uint32_t generation = generation_;
+
+        while (true) {
+            size_t avail = buffer_.size() - readPos_;
+            if (avail < 2) break;
+
+            char* base = buffer_.data() + readPos_;
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(base);
+
+            bool fin = (p[0] & 0x80) != 0;
+            bool rsv1 = (p[0] & 0x40) != 0;
+            uint8_t opcode = p[0] & 0x0F;
+            bool masked = (p[1] & 0x80) != 0;
+            uint64_t payloadLen = p[1] & 0x7F;
+
+            // RSV1 only on the first frame of a data message (RFC 7692 6)
+            if (p[0] & 0x30) return fail();
+            if (rsv1 && (!allowCompression_ || opcode == 0x0 || opcode >= 0x8)) return fail();
+
+            size_t headerSize = 2;
+            if (payloadLen == 126) {
+                if (avail < 4) break;
+                payloadLen = (uint64_t(p[2]) << 8) | p[3];
+                headerSize = 4;
+            }
+            else if (payloadLen == 127) {
+                if (avail < 10) break;
+                payloadLen = 0;
+                for (int i = 0; i < 8; ++i) {
+                    payloadLen = (payloadLen << 8) | p[2 + i];
+                }
+                headerSize = 10;
+            }
+
+            if (requireMask_ && !masked) return fail();
+            if (payloadLen > maxMessageSize_) return fail();
+
+            uint8_t maskingKey[4] = {0, 0, 0, 0};
+            if (masked) {
+                if (avail < headerSize + 4) break;
+                std::memcpy(maskingKey, p + headerSize, 4);
+                headerSize += 4;
+            }
+
+            if (avail < headerSize + payloadLen) break;
+
+            char* payload = base + headerSize;
+            size_t size = static_cast<size_t>(payloadLen);
+            if (masked && size > 0) {
+                ws_internal::applyMask(payload, size, maskingKey);
+            }
+            readPos_ += headerSize + size;
+
+            Frame frame;
+            if (opcode >= 0x8) {
+                // Control frames: never fragmented, payload <= 125
+                if (!fin || size > 125) return fail();
+                if (opcode != 0x8 && opcode != 0x9 && opcode != 0xA) return fail();
+                frame.opcode = static_cast<WebSocketOpcode>(opcode);
+                frame.payload = payload;
+                frame.size = size;
+                fn(static_cast<const Frame&>(frame));
+            }
+            else if (opcode == 0x1 || opcode == 0x2) {
+                if (fragmenting_) return fail();
+                if (fin) {
+                    // Unfragmented: deliver straight from the receive buffer
+                    frame.opcode = static_cast<WebSocketOpcode>(opcode);
+                    frame.payload = payload;
+                    frame.size = size;
+                    frame.compressed = rsv1;
+                    fn(static_cast<const Frame&>(frame));
+                }
+                else {
+                    fragmenting_ = true;
+                    fragmentOpcode_ = static_cast<WebSocketOpcode>(opcode);
+                    fragmentCompressed_ = rsv1;
+                    fragment_.assign(payload, payload + size);
+                }
+            }
+            else if (opcode == 0x0) {
+                if (!fragmenting_) return fail();
+                if (fragment_.size() + size > maxMessageSize_) return fail();
+                fragment_.insert(fragment_.end(), payload, payload + size);
+                if (fin) {
+                    frame.opcode = fragmentOpcode_;
+                    frame.payload = fragment_.data();
+                    frame.size = fragment_.size();
+                    frame.compressed = fragmentCompressed_;
+                    fn(static_cast<const Frame&>(frame));
+                    fragment_.clear();
+                    fragmenting_ = false;
+                }
+            }
+            else {
+                return fail();  // Reserved opcode
+            }
+
+            if (error_) return false;                   // fail from inside callback
+            if (generation_ != generation) return true; // clear() from inside callback
+        }
+
+        if (readPos_ == buffer_.size()) {
+            buffer_.clear();
+            readPos_ = 0;
+        }
+        return true;
+    }
+
+private:
+    bool fail() {
+        error_ = true;
+        return false;
+    }
+
+    std::vector<char> buffer_;
+    size_t readPos_ = 0;
+
+    // Fragment reassembly
+    std::vector<char> fragment_;
+    WebSocketOpcode fragmentOpcode_ = WebSocketOpcode::Binary;
+    bool fragmentCompressed_ = false;
+    bool fragmenting_ = false;
+
+    bool requireMask_ = false;
+    bool allowCompression_ = false;
+    bool error_ = false;
+    uint32_t generation_ = 0;   // Bumped by clear()
+    size_t maxMessageSize_ = DEFAULT_MAX_MESSAGE_SIZE;
+};
+
+} // namespace trussc
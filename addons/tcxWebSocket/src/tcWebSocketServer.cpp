@@ -0,0 +1,601 @@
+#include "tcWebSocketServer.h"
+#include <TrussC.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+#ifndef __EMSCRIPTEN__
+
+// Built-in zlib of stb (compiled in TrussC's stb_impl.cpp)
+extern "C" unsigned char* stbi_zlib_compress(unsigned char* data, int data_len, int* out_len, int quality);
+extern "C" char* stbi_zlib_decode_noheader_malloc(const char* buffer, int len, int* outlen);
+
+namespace trussc {
+
+namespace {
+
+// Upper bound of bytes gathered into one send() per client per pass
+constexpr size_t MAX_WRITE_BATCH = 256 * 1024;
+
+// Retry interval for clients whose socket buffer is full
+constexpr auto WRITE_RETRY_INTERVAL = std::chrono::milliseconds(2);
+
+// stb compression quality (5 = fastest)
+constexpr int DEFLATE_QUALITY = 5;
+
+std::string trim(const std::string& s) {
+    size_t b = s.find_first_not_of(" \t");
+    if (b == std::string::npos) return "";
+    return s.substr(b, s.find_last_not_of(" \t") - b + 1);
+}
+
+// Pick the first permessage-deflate offer we can honour (RFC 7692 7.1) and
+// build the response extension. Outgoing messages are independent DEFLATE
+// streams with stb's 32 KB window, so server_max_window_bits below 15
+// declines the offer; client_max_window_bits is echoed (any window inflates).
+bool negotiateDeflate(const std::string& header, std::string& response) {
+    size_t offerStart = 0;
+    while (offerStart <= header.size()) {
+        size_t offerEnd = header.find(',', offerStart);
+        if (offerEnd == std::string::npos) offerEnd = header.size();
+        std::string offer = header.substr(offerStart, offerEnd - offerStart);
+        offerStart = offerEnd + 1;
+
+        std::vector<std::string> params;
+        size_t pos = 0;
+        while (pos <= offer.size()) {
+            size_t end = offer.find(';', pos);
+            if (end == std::string::npos) end = offer.size();
+            params.push_back(trim(offer.substr(pos, end - pos)));
+            pos = end + 1;
+        }
+        if (params.empty() || params[0] != "permessage-deflate") continue;
+
+        bool ok = true;
+        std::string extra;
+        std::vector<std::string> seen;
+        for (size_t i = 1; i < params.size() && ok; i++) {
+            std::string name = params[i], value;
+            size_t eq = name.find('=');
+            if (eq != std::string::npos) {
+                value = trim(name.substr(eq + 1));
+                name = trim(name.substr(0, eq));
+                if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+                    value = value.substr(1, value.size() - 2);
+                }
+            }
+            if (std::find(seen.begin(), seen.end(), name) != seen.end()) {
+                ok = false;     // Duplicate parameter
+                break;
+            }
+            seen.push_back(name);
+
+            bool validBits = value.size() >= 1 && value.size() <= 2 &&
+                             std::all_of(value.begin(), value.end(), ::isdigit) &&
+                             std::stoi(value) >= 8 && std::stoi(value) <= 15;
+            if (name == "server_no_context_takeover" || name == "client_no_context_takeover") {
+                ok = value.empty();
+            }
+            else if (name == "server_max_window_bits") {
+                ok = validBits && std::stoi(value) == 15;
+                if (ok) extra += "; server_max_window_bits=15";
+            }
+            else if (name == "client_max_window_bits") {
+                ok = value.empty() || validBits;
+                if (ok && !value.empty()) extra += "; client_max_window_bits=" + value;
+            }
+            else {
+                ok = false;     // Unknown parameter
+            }
+        }
+        if (!ok) continue;
+
+        response = "permessage-deflate; server_no_context_takeover; client_no_context_takeover" + extra;
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// =============================================================================
+// Constructor / Destructor
+// =============================================================================
+WebSocketServer::WebSocketServer() {}
+
+WebSocketServer::~WebSocketServer() {
+    stop();
+}
+
+// =============================================================================
+// Management
+// =============================================================================
+bool WebSocketServer::start(int port, int maxClients) {
+    stop();
+
+    connectListener_ = tcp_.onClientConnect.listen(this, &WebSocketServer::handleConnect);
+    receiveListener_ = tcp_.onReceive.listen(this, &WebSocketServer::handleReceive);
+    disconnectListener_ = tcp_.onClientDisconnect.listen(this, &WebSocketServer::handleDisconnect);
+    errorListener_ = tcp_.onError.listen([this](TcpServerErrorEventArgs& args) {
+        onError.notify(args);
+    });
+
+    droppedMessages_ = 0;
+    running_ = true;
+    writerThread_ = std::thread(&WebSocketServer::writerThreadFunc, this);
+
+    if (!tcp_.start(port, maxClients)) {
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void WebSocketServer::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    writerCv_.notify_all();
+    if (writerThread_.joinable()) {
+        writerThread_.join();
+    }
+
+    if (tcp_.isRunning()) {
+        tcp_.stop();
+    }
+
+    connectListener_.disconnect();
+    receiveListener_.disconnect();
+    disconnectListener_.disconnect();
+    errorListener_.disconnect();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    clients_.clear();
+    deflateClients_ = 0;
+}
+
+// =============================================================================
+// Send
+// =============================================================================
+bool WebSocketServer::send(int clientId, const std::string& message) {
+    return queueTo(clientId, encode(WebSocketOpcode::Text, message.data(), message.size()));
+}
+
+bool WebSocketServer::sendBinary(int clientId, const void* data, size_t size) {
+    return queueTo(clientId, encode(WebSocketOpcode::Binary, data, size));
+}
+
+size_t WebSocketServer::broadcast(const std::string& message) {
+    return queueToAll(encode(WebSocketOpcode::Text, message.data(), message.size()));
+}
+
+size_t WebSocketServer::broadcastBinary(const void* data, size_t size) {
+    return queueToAll(encode(WebSocketOpcode::Binary, data, size));
+}
+
+void WebSocketServer::disconnectClient(int clientId) {
+    // Close frame with status 1000 (normal closure); socket closes after it is sent
+    const char status[2] = {static_cast<char>(0x03), static_cast<char>(0xE8)};
+    EncodedMessage msg = encode(WebSocketOpcode::Close, status, 2);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = clients_.find(clientId);
+    if (it == clients_.end()) return;
+    Client& client = *it->second;
+    if (client.open && !client.closing) {
+        enqueue(client, msg);
+    }
+    client.closing = true;
+    workPending_ = true;
+    writerCv_.notify_one();
+}
+
+WebSocketServer::EncodedMessage WebSocketServer::encode(WebSocketOpcode opcode, const void* data, size_t size) const {
+    EncodedMessage msg;
+
+    auto plain = std::make_shared<std::vector<char>>();
+    plain->reserve(ws_internal::frameHeaderSize(size, false) + size);
+    ws_internal::encodeFrame(*plain, opcode, data, size);
+    msg.plain = std::move(plain);
+
+    bool isData = (opcode == WebSocketOpcode::Text || opcode == WebSocketOpcode::Binary);
+    if (isData && compression_ && size >= compressionMinSize_ && deflateClients_ > 0) {
+        int zlen = 0;
+        unsigned char* z = stbi_zlib_compress(
+            const_cast<unsigned char*>(static_cast<const unsigned char*>(data)),
+            static_cast<int>(size), &zlen, DEFLATE_QUALITY);
+        // Strip zlib header (2) and adler32 (4) to get raw DEFLATE
+        if (z && zlen > 6 && static_cast<size_t>(zlen - 6) < size) {
+            auto compressed = std::make_shared<std::vector<char>>();
+            ws_internal::encodeFrame(*compressed, opcode, z + 2, zlen - 6, nullptr, true, true);
+            msg.compressed = std::move(compressed);
+        }
+        std::free(z);
+    }
+
+    return msg;
+}
+
+bool WebSocketServer::enqueue(Client& client, const EncodedMessage& msg) {
+    if (!client.open || client.closing) return false;
+
+    const Packet& packet = (client.deflate && msg.compressed) ? msg.compressed : msg.plain;
+
+    if (client.queuedBytes + packet->size() > maxQueuedBytes_) {
+        ++droppedMessages_;
+        if (overflowPolicy_ == OverflowPolicy::Disconnect) {
+            // Drop everything still queued and close the slow client
+            // (only the part of out being written stays accounted)
+            client.queue.clear();
+            client.queuedBytes = client.out ? client.out->size() - client.outOffset : 0;
+            client.closing = true;
+            workPending_ = true;
+        }
+        return false;
+    }
+
+    client.queue.push_back(packet);
+    client.queuedBytes += packet->size();
+    workPending_ = true;
+    return true;
+}
+
+bool WebSocketServer::isClosing(const Client& client) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return client.closing;
+}
+
+bool WebSocketServer::queueTo(int clientId, const EncodedMessage& msg) {
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = clients_.find(clientId);
+        if (it == clients_.end()) return false;
+        queued = enqueue(*it->second, msg);
+    }
+    writerCv_.notify_one();
+    return queued;
+}
+
+size_t WebSocketServer::queueToAll(const EncodedMessage& msg) {
+    size_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& pair : clients_) {
+            if (enqueue(*pair.second, msg)) ++count;
+        }
+    }
+    writerCv_.notify_one();
+    return count;
+}
+
+// =============================================================================
+// Clients
+// =============================================================================
+int WebSocketServer::getClientCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int count = 0;
+    for (const auto& pair : clients_) {
+        if (pair.second->open) ++count;
+    }
+    return count;
+}
+
+std::vector<int> WebSocketServer::getClientIds() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<int> ids;
+    for (const auto& pair : clients_) {
+        if (pair.second->open) ids.push_back(pair.first);
+    }
+    return ids;
+}
+
+size_t WebSocketServer::getQueuedBytes(int clientId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = clients_.find(clientId);
+    return (it != clients_.end()) ? it->second->queuedBytes : 0;
+}
+
+// =============================================================================
+// TcpServer events (network threads)
+// =============================================================================
+void WebSocketServer::handleConnect(TcpClientConnectEventArgs& args) {
+    auto client = std::make_shared<Client>();
+    client->id = args.clientId;
+    client->host = args.host;
+    client->port = args.port;
+    client->parser.setRequireMask(true);
+    client->parser.setMaxMessageSize(maxMessageSize_);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    clients_[args.clientId] = std::move(client);
+}
+
+void WebSocketServer::handleReceive(TcpServerReceiveEventArgs& args) {
+    std::shared_ptr<Client> client;
+    bool open = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = clients_.find(args.clientId);
+        if (it == clients_.end()) return;
+        client = it->second;
+        if (client->closing) return;
+        open = client->open;
+    }
+
+    if (!open) {
+        client->handshakeBuffer.append(args.data.data(), args.data.size());
+        processHandshake(*client);
+    }
+    else {
+        client->parser.append(args.data.data(), args.data.size());
+        processFrames(*client);
+    }
+}
+
+void WebSocketServer::handleDisconnect(TcpClientDisconnectEventArgs& args) {
+    bool wasOpen = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = clients_.find(args.clientId);
+        if (it == clients_.end()) return;
+        wasOpen = it->second->open;
+        if (it->second->deflate) --deflateClients_;
+        clients_.erase(it);
+    }
+
+    if (wasOpen) {
+        WebSocketServerDisconnectEventArgs e;
+        e.clientId = args.clientId;
+        e.reason = args.reason;
+        onClientDisconnect.notify(e);
+    }
+}
+
+// =============================================================================
+// Handshake
+// =============================================================================
+void WebSocketServer::processHandshake(Client& client) {
+    size_t headerEnd = client.handshakeBuffer.find("\r\n\r\n");
+    if (headerEnd == std::string::npos) {
+        if (client.handshakeBuffer.size() > 16 * 1024) {
+            tcp_.disconnectClient(client.id);  // Oversized request
+        }
+        return;
+    }
+
+    std::string request = client.handshakeBuffer.substr(0, headerEnd + 2);
+    std::string leftover = client.handshakeBuffer.substr(headerEnd + 4);
+    client.handshakeBuffer.clear();
+
+    // Request line: GET <path> HTTP/1.1
+    std::string path = "/";
+    if (request.compare(0, 4, "GET ") == 0) {
+        size_t pathEnd = request.find(' ', 4);
+        if (pathEnd != std::string::npos) path = request.substr(4, pathEnd - 4);
+    }
+
+    std::string key = ws_internal::findHeader(request, "Sec-WebSocket-Key");
+    std::string upgrade = ws_internal::findHeader(request, "Upgrade");
+    std::transform(upgrade.begin(), upgrade.end(), upgrade.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (key.empty() || upgrade != "websocket") {
+        tcp_.send(client.id, std::string("HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n"));
+        tcp_.disconnectClient(client.id);
+        return;
+    }
+
+    std::string extension;
+    bool deflate = compression_ &&
+                   negotiateDeflate(ws_internal::findHeader(request, "Sec-WebSocket-Extensions"), extension);
+
+    std::string response =
+        "HTTP/1.1 101 Switching Protocols\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Accept: " + ws_internal::computeAcceptKey(key) + "\r\n";
+    if (deflate) {
+        // Every message is an independent DEFLATE stream in both directions
+        response += "Sec-WebSocket-Extensions: " + extension + "\r\n";
+    }
+    response += "\r\n";
+
+    if (!tcp_.send(client.id, response)) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        client.open = true;
+        client.deflate = deflate;
+        if (deflate) ++deflateClients_;
+    }
+    client.parser.setAllowCompression(deflate);
+
+    WebSocketServerConnectEventArgs args;
+    args.clientId = client.id;
+    args.host = client.host;
+    args.port = client.port;
+    args.path = path;
+    args.compression = deflate;
+    onClientConnect.notify(args);
+
+    if (!leftover.empty()) {
+        client.parser.append(leftover.data(), leftover.size());
+        processFrames(client);
+    }
+}
+
+// =============================================================================
+// Frames
+// =============================================================================
+void WebSocketServer::processFrames(Client& client) {
+    bool ok = client.parser.parse([this, &client](const WebSocketFrameParser::Frame& frame) {
+        // Nothing is dispatched once the connection is closing (Close
+        // received or sent); the rest of the buffer is dropped
+        if (isClosing(client)) {
+            client.parser.clear();
+            return;
+        }
+        switch (frame.opcode) {
+            case WebSocketOpcode::Text:
+            case WebSocketOpcode::Binary:
+                deliverMessage(client, frame);
+                break;
+            case WebSocketOpcode::Ping:
+                queueTo(client.id, encode(WebSocketOpcode::Pong, frame.payload, frame.size));
+                break;
+            case WebSocketOpcode::Close:
+                disconnectClient(client.id);
+                break;
+            default:
+                break;
+        }
+    });
+
+    if (!ok) {
+        TcpServerErrorEventArgs err;
+        err.message = "WebSocket protocol error";
+        err.clientId = client.id;
+        onError.notify(err);
+        disconnectClient(client.id);
+    }
+}
+
+void WebSocketServer::deliverMessage(Client& client, const WebSocketFrameParser::Frame& frame) {
+    const char* payload = frame.payload;
+    size_t size = frame.size;
+    char* inflated = nullptr;
+
+    if (frame.compressed) {
+        if (!client.deflate) {
+            disconnectClient(client.id);
+            return;
+        }
+        // Append the empty stored block trailer removed by the sender (RFC 7692 7.2.2)
+        std::vector<char>& in = client.messageArgs.data;
+        in.assign(frame.payload, frame.payload + frame.size);
+        const char trailer[4] = {0x00, 0x00, static_cast<char>(0xFF), static_cast<char>(0xFF)};
+        in.insert(in.end(), trailer, trailer + 4);
+
+        int outLen = 0;
+        inflated = stbi_zlib_decode_noheader_malloc(in.data(), static_cast<int>(in.size()), &outLen);
+        if (!inflated || static_cast<size_t>(outLen) > maxMessageSize_) {
+            std::free(inflated);
+            TcpServerErrorEventArgs err;
+            err.message = "WebSocket: failed to inflate message";
+            err.clientId = client.id;
+            onError.notify(err);
+            disconnectClient(client.id);
+            return;
+        }
+        payload = inflated;
+        size = static_cast<size_t>(outLen);
+    }
+
+    // Reuse args buffers (no allocation once capacity is reached)
+    WebSocketServerMessageEventArgs& args = client.messageArgs;
+    args.clientId = client.id;
+    args.isBinary = (frame.opcode == WebSocketOpcode::Binary);
+    args.data.assign(payload, payload + size);
+    if (args.isBinary) {
+        args.message.clear();
+    }
+    else {
+        args.message.assign(payload, size);
+    }
+    std::free(inflated);
+
+    onMessage.notify(args);
+}
+
+// =============================================================================
+// Writer thread
+// =============================================================================
+void WebSocketServer::writerThreadFunc() {
+    std::vector<std::shared_ptr<Client>> writable;
+    std::vector<int> toClose;
+    bool blocked = false;   // Some client's socket buffer was full last pass
+
+    while (true) {
+        writable.clear();
+        toClose.clear();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            auto ready = [this]() { return !running_ || workPending_; };
+            if (blocked) {
+                writerCv_.wait_for(lock, WRITE_RETRY_INTERVAL, ready);
+            }
+            else {
+                writerCv_.wait(lock, ready);
+            }
+            if (!running_) break;
+            workPending_ = false;
+
+            for (auto& pair : clients_) {
+                Client& client = *pair.second;
+                if (!client.out && !client.queue.empty()) {
+                    // Next write: one packet as is, or several gathered into one buffer
+                    if (client.queue.size() == 1 || client.queue.front()->size() >= MAX_WRITE_BATCH) {
+                        client.out = std::move(client.queue.front());
+                        client.queue.pop_front();
+                    }
+                    else {
+                        auto batch = std::make_shared<std::vector<char>>();
+                        while (!client.queue.empty() &&
+                               batch->size() + client.queue.front()->size() <= MAX_WRITE_BATCH) {
+                            const auto& p = *client.queue.front();
+                            batch->insert(batch->end(), p.begin(), p.end());
+                            client.queue.pop_front();
+                        }
+                        client.out = std::move(batch);
+                    }
+                    client.outOffset = 0;
+                }
+
+                if (client.out) {
+                    writable.push_back(pair.second);
+                }
+                else if (client.closing && !client.closed) {
+                    client.closed = true;
+                    toClose.push_back(client.id);
+                }
+            }
+        }
+
+        // Non-blocking writes outside the lock
+        blocked = false;
+        for (auto& clientPtr : writable) {
+            Client& client = *clientPtr;
+            const std::vector<char>& out = *client.out;
+            int sent = tcp_.trySend(client.id, out.data() + client.outOffset, out.size() - client.outOffset);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (sent < 0) {
+                // Broken connection: drop its data, the receive side reports the disconnect
+                client.queue.clear();
+                client.queuedBytes = 0;
+                client.out.reset();
+                client.closing = true;
+                workPending_ = true;
+                continue;
+            }
+            client.outOffset += static_cast<size_t>(sent);
+            client.queuedBytes -= static_cast<size_t>(sent);
+            if (client.outOffset < out.size()) {
+                blocked = true;     // Retry this client later, the others are not held up
+                continue;
+            }
+            client.out.reset();
+            if (!client.queue.empty() || client.closing) workPending_ = true;
+        }
+
+        for (int id : toClose) {
+            tcp_.disconnectClient(id);
+        }
+    }
+}
+
+} // namespace trussc
+
+#endif // __EMSCRIPTEN__
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "tc/network/tcTcpServer.h"
+#include "tcWebSocketFrame.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
+
+namespace trussc {
+
+#ifndef __EMSCRIPTEN__
+
+// =============================================================================
+// WebSocket Server Event Args
+// =============================================================================
+struct WebSocketServerConnectEventArgs {
+    int clientId = -1;
+    std::string host;
+    int port = 0;
+    std::string path;           // Request path ("/" etc.)
+    bool compression = false;   // permessage-deflate negotiated
+};
+
+struct WebSocketServerMessageEventArgs {
+    int clientId = -1;
+    std::string message;        // Text payload (text messages only)
+    std::vector<char> data;     // Raw payload (text and binary)
+    bool isBinary = false;
+};
+
+struct WebSocketServerDisconnectEventArgs {
+    int clientId = -1;
+    std::string reason;
+};
+
+// =============================================================================
+// WebSocketServer - WebSocket server on top of TcpServer
+//
+// Outgoing frames go through per-client write queues drained by one writer
+// thread. broadcast() encodes a frame once and shares it by reference across
+// all client queues. The writer never blocks on a socket: a client whose
+// socket buffer is full keeps its partial write and is retried, while the
+// others carry on. Each queue is bounded (setMaxQueuedBytes) so a slow
+// client cannot grow memory without limit.
+//
+// Events are called from network threads (like TcpServer).
+// =============================================================================
+class WebSocketServer {
+public:
+    // What to do when a client's write queue is over the limit
+    enum class OverflowPolicy {
+        DropMessage,    // Skip the message for that client
+        Disconnect      // Close the slow client
+    };
+
+    // -------------------------------------------------------------------------
+    // Events
+    // -------------------------------------------------------------------------
+    Event<WebSocketServerConnectEventArgs> onClientConnect;         // After handshake
+    Event<WebSocketServerMessageEventArgs> onMessage;
+    Event<WebSocketServerDisconnectEventArgs> onClientDisconnect;
+    Event<TcpServerErrorEventArgs> onError;
+
+    // -------------------------------------------------------------------------
+    // Constructor / Destructor
+    // -------------------------------------------------------------------------
+    WebSocketServer();
+    ~WebSocketServer();
+
+    WebSocketServer(const WebSocketServer&) = delete;
+    WebSocketServer& operator=(const WebSocketServer&) = delete;
+
+    // -------------------------------------------------------------------------
+    // Management
+    // -------------------------------------------------------------------------
+    bool start(int port, int maxClients = 64);
+    void stop();
+    bool isRunning() const { return running_; }
+
+    int getPort() const { return tcp_.getPort(); }
+
+    // -------------------------------------------------------------------------
+    // Send (queued, returns false if client unknown or queue full)
+    // -------------------------------------------------------------------------
+    bool send(int clientId, const std::string& message);
+    bool sendBinary(int clientId, const void* data, size_t size);
+
+    // Encode once, queue to every open client. Returns number of clients queued
+    size_t broadcast(const std::string& message);
+    size_t broadcastBinary(const void* data, size_t size);
+
+    void disconnectClient(int clientId);
+
+    // -------------------------------------------------------------------------
+    // Clients
+    // -------------------------------------------------------------------------
+    int getClientCount() const;
+    std::vector<int> getClientIds() const;
+
+    // Bytes waiting in client's write queue
+    size_t getQueuedBytes(int clientId) const;
+
+    // Messages dropped by backpressure since start()
+    uint64_t getDroppedMessageCount() const { return droppedMessages_; }
+
+    // -------------------------------------------------------------------------
+    // Settings
+    // -------------------------------------------------------------------------
+
+    // Per-client write queue limit (default 4 MB)
+    void setMaxQueuedBytes(size_t bytes) { maxQueuedBytes_ = bytes; }
+    void setOverflowPolicy(OverflowPolicy policy) { overflowPolicy_ = policy; }
+
+    // Accept permessage-deflate (no context takeover) and compress outgoing
+    // messages of at least minSize bytes. Set before start()
+    void setCompression(bool enabled, size_t minSize = 256) {
+        compression_ = enabled;
+        compressionMinSize_ = minSize;
+    }
+
+    // Maximum incoming message size
+    void setMaxMessageSize(size_t bytes) { maxMessageSize_ = bytes; }
+
+private:
+    using Packet = std::shared_ptr<const std::vector<char>>;
+
+    // One message encoded for both kinds of clients
+    struct EncodedMessage {
+        Packet plain;
+        Packet compressed;    // nullptr if compression is off or not beneficial
+    };
+
+    struct Client {
+        int id = -1;
+        std::string host;
+        int port = 0;
+
+        // Receive side (touched only by the client's receive thread)
+        std::string handshakeBuffer;
+        WebSocketFrameParser parser;
+        WebSocketServerMessageEventArgs messageArgs;
+
+        // Shared state (guarded by mutex_)
+        bool open = false;
+        bool deflate = false;
+        bool closing = false;   // Close once the queue is drained
+        bool closed = false;    // Socket close requested
+        std::deque<Packet> queue;
+        size_t queuedBytes = 0;   // Includes the unsent part of out
+
+        // Bytes being written and how far they got (set by the writer
+        // under mutex_, sent outside it)
+        Packet out;
+        size_t outOffset = 0;
+    };
+
+    void handleConnect(TcpClientConnectEventArgs& args);
+    void handleReceive(TcpServerReceiveEventArgs& args);
+    void handleDisconnect(TcpClientDisconnectEventArgs& args);
+
+    void processHandshake(Client& client);
+    void processFrames(Client& client);
+    void deliverMessage(Client& client, const WebSocketFrameParser::Frame& frame);
+
+    EncodedMessage encode(WebSocketOpcode opcode, const void* data, size_t size) const;
+    bool enqueue(Client& client, const EncodedMessage& msg);  // Requires mutex_
+    bool isClosing(const Client& client) const;
+    bool queueTo(int clientId, const EncodedMessage& msg);
+    size_t queueToAll(const EncodedMessage& msg);
+
+    void writerThreadFunc();
+
+    TcpServer tcp_;
+    EventListener connectListener_;
+    EventListener receiveListener_;
+    EventListener disconnectListener_;
+    EventListener errorListener_;
+
+    std::unordered_map<int, std::shared_ptr<Client>> clients_;
+    mutable std::mutex mutex_;
+    std::condition_variable writerCv_;
+    std::thread writerThread_;
+    std::atomic<bool> running_{false};
+    bool workPending_ = false;
+    std::atomic<int> deflateClients_{0};
+    std::atomic<uint64_t> droppedMessages_{0};
+
+    size_t maxQueuedBytes_ = 4 * 1024 * 1024;
+    OverflowPolicy overflowPolicy_ = OverflowPolicy::DropMessage;
+    bool compression_ = false;
+    size_t compressionMinSize_ = 256;
+    size_t maxMessageSize_ = WebSocketFrameParser::DEFAULT_MAX_MESSAGE_SIZE;
+};
+
+#endif // __EMSCRIPTEN__
+
+} // namespace trussc
+
+namespace tc = trussc;
@@ -0,0 +1,12 @@
+// =============================================================================
+// main.cpp - Entry point
+// =============================================================================
+
+#include "tcApp.h"
+
+int main() {
+    tc::WindowSettings settings;
+    settings.setSize(960, 600);
+
+    return tc::runApp<tcApp>(settings);
+}
@@ -0,0 +1,171 @@
+// =============================================================================
+// meshPickingExample
+// Picks triangles on a displaced sphere (~320K triangles) under the mouse:
+//   - MeshNode::buildBVHAsync: the BVH is built off the main thread
+//   - screenToRay: mouse -> world-space ray (inside cam.begin() / cam.end())
+//   - MeshNode::raycastGlobal: nearest triangle, hit point, barycentrics
+//     (the node is rotated, so the ray is moved into its local space)
+//   - MeshBVH::closestPoint: nearest surface point to an orbiting probe
+//   - MeshNode::refitBVH: cheap update while the vertices move (SPACE)
+// Testing every triangle would take several ms per ray at this size;
+// the BVH answers in a few microseconds.
+// =============================================================================
+
+#include "tcApp.h"
+
+namespace {
+
+constexpr float RADIUS = 150.0f;
+constexpr float TILT = 0.4f;       // Node rotation around Z
+
+// Bumps along the sphere, animated by time
+float bump(const Vec3& dir, float time) {
+    return 1.0f + 0.08f * std::sin(dir.x * 9.0f + time) * std::sin(dir.y * 11.0f)
+                + 0.04f * std::sin(dir.z * 23.0f - time * 1.7f);
+}
+
+float millisSince(uint64_t startMicros) {
+    return (getElapsedTimeMicros() - startMicros) / 1000.0f;
+}
+
+} // namespace
+
+void tcApp::setup() {
+    setWindowTitle("meshPickingExample");
+
+    cam.setDistance(500);
+    cam.enableMouseInput();
+
+    light.setDirectional(Vec3(-0.6f, -1.0f, -0.5f));
+    light.setAmbient(0.35f, 0.35f, 0.4f);
+    light.setDiffuse(0.8f, 0.8f, 0.75f);
+    material = Material::plastic(Color(0.55f, 0.6f, 0.7f));
+
+    sphere = make_shared<MeshNode>();
+    sphere->setRot(TILT);
+    rebuildMesh();
+}
+
+void tcApp::rebuildMesh() {
+    sphere->setMesh(createSphere(RADIUS, resolution));
+    basePositions = sphere->getMesh().getVertices();
+    displace(0);
+
+    // Picking misses until the build is done; drawing goes on meanwhile
+    buildStart = getElapsedTimeMicros();
+    buildMs = 0;
+    refitMs = 0;
+    sphere->buildBVHAsync();
+}
+
+void tcApp::displace(float time) {
+    auto& vertices = sphere->getMesh().getVertices();
+    for (size_t i = 0; i < vertices.size(); i++) {
+        Vec3 dir = basePositions[i] / RADIUS;
+        vertices[i] = basePositions[i] * bump(dir, time);
+    }
+}
+
+void tcApp::update() {
+    float t = getElapsedTimef();
+
+    if (!sphere->isBVHReady()) {
+        nearest = {};
+        return;
+    }
+    if (buildMs == 0) {
+        buildMs = millisSince(buildStart);
+        const MeshBVH& bvh = sphere->getBVH();
+        logNotice("meshPicking") << bvh.getNumTriangles() << " triangles, " << bvh.getNumNodes()
+                                 << " nodes, build " << buildMs << " ms";
+    }
+
+    if (wobble) {
+        displace(t);
+        uint64_t start = getElapsedTimeMicros();
+        sphere->refitBVH();
+        refitMs = millisSince(start);
+    }
+
+    // The BVH is in the node's local space
+    probe = Vec3(std::cos(t * 0.5f), 0.4f * std::sin(t * 0.8f), std::sin(t * 0.5f)) * (RADIUS * 1.6f);
+    nearest = sphere->getBVH().closestPoint(sphere->globalToLocal(probe));
+}
+
+void tcApp::draw() {
+    clear(0.08f);
+
+    cam.begin();
+
+    // Pick while the camera matrices are active
+    uint64_t start = getElapsedTimeMicros();
+    hit = sphere->raycastGlobal(screenToRay(getMousePos()));
+    pickUs = static_cast<float>(getElapsedTimeMicros() - start);
+
+    enableLighting();
+    addLight(light);
+    setCameraPosition(cam.getPosition());
+    setMaterial(material);
+    pushMatrix();
+    rotateZ(TILT);
+    sphere->draw();
+    disableLighting();
+
+    // Hit and closest point are local to the node
+    if (hit.hit()) {
+        const auto& v = sphere->getMesh().getVertices();
+        Vec3 a = v[hit.vertices[0]], b = v[hit.vertices[1]], c = v[hit.vertices[2]];
+
+        // Lift the highlight off the surface a little to avoid z-fighting
+        Vec3 lift = hit.normal * 0.3f;
+        setColor(1.0f, 0.3f, 0.2f);
+        drawTriangle(a + lift, b + lift, c + lift);
+
+        setColor(1.0f, 0.9f, 0.2f);
+        drawLine(hit.point, hit.point + hit.normal * 20.0f);
+        drawSphere(hit.point, 1.5f, 8);
+    }
+
+    if (nearest.found()) {
+        Vec3 localProbe = sphere->globalToLocal(probe);
+        setColor(0.3f, 0.9f, 1.0f);
+        drawSphere(localProbe, 4.0f, 12);
+        drawLine(localProbe, nearest.point);
+        drawSphere(nearest.point, 2.0f, 8);
+    }
+    popMatrix();
+
+    cam.end();
+
+    setColor(1.0f);
+    float y = 20;
+    if (sphere->isBuildingBVH()) {
+        drawBitmapString("building BVH... " + toString(millisSince(buildStart), 0) + " ms", 20, y);
+    } else {
+        drawBitmapString("triangles: " + toString(sphere->getBVH().getNumTriangles()) + "  build: "
+                         + toString(buildMs, 1) + " ms  refit: " + toString(refitMs, 2) + " ms", 20, y);
+    }
+    drawBitmapString("pick: " + toString(pickUs, 1) + " us", 20, y += 16);
+    if (hit.hit()) {
+        drawBitmapString("triangle " + toString(hit.triangle) + "  distance " + toString(hit.distance, 1)
+                         + "  uv (" + toString(hit.u, 2) + ", " + toString(hit.v, 2) + ")", 20, y += 16);
+    }
+    y = getWindowHeight() - 50;
+    drawBitmapString("SPACE: wobble (refit)  +/-: resolution (rebuild)", 20, y);
+    drawBitmapString("resolution: " + toString(resolution), 20, y += 16);
+}
+
+void tcApp::keyPressed(int key) {
+    if (key == ' ') {
+        wobble = !wobble;
+        if (!wobble) refitMs = 0;
+    } else if (key == '+' || key == '=') {
+        resolution = std::min(resolution * 2, 800);
+        rebuildMesh();
+    } else if (key == '-') {
+        resolution = std::max(resolution / 2, 25);
+        rebuildMesh();
+    } else if (key == KEY_ESCAPE) {
+        sapp_request_quit();
+    }
+}
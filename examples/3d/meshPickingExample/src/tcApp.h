@@ -0,0 +1,38 @@
+#pragma once
+
+#include <TrussC.h>
+using namespace std;
+using namespace tc;
+
+// meshPickingExample - Mouse picking on a large mesh with MeshNode / MeshBVH
+
+class tcApp : public App {
+public:
+    void setup() override;
+    void update() override;
+    void draw() override;
+
+    void keyPressed(int key) override;
+
+private:
+    EasyCam cam;
+    Light light;
+    Material material;
+
+    MeshNode::Ptr sphere;
+    std::vector<Vec3> basePositions;   // Undisplaced sphere
+
+    int resolution = 400;              // 707 -> ~1M triangles
+    bool wobble = false;
+    uint64_t buildStart = 0;
+    float buildMs = 0;
+    float refitMs = 0;
+    float pickUs = 0;
+
+    MeshRayHit hit;
+    Vec3 probe;                        // Orbiting point, linked to its closest surface point
+    MeshClosestPoint nearest;
+
+    void rebuildMesh();
+    void displace(float time);
+};
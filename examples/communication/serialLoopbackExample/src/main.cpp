@@ -0,0 +1,12 @@
+// =============================================================================
+// main.cpp - Entry point for the serial loopback test (headless)
+// =============================================================================
+
+#include "tcApp.h"
+
+int main() {
+    HeadlessSettings settings;
+    settings.setFps(60.0f);
+
+    return runHeadlessApp<tcApp>(settings);
+}
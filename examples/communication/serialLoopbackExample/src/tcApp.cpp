@@ -0,0 +1,351 @@
+// =============================================================================
+// serialLoopbackExample - Threaded Serial reader against a pty (headless)
+// =============================================================================
+//
+// Opens a pseudo-terminal pair (posix_openpt), connects Serial to the slave
+// side and runs every framing through the threaded reader:
+//   - newline (delimiter), SLIP, COBS, 1/2/4 byte length prefix
+//   - writeFrame() output is read back on the master side and compared with
+//     encodeSerialFrame()
+//   - the same bytes are echoed back in random small chunks, with garbage
+//     frames mixed in (too long, bad SLIP escape, truncated COBS block,
+//     oversized length), so frames arrive split across reads and pass the
+//     poll() / wake pipe loop and the ring buffer
+//   - every payload must come out of onFrame intact and in order, and every
+//     garbage frame must show up in getDroppedFrameCount()
+//   - closing our end hangs up the port: the reader thread stops, the port
+//     is closed and onDisconnect fires
+// Each check is logged as PASS / FAIL and the app exits when done.
+// POSIX only (macOS, Linux).
+//
+// =============================================================================
+
+#include "tcApp.h"
+
+#if !defined(_WIN32)
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdlib>
+
+namespace {
+
+constexpr size_t MAX_FRAME = 1024;
+constexpr size_t MAX_FRAME_PREFIX1 = 200;   // A 1-byte prefix can't exceed 255
+constexpr int PAYLOAD_COUNT = 40;
+constexpr int GARBAGE_EVERY = 10;           // Garbage frame before every 10th payload
+constexpr double STEP_TIMEOUT = 5.0;
+
+string hexPreview(const vector<uint8_t>& data) {
+    static const char* digits = "0123456789abcdef";
+    string s;
+    for (size_t i = 0; i < data.size() && i < 16; i++) {
+        if (i) s += ' ';
+        s += digits[data[i] >> 4];
+        s += digits[data[i] & 15];
+    }
+    if (data.size() > 16) s += " ...";
+    return s;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Setup
+// -----------------------------------------------------------------------------
+void tcApp::setup() {
+    logNotice("serialLoopback") << "=== Serial loopback test ===";
+
+    if (!openPty() || !serial_.setup(slavePath_, 115200)) {
+        check("open pty", false, slavePath_);
+        requestExit();
+        return;
+    }
+    logNotice("serialLoopback") << "pty slave " << slavePath_;
+
+    frameListener_ = serial_.onFrame.listen([this](SerialFrameEventArgs& e) {
+        received_.push_back(e.data);
+    });
+    disconnectListener_ = serial_.onDisconnect.listen([this]() { disconnects_++; });
+
+    cases_ = {
+        {"newline",        SerialFraming::Newline,      2, false},
+        {"SLIP",           SerialFraming::Slip,         2, false},
+        {"COBS",           SerialFraming::Cobs,         2, false},
+        {"length 1",       SerialFraming::LengthPrefix, 1, false},
+        {"length 2 (BE)",  SerialFraming::LengthPrefix, 2, true},
+        {"length 4",       SerialFraming::LengthPrefix, 4, false},
+    };
+    startCase();
+}
+
+bool tcApp::openPty() {
+    masterFd_ = posix_openpt(O_RDWR | O_NOCTTY);
+    if (masterFd_ == -1) return false;
+    if (grantpt(masterFd_) == -1 || unlockpt(masterFd_) == -1) return false;
+    const char* name = ptsname(masterFd_);
+    if (!name) return false;
+    slavePath_ = name;
+    fcntl(masterFd_, F_SETFL, fcntl(masterFd_, F_GETFL) | O_NONBLOCK);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Test data
+// -----------------------------------------------------------------------------
+void tcApp::makePayloads(SerialFraming framing) {
+    payloads_.clear();
+    const Case& c = cases_[caseIndex_];
+    size_t maxSize = (framing == SerialFraming::LengthPrefix && c.prefixBytes == 1) ? MAX_FRAME_PREFIX1 : MAX_FRAME;
+
+    // Sizes around the COBS block length first, then random
+    vector<size_t> sizes = {1, 2, 253, 254, 255, 256, 509, maxSize};
+    while (sizes.size() < PAYLOAD_COUNT) sizes.push_back(1 + rng_() % maxSize);
+
+    for (size_t size : sizes) {
+        size = std::min(size, maxSize);
+        vector<uint8_t> p(size);
+        if (framing == SerialFraming::Newline) {
+            // Printable text; a trailing '\r' would be taken as "\r\n"
+            for (auto& b : p) b = static_cast<uint8_t>(' ' + rng_() % 95);
+        } else {
+            // Heavy on the bytes each framing has to escape or stuff
+            static const uint8_t special[] = {0x00, 0xC0, 0xDB, 0xDC, 0xDD, 0xFF};
+            for (auto& b : p) {
+                b = (rng_() % 3 == 0) ? special[rng_() % 6] : static_cast<uint8_t>(rng_());
+            }
+        }
+        payloads_.push_back(std::move(p));
+    }
+
+    if (framing != SerialFraming::Newline) {
+        // No zeros at all (full 0xFF COBS blocks), then only zeros
+        vector<uint8_t> noZeros(maxSize);
+        for (auto& b : noZeros) b = static_cast<uint8_t>(1 + rng_() % 255);
+        payloads_.push_back(std::move(noZeros));
+        payloads_.push_back(vector<uint8_t>(std::min<size_t>(300, maxSize), 0));
+    }
+}
+
+// One frame the decoder has to drop
+vector<uint8_t> tcApp::garbageFrame(SerialFraming framing, int prefixBytes) {
+    switch (framing) {
+        case SerialFraming::Newline: {
+            vector<uint8_t> g(MAX_FRAME + 200, 'x');    // Too long
+            g.push_back('\n');
+            return g;
+        }
+        case SerialFraming::Slip:
+            return {0xC0, 0xDB, 0x01, 'a', 0xC0};       // Bad escape
+        case SerialFraming::Cobs:
+            return {0x05, 'a', 'b', 0x00};              // Truncated block
+        case SerialFraming::LengthPrefix: {
+            // Oversized length, then that many bytes that must be skipped
+            const Case& c = cases_[caseIndex_];
+            size_t size = (prefixBytes == 1 ? MAX_FRAME_PREFIX1 : MAX_FRAME) + 50;
+            vector<uint8_t> g;
+            for (int k = 0; k < prefixBytes; k++) {
+                int shift = c.bigEndian ? (prefixBytes - 1 - k) * 8 : k * 8;
+                g.push_back(static_cast<uint8_t>(size >> shift));
+            }
+            for (size_t i = 0; i < size; i++) g.push_back(static_cast<uint8_t>(rng_()));
+            return g;
+        }
+        case SerialFraming::None:
+            break;
+    }
+    return {};
+}
+
+// -----------------------------------------------------------------------------
+// Cases
+// -----------------------------------------------------------------------------
+void tcApp::startCase() {
+    const Case& c = cases_[caseIndex_];
+    logNotice("serialLoopback") << "--- " << c.name << " ---";
+
+    // Leftovers from the previous case
+    uint8_t scratch[4096];
+    while (read(masterFd_, scratch, sizeof(scratch)) > 0) {}
+
+    serial_.stopThread();
+    bool shortPrefix = c.framing == SerialFraming::LengthPrefix && c.prefixBytes == 1;
+    serial_.setMaxFrameSize(shortPrefix ? MAX_FRAME_PREFIX1 : MAX_FRAME);
+    serial_.setLengthPrefix(c.prefixBytes, c.bigEndian);
+    if (!serial_.startThread(c.framing)) {
+        check(c.name + ": startThread", false);
+        finishCase();
+        return;
+    }
+
+    makePayloads(c.framing);
+    expectedWire_.clear();
+    collected_.clear();
+    received_.clear();
+    echo_.clear();
+    echoOffset_ = 0;
+
+    // Queued while the reader thread runs; the wake pipe gets them out
+    for (const auto& p : payloads_) {
+        encodeSerialFrame(c.framing, p.data(), p.size(), expectedWire_, c.prefixBytes, c.bigEndian);
+        serial_.writeFrame(p.data(), static_cast<int>(p.size()));
+    }
+
+    step_ = Step::Collect;
+    stepStart_ = headless::getElapsedTime();
+}
+
+void tcApp::finishCase() {
+    step_ = Step::Done;
+    if (++caseIndex_ < cases_.size()) {
+        startCase();
+        return;
+    }
+    startHangUp();
+}
+
+// Last frame, then our end goes away
+void tcApp::startHangUp() {
+    logNotice("serialLoopback") << "--- hang-up ---";
+    serial_.stopThread();
+    if (!serial_.startThread(SerialFraming::Newline)) {
+        check("hang-up: startThread", false);
+        requestExit();
+        return;
+    }
+    received_.clear();
+    [[maybe_unused]] ssize_t n = write(masterFd_, "bye\n", 4);
+    step_ = Step::HangUp;
+    stepStart_ = headless::getElapsedTime();
+}
+
+void tcApp::updateHangUp(bool timedOut) {
+    if (masterFd_ != -1) {
+        if (received_.empty() && !timedOut) return;
+        check("hang-up: last frame", received_.size() == 1 && received_[0] == vector<uint8_t>{'b', 'y', 'e'});
+        ::close(masterFd_);
+        masterFd_ = -1;
+        stepStart_ = headless::getElapsedTime();
+        return;
+    }
+    if (disconnects_ == 0 && !timedOut) return;
+    check("hang-up: onDisconnect", disconnects_ == 1, to_string(disconnects_) + " events");
+    check("hang-up: thread stopped", !serial_.isThreaded());
+    check("hang-up: port closed", !serial_.isInitialized());
+
+    step_ = Step::Done;
+    logNotice("serialLoopback") << "=== " << passed_ << " passed, " << failed_ << " failed ===";
+    requestExit();
+}
+
+// -----------------------------------------------------------------------------
+// Update
+// -----------------------------------------------------------------------------
+void tcApp::update() {
+    if (step_ == Step::Done) return;
+    bool timedOut = headless::getElapsedTime() - stepStart_ > STEP_TIMEOUT;
+    if (step_ == Step::HangUp) {
+        updateHangUp(timedOut);
+        return;
+    }
+    const Case& c = cases_[caseIndex_];
+
+    if (step_ == Step::Collect) {
+        // writeFrame() output as it reaches our end
+        uint8_t buf[4096];
+        ssize_t n;
+        while ((n = read(masterFd_, buf, sizeof(buf))) > 0) collected_.insert(collected_.end(), buf, buf + n);
+
+        if (collected_.size() < expectedWire_.size() && !timedOut) return;
+        check(c.name + ": writeFrame bytes", collected_ == expectedWire_,
+              to_string(collected_.size()) + " of " + to_string(expectedWire_.size()) + " bytes");
+
+        // Echo what arrived, garbage frames at frame boundaries
+        garbageFrames_ = 0;
+        size_t offset = 0;
+        for (size_t i = 0; i < payloads_.size(); i++) {
+            if (i % GARBAGE_EVERY == 0) {
+                auto g = garbageFrame(c.framing, c.prefixBytes);
+                echo_.insert(echo_.end(), g.begin(), g.end());
+                garbageFrames_++;
+            }
+            vector<uint8_t> frame;
+            encodeSerialFrame(c.framing, payloads_[i].data(), payloads_[i].size(), frame, c.prefixBytes, c.bigEndian);
+            size_t end = std::min(offset + frame.size(), collected_.size());
+            echo_.insert(echo_.end(), collected_.begin() + offset, collected_.begin() + end);
+            offset = end;
+        }
+        droppedBefore_ = serial_.getDroppedFrameCount();
+        step_ = Step::Echo;
+        stepStart_ = headless::getElapsedTime();
+        return;
+    }
+
+    if (step_ == Step::Echo) {
+        // Many small writes per frame so frames are split across reads
+        for (int i = 0; i < 64 && echoOffset_ < echo_.size(); i++) {
+            size_t chunk = (i % 16 == 15) ? 512 : 1 + rng_() % 17;
+            chunk = std::min(chunk, echo_.size() - echoOffset_);
+            ssize_t n = write(masterFd_, echo_.data() + echoOffset_, chunk);
+            if (n <= 0) break;      // pty buffer full, next frame
+            echoOffset_ += static_cast<size_t>(n);
+        }
+        if (echoOffset_ < echo_.size() && !timedOut) return;
+        check(c.name + ": echo written", echoOffset_ == echo_.size());
+        step_ = Step::Verify;
+        stepStart_ = headless::getElapsedTime();
+        return;
+    }
+
+    // Verify (onFrame runs from events().update)
+    uint64_t dropped = serial_.getDroppedFrameCount() - droppedBefore_;
+    bool complete = received_.size() >= payloads_.size() && dropped >= static_cast<uint64_t>(garbageFrames_);
+    if (!complete && !timedOut) return;
+
+    check(c.name + ": frame count", received_.size() == payloads_.size(),
+          to_string(received_.size()) + " of " + to_string(payloads_.size()));
+    size_t mismatch = 0;
+    for (size_t i = 0; i < received_.size() && i < payloads_.size(); i++) {
+        if (received_[i] != payloads_[i]) {
+            if (mismatch++ == 0) {
+                logNotice("serialLoopback") << "  first mismatch at frame " << i << ": "
+                                            << hexPreview(received_[i]) << " / " << hexPreview(payloads_[i]);
+            }
+        }
+    }
+    check(c.name + ": payloads intact", mismatch == 0, to_string(mismatch) + " differ");
+    check(c.name + ": garbage dropped", dropped == static_cast<uint64_t>(garbageFrames_),
+          to_string(dropped) + " of " + to_string(garbageFrames_));
+    check(c.name + ": ring drained", serial_.getBufferedCount() == 0);
+    finishCase();
+}
+
+void tcApp::cleanup() {
+    serial_.stopThread();
+    serial_.close();
+    if (masterFd_ != -1) ::close(masterFd_);
+}
+
+void tcApp::check(const string& name, bool ok, const string& detail) {
+    if (ok) {
+        passed_++;
+        logNotice("serialLoopback") << "PASS " << name;
+    } else {
+        failed_++;
+        logError("serialLoopback") << "FAIL " << name << (detail.empty() ? "" : " (" + detail + ")");
+    }
+}
+
+#else
+
+// No pseudo-terminals on Windows
+void tcApp::setup() {
+    logError("serialLoopback") << "serialLoopbackExample needs a POSIX pty (macOS, Linux)";
+    requestExit();
+}
+
+void tcApp::update() {}
+void tcApp::cleanup() {}
+
+#endif
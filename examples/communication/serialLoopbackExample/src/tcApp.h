@@ -0,0 +1,61 @@
+#pragma once
+
+#include <TrussC.h>
+#include <random>
+using namespace std;
+using namespace tc;
+
+// =============================================================================
+// tcApp - Threaded Serial reader against a pseudo-terminal (headless)
+// =============================================================================
+
+class tcApp : public App {
+public:
+    void setup() override;
+    void update() override;
+    void cleanup() override;
+
+private:
+    // Our end of the pty; Serial opens the other one
+    int masterFd_ = -1;
+    string slavePath_;
+    Serial serial_;
+    EventListener frameListener_;
+    EventListener disconnectListener_;
+    int disconnects_ = 0;
+
+    struct Case {
+        string name;
+        SerialFraming framing;
+        int prefixBytes;
+        bool bigEndian;
+    };
+    vector<Case> cases_;
+    size_t caseIndex_ = 0;
+
+    // Current case
+    enum class Step { Collect, Echo, Verify, HangUp, Done };
+    Step step_ = Step::Done;
+    double stepStart_ = 0.0;
+    vector<vector<uint8_t>> payloads_;
+    vector<uint8_t> expectedWire_;      // What writeFrame() should have sent
+    vector<uint8_t> collected_;         // What arrived on our end
+    vector<uint8_t> echo_;              // collected_ with garbage frames mixed in
+    size_t echoOffset_ = 0;
+    int garbageFrames_ = 0;
+    uint64_t droppedBefore_ = 0;
+    vector<vector<uint8_t>> received_;
+
+    mt19937 rng_{1234};
+    int passed_ = 0;
+    int failed_ = 0;
+
+    bool openPty();
+    void startCase();
+    void finishCase();
+    void startHangUp();
+    void updateHangUp(bool timedOut);
+    void makePayloads(SerialFraming framing);
+    vector<uint8_t> garbageFrame(SerialFraming framing, int prefixBytes);
+    void check(const string& name, bool ok, const string& detail = "");
+};
@@ -0,0 +1,12 @@
+// =============================================================================
+// main.cpp - Entry point for jsonBenchmark example
+// =============================================================================
+
+#include "tcApp.h"
+
+int main() {
+    tc::HeadlessSettings settings;
+    settings.setFps(60.0f);
+
+    return tc::runHeadlessApp<tcApp>(settings);
+}
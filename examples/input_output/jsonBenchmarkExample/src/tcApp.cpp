@@ -0,0 +1,120 @@
+// =============================================================================
+// jsonBenchmarkExample - JSON loading paths compared (headless)
+// =============================================================================
+//
+// Writes one synthetic dataset as text, CBOR and MessagePack to the temp
+// directory, then times every way of reading it back:
+//   - Json::parse on an ifstream (the previous loadJson)
+//   - loadJson (memory-mapped text)
+//   - loadJsonItems (one record at a time, no full DOM)
+//   - loadJsonSax (events only, counting numbers)
+//   - loadBinaryJson (CBOR / MessagePack)
+//
+// Set RECORDS below to scale the file (200000 records ~ 50 MB of text).
+//
+// =============================================================================
+
+#include "tcApp.h"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+constexpr int RECORDS = 200000;
+constexpr int RUNS = 3;             // Best of
+
+// Counts values without storing them
+struct CountingSax : JsonSax {
+    size_t numbers = 0;
+    size_t strings = 0;
+
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool number_integer(number_integer_t) override { numbers++; return true; }
+    bool number_unsigned(number_unsigned_t) override { numbers++; return true; }
+    bool number_float(number_float_t, const string_t&) override { numbers++; return true; }
+    bool string(string_t&) override { strings++; return true; }
+    bool binary(binary_t&) override { return true; }
+    bool start_object(std::size_t) override { return true; }
+    bool key(string_t&) override { return true; }
+    bool end_object() override { return true; }
+    bool start_array(std::size_t) override { return true; }
+    bool end_array() override { return true; }
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override { return false; }
+};
+
+std::string megabytes(const std::string& path) {
+    return toString(getFileSize(path) / (1024.0 * 1024.0), 1) + " MB";
+}
+
+} // namespace
+
+void tcApp::setup() {
+    auto dir = std::filesystem::temp_directory_path();
+    std::string textPath = (dir / "tc_json_benchmark.json").string();
+    std::string cborPath = (dir / "tc_json_benchmark.cbor").string();
+    std::string msgpackPath = (dir / "tc_json_benchmark.msgpack").string();
+
+    logNotice("jsonBenchmark") << "Generating " << RECORDS << " records...";
+    {
+        Json data = makeDataset(RECORDS);
+        logNotice("jsonBenchmark") << "save text:        " << measureMillis([&] { saveJson(data, textPath, -1); }) << " ms";
+        logNotice("jsonBenchmark") << "save CBOR:        " << measureMillis([&] { saveBinaryJson(data, cborPath); }) << " ms";
+        logNotice("jsonBenchmark") << "save MessagePack: " << measureMillis([&] { saveBinaryJson(data, msgpackPath, JsonBinaryFormat::MessagePack); }) << " ms";
+    }
+    logNotice("jsonBenchmark") << "sizes: text " << megabytes(textPath) << ", CBOR " << megabytes(cborPath)
+                               << ", MessagePack " << megabytes(msgpackPath);
+
+    size_t count = 0;
+    double ms = measureMillis([&] {
+        std::ifstream file(textPath);
+        count = Json::parse(file).size();
+    }, RUNS);
+    logNotice("jsonBenchmark") << "ifstream parse:   " << ms << " ms (" << count << " records)";
+
+    ms = measureMillis([&] { count = loadJson(textPath).size(); }, RUNS);
+    logNotice("jsonBenchmark") << "loadJson:         " << ms << " ms (" << count << " records)";
+
+    ms = measureMillis([&] {
+        count = 0;
+        loadJsonItems(textPath, [&](const std::string&, Json& record) {
+            count += record["id"].get<int>() >= 0;
+            return true;
+        });
+    }, RUNS);
+    logNotice("jsonBenchmark") << "loadJsonItems:    " << ms << " ms (" << count << " records, one in memory)";
+
+    CountingSax sax;
+    ms = measureMillis([&] {
+        sax = CountingSax();
+        loadJsonSax(textPath, sax);
+    }, RUNS);
+    logNotice("jsonBenchmark") << "loadJsonSax:      " << ms << " ms (" << sax.numbers << " numbers, "
+                               << sax.strings << " strings)";
+
+    ms = measureMillis([&] { count = loadBinaryJson(cborPath).size(); }, RUNS);
+    logNotice("jsonBenchmark") << "loadBinaryJson CBOR:        " << ms << " ms (" << count << " records)";
+
+    ms = measureMillis([&] { count = loadBinaryJson(msgpackPath, JsonBinaryFormat::MessagePack).size(); }, RUNS);
+    logNotice("jsonBenchmark") << "loadBinaryJson MessagePack: " << ms << " ms (" << count << " records)";
+
+    std::filesystem::remove(textPath);
+    std::filesystem::remove(cborPath);
+    std::filesystem::remove(msgpackPath);
+    requestExitApp();
+}
+
+Json tcApp::makeDataset(int records) {
+    Json data = Json::array();
+    for (int i = 0; i < records; i++) {
+        data.push_back({
+            {"id", i},
+            {"name", "node_" + toString(i)},
+            {"position", {random(-1000.0f, 1000.0f), random(-1000.0f, 1000.0f), random(-1000.0f, 1000.0f)}},
+            {"color", {random(1.0f), random(1.0f), random(1.0f), 1.0f}},
+            {"visible", i % 3 != 0},
+            {"tags", {"scene", i % 2 ? "static" : "dynamic"}},
+        });
+    }
+    return data;
+}
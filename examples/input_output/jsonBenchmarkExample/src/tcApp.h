@@ -0,0 +1,14 @@
+#pragma once
+
+#include <TrussC.h>
+using namespace std;
+using namespace tc;
+
+class tcApp : public App {
+public:
+    void setup() override;
+
+private:
+    // Synthetic scene: records with numbers, strings and nested arrays
+    Json makeDataset(int records);
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <TrussC.h>
+using namespace std;
+using namespace tc;
+
+class tcApp : public App {
+public:
+    void setup() override;
+
+private:
+    // Logs scalar vs SIMD timings side by side
+    void report(const std::string& name, double scalarMs, double simdMs);
+};
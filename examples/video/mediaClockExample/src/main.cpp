@@ -0,0 +1,12 @@
+// =============================================================================
+// mediaClockExample - Deterministic MediaClock test (headless)
+// =============================================================================
+
+#include "tcApp.h"
+
+int main() {
+    HeadlessSettings settings;
+    settings.setFps(60.0f);
+
+    return runHeadlessApp<tcApp>(settings);
+}
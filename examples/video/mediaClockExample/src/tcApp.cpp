@@ -0,0 +1,321 @@
+// =============================================================================
+// mediaClockExample - Deterministic MediaClock test (headless)
+// =============================================================================
+//
+// Drives a MediaClock with explicit times (clock.update(step / 60.0)) and
+// checks which frame every player shows after each step:
+//   - slaved clips at 30 and 24 fps show floor(time * fps)
+//   - with setRefreshRate(60) a 30 fps clip holds every frame for exactly two
+//     refreshes, even when the time source jitters
+//   - looping wraps the group and fires `looped`
+//   - seek() while paused is shown on the next update
+//   - setWaitForAll() holds the clock while a player's buffer lags
+//   - a free-running (native) player is nudged back in sync, and hard seeked
+//     when it drifts too far
+//   - a zero-length clip in the group is left alone
+// The clips are synthetic: they pick frames from the clock time the same way
+// HapPlayer does, so no media files are needed. Each check is logged as
+// PASS / FAIL and the app exits when done.
+//
+// =============================================================================
+
+#include "tcApp.h"
+#include <random>
+
+namespace {
+
+constexpr double REFRESH = 60.0;
+
+// Synthetic clip: frames are "decoded" on demand, like HapPlayer
+class ClipPlayer : public VideoPlayerBase {
+public:
+    ClipPlayer(int frames, double fps, bool slavable = true)
+        : frames_(frames), fps_(fps), slavable_(slavable) {
+        initialized_ = true;
+    }
+
+    bool load(const string&) override { return true; }
+    void close() override { initialized_ = false; }
+
+    void update() override {
+        if (!initialized_ || frames_ <= 0) return;
+        if (clockSlave_) {
+            show(clockTime_);
+            return;
+        }
+        // Free running: advance one refresh at our own speed
+        if (playing_ && !paused_) {
+            time_ += speed_ / REFRESH;
+            show(time_);
+        }
+    }
+
+    float getDuration() const override { return fps_ > 0.0 ? static_cast<float>(frames_ / fps_) : 0.0f; }
+    float getPosition() const override {
+        float duration = getDuration();
+        return duration > 0.0f ? static_cast<float>(time_ / duration) : 0.0f;
+    }
+
+    int getCurrentFrame() const override { return current_; }
+    int getTotalFrames() const override { return frames_; }
+    void setFrame(int frame) override {
+        if (frames_ <= 0) return;
+        time_ = std::clamp(frame, 0, frames_ - 1) / fps_;
+        show(time_);
+    }
+    void nextFrame() override { setFrame(current_ + 1); }
+    void previousFrame() override { setFrame(current_ - 1); }
+
+    unsigned char* getPixels() override { return nullptr; }
+    const unsigned char* getPixels() const override { return nullptr; }
+
+    bool supportsClock() const override { return slavable_; }
+    double getBufferedTime() const override { return bufferedTime_; }
+
+    // Test controls
+    double bufferedTime_ = std::numeric_limits<double>::infinity();
+    double time_ = 0.0;
+    int seeks_ = 0;
+
+protected:
+    void playImpl() override {}
+    void stopImpl() override { time_ = 0.0; }
+    void setPausedImpl(bool) override {}
+    void setPositionImpl(float pct) override {
+        time_ = pct * getDuration();
+        seeks_++;
+    }
+    void setVolumeImpl(float) override {}
+    void setSpeedImpl(float) override {}
+    void setPanImpl(float) override {}
+    void setLoopImpl(bool) override {}
+
+private:
+    int frames_;
+    double fps_;
+    bool slavable_;
+    int current_ = 0;
+
+    // Same mapping as HapPlayer::update()
+    void show(double t) {
+        double duration = getDuration();
+        t = std::clamp(t, 0.0, duration);
+        current_ = std::min(static_cast<int>(t / duration * frames_), frames_ - 1);
+        markFrameNew();
+    }
+};
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Setup / update
+// -----------------------------------------------------------------------------
+void tcApp::setup() {
+    logNotice("mediaClock") << "=== MediaClock test ===";
+
+    cases_ = {
+        {"slaved frames", [this] { testSlavedFrames(); }},
+        {"refresh stepping", [this] { testRefreshStepping(); }},
+        {"loop", [this] { testLoop(); }},
+        {"seek while paused", [this] { testSeekWhilePaused(); }},
+        {"wait for all", [this] { testWaitForAll(); }},
+        {"free-running drift", [this] { testFreeRunningDrift(); }},
+        {"empty clip", [this] { testEmptyClip(); }},
+    };
+}
+
+// One case per app frame
+void tcApp::update() {
+    if (caseIndex_ < cases_.size()) {
+        logNotice("mediaClock") << "--- " << cases_[caseIndex_].name;
+        cases_[caseIndex_].run();
+        caseIndex_++;
+        return;
+    }
+
+    logNotice("mediaClock") << "=== " << passed_ << " passed, " << failed_ << " failed ===";
+    requestExit();
+}
+
+// -----------------------------------------------------------------------------
+// Cases
+// -----------------------------------------------------------------------------
+void tcApp::testSlavedFrames() {
+    MediaClock clock;
+    ClipPlayer a(60, 30.0);     // 2 s
+    ClipPlayer b(48, 24.0);     // 2 s
+    clock.add(a);
+    clock.add(b);
+    clock.play();
+
+    int wrong = 0;
+    string detail;
+    for (int step = 0; step < 110; step++) {
+        clock.update(step / REFRESH);
+        int expectA = step * 30 / 60;
+        int expectB = step * 24 / 60;
+        if (a.getCurrentFrame() != expectA || b.getCurrentFrame() != expectB) {
+            if (!wrong++) {
+                detail = "step " + to_string(step) + ": " + to_string(a.getCurrentFrame()) + "/" +
+                         to_string(b.getCurrentFrame()) + ", expected " + to_string(expectA) + "/" +
+                         to_string(expectB);
+            }
+        }
+    }
+    check("30 and 24 fps clips follow the clock", wrong == 0, detail);
+    check("getFrame() at the first clip's rate", clock.getFrame() == 109 * 30 / 60,
+          to_string(clock.getFrame()));
+}
+
+void tcApp::testRefreshStepping() {
+    MediaClock clock;
+    ClipPlayer clip(300, 30.0);
+    clock.add(clip);
+    clock.setRefreshRate(REFRESH);
+    clock.play();
+
+    // +-4 ms timer jitter around each refresh
+    mt19937 rng(42);
+    uniform_real_distribution<double> jitter(-0.004, 0.004);
+
+    int wrong = 0;
+    int offGrid = 0;
+    string detail;
+    for (int step = 0; step < 240; step++) {
+        double now = step / REFRESH + (step > 0 ? jitter(rng) : 0.0);
+        clock.update(now);
+        int expect = step / 2;
+        if (clip.getCurrentFrame() != expect && !wrong++) {
+            detail = "step " + to_string(step) + ": frame " + to_string(clip.getCurrentFrame()) +
+                     ", expected " + to_string(expect);
+        }
+        double refreshes = clock.getTime() * REFRESH;
+        if (std::abs(refreshes - std::round(refreshes)) > 1e-6) offGrid++;
+    }
+    check("every frame held for two refreshes", wrong == 0, detail);
+    check("time advances in whole refreshes", offGrid == 0, to_string(offGrid) + " steps off the grid");
+}
+
+void tcApp::testLoop() {
+    MediaClock clock;
+    ClipPlayer clip(30, 30.0);  // 1 s
+    clock.add(clip);
+    clock.setLoop(true);
+
+    int loops = 0;
+    EventListener listener = clock.looped.listen([&loops] { loops++; });
+    clock.play();
+
+    int wrong = 0;
+    for (int step = 0; step < 150; step++) {
+        clock.update(step / REFRESH);
+        if (clip.getCurrentFrame() != (step % 60) / 2) wrong++;
+    }
+    check("frames wrap with the group", wrong == 0, to_string(wrong) + " steps off");
+    check("looped fired per wrap", loops == 2 && clock.getLoopCount() == 2,
+          to_string(loops) + " events, count " + to_string(clock.getLoopCount()));
+    check("not finished while looping", !clock.isFinished());
+}
+
+void tcApp::testSeekWhilePaused() {
+    MediaClock clock;
+    ClipPlayer clip(90, 30.0);  // 3 s
+    clock.add(clip);
+    clock.play();
+
+    int step = 0;
+    for (; step < 10; step++) clock.update(step / REFRESH);
+    clock.setPaused(true);
+    clock.seek(1.0);
+    clock.update(step++ / REFRESH);
+    check("seek shown while paused", clip.getCurrentFrame() == 30, to_string(clip.getCurrentFrame()));
+
+    for (int i = 0; i < 30; i++) clock.update(step++ / REFRESH);
+    check("paused clock holds", clock.getTime() == 1.0 && clip.getCurrentFrame() == 30,
+          to_string(clock.getTime()));
+
+    // Resuming doesn't catch up the paused interval
+    clock.setPaused(false);
+    for (int i = 0; i < 7; i++) clock.update(step++ / REFRESH);
+    check("resumes from the seek position", clip.getCurrentFrame() == 33, to_string(clip.getCurrentFrame()));
+}
+
+void tcApp::testWaitForAll() {
+    MediaClock clock;
+    ClipPlayer a(300, 30.0);
+    ClipPlayer b(300, 30.0);
+    clock.add(a);
+    clock.add(b);
+    clock.setWaitForAll(true, 0.5);
+    b.bufferedTime_ = 0.25;
+    clock.play();
+
+    int step = 0;
+    for (; step < 25; step++) clock.update(step / REFRESH);
+    double held = clock.getTime();
+    check("clock held at the lagging buffer", held <= 0.25 + 1.0 / 30.0 + 1e-9, to_string(held));
+    check("stalls counted", clock.getStallCount() > 0, to_string(clock.getStallCount()));
+    check("players show the same frame", a.getCurrentFrame() == b.getCurrentFrame());
+
+    b.bufferedTime_ = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < 10; i++) clock.update(step++ / REFRESH);
+    check("runs again once buffered", std::abs(clock.getTime() - (held + 10.0 / REFRESH)) < 1e-9,
+          to_string(clock.getTime()));
+}
+
+void tcApp::testFreeRunningDrift() {
+    MediaClock clock;
+    ClipPlayer native(600, 30.0, false);   // Can't be slaved (like AVFoundation)
+    clock.add(native);
+    clock.play();
+
+    int step = 0;
+    for (; step < 10; step++) clock.update(step / REFRESH);
+    // The player already stepped to the next refresh in its update()
+    auto drift = [&] { return native.getCurrentTime() - (clock.getTime() + 1.0 / REFRESH); };
+    check("starts in sync", std::abs(drift()) < 1e-3, to_string(drift()));
+
+    // 100 ms ahead: slowed down until caught up, then back to normal speed
+    native.time_ += 0.1;
+    float slowest = 1.0f;
+    for (int i = 0; i < 240; i++) {
+        clock.update(step++ / REFRESH);
+        slowest = std::min(slowest, native.getSpeed());
+    }
+    check("nudged by speed", slowest < 1.0f && slowest >= 0.95f, to_string(slowest));
+    check("caught up", std::abs(drift()) < 0.02 && native.getSpeed() == 1.0f,
+          "drift " + to_string(drift()) + ", speed " + to_string(native.getSpeed()));
+
+    // Too far off: hard seek
+    int seeks = native.seeks_;
+    native.time_ += 0.5;
+    clock.update(step++ / REFRESH);
+    check("hard seek on large drift", native.seeks_ == seeks + 1 && std::abs(drift()) < 0.02,
+          "drift " + to_string(drift()));
+}
+
+void tcApp::testEmptyClip() {
+    MediaClock clock;
+    ClipPlayer clip(60, 30.0);
+    ClipPlayer empty(0, 30.0);
+    clock.add(clip);
+    clock.add(empty);
+    clock.play();
+
+    for (int step = 0; step < 30; step++) clock.update(step / REFRESH);
+    check("other players unaffected", clip.getCurrentFrame() == 14, to_string(clip.getCurrentFrame()));
+    check("empty clip shows nothing", empty.getCurrentFrame() == 0 && !empty.isFrameNew());
+}
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+void tcApp::check(const string& name, bool ok, const string& detail) {
+    if (ok) {
+        passed_++;
+        logNotice("mediaClock") << "PASS " << name;
+    } else {
+        failed_++;
+        logError("mediaClock") << "FAIL " << name << (detail.empty() ? "" : " (" + detail + ")");
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <TrussC.h>
+#include <functional>
+using namespace std;
+using namespace tc;
+
+// =============================================================================
+// tcApp - Steps a MediaClock with explicit times and checks frame positions
+// =============================================================================
+
+class tcApp : public App {
+public:
+    void setup() override;
+    void update() override;
+
+private:
+    struct Case {
+        string name;
+        function<void()> run;
+    };
+    vector<Case> cases_;
+    size_t caseIndex_ = 0;
+
+    int passed_ = 0;
+    int failed_ = 0;
+
+    void testSlavedFrames();
+    void testRefreshStepping();
+    void testLoop();
+    void testSeekWhilePaused();
+    void testWaitForAll();
+    void testFreeRunningDrift();
+    void testEmptyClip();
+    void check(const string& name, bool ok, const string& detail = "");
+};
@@ -78,6 +78,8 @@
 #include "tc/utils/tcUtils.h"
 #include "tc/utils/tcTime.h"
 #include "tc/utils/tcLog.h"
+#include "tc/utils/tcProfiler.h"
+#include "tc/utils/tcFrameStats.h"
 
 // TrussC file dialogs
 #include "tc/utils/tcFileDialog.h"
@@ -370,6 +372,9 @@ inline void present() {
     // Skip in headless mode (no graphics context)
     if (headless::isActive()) return;
 
+    TC_PROFILE_SCOPE("present");
+    FrameStats::PhaseTimer statsTimer(frameStats(), FrameStats::Phase::Present);
+
     // Start swapchain pass now (deferred from clear()).
     // All sgl commands recorded during draw() will be submitted in this single pass.
     if (!internal::inSwapchainPass) {
@@ -383,11 +388,17 @@ inline void present() {
         internal::inSwapchainPass = true;
     }
 
+    // sokol_gl totals must be read before the flush rewinds the buffers
+    RenderStats renderStats;
+    renderStats.sglVertices = static_cast<uint32_t>(sgl_num_vertices());
+    renderStats.sglCommands = static_cast<uint32_t>(sgl_num_commands());
+
     // Flush sokol_gl layers and deferred shader draws
     flushDeferredShaderDraws();
 
     // Render ImGui on top of all sokol_gl content (deferred from imguiEnd)
     if (internal::imguiRenderPending) {
+        TC_PROFILE_SCOPE("ImGui::render");
         simgui_render();
         internal::imguiRenderPending = false;
     }
@@ -410,6 +421,19 @@ inline void present() {
     sg_end_pass();
     internal::inSwapchainPass = false;
     sg_commit();
+
+    // sokol_gfx moves the committed frame's counters to prev_frame
+    const sg_frame_stats gfx = sg_query_stats().prev_frame;
+    renderStats.passes = gfx.num_passes;
+    renderStats.drawCalls = gfx.num_draw + gfx.num_draw_ex;
+    renderStats.pipelineSwitches = gfx.num_apply_pipeline;
+    renderStats.bindingChanges = gfx.num_apply_bindings;
+    renderStats.uniformUploads = gfx.num_apply_uniforms;
+    renderStats.textureUploads = gfx.num_update_image;
+    renderStats.textureUploadBytes = gfx.size_update_image;
+    renderStats.bufferUploads = gfx.num_update_buffer + gfx.num_append_buffer;
+    renderStats.bufferUploadBytes = gfx.size_update_buffer + gfx.size_append_buffer;
+    frameStats().setRenderStats(renderStats);
 }
 
 // Get swapchain pass state (for FBO)
@@ -1013,6 +1037,32 @@ inline Vec3 screenToWorld(const Vec2& screenPos, float worldZ = 0.0f) {
     );
 }
 
+/// Convert screen coordinate to a world-space ray from the camera (for picking,
+/// e.g. MeshBVH::raycast). Call between cam.begin() and cam.end() like screenToWorld
+inline Ray screenToRay(const Vec2& screenPos) {
+    float viewW = internal::currentViewW;
+    float viewH = internal::currentViewH;
+    if (viewW == 0) viewW = (float)sapp_width() / sapp_dpi_scale();
+    if (viewH == 0) viewH = (float)sapp_height() / sapp_dpi_scale();
+
+    float ndcX = (screenPos.x / viewW) * 2.0f - 1.0f;
+    float ndcY = 1.0f - (screenPos.y / viewH) * 2.0f;  // Flip Y
+
+    Mat4 mvp = internal::currentProjectionMatrix * internal::currentViewMatrix;
+    Mat4 invMvp = mvp.inverted();
+
+    // Same near / middle points as screenToWorld
+    Vec4 nearClip = invMvp * Vec4(ndcX, ndcY, -1.0f, 1.0f);
+    Vec4 midClip = invMvp * Vec4(ndcX, ndcY, 0.0f, 1.0f);
+    if (std::abs(nearClip.w) < 1e-7f || std::abs(midClip.w) < 1e-7f) {
+        return Ray(Vec3(screenPos.x, screenPos.y, 0.0f), Vec3(0, 0, -1));
+    }
+
+    Vec3 nearPoint(nearClip.x / nearClip.w, nearClip.y / nearClip.w, nearClip.z / nearClip.w);
+    Vec3 midPoint(midClip.x / midClip.w, midClip.y / midClip.w, midClip.z / midClip.w);
+    return Ray(nearPoint, midPoint - nearPoint);
+}
+
 // Disable 3D drawing mode (return to 2D ortho)
 // Deprecated: use setupScreenOrtho() instead
 [[deprecated("Use setupScreenOrtho() instead")]]
@@ -1957,6 +2007,8 @@ namespace internal {
 
     inline void _frame_cb() {
         auto now = std::chrono::high_resolution_clock::now();
+        profiler().beginFrame();
+        frameStats().beginFrame();
 
         // Initialize timing
         if (!lastUpdateTimeInitialized) {
@@ -1968,20 +2020,26 @@ namespace internal {
             lastDrawTimeInitialized = true;
         }
 
-        // Process console input (fire events)
-        console::processQueue();
+        {
+            TC_PROFILE_SCOPE("processQueues");
 
-        // Process MCP HTTP requests on main thread
-        #ifndef __EMSCRIPTEN__
-        mcp::processHttpQueue();
-        #endif
+            // Process console input (fire events)
+            console::processQueue();
+
+            // Process MCP HTTP requests on main thread
+            #ifndef __EMSCRIPTEN__
+            mcp::processHttpQueue();
+            #endif
+        }
 
         // --- Update Loop processing ---
+        bool updated = false;
         if (updateSyncedToDraw) {
             // Synced to Draw: handled with shouldDraw below
         } else if (updateTargetFps == VSYNC) {
             // VSYNC mode (independent): update every frame
             if (appUpdateFunc) appUpdateFunc();
+            updated = true;
         } else if (updateTargetFps > 0) {
             // Independent fixed Hz Update
             double updateInterval = 1.0 / updateTargetFps;
@@ -1992,6 +2050,7 @@ namespace internal {
             while (updateAccumulator >= updateInterval) {
                 if (appUpdateFunc) appUpdateFunc();
                 updateAccumulator -= updateInterval;
+                updated = true;
             }
         }
         // If updateTargetFps == EVENT_DRIVEN (0), no Update (event-driven)
@@ -2042,9 +2101,16 @@ namespace internal {
             if (redrawCount > 0) {
                 redrawCount--;
             }
+
+            profiler().endFrame();
+            frameStats().endFrame();
         } else {
             // Skip Present when not drawing (prevent double-buffer flickering)
             sapp_skip_present();
+
+            // An update-only frame is a profiler frame of its own (idle
+            // frames stay open and are merged into the next one)
+            if (updated) profiler().endFrame();
         }
 
         // Save previous frame's mouse position
@@ -2066,6 +2132,8 @@ namespace internal {
     }
 
     inline void _event_cb(const sapp_event* ev) {
+        TC_PROFILE_SCOPE("events (input)");
+
         // Pass event to ImGui
         if (imguiEnabled) {
             simgui_handle_event(ev);
@@ -2260,15 +2328,30 @@ int runApp(const WindowSettings& settings = WindowSettings()) {
         // setup() is called automatically in updateTree() via setupCalled_ flag
     };
     internal::appUpdateFunc = []() {
+        TC_PROFILE_SCOPE("update");
+        FrameStats::PhaseTimer statsTimer(frameStats(), FrameStats::Phase::Update);
         internal::updateFrameCount++;  // Update frame count
-        events().update.notify();
+        {
+            TC_PROFILE_SCOPE("events().update");
+            events().update.notify();
+        }
         if (app) {
+            TC_PROFILE_SCOPE("Node::updateTree");
             app->handleUpdate(internal::mouseX, internal::mouseY);
         }
     };
     internal::appDrawFunc = []() {
-        events().draw.notify();
-        if (app) app->handleDraw();
+        TC_PROFILE_SCOPE("draw");
+        FrameStats::PhaseTimer statsTimer(frameStats(), FrameStats::Phase::Draw);
+        {
+            TC_PROFILE_SCOPE("events().draw");
+            events().draw.notify();
+        }
+        if (app) {
+            TC_PROFILE_SCOPE("Node::drawTree");
+            app->handleDraw();
+        }
+        events().afterDraw.notify();
     };
     internal::appCleanupFunc = []() {
         if (app) {
@@ -2382,6 +2465,7 @@ inline void bindCursorImage(Cursor cursor, const Image& image,
 
 // TrussC mesh
 #include "tc/graphics/tcMesh.h"
+#include "tc/3d/tcMeshBVH.h"
 
 // TrussC stroke mesh (thick line drawing)
 #include "tc/graphics/tcStrokeMesh.h"
@@ -2402,6 +2486,7 @@ inline void bindCursorImage(Cursor cursor, const Image& image,
 
 // TrussC video playback
 #include "tc/video/tcVideoPlayer.h"
+#include "tc/video/tcMediaClock.h"
 
 // TrussC 3D primitives
 #include <map>
@@ -2519,6 +2604,9 @@ inline void drawCone(float x, float y, float z, float radius, float height, int
 // TrussC headless mode (no window)
 #include "tc/app/tcHeadlessApp.h"
 
+// Asynchronous screenshots and image sequences (saveScreenshotAsync, FrameRecorder)
+#include "tc/graphics/tcImageEncoder.h"
+
 // =============================================================================
 // Standard library includes (convenience)
 // =============================================================================
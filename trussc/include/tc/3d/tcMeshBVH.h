@@ -0,0 +1,600 @@
+#pragma once
+
+// =============================================================================
+// tcMeshBVH.h - Bounding volume hierarchy over Mesh triangles
+// =============================================================================
+// This file is included from TrussC.h (after tcMesh.h)
+//
+// Ray picking and nearest-point queries that stay fast on scanned models
+// with millions of triangles:
+//
+//   MeshBVH bvh;
+//   bvh.build(mesh);                        // binned SAH, threads for big meshes
+//   MeshRayHit hit = bvh.raycast(ray);      // nearest triangle
+//   bvh.refit(mesh);                        // vertices moved, same triangles
+//
+// Triangles, TriangleStrip and TriangleFan meshes are supported (indexed or
+// not); other modes have no triangles. Vertex positions are copied, so the
+// Mesh may change afterwards: call refit() to follow moved vertices (fast,
+// but the tree degrades with large deformations) or build() again.
+// Queries are const and may run on several threads at once.
+// =============================================================================
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+
+namespace trussc {
+
+// Result of MeshBVH::raycast() / raycastAll()
+struct MeshRayHit {
+    int triangle = -1;              // Triangle number in Mesh order
+    unsigned int vertices[3] = {};  // Vertex indices of that triangle
+    float distance = 0;             // Ray t (distance for a normalized direction)
+    Vec3 point;                     // Hit position
+    Vec3 normal;                    // Geometric normal (counter-clockwise = front)
+    float u = 0, v = 0;             // point = (1 - u - v) * v0 + u * v1 + v * v2
+
+    bool hit() const { return triangle >= 0; }
+};
+
+// Result of MeshBVH::closestPoint()
+struct MeshClosestPoint {
+    int triangle = -1;
+    unsigned int vertices[3] = {};
+    float distance = 0;
+    Vec3 point;
+
+    bool found() const { return triangle >= 0; }
+};
+
+namespace bvh_detail {
+
+struct Bounds {
+    Vec3 min{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+             std::numeric_limits<float>::max()};
+    Vec3 max{-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(),
+             -std::numeric_limits<float>::max()};
+
+    void grow(const Vec3& p) {
+        min = Vec3(std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z));
+        max = Vec3(std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z));
+    }
+    void grow(const Bounds& b) {
+        min = Vec3(std::min(min.x, b.min.x), std::min(min.y, b.min.y), std::min(min.z, b.min.z));
+        max = Vec3(std::max(max.x, b.max.x), std::max(max.y, b.max.y), std::max(max.z, b.max.z));
+    }
+    // Half the surface area (the SAH only compares ratios)
+    float area() const {
+        Vec3 e = max - min;
+        return e.x * e.y + e.y * e.z + e.z * e.x;
+    }
+};
+
+// Leaf: count > 0, triangles [first, first + count)
+// Inner: count == 0, children at first and first + 1
+struct Node {
+    Vec3 min;
+    uint32_t first = 0;
+    Vec3 max;
+    uint32_t count = 0;
+};
+
+struct Tri {
+    uint32_t a, b, c;
+};
+
+// Ray entry distance into a box, or -1 if it misses within [0, limit]
+inline float enterBox(const Vec3& bmin, const Vec3& bmax, const Vec3& origin, const Vec3& invDir,
+                      float limit) {
+    float tx1 = (bmin.x - origin.x) * invDir.x, tx2 = (bmax.x - origin.x) * invDir.x;
+    float ty1 = (bmin.y - origin.y) * invDir.y, ty2 = (bmax.y - origin.y) * invDir.y;
+    float tz1 = (bmin.z - origin.z) * invDir.z, tz2 = (bmax.z - origin.z) * invDir.z;
+    float tmin = std::max({std::min(tx1, tx2), std::min(ty1, ty2), std::min(tz1, tz2), 0.0f});
+    float tmax = std::min({std::max(tx1, tx2), std::max(ty1, ty2), std::max(tz1, tz2), limit});
+    return tmin <= tmax ? tmin : -1.0f;
+}
+
+// Squared distance from p to a box (0 inside)
+inline float boxDistanceSquared(const Vec3& bmin, const Vec3& bmax, const Vec3& p) {
+    float dx = std::max({bmin.x - p.x, 0.0f, p.x - bmax.x});
+    float dy = std::max({bmin.y - p.y, 0.0f, p.y - bmax.y});
+    float dz = std::max({bmin.z - p.z, 0.0f, p.z - bmax.z});
+    return dx * dx + dy * dy + dz * dz;
+}
+
+// Moller-Trumbore; t in [0, limit)
+inline bool intersectTriangle(const Vec3& origin, const Vec3& dir, const Vec3& a, const Vec3& b,
+                              const Vec3& c, bool cullBackFaces, float limit,
+                              float& outT, float& outU, float& outV) {
+    Vec3 e1 = b - a;
+    Vec3 e2 = c - a;
+    Vec3 p = dir.cross(e2);
+    float det = e1.dot(p);
+    // det > 0: the ray meets the counter-clockwise (front) side
+    if (cullBackFaces ? det <= 0.0f : det == 0.0f) return false;
+    float invDet = 1.0f / det;
+    Vec3 s = origin - a;
+    float u = s.dot(p) * invDet;
+    if (u < 0.0f || u > 1.0f) return false;
+    Vec3 q = s.cross(e1);
+    float v = dir.dot(q) * invDet;
+    if (v < 0.0f || u + v > 1.0f) return false;
+    float t = e2.dot(q) * invDet;
+    if (t < 0.0f || t >= limit) return false;
+    outT = t;
+    outU = u;
+    outV = v;
+    return true;
+}
+
+// Closest point on triangle abc to p (Ericson, Real-Time Collision Detection 5.1.5)
+inline Vec3 closestOnTriangle(const Vec3& p, const Vec3& a, const Vec3& b, const Vec3& c) {
+    Vec3 ab = b - a, ac = c - a, ap = p - a;
+    float d1 = ab.dot(ap), d2 = ac.dot(ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+    Vec3 bp = p - b;
+    float d3 = ab.dot(bp), d4 = ac.dot(bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + ab * (d1 / (d1 - d3));
+
+    Vec3 cp = p - c;
+    float d5 = ab.dot(cp), d6 = ac.dot(cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + ac * (d2 / (d2 - d6));
+
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    float denom = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+} // namespace bvh_detail
+
+// =============================================================================
+// MeshBVH
+// =============================================================================
+
+class MeshBVH {
+public:
+    MeshBVH() = default;
+    explicit MeshBVH(const Mesh& mesh, bool parallel = true) { build(mesh, parallel); }
+
+    // -------------------------------------------------------------------------
+    // Build / refit
+    // -------------------------------------------------------------------------
+
+    // Build from the mesh triangles. parallel: split the upper levels of
+    // large meshes (64K+ triangles) across threads
+    void build(const Mesh& mesh, bool parallel = true) {
+        clear();
+        positions_ = mesh.getVertices();
+        std::vector<bvh_detail::Tri> tris;
+        std::vector<uint32_t> ids;
+        collectTriangles(mesh, tris, ids);
+        if (tris.empty()) return;
+
+        // Per-triangle bounds and centroids
+        const uint32_t count = static_cast<uint32_t>(tris.size());
+        BuildContext ctx;
+        ctx.items.resize(count);
+        for (uint32_t i = 0; i < count; i++) {
+            BuildItem& item = ctx.items[i];
+            item.bounds.grow(positions_[tris[i].a]);
+            item.bounds.grow(positions_[tris[i].b]);
+            item.bounds.grow(positions_[tris[i].c]);
+            item.centroid = (item.bounds.min + item.bounds.max) * 0.5f;
+            item.index = i;
+        }
+
+        // A binary tree with at least one triangle per leaf has < 2N nodes
+        nodes_.resize(static_cast<size_t>(count) * 2);
+        ctx.nodeCount = 1;
+        if (parallel) {
+            unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+            while ((1u << ctx.parallelDepth) < threads && ctx.parallelDepth < 6) ctx.parallelDepth++;
+        }
+        subdivide(ctx, 0, 0, count, 0);
+        nodes_.resize(ctx.nodeCount);
+        nodes_.shrink_to_fit();
+
+        // Store triangles in leaf order
+        tris_.resize(count);
+        ids_.resize(count);
+        for (uint32_t i = 0; i < count; i++) {
+            tris_[i] = tris[ctx.items[i].index];
+            ids_[i] = ids[ctx.items[i].index];
+        }
+    }
+
+    // Update bounds after vertices moved (same vertex count and triangles).
+    // Falls back to build() when the vertex count changed
+    void refit(const Mesh& mesh) {
+        if (nodes_.empty() || mesh.getVertices().size() != positions_.size()) {
+            build(mesh);
+            return;
+        }
+        positions_ = mesh.getVertices();
+        // Children are always allocated after their parent: walk backwards
+        for (size_t i = nodes_.size(); i-- > 0;) {
+            bvh_detail::Node& node = nodes_[i];
+            bvh_detail::Bounds b;
+            if (node.count > 0) {
+                for (uint32_t t = node.first; t < node.first + node.count; t++) {
+                    b.grow(positions_[tris_[t].a]);
+                    b.grow(positions_[tris_[t].b]);
+                    b.grow(positions_[tris_[t].c]);
+                }
+            } else {
+                const bvh_detail::Node& left = nodes_[node.first];
+                const bvh_detail::Node& right = nodes_[node.first + 1];
+                b.grow(left.min);
+                b.grow(left.max);
+                b.grow(right.min);
+                b.grow(right.max);
+            }
+            node.min = b.min;
+            node.max = b.max;
+        }
+    }
+
+    void clear() {
+        nodes_.clear();
+        tris_.clear();
+        ids_.clear();
+        positions_.clear();
+    }
+
+    bool empty() const { return nodes_.empty(); }
+    int getNumTriangles() const { return static_cast<int>(tris_.size()); }
+    int getNumNodes() const { return static_cast<int>(nodes_.size()); }
+    Vec3 getBoundsMin() const { return nodes_.empty() ? Vec3() : nodes_[0].min; }
+    Vec3 getBoundsMax() const { return nodes_.empty() ? Vec3() : nodes_[0].max; }
+
+    // -------------------------------------------------------------------------
+    // Queries
+    // -------------------------------------------------------------------------
+
+    // Nearest triangle along the ray within maxDistance
+    MeshRayHit raycast(const Ray& ray, float maxDistance = std::numeric_limits<float>::max(),
+                       bool cullBackFaces = false) const {
+        MeshRayHit result;
+        float best = maxDistance;
+        int bestIndex = -1;
+        float bestU = 0, bestV = 0;
+        traverseRay(ray, best, [&](uint32_t i, float& limit) {
+            float t, u, v;
+            if (intersect(ray, i, cullBackFaces, limit, t, u, v)) {
+                limit = t;
+                bestIndex = static_cast<int>(i);
+                bestU = u;
+                bestV = v;
+            }
+        });
+        if (bestIndex >= 0) fillHit(ray, static_cast<uint32_t>(bestIndex), best, bestU, bestV, result);
+        return result;
+    }
+
+    // Every triangle along the ray within maxDistance, nearest first
+    std::vector<MeshRayHit> raycastAll(const Ray& ray, float maxDistance = std::numeric_limits<float>::max(),
+                                       bool cullBackFaces = false) const {
+        std::vector<MeshRayHit> hits;
+        float limit = maxDistance;
+        traverseRay(ray, limit, [&](uint32_t i, float& l) {
+            float t, u, v;
+            if (intersect(ray, i, cullBackFaces, l, t, u, v)) {
+                hits.emplace_back();
+                fillHit(ray, i, t, u, v, hits.back());
+            }
+        });
+        std::sort(hits.begin(), hits.end(), [](const MeshRayHit& a, const MeshRayHit& b) {
+            return a.distance < b.distance;
+        });
+        return hits;
+    }
+
+    // Nearest point on the surface within maxDistance
+    MeshClosestPoint closestPoint(const Vec3& p, float maxDistance = std::numeric_limits<float>::max()) const {
+        MeshClosestPoint result;
+        if (nodes_.empty()) return result;
+
+        float bestSq = maxDistance < std::numeric_limits<float>::max()
+            ? maxDistance * maxDistance : std::numeric_limits<float>::max();
+        int bestIndex = -1;
+        Vec3 bestPoint;
+
+        // Nodes with their box distance; skipped if something closer was found since
+        StackEntry stack[STACK_SIZE];
+        int top = 0;
+        float rootSq = bvh_detail::boxDistanceSquared(nodes_[0].min, nodes_[0].max, p);
+        if (rootSq <= bestSq) stack[top++] = {0, rootSq};
+        while (top > 0) {
+            StackEntry entry = stack[--top];
+            if (entry.key > bestSq) continue;
+            const bvh_detail::Node& node = nodes_[entry.node];
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                    const bvh_detail::Tri& tri = tris_[i];
+                    Vec3 q = bvh_detail::closestOnTriangle(p, positions_[tri.a], positions_[tri.b],
+                                                           positions_[tri.c]);
+                    float d = q.distanceSquared(p);
+                    if (d <= bestSq) {
+                        bestSq = d;
+                        bestIndex = static_cast<int>(i);
+                        bestPoint = q;
+                    }
+                }
+                continue;
+            }
+            // Visit the nearer child first (pushed last)
+            uint32_t nearChild = node.first, farChild = node.first + 1;
+            float dNear = bvh_detail::boxDistanceSquared(nodes_[nearChild].min, nodes_[nearChild].max, p);
+            float dFar = bvh_detail::boxDistanceSquared(nodes_[farChild].min, nodes_[farChild].max, p);
+            if (dFar < dNear) {
+                std::swap(nearChild, farChild);
+                std::swap(dNear, dFar);
+            }
+            if (dFar <= bestSq) stack[top++] = {farChild, dFar};
+            if (dNear <= bestSq) stack[top++] = {nearChild, dNear};
+        }
+
+        if (bestIndex >= 0) {
+            const bvh_detail::Tri& tri = tris_[bestIndex];
+            result.triangle = static_cast<int>(ids_[bestIndex]);
+            result.vertices[0] = tri.a;
+            result.vertices[1] = tri.b;
+            result.vertices[2] = tri.c;
+            result.distance = std::sqrt(bestSq);
+            result.point = bestPoint;
+        }
+        return result;
+    }
+
+private:
+    std::vector<bvh_detail::Node> nodes_;   // nodes_[0] is the root
+    std::vector<bvh_detail::Tri> tris_;     // Leaf order
+    std::vector<uint32_t> ids_;             // Mesh triangle number per tris_ entry
+    std::vector<Vec3> positions_;
+
+    static constexpr int BINS = 16;
+    static constexpr uint32_t MAX_LEAF_SIZE = 8;        // Forced split above this
+    static constexpr uint32_t PARALLEL_MIN_SIZE = 65536;
+    // Median splits below this depth keep the tree under STACK_SIZE levels
+    static constexpr int MAX_SAH_DEPTH = 64;
+    static constexpr int STACK_SIZE = 128;
+
+    struct StackEntry {
+        uint32_t node;
+        float key;      // Ray entry t or squared box distance
+    };
+
+    // Moved with the partition so every pass reads memory in order
+    struct BuildItem {
+        bvh_detail::Bounds bounds;
+        Vec3 centroid;
+        uint32_t index;     // Into the collected triangles
+    };
+
+    struct BuildContext {
+        std::vector<BuildItem> items;           // Partitioned in place
+        std::atomic<uint32_t> nodeCount{0};
+        int parallelDepth = 0;
+    };
+
+    // Mesh triangles as vertex indices; out-of-range triangles are skipped
+    static void collectTriangles(const Mesh& mesh, std::vector<bvh_detail::Tri>& tris,
+                                 std::vector<uint32_t>& ids) {
+        const auto& indices = mesh.getIndices();
+        const size_t numVertices = mesh.getVertices().size();
+        const bool indexed = mesh.hasIndices();
+        const size_t n = indexed ? indices.size() : numVertices;
+        auto at = [&](size_t i) { return indexed ? indices[i] : static_cast<uint32_t>(i); };
+
+        uint32_t number = 0;
+        auto add = [&](size_t i0, size_t i1, size_t i2) {
+            bvh_detail::Tri tri{at(i0), at(i1), at(i2)};
+            if (tri.a < numVertices && tri.b < numVertices && tri.c < numVertices) {
+                tris.push_back(tri);
+                ids.push_back(number);
+            }
+            number++;
+        };
+
+        switch (mesh.getMode()) {
+            case PrimitiveMode::Triangles:
+                tris.reserve(n / 3);
+                ids.reserve(n / 3);
+                for (size_t i = 0; i + 2 < n; i += 3) add(i, i + 1, i + 2);
+                break;
+            case PrimitiveMode::TriangleStrip:
+                // Every other triangle is flipped to keep the winding
+                for (size_t i = 0; i + 2 < n; i++) {
+                    if (i % 2 == 0) add(i, i + 1, i + 2);
+                    else add(i + 1, i, i + 2);
+                }
+                break;
+            case PrimitiveMode::TriangleFan:
+                for (size_t i = 1; i + 1 < n; i++) add(0, i, i + 1);
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Binned SAH split of items[first, first + count) into nodes_[nodeIndex]
+    void subdivide(BuildContext& ctx, uint32_t nodeIndex, uint32_t first, uint32_t count, int depth) {
+        using bvh_detail::Bounds;
+
+        Bounds bounds, centroidBounds;
+        for (uint32_t i = first; i < first + count; i++) {
+            bounds.grow(ctx.items[i].bounds);
+            centroidBounds.grow(ctx.items[i].centroid);
+        }
+        bvh_detail::Node& node = nodes_[nodeIndex];
+        node.min = bounds.min;
+        node.max = bounds.max;
+        node.first = first;
+        node.count = count;
+        if (count <= 2) return;
+
+        // Bin centroids on all three axes in one pass
+        float lo[3], scale[3];
+        bool splittable[3];
+        for (int axis = 0; axis < 3; axis++) {
+            float extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+            lo[axis] = centroidBounds.min[axis];
+            scale[axis] = extent > 0.0f ? BINS / extent : 0.0f;
+            splittable[axis] = extent > 0.0f && depth < MAX_SAH_DEPTH;
+        }
+        auto binOf = [&](const BuildItem& item, int axis) {
+            return std::min(BINS - 1, static_cast<int>((item.centroid[axis] - lo[axis]) * scale[axis]));
+        };
+
+        Bounds binBounds[3][BINS];
+        uint32_t binCount[3][BINS] = {};
+        if (splittable[0] || splittable[1] || splittable[2]) {
+            for (uint32_t i = first; i < first + count; i++) {
+                const BuildItem& item = ctx.items[i];
+                for (int axis = 0; axis < 3; axis++) {
+                    int b = binOf(item, axis);
+                    binBounds[axis][b].grow(item.bounds);
+                    binCount[axis][b]++;
+                }
+            }
+        }
+
+        // Best plane: cost = area(L) * n(L) + area(R) * n(R)
+        int bestAxis = -1, bestPlane = 0;
+        float bestCost = std::numeric_limits<float>::max();
+        for (int axis = 0; axis < 3; axis++) {
+            if (!splittable[axis]) continue;
+            // Sweep: left side of plane p holds bins [0, p]
+            float leftCost[BINS - 1];
+            Bounds acc;
+            uint32_t n = 0;
+            for (int p = 0; p < BINS - 1; p++) {
+                n += binCount[axis][p];
+                if (binCount[axis][p] > 0) acc.grow(binBounds[axis][p]);
+                leftCost[p] = n > 0 ? acc.area() * n : 0.0f;
+            }
+            acc = Bounds();
+            n = 0;
+            for (int p = BINS - 1; p > 0; p--) {
+                n += binCount[axis][p];
+                if (binCount[axis][p] > 0) acc.grow(binBounds[axis][p]);
+                float cost = leftCost[p - 1] + (n > 0 ? acc.area() * n : 0.0f);
+                if (n > 0 && n < count && cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestPlane = p - 1;
+                }
+            }
+        }
+
+        // Leaf if splitting doesn't pay (intersection cost 1, traversal cost 1)
+        if (count <= MAX_LEAF_SIZE && (bestAxis < 0 || bestCost + bounds.area() >= bounds.area() * count)) {
+            return;
+        }
+
+        uint32_t leftCount = 0;
+        auto begin = ctx.items.begin() + first;
+        if (bestAxis >= 0) {
+            auto mid = std::partition(begin, begin + count, [&](const BuildItem& item) {
+                return binOf(item, bestAxis) <= bestPlane;
+            });
+            leftCount = static_cast<uint32_t>(mid - begin);
+        }
+        if (leftCount == 0 || leftCount == count) {
+            // Too deep or no usable plane: median along the longest centroid axis
+            Vec3 extent = centroidBounds.max - centroidBounds.min;
+            int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+            leftCount = count / 2;
+            std::nth_element(begin, begin + leftCount, begin + count, [&](const BuildItem& a, const BuildItem& b) {
+                return a.centroid[axis] < b.centroid[axis];
+            });
+        }
+
+        uint32_t left = ctx.nodeCount.fetch_add(2);
+        node.first = left;
+        node.count = 0;
+
+        if (depth < ctx.parallelDepth && count >= PARALLEL_MIN_SIZE) {
+            std::thread worker([&, left, first, leftCount, depth] {
+                subdivide(ctx, left, first, leftCount, depth + 1);
+            });
+            subdivide(ctx, left + 1, first + leftCount, count - leftCount, depth + 1);
+            worker.join();
+        } else {
+            subdivide(ctx, left, first, leftCount, depth + 1);
+            subdivide(ctx, left + 1, first + leftCount, count - leftCount, depth + 1);
+        }
+    }
+
+    bool intersect(const Ray& ray, uint32_t i, bool cullBackFaces, float limit,
+                   float& t, float& u, float& v) const {
+        const bvh_detail::Tri& tri = tris_[i];
+        return bvh_detail::intersectTriangle(ray.origin, ray.direction, positions_[tri.a],
+                                             positions_[tri.b], positions_[tri.c],
+                                             cullBackFaces, limit, t, u, v);
+    }
+
+    // Calls leafTriangle(index, limit) for triangles in boxes the ray enters
+    // before limit; the callback may shrink limit to prune the rest
+    template <typename Fn>
+    void traverseRay(const Ray& ray, float& limit, Fn&& leafTriangle) const {
+        if (nodes_.empty()) return;
+        const Vec3 invDir(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+
+        StackEntry stack[STACK_SIZE];
+        int top = 0;
+        float rootT = bvh_detail::enterBox(nodes_[0].min, nodes_[0].max, ray.origin, invDir, limit);
+        if (rootT >= 0.0f) stack[top++] = {0, rootT};
+        while (top > 0) {
+            StackEntry entry = stack[--top];
+            if (entry.key > limit) continue;
+            const bvh_detail::Node& node = nodes_[entry.node];
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                    leafTriangle(i, limit);
+                }
+                continue;
+            }
+            uint32_t nearChild = node.first, farChild = node.first + 1;
+            float tNear = bvh_detail::enterBox(nodes_[nearChild].min, nodes_[nearChild].max, ray.origin, invDir, limit);
+            float tFar = bvh_detail::enterBox(nodes_[farChild].min, nodes_[farChild].max, ray.origin, invDir, limit);
+            if (tNear < 0.0f || (tFar >= 0.0f && tFar < tNear)) {
+                std::swap(nearChild, farChild);
+                std::swap(tNear, tFar);
+            }
+            if (tFar >= 0.0f) stack[top++] = {farChild, tFar};
+            if (tNear >= 0.0f) stack[top++] = {nearChild, tNear};
+        }
+    }
+
+    void fillHit(const Ray& ray, uint32_t i, float t, float u, float v, MeshRayHit& hit) const {
+        const bvh_detail::Tri& tri = tris_[i];
+        const Vec3& a = positions_[tri.a];
+        hit.triangle = static_cast<int>(ids_[i]);
+        hit.vertices[0] = tri.a;
+        hit.vertices[1] = tri.b;
+        hit.vertices[2] = tri.c;
+        hit.distance = t;
+        hit.point = ray.at(t);
+        hit.normal = (positions_[tri.b] - a).cross(positions_[tri.c] - a).normalized();
+        hit.u = u;
+        hit.v = v;
+    }
+};
+
+} // namespace trussc
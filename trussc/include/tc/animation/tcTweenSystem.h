@@ -0,0 +1,529 @@
+#pragma once
+
+// =============================================================================
+// tcTweenSystem.h - Batched tween engine for many concurrent tweens
+// =============================================================================
+//
+// Usage:
+//   auto id = tweens().moveTo(node, Vec3(100, 200, 0), 0.5f, EaseType::Cubic);
+//   tweens().scaleTo(node, Vec3(2, 2, 1), 0.5f);
+//   tweens().animate(&particle.alpha, 1.0f, 0.0f, 2.0f, EaseType::Quad, EaseMode::Out);
+//   tweens().onComplete(id, [] { logNotice() << "done"; });
+//   tweens().cancelAll(node.get());               // all tweens of a node
+//
+// Unlike TweenMod (one Mod per node, updated through a virtual call), all
+// tweens live in one system. They are stored as structure-of-arrays grouped
+// by easing curve, so progress and easing run as tight per-group loops the
+// compiler can vectorize, followed by one write-back pass. Completion
+// callbacks fire in a batch after every group has been updated.
+//
+// The global tweens() instance updates itself before the app's update
+// (events().update, BeforeApp). Tweens write Node properties while the node
+// is alive; raw float targets must outlive their tween.
+//
+// =============================================================================
+
+#include "tcNode.h"
+#include "tcEasing.h"
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <unordered_map>
+
+namespace trussc {
+
+using TweenId = uint64_t;
+
+// What a tween writes to
+enum class TweenTarget : uint8_t {
+    Pos,        // Node::setPos (3 components)
+    Scale,      // Node::setScale (3 components)
+    Rot,        // Node::setRot (1 component, radians)
+    Float       // float* (1-3 consecutive floats)
+};
+
+// Full description of one tween (see the convenience functions below)
+struct TweenDesc {
+    TweenTarget target = TweenTarget::Float;
+    std::shared_ptr<Node> node;     // Pos / Scale / Rot
+    float* value = nullptr;         // Float
+    int components = 1;             // Float: 1-3
+    float from[3] = {0.0f, 0.0f, 0.0f};
+    float to[3] = {0.0f, 0.0f, 0.0f};
+    float duration = 1.0f;
+    float delay = 0.0f;
+    EaseType easeType = EaseType::Cubic;
+    EaseMode easeMode = EaseMode::InOut;
+};
+
+class TweenSystem {
+public:
+    // Ids of the tweens that finished in the last update (batched)
+    Event<std::vector<TweenId>> completed;
+
+    TweenSystem() = default;
+    ~TweenSystem() = default;
+    TweenSystem(const TweenSystem&) = delete;
+    TweenSystem& operator=(const TweenSystem&) = delete;
+
+    // -------------------------------------------------------------------------
+    // Adding tweens (from = current value)
+    // -------------------------------------------------------------------------
+
+    TweenId moveTo(const std::shared_ptr<Node>& node, const Vec3& to, float duration,
+                   EaseType type = EaseType::Cubic, EaseMode mode = EaseMode::InOut, float delay = 0.0f) {
+        if (!node) return 0;
+        TweenDesc desc = makeDesc(TweenTarget::Pos, duration, type, mode, delay);
+        desc.node = node;
+        setVec(desc, node->getPos(), to);
+        return add(desc);
+    }
+
+    TweenId scaleTo(const std::shared_ptr<Node>& node, const Vec3& to, float duration,
+                    EaseType type = EaseType::Cubic, EaseMode mode = EaseMode::InOut, float delay = 0.0f) {
+        if (!node) return 0;
+        TweenDesc desc = makeDesc(TweenTarget::Scale, duration, type, mode, delay);
+        desc.node = node;
+        setVec(desc, node->getScale(), to);
+        return add(desc);
+    }
+
+    TweenId rotateTo(const std::shared_ptr<Node>& node, float radians, float duration,
+                     EaseType type = EaseType::Cubic, EaseMode mode = EaseMode::InOut, float delay = 0.0f) {
+        if (!node) return 0;
+        TweenDesc desc = makeDesc(TweenTarget::Rot, duration, type, mode, delay);
+        desc.node = node;
+        desc.from[0] = node->getRot();
+        desc.to[0] = radians;
+        return add(desc);
+    }
+
+    TweenId animate(float* value, float from, float to, float duration,
+                    EaseType type = EaseType::Cubic, EaseMode mode = EaseMode::InOut, float delay = 0.0f) {
+        TweenDesc desc = makeDesc(TweenTarget::Float, duration, type, mode, delay);
+        desc.value = value;
+        desc.from[0] = from;
+        desc.to[0] = to;
+        return add(desc);
+    }
+
+    TweenId animate(Vec2* value, const Vec2& from, const Vec2& to, float duration,
+                    EaseType type = EaseType::Cubic, EaseMode mode = EaseMode::InOut, float delay = 0.0f) {
+        TweenDesc desc = makeDesc(TweenTarget::Float, duration, type, mode, delay);
+        desc.value = &value->x;
+        desc.components = 2;
+        setVec(desc, Vec3(from.x, from.y, 0.0f), Vec3(to.x, to.y, 0.0f));
+        return add(desc);
+    }
+
+    TweenId animate(Vec3* value, const Vec3& from, const Vec3& to, float duration,
+                    EaseType type = EaseType::Cubic, EaseMode mode = EaseMode::InOut, float delay = 0.0f) {
+        TweenDesc desc = makeDesc(TweenTarget::Float, duration, type, mode, delay);
+        desc.value = &value->x;
+        desc.components = 3;
+        setVec(desc, from, to);
+        return add(desc);
+    }
+
+    TweenId add(const TweenDesc& desc) {
+        ensureListening();
+
+        Group& g = groups_[groupIndex(desc.easeType, desc.easeMode)];
+        uint32_t slot = allocSlot();
+        uint32_t index = static_cast<uint32_t>(g.ids.size());
+        slots_[slot].group = groupIndex(desc.easeType, desc.easeMode);
+        slots_[slot].index = index;
+        TweenId id = makeId(slot, slots_[slot].generation);
+
+        float duration = std::max(desc.duration, 0.0f);
+        g.elapsed.push_back(-std::max(desc.delay, 0.0f));
+        g.invDuration.push_back(duration > 0.0f ? 1.0f / duration : 0.0f);
+        g.eased.push_back(0.0f);
+        for (int c = 0; c < 3; ++c) {
+            g.from[c].push_back(desc.from[c]);
+            g.delta[c].push_back(desc.to[c] - desc.from[c]);
+        }
+        void* ptr = desc.target == TweenTarget::Float ? static_cast<void*>(desc.value)
+                                                      : static_cast<void*>(desc.node.get());
+        g.targets.push_back(Target{ptr, desc.target, static_cast<uint8_t>(std::clamp(desc.components, 1, 3))});
+        g.owners.push_back(desc.node);
+        g.ids.push_back(id);
+        count_++;
+        return id;
+    }
+
+    // Called once when the tween finishes (not when cancelled)
+    bool onComplete(TweenId id, std::function<void()> callback) {
+        if (!isActive(id)) return false;
+        callbacks_[id] = std::move(callback);
+        return true;
+    }
+
+    // -------------------------------------------------------------------------
+    // Control
+    // -------------------------------------------------------------------------
+
+    // Stop without writing the end value or firing callbacks
+    bool cancel(TweenId id) {
+        const Slot* s = findSlot(id);
+        if (!s) return false;
+        removeAt(s->group, s->index);
+        callbacks_.erase(id);
+        return true;
+    }
+
+    // Stop all tweens of a node
+    size_t cancelAll(const Node* node) {
+        size_t removed = 0;
+        for (uint32_t gi = 0; gi < GROUP_COUNT; ++gi) {
+            Group& g = groups_[gi];
+            for (size_t i = g.ids.size(); i-- > 0;) {
+                if (g.targets[i].isNode() && g.targets[i].ptr == node) {
+                    callbacks_.erase(g.ids[i]);
+                    removeAt(gi, static_cast<uint32_t>(i));
+                    removed++;
+                }
+            }
+        }
+        return removed;
+    }
+
+    // Jump to the end value and complete now (fires callbacks)
+    bool finish(TweenId id) {
+        const Slot* s = findSlot(id);
+        if (!s) return false;
+        Group& g = groups_[s->group];
+        g.eased[s->index] = 1.0f;
+        if (!g.targets[s->index].isNode() || !g.owners[s->index].expired()) writeBack(g, s->index);
+        removeAt(s->group, s->index);
+        finished_.push_back(id);
+        fireCompleted();
+        return true;
+    }
+
+    void clear() {
+        for (auto& g : groups_) g.clear();
+        for (uint32_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i].index != INVALID) releaseSlot(i);
+        }
+        callbacks_.clear();
+        count_ = 0;
+    }
+
+    bool isActive(TweenId id) const { return findSlot(id) != nullptr; }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    void setPaused(bool paused) { paused_ = paused; }
+    bool isPaused() const { return paused_; }
+
+    // Update from events().update (default). Disable to call update() yourself.
+    void setAutoUpdate(bool enabled) {
+        autoUpdate_ = enabled;
+        if (!enabled) updateListener_.disconnect();
+    }
+    bool isAutoUpdate() const { return autoUpdate_; }
+
+    // -------------------------------------------------------------------------
+    // Update
+    // -------------------------------------------------------------------------
+
+    void update(float deltaTime) {
+        if (paused_ || count_ == 0) return;
+        TC_PROFILE_SCOPE("TweenSystem::update");
+
+        for (uint32_t gi = 0; gi < GROUP_COUNT; ++gi) {
+            Group& g = groups_[gi];
+            if (g.ids.empty()) continue;
+            applyEasing(g, groupType(gi), groupMode(gi), deltaTime);
+
+            // Write back, then swap-remove finished / orphaned tweens from
+            // the back so the indices still to be removed stay valid
+            const size_t n = g.ids.size();
+            const float* elapsed = g.elapsed.data();
+            const float* invDuration = g.invDuration.data();
+            const Target* targets = g.targets.data();
+            for (size_t i = 0; i < n; ++i) {
+                if (elapsed[i] < 0.0f) continue;  // Delayed
+                if (targets[i].isNode() && g.owners[i].expired()) {
+                    removals_.push_back(static_cast<uint32_t>(i) | ORPHANED);
+                    continue;
+                }
+                writeBack(g, i);
+                if (invDuration[i] == 0.0f || elapsed[i] * invDuration[i] >= 1.0f) {
+                    removals_.push_back(static_cast<uint32_t>(i));
+                }
+            }
+            for (size_t r = removals_.size(); r-- > 0;) {
+                uint32_t i = removals_[r] & ~ORPHANED;
+                if (removals_[r] & ORPHANED) {
+                    callbacks_.erase(g.ids[i]);
+                } else {
+                    finished_.push_back(g.ids[i]);
+                }
+                removeAt(gi, i);
+            }
+            removals_.clear();
+        }
+
+        fireCompleted();
+    }
+
+private:
+    // -------------------------------------------------------------------------
+    // Storage
+    // -------------------------------------------------------------------------
+
+    static constexpr uint32_t EASE_TYPE_COUNT = static_cast<uint32_t>(EaseType::Bounce) + 1;
+    static constexpr uint32_t GROUP_COUNT = EASE_TYPE_COUNT * 3;
+    static constexpr uint32_t INVALID = 0xffffffffu;
+    static constexpr uint32_t ORPHANED = 0x80000000u;   // Flag in removals_
+
+    // Per-tween write-back destination
+    struct Target {
+        void* ptr;              // Node* or float*
+        TweenTarget kind;
+        uint8_t components;
+        bool isNode() const { return kind != TweenTarget::Float; }
+    };
+
+    // One easing curve; every array is indexed by the same tween index
+    struct Group {
+        std::vector<float> elapsed;         // Negative while delayed
+        std::vector<float> invDuration;     // 0 = zero duration
+        std::vector<float> eased;           // Scratch: eased progress
+        std::vector<float> from[3];
+        std::vector<float> delta[3];        // to - from
+        std::vector<Target> targets;
+        std::vector<std::weak_ptr<Node>> owners;
+        std::vector<TweenId> ids;
+
+        void clear() {
+            elapsed.clear(); invDuration.clear(); eased.clear();
+            for (int c = 0; c < 3; ++c) { from[c].clear(); delta[c].clear(); }
+            targets.clear(); owners.clear(); ids.clear();
+        }
+    };
+
+    struct Slot {
+        uint32_t group = 0;
+        uint32_t index = INVALID;   // INVALID = free
+        uint32_t generation = 1;
+    };
+
+    static uint32_t groupIndex(EaseType type, EaseMode mode) {
+        return static_cast<uint32_t>(type) * 3 + static_cast<uint32_t>(mode);
+    }
+    static EaseType groupType(uint32_t gi) { return static_cast<EaseType>(gi / 3); }
+    static EaseMode groupMode(uint32_t gi) { return static_cast<EaseMode>(gi % 3); }
+
+    static TweenId makeId(uint32_t slot, uint32_t generation) {
+        return (static_cast<uint64_t>(generation) << 32) | slot;
+    }
+
+    static TweenDesc makeDesc(TweenTarget target, float duration, EaseType type, EaseMode mode, float delay) {
+        TweenDesc desc;
+        desc.target = target;
+        desc.duration = duration;
+        desc.easeType = type;
+        desc.easeMode = mode;
+        desc.delay = delay;
+        return desc;
+    }
+
+    static void setVec(TweenDesc& desc, const Vec3& from, const Vec3& to) {
+        desc.from[0] = from.x; desc.from[1] = from.y; desc.from[2] = from.z;
+        desc.to[0] = to.x; desc.to[1] = to.y; desc.to[2] = to.z;
+    }
+
+    const Slot* findSlot(TweenId id) const {
+        uint32_t slot = static_cast<uint32_t>(id & 0xffffffffu);
+        uint32_t generation = static_cast<uint32_t>(id >> 32);
+        if (slot >= slots_.size()) return nullptr;
+        const Slot& s = slots_[slot];
+        if (s.index == INVALID || s.generation != generation) return nullptr;
+        return &s;
+    }
+
+    uint32_t allocSlot() {
+        if (!freeSlots_.empty()) {
+            uint32_t slot = freeSlots_.back();
+            freeSlots_.pop_back();
+            return slot;
+        }
+        slots_.emplace_back();
+        return static_cast<uint32_t>(slots_.size() - 1);
+    }
+
+    void releaseSlot(uint32_t slot) {
+        slots_[slot].index = INVALID;
+        slots_[slot].generation++;
+        freeSlots_.push_back(slot);
+    }
+
+    // Swap-remove; the last tween of the group takes index i
+    void removeAt(uint32_t gi, uint32_t i) {
+        Group& g = groups_[gi];
+        uint32_t last = static_cast<uint32_t>(g.ids.size() - 1);
+        releaseSlot(static_cast<uint32_t>(g.ids[i] & 0xffffffffu));
+        if (i != last) {
+            g.elapsed[i] = g.elapsed[last];
+            g.invDuration[i] = g.invDuration[last];
+            g.eased[i] = g.eased[last];
+            for (int c = 0; c < 3; ++c) {
+                g.from[c][i] = g.from[c][last];
+                g.delta[c][i] = g.delta[c][last];
+            }
+            g.targets[i] = g.targets[last];
+            g.owners[i] = std::move(g.owners[last]);
+            g.ids[i] = g.ids[last];
+            slots_[g.ids[i] & 0xffffffffu].index = i;
+        }
+        g.elapsed.pop_back();
+        g.invDuration.pop_back();
+        g.eased.pop_back();
+        for (int c = 0; c < 3; ++c) {
+            g.from[c].pop_back();
+            g.delta[c].pop_back();
+        }
+        g.targets.pop_back();
+        g.owners.pop_back();
+        g.ids.pop_back();
+        count_--;
+    }
+
+    // -------------------------------------------------------------------------
+    // Kernels
+    // -------------------------------------------------------------------------
+
+    // Advance time and compute eased progress for one curve
+    // (no per-tween branching on the easing type)
+    template<typename Curve>
+    static void easeGroup(Group& g, EaseMode mode, float dt, Curve curve) {
+        float* __restrict elapsed = g.elapsed.data();
+        const float* __restrict invDuration = g.invDuration.data();
+        float* __restrict eased = g.eased.data();
+        const size_t n = g.elapsed.size();
+
+        auto progress = [&](size_t i) {
+            elapsed[i] += dt;
+            // Zero duration completes immediately
+            float t = invDuration[i] > 0.0f ? elapsed[i] * invDuration[i] : 1.0f;
+            return std::clamp(t, 0.0f, 1.0f);
+        };
+
+        switch (mode) {
+            case EaseMode::In:
+                for (size_t i = 0; i < n; ++i) eased[i] = curve(progress(i));
+                break;
+            case EaseMode::Out:
+                for (size_t i = 0; i < n; ++i) eased[i] = 1.0f - curve(1.0f - progress(i));
+                break;
+            case EaseMode::InOut:
+                for (size_t i = 0; i < n; ++i) {
+                    // One curve evaluation, mirrored for the second half
+                    float t = progress(i);
+                    bool firstHalf = t < 0.5f;
+                    float c = curve(firstHalf ? t * 2.0f : (1.0f - t) * 2.0f) * 0.5f;
+                    eased[i] = firstHalf ? c : 1.0f - c;
+                }
+                break;
+        }
+    }
+
+    static void applyEasing(Group& g, EaseType type, EaseMode mode, float dt) {
+        switch (type) {
+            case EaseType::Linear:  easeGroup(g, mode, dt, [](float t) { return internal::easeLinear(t); }); break;
+            case EaseType::Quad:    easeGroup(g, mode, dt, [](float t) { return internal::easeQuad(t); }); break;
+            case EaseType::Cubic:   easeGroup(g, mode, dt, [](float t) { return internal::easeCubic(t); }); break;
+            case EaseType::Quart:   easeGroup(g, mode, dt, [](float t) { return internal::easeQuart(t); }); break;
+            case EaseType::Quint:   easeGroup(g, mode, dt, [](float t) { return internal::easeQuint(t); }); break;
+            case EaseType::Sine:    easeGroup(g, mode, dt, [](float t) { return internal::easeSine(t); }); break;
+            case EaseType::Expo:    easeGroup(g, mode, dt, [](float t) { return internal::easeExpo(t); }); break;
+            case EaseType::Circ:    easeGroup(g, mode, dt, [](float t) { return internal::easeCirc(t); }); break;
+            case EaseType::Back:    easeGroup(g, mode, dt, [](float t) { return internal::easeBack(t); }); break;
+            case EaseType::Elastic: easeGroup(g, mode, dt, [](float t) { return internal::easeElastic(t); }); break;
+            case EaseType::Bounce:  easeGroup(g, mode, dt, [](float t) { return internal::easeBounce(t); }); break;
+        }
+    }
+
+    // Node targets must be checked for expiry first
+    static void writeBack(Group& g, size_t i) {
+        const Target& target = g.targets[i];
+        const float e = g.eased[i];
+        auto value = [&](int c) { return g.from[c][i] + g.delta[c][i] * e; };
+
+        switch (target.kind) {
+            case TweenTarget::Pos:
+                static_cast<Node*>(target.ptr)->setPos(Vec3(value(0), value(1), value(2)));
+                break;
+            case TweenTarget::Scale:
+                static_cast<Node*>(target.ptr)->setScale(Vec3(value(0), value(1), value(2)));
+                break;
+            case TweenTarget::Rot:
+                static_cast<Node*>(target.ptr)->setRot(value(0));
+                break;
+            case TweenTarget::Float: {
+                float* out = static_cast<float*>(target.ptr);
+                for (int c = 0; c < target.components; ++c) out[c] = value(c);
+                break;
+            }
+        }
+    }
+
+    void fireCompleted() {
+        if (finished_.empty()) return;
+        // Swap out first: callbacks may add tweens or finish others
+        std::vector<TweenId> batch;
+        batch.swap(finished_);
+        if (!callbacks_.empty()) {
+            for (TweenId id : batch) {
+                auto it = callbacks_.find(id);
+                if (it == callbacks_.end()) continue;
+                auto callback = std::move(it->second);
+                callbacks_.erase(it);
+                if (callback) callback();
+            }
+        }
+        completed.notify(batch);
+        if (finished_.empty()) {
+            batch.clear();
+            finished_.swap(batch);  // Keep the capacity
+        }
+    }
+
+    void ensureListening() {
+        if (!autoUpdate_ || updateListener_.isConnected()) return;
+        lastTime_ = -1.0;
+        updateListener_ = events().update.listen([this]() {
+            double now = getElapsedTime();
+            float dt = lastTime_ < 0.0 ? 0.0f : static_cast<float>(now - lastTime_);
+            lastTime_ = now;
+            update(dt);
+        }, EventPriority::BeforeApp);
+    }
+
+    Group groups_[GROUP_COUNT];
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> freeSlots_;
+    std::unordered_map<TweenId, std::function<void()>> callbacks_;
+    std::vector<TweenId> finished_;
+    std::vector<uint32_t> removals_;    // Scratch for update()
+    size_t count_ = 0;
+    bool paused_ = false;
+    bool autoUpdate_ = true;
+    double lastTime_ = -1.0;
+    EventListener updateListener_;
+};
+
+// ---------------------------------------------------------------------------
+// Global instance
+// ---------------------------------------------------------------------------
+inline TweenSystem& tweens() {
+    static TweenSystem instance;
+    return instance;
+}
+
+} // namespace trussc
@@ -10,6 +10,7 @@
 #include <chrono>
 #include <thread>
 #include <csignal>
+#include <cstdlib>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -107,6 +108,18 @@ int runHeadlessApp(const HeadlessSettings& settings = HeadlessSettings()) {
     // Call setup
     app.setup();
 
+    // MCP over HTTP (same environment variables as windowed apps)
+    #ifndef __EMSCRIPTEN__
+    const char* envMcp = std::getenv("TRUSSC_MCP");
+    bool mcpEnabled = envMcp && std::string(envMcp) == "1";
+    if (mcpEnabled) {
+        mcp::registerInspectionTools();
+        const char* envPort = std::getenv("TRUSSC_MCP_PORT");
+        mcp::startHttpServer(envPort ? std::atoi(envPort) : 0);
+        logNotice("System") << "MCP HTTP server started";
+    }
+    #endif
+
     // Main loop
     const double targetDelta = 1.0 / headless::targetFps;
     double accumulator = 0.0;
@@ -119,9 +132,25 @@ int runHeadlessApp(const HeadlessSettings& settings = HeadlessSettings()) {
 
         accumulator += elapsed;
 
+        #ifndef __EMSCRIPTEN__
+        if (mcpEnabled) mcp::processHttpQueue();
+        #endif
+
         // Fixed timestep update
         while (accumulator >= targetDelta) {
-            app.update();
+            profiler().beginFrame();
+            frameStats().beginFrame();
+            {
+                TC_PROFILE_SCOPE("update");
+                FrameStats::PhaseTimer statsTimer(frameStats(), FrameStats::Phase::Update);
+                {
+                    TC_PROFILE_SCOPE("events().update");
+                    events().update.notify();
+                }
+                app.update();
+            }
+            profiler().endFrame();
+            frameStats().endFrame();
             headless::frameCount++;
             accumulator -= targetDelta;
         }
@@ -130,6 +159,10 @@ int runHeadlessApp(const HeadlessSettings& settings = HeadlessSettings()) {
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
 
+    #ifndef __EMSCRIPTEN__
+    if (mcpEnabled) mcp::stopHttpServer();
+    #endif
+
     // Call exit and cleanup
     app.exit();
     app.cleanup();
@@ -5,12 +5,20 @@
 // Cross-platform serial communication class
 // - Windows: Win32 API (CreateFile, SetCommState, etc.)
 // - macOS/Linux: POSIX API (termios)
+//
+// Polling (default): readBytes() / readByte() read the OS buffer directly.
+// Threaded (startThread()): a background thread reads everything into a ring
+// buffer as it arrives and writes queued output; frames are decoded on the
+// main thread and delivered through onFrame (see tcSerialFraming.h).
 // =============================================================================
 
 #include <string>
 #include <vector>
 #include <cstdint>
 #include <cstring>
+#include <thread>
+#include <mutex>
+#include <atomic>
 
 // Platform-specific headers
 #if defined(_WIN32)
@@ -28,10 +36,17 @@
     #include <termios.h>
     #include <sys/ioctl.h>
     #include <dirent.h>
+    #include <poll.h>
     #include <cerrno>
+    #if defined(__APPLE__)
+    #include <IOKit/serial/ioss.h>
+    #endif
 #endif
 
 #include "../utils/tcLog.h"
+#include "../events/tcCoreEvents.h"
+#include "../events/tcEventListener.h"
+#include "tcSerialFraming.h"
 
 namespace trussc {
 
@@ -49,6 +64,13 @@ struct SerialDeviceInfo {
     const std::string& getDeviceName() const { return deviceName; }
 };
 
+// One decoded frame (threaded mode)
+struct SerialFrameEventArgs {
+    std::vector<uint8_t> data;
+
+    std::string toString() const { return std::string(data.begin(), data.end()); }
+};
+
 // ---------------------------------------------------------------------------
 // Serial Communication Class
 // ---------------------------------------------------------------------------
@@ -65,25 +87,28 @@ public:
         close();
     }
 
+    // Frames decoded from the threaded reader (main thread)
+    Event<SerialFrameEventArgs> onFrame;
+
+    // The reader thread stopped on its own (device unplugged or a read
+    // error). Remaining frames are delivered first (with framing None unread
+    // bytes are dropped), then the port is closed and this fires from
+    // events().update (main thread)
+    Event<void> onDisconnect;
+
     // Non-copyable
     Serial(const Serial&) = delete;
     Serial& operator=(const Serial&) = delete;
 
-    // Move-enabled
-    Serial(Serial&& other) noexcept
-#if defined(_WIN32)
-        : handle_(other.handle_), initialized_(other.initialized_), devicePath_(std::move(other.devicePath_)) {
-        other.handle_ = INVALID_HANDLE_VALUE;
-#else
-        : fd_(other.fd_), initialized_(other.initialized_), devicePath_(std::move(other.devicePath_)) {
-        other.fd_ = -1;
-#endif
-        other.initialized_ = false;
+    // Move-enabled (a running reader thread is stopped first)
+    Serial(Serial&& other) noexcept : Serial() {
+        *this = std::move(other);
     }
 
     Serial& operator=(Serial&& other) noexcept {
         if (this != &other) {
             close();
+            other.stopThread();
 #if defined(_WIN32)
             handle_ = other.handle_;
             other.handle_ = INVALID_HANDLE_VALUE;
@@ -291,7 +316,13 @@ public:
         cfmakeraw(&options);
 
         // Set baud rate
-        speed_t speed = baudRateToSpeed(baudRate);
+        speed_t speed = B9600;
+        bool customSpeed = !baudRateToSpeed(baudRate, speed);
+#if !defined(__APPLE__)
+        if (customSpeed) {
+            logWarning() << "Serial: unsupported baud rate " << baudRate << ", using 9600";
+        }
+#endif
         cfsetispeed(&options, speed);
         cfsetospeed(&options, speed);
 
@@ -322,6 +353,16 @@ public:
             return false;
         }
 
+#if defined(__APPLE__)
+        // Rates without a B constant (e.g. 1000000, 2000000) are set separately
+        if (customSpeed) {
+            speed_t custom = static_cast<speed_t>(baudRate);
+            if (ioctl(fd_, IOSSIOSPEED, &custom) == -1) {
+                logWarning() << "Serial: unsupported baud rate " << baudRate << ", using 9600";
+            }
+        }
+#endif
+
         // Flush buffers
         tcflush(fd_, TCIOFLUSH);
 
@@ -344,6 +385,7 @@ public:
 
     // Disconnect
     void close() {
+        stopThread();
 #if defined(_WIN32)
         if (handle_ != INVALID_HANDLE_VALUE) {
             CloseHandle(handle_);
@@ -381,6 +423,9 @@ public:
     // Get number of bytes available for reading
     int available() const {
         if (!isInitialized()) return 0;
+        if (threaded_) {
+            return decoder_.getFraming() == SerialFraming::None ? static_cast<int>(ring_.size()) : 0;
+        }
 
 #if defined(_WIN32)
         COMSTAT comStat;
@@ -404,9 +449,14 @@ public:
 
     // Read specified number of bytes
     // Returns: actual bytes read (>=0), -1 on error
+    // Threaded: reads the ring buffer (framing None only; frames go to onFrame)
     int readBytes(void* buffer, int length) {
         if (!isInitialized()) return -1;
         if (length <= 0) return 0;
+        if (threaded_) {
+            if (decoder_.getFraming() != SerialFraming::None) return 0;
+            return static_cast<int>(ring_.read(buffer, length));
+        }
 
 #if defined(_WIN32)
         DWORD bytesRead = 0;
@@ -443,6 +493,9 @@ public:
         if (!isInitialized()) return -2;
 
         unsigned char byte;
+        if (threaded_) {
+            return readBytes(&byte, 1) == 1 ? byte : -1;
+        }
 #if defined(_WIN32)
         DWORD bytesRead = 0;
         if (!ReadFile(handle_, &byte, 1, &bytesRead, nullptr)) {
@@ -469,9 +522,19 @@ public:
 
     // Write specified number of bytes
     // Returns: actual bytes written, -1 on error
+    // Threaded: queued for the reader thread (never blocks), returns length
     int writeBytes(const void* buffer, int length) {
         if (!isInitialized()) return -1;
         if (length <= 0) return 0;
+        if (threaded_) {
+            const uint8_t* p = static_cast<const uint8_t*>(buffer);
+            {
+                std::lock_guard<std::mutex> lock(writeMutex_);
+                writeQueue_.insert(writeQueue_.end(), p, p + length);
+            }
+            wakeThread();
+            return length;
+        }
 
 #if defined(_WIN32)
         DWORD bytesWritten = 0;
@@ -498,6 +561,19 @@ public:
         return writeBytes(&byte, 1) == 1;
     }
 
+    // Write one frame encoded with the current framing (see startThread())
+    int writeFrame(const void* data, int length) {
+        if (length < 0) return -1;
+        frameScratch_.clear();
+        encodeSerialFrame(decoder_.getFraming(), data, length, frameScratch_,
+                          decoder_.getLengthPrefixBytes(), decoder_.isLengthPrefixBigEndian());
+        return writeBytes(frameScratch_.data(), static_cast<int>(frameScratch_.size()));
+    }
+
+    int writeFrame(const std::string& data) {
+        return writeFrame(data.data(), static_cast<int>(data.size()));
+    }
+
     // ---------------------------------------------------------------------------
     // Buffer Control
     // ---------------------------------------------------------------------------
@@ -542,7 +618,120 @@ public:
 #endif
     }
 
+    // ---------------------------------------------------------------------------
+    // Threaded Reading
+    // ---------------------------------------------------------------------------
+
+    // Read and write on a background thread (call after setup()).
+    // framing None: readBytes() / readByte() / available() use the ring buffer.
+    // Other framings: frames are delivered to onFrame from events().update.
+    // bufferSize: ring buffer capacity (1 MB holds ~5 s at 2 Mbaud)
+    bool startThread(SerialFraming framing = SerialFraming::None, size_t bufferSize = 1 << 20) {
+        if (!isInitialized()) {
+            logError() << "Serial: startThread() called before setup()";
+            return false;
+        }
+        stopThread();
+        decoder_.setFraming(framing);
+        ring_.allocate(bufferSize);
+
+#if defined(_WIN32)
+        // Return as soon as bytes arrive, otherwise after 10 ms (writes are
+        // picked up between reads)
+        GetCommTimeouts(handle_, &savedTimeouts_);
+        COMMTIMEOUTS timeouts = {};
+        timeouts.ReadIntervalTimeout = MAXDWORD;
+        timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
+        timeouts.ReadTotalTimeoutConstant = 10;
+        SetCommTimeouts(handle_, &timeouts);
+#else
+        // Wakes poll() for queued writes and stopThread()
+        if (pipe(wakePipe_) == -1) {
+            logError() << "Serial: failed to create wake pipe";
+            return false;
+        }
+        for (int fd : wakePipe_) fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+#endif
+
+        threaded_ = true;
+        threadRunning_ = true;
+        threadExited_ = false;
+        thread_ = std::thread([this]() {
+            threadLoop();
+            threadExited_ = true;
+        });
+        updateListener_ = events().update.listen([this]() { processReceived(); });
+        return true;
+    }
+
+    // Stop the background thread (queued writes are attempted once more)
+    void stopThread() {
+        if (!threaded_) return;
+        threadRunning_ = false;
+        wakeThread();
+        if (thread_.joinable()) thread_.join();
+        updateListener_.disconnect();
+        threaded_ = false;
+
+#if defined(_WIN32)
+        SetCommTimeouts(handle_, &savedTimeouts_);
+#else
+        for (int& fd : wakePipe_) {
+            ::close(fd);
+            fd = -1;
+        }
+#endif
+        {
+            std::lock_guard<std::mutex> lock(writeMutex_);
+            writeQueue_.clear();
+        }
+        decoder_.reset();
+    }
+
+    bool isThreaded() const { return threaded_; }
+    SerialFraming getFraming() const { return decoder_.getFraming(); }
+
+    // Decoder limits (see SerialFrameDecoder)
+    void setMaxFrameSize(size_t bytes) { decoder_.setMaxFrameSize(bytes); }
+    void setLengthPrefix(int bytes, bool bigEndian = false) { decoder_.setLengthPrefix(bytes, bigEndian); }
+    uint64_t getDroppedFrameCount() const { return decoder_.getDroppedCount(); }
+
+    // Bytes received but not yet decoded / read
+    size_t getBufferedCount() const { return threaded_ ? ring_.size() : 0; }
+
+    // Decode buffered bytes and notify onFrame (and onDisconnect when the
+    // reader thread has died). Runs from events().update; call it directly
+    // when there is no app loop.
+    void processReceived() {
+        if (!threaded_) return;
+        // Read before decoding so bytes written just before the exit are seen
+        bool exited = threadExited_ && threadRunning_;
+        decodeReceived();
+        if (exited && threaded_) {     // onFrame may have closed the port already
+            logVerbose() << "Serial: reader thread stopped on " << devicePath_;
+            close();
+            onDisconnect.notify();
+        }
+    }
+
 private:
+    void decodeReceived() {
+        if (decoder_.getFraming() == SerialFraming::None) return;
+        auto deliver = [this](std::vector<uint8_t>& frame) {
+            // Swapped in and out so the decoder keeps its buffer
+            frameArgs_.data.swap(frame);
+            onFrame.notify(frameArgs_);
+            frameArgs_.data.swap(frame);
+        };
+        while (threaded_) {
+            size_t length;
+            const uint8_t* data = ring_.readRegion(length);
+            if (length == 0) break;
+            decoder_.feed(data, length, deliver);
+            ring_.commitRead(length);
+        }
+    }
+
 #if defined(_WIN32)
     HANDLE handle_;        // Windows handle
 #else
@@ -551,30 +740,180 @@ private:
     bool initialized_;     // Connection state
     std::string devicePath_; // Current device path
 
+    // Threaded mode
+    bool threaded_ = false;
+    std::atomic<bool> threadRunning_{false};
+    std::atomic<bool> threadExited_{false};     // Set by the reader thread as it returns
+    std::thread thread_;
+    SerialRingBuffer ring_;                 // Reader thread -> main thread
+    SerialFrameDecoder decoder_;            // Main thread
+    SerialFrameEventArgs frameArgs_;
+    std::mutex writeMutex_;
+    std::vector<uint8_t> writeQueue_;       // Main thread -> reader thread
+    std::vector<uint8_t> frameScratch_;     // writeFrame()
+    EventListener updateListener_;
+#if defined(_WIN32)
+    COMMTIMEOUTS savedTimeouts_ = {};
+#else
+    int wakePipe_[2] = {-1, -1};
+#endif
+
+    void wakeThread() {
+#if !defined(_WIN32)
+        if (wakePipe_[1] != -1) {
+            char b = 1;
+            [[maybe_unused]] ssize_t n = write(wakePipe_[1], &b, 1);
+        }
+#endif
+    }
+
+#if defined(_WIN32)
+    void threadLoop() {
+        std::vector<uint8_t> writing;
+        while (threadRunning_) {
+            {
+                std::lock_guard<std::mutex> lock(writeMutex_);
+                writing.swap(writeQueue_);
+            }
+            if (!writing.empty()) {
+                DWORD written = 0;
+                WriteFile(handle_, writing.data(), static_cast<DWORD>(writing.size()), &written, nullptr);
+                writing.clear();
+            }
+
+            size_t space;
+            uint8_t* dst = ring_.writeRegion(space);
+            if (space == 0) {
+                Sleep(1);           // Ring full: wait for the main thread
+                continue;
+            }
+            DWORD bytesRead = 0;
+            if (!ReadFile(handle_, dst, static_cast<DWORD>(std::min<size_t>(space, 1 << 16)), &bytesRead, nullptr)) {
+                logError() << "Serial: read failed on " << devicePath_ << " (error: " << GetLastError() << ")";
+                break;
+            }
+            if (bytesRead > 0) ring_.commitWrite(bytesRead);
+        }
+    }
+#else
+    void threadLoop() {
+        std::vector<uint8_t> writing;
+        size_t written = 0;
+        bool running = true;
+        while (running) {
+            running = threadRunning_;
+            if (written == writing.size()) {
+                writing.clear();
+                written = 0;
+                std::lock_guard<std::mutex> lock(writeMutex_);
+                writing.swap(writeQueue_);
+            }
+            bool pendingWrite = written < writing.size();
+            if (!running) {
+                // Last pass: try the queued output once, never wait
+                if (pendingWrite) {
+                    [[maybe_unused]] ssize_t n = write(fd_, writing.data() + written, writing.size() - written);
+                }
+                break;
+            }
+
+            size_t space;
+            ring_.writeRegion(space);
+            pollfd fds[2] = {};
+            fds[0].fd = fd_;
+            fds[0].events = static_cast<short>((space > 0 ? POLLIN : 0) | (pendingWrite ? POLLOUT : 0));
+            fds[1].fd = wakePipe_[0];
+            fds[1].events = POLLIN;
+
+            // Ring full: poll again shortly while the main thread drains it
+            int result = poll(fds, 2, space > 0 ? -1 : 1);
+            if (result == -1) {
+                if (errno == EINTR) continue;
+                logError() << "Serial: poll failed on " << devicePath_;
+                break;
+            }
+
+            if (fds[1].revents & POLLIN) {
+                char drain[64];
+                while (read(wakePipe_[0], drain, sizeof(drain)) > 0) {}
+            }
+
+            size_t received = 0;
+            if (fds[0].revents & POLLIN) {
+                // Until the OS buffer is empty or the ring is full
+                while (true) {
+                    size_t length;
+                    uint8_t* dst = ring_.writeRegion(length);
+                    if (length == 0) break;
+                    ssize_t n = read(fd_, dst, length);
+                    if (n > 0) {
+                        ring_.commitWrite(static_cast<size_t>(n));
+                        received += static_cast<size_t>(n);
+                    }
+                    if (n < static_cast<ssize_t>(length)) {
+                        if (n == -1 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                            logError() << "Serial: read failed on " << devicePath_ << " (errno: " << errno << ")";
+                            return;
+                        }
+                        break;
+                    }
+                }
+            }
+            // Hang-up also reports POLLIN; it is final once nothing is left to read
+            if ((fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) && received == 0) {
+                logError() << "Serial: device " << devicePath_ << " disconnected";
+                return;
+            }
+
+            if (fds[0].revents & POLLOUT) {
+                ssize_t n = write(fd_, writing.data() + written, writing.size() - written);
+                if (n > 0) written += static_cast<size_t>(n);
+            }
+        }
+    }
+#endif
+
 #if !defined(_WIN32)
-    // Convert baud rate to speed_t (POSIX only)
-    speed_t baudRateToSpeed(int baudRate) {
+    // Convert baud rate to speed_t (POSIX only). False if there is no constant.
+    static bool baudRateToSpeed(int baudRate, speed_t& speed) {
         switch (baudRate) {
-            case 300:    return B300;
-            case 600:    return B600;
-            case 1200:   return B1200;
-            case 2400:   return B2400;
-            case 4800:   return B4800;
-            case 9600:   return B9600;
-            case 19200:  return B19200;
-            case 38400:  return B38400;
-            case 57600:  return B57600;
-            case 115200: return B115200;
-            case 230400: return B230400;
+            case 300:    speed = B300; return true;
+            case 600:    speed = B600; return true;
+            case 1200:   speed = B1200; return true;
+            case 2400:   speed = B2400; return true;
+            case 4800:   speed = B4800; return true;
+            case 9600:   speed = B9600; return true;
+            case 19200:  speed = B19200; return true;
+            case 38400:  speed = B38400; return true;
+            case 57600:  speed = B57600; return true;
+            case 115200: speed = B115200; return true;
+            case 230400: speed = B230400; return true;
 #ifdef B460800
-            case 460800: return B460800;
+            case 460800: speed = B460800; return true;
+#endif
+#ifdef B500000
+            case 500000: speed = B500000; return true;
 #endif
 #ifdef B921600
-            case 921600: return B921600;
+            case 921600: speed = B921600; return true;
+#endif
+#ifdef B1000000
+            case 1000000: speed = B1000000; return true;
+#endif
+#ifdef B1500000
+            case 1500000: speed = B1500000; return true;
+#endif
+#ifdef B2000000
+            case 2000000: speed = B2000000; return true;
+#endif
+#ifdef B3000000
+            case 3000000: speed = B3000000; return true;
+#endif
+#ifdef B4000000
+            case 4000000: speed = B4000000; return true;
 #endif
             default:
-                logWarning() << "Serial: unsupported baud rate " << baudRate << ", using 9600";
-                return B9600;
+                return false;
         }
     }
 #endif
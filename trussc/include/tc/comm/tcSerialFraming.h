@@ -0,0 +1,394 @@
+#pragma once
+
+// =============================================================================
+// tcSerialFraming - Byte ring and packet framings for Serial
+// =============================================================================
+// SerialRingBuffer:   single producer / single consumer byte ring (lock-free),
+//                     filled by the Serial reader thread, drained on the main
+//                     thread
+// SerialFrameDecoder: splits a byte stream into frames, fed in chunks
+// encodeSerialFrame:  the matching encoder (Serial::writeFrame())
+//
+// Framings:
+//   Newline:      text lines, '\n' ends a frame ("\r\n" accepted)
+//   Slip:         RFC 1055 (END 0xC0, ESC 0xDB)
+//   Cobs:         Consistent Overhead Byte Stuffing, 0x00 ends a frame
+//   LengthPrefix: 1, 2 or 4 byte payload length, then the payload
+// =============================================================================
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+namespace trussc {
+
+enum class SerialFraming {
+    None,           // Raw bytes (readBytes() / readByte())
+    Newline,
+    Slip,
+    Cobs,
+    LengthPrefix
+};
+
+// ---------------------------------------------------------------------------
+// SerialRingBuffer
+// ---------------------------------------------------------------------------
+
+class SerialRingBuffer {
+public:
+    SerialRingBuffer() = default;
+    SerialRingBuffer(const SerialRingBuffer&) = delete;
+    SerialRingBuffer& operator=(const SerialRingBuffer&) = delete;
+
+    // Capacity is rounded up to a power of two. Not thread-safe.
+    void allocate(size_t capacity) {
+        size_t size = 1024;
+        while (size < capacity) size <<= 1;
+        buffer_.assign(size, 0);
+        mask_ = size - 1;
+        head_.store(0);
+        tail_.store(0);
+    }
+
+    size_t capacity() const { return buffer_.size(); }
+    size_t size() const { return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire); }
+    bool empty() const { return size() == 0; }
+
+    // --- Producer ---
+
+    // Contiguous free space (read() directly into it), then commitWrite()
+    uint8_t* writeRegion(size_t& length) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t free = buffer_.size() - (head - tail_.load(std::memory_order_acquire));
+        length = std::min(free, buffer_.size() - (head & mask_));
+        return buffer_.data() + (head & mask_);
+    }
+
+    void commitWrite(size_t length) {
+        head_.store(head_.load(std::memory_order_relaxed) + length, std::memory_order_release);
+    }
+
+    // --- Consumer ---
+
+    // Contiguous readable bytes, then commitRead()
+    const uint8_t* readRegion(size_t& length) const {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t used = head_.load(std::memory_order_acquire) - tail;
+        length = std::min(used, buffer_.size() - (tail & mask_));
+        return buffer_.data() + (tail & mask_);
+    }
+
+    void commitRead(size_t length) {
+        tail_.store(tail_.load(std::memory_order_relaxed) + length, std::memory_order_release);
+    }
+
+    size_t read(void* dst, size_t length) {
+        uint8_t* out = static_cast<uint8_t*>(dst);
+        size_t total = 0;
+        while (total < length) {
+            size_t n;
+            const uint8_t* src = readRegion(n);
+            n = std::min(n, length - total);
+            if (n == 0) break;
+            std::memcpy(out + total, src, n);
+            commitRead(n);
+            total += n;
+        }
+        return total;
+    }
+
+    // Drop everything readable (consumer side)
+    void discard() {
+        tail_.store(head_.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+private:
+    std::vector<uint8_t> buffer_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> head_{0};     // Written by the producer
+    alignas(64) std::atomic<size_t> tail_{0};     // Written by the consumer
+};
+
+// ---------------------------------------------------------------------------
+// SerialFrameDecoder
+// ---------------------------------------------------------------------------
+
+class SerialFrameDecoder {
+public:
+    static constexpr uint8_t kSlipEnd = 0xC0;
+    static constexpr uint8_t kSlipEsc = 0xDB;
+    static constexpr uint8_t kSlipEscEnd = 0xDC;
+    static constexpr uint8_t kSlipEscEsc = 0xDD;
+
+    void setFraming(SerialFraming framing) {
+        framing_ = framing;
+        reset();
+    }
+    SerialFraming getFraming() const { return framing_; }
+
+    // Longer frames are dropped (counted in getDroppedCount())
+    void setMaxFrameSize(size_t bytes) { maxFrameSize_ = std::max<size_t>(bytes, 1); }
+    size_t getMaxFrameSize() const { return maxFrameSize_; }
+
+    // LengthPrefix: header size (1, 2 or 4 bytes) and byte order
+    void setLengthPrefix(int bytes, bool bigEndian = false) {
+        prefixBytes_ = (bytes == 1 || bytes == 2) ? bytes : 4;
+        bigEndian_ = bigEndian;
+        reset();
+    }
+    int getLengthPrefixBytes() const { return prefixBytes_; }
+    bool isLengthPrefixBigEndian() const { return bigEndian_; }
+
+    // Frames dropped as too long or malformed
+    uint64_t getDroppedCount() const { return dropped_; }
+
+    void reset() {
+        frame_.clear();
+        discarding_ = false;
+        escaped_ = false;
+        cobsCode_ = 0;
+        cobsLeft_ = 0;
+        headerRead_ = 0;
+        payloadSize_ = 0;
+    }
+
+    // onFrame(const std::vector<uint8_t>&) for every complete frame
+    template<typename F>
+    void feed(const uint8_t* data, size_t length, F&& onFrame) {
+        switch (framing_) {
+            case SerialFraming::Newline:      feedNewline(data, length, onFrame); break;
+            case SerialFraming::Slip:         feedSlip(data, length, onFrame); break;
+            case SerialFraming::Cobs:         feedCobs(data, length, onFrame); break;
+            case SerialFraming::LengthPrefix: feedLengthPrefix(data, length, onFrame); break;
+            case SerialFraming::None:
+                if (length > 0) {
+                    frame_.assign(data, data + length);
+                    onFrame(frame_);
+                }
+                break;
+        }
+    }
+
+private:
+    // Append to the current frame; past the limit the frame is dropped at its end
+    void append(uint8_t b) {
+        if (discarding_) return;
+        if (frame_.size() >= maxFrameSize_) {
+            discarding_ = true;
+            frame_.clear();
+            return;
+        }
+        frame_.push_back(b);
+    }
+
+    template<typename F>
+    void finish(F& onFrame) {
+        if (discarding_) {
+            dropped_++;
+        } else {
+            onFrame(frame_);
+        }
+        frame_.clear();
+        discarding_ = false;
+    }
+
+    template<typename F>
+    void feedNewline(const uint8_t* data, size_t length, F& onFrame) {
+        const uint8_t* end = data + length;
+        while (data < end) {
+            const uint8_t* nl = static_cast<const uint8_t*>(std::memchr(data, '\n', end - data));
+            const uint8_t* stop = nl ? nl : end;
+            if (!discarding_) {
+                size_t n = stop - data;
+                if (frame_.size() + n > maxFrameSize_) {
+                    discarding_ = true;
+                    frame_.clear();
+                } else {
+                    frame_.insert(frame_.end(), data, stop);
+                }
+            }
+            if (!nl) break;
+            if (!frame_.empty() && frame_.back() == '\r') frame_.pop_back();
+            finish(onFrame);
+            data = nl + 1;
+        }
+    }
+
+    template<typename F>
+    void feedSlip(const uint8_t* data, size_t length, F& onFrame) {
+        for (size_t i = 0; i < length; i++) {
+            uint8_t b = data[i];
+            if (b == kSlipEnd) {
+                // Back-to-back END bytes delimit nothing
+                if (!frame_.empty() || discarding_) finish(onFrame);
+                escaped_ = false;
+            } else if (escaped_) {
+                escaped_ = false;
+                if (b == kSlipEscEnd) append(kSlipEnd);
+                else if (b == kSlipEscEsc) append(kSlipEsc);
+                else discarding_ = true;        // Protocol error
+            } else if (b == kSlipEsc) {
+                escaped_ = true;
+            } else {
+                append(b);
+            }
+        }
+    }
+
+    template<typename F>
+    void feedCobs(const uint8_t* data, size_t length, F& onFrame) {
+        for (size_t i = 0; i < length; i++) {
+            uint8_t b = data[i];
+            if (b == 0) {
+                if (cobsCode_ != 0) {
+                    if (cobsLeft_ != 0) discarding_ = true;     // Truncated block
+                    finish(onFrame);
+                }
+                cobsCode_ = 0;
+                cobsLeft_ = 0;
+            } else if (cobsLeft_ == 0) {
+                // Block header; every block but a full one (0xFF) ends in a zero
+                if (cobsCode_ != 0 && cobsCode_ != 0xFF) append(0);
+                cobsCode_ = b;
+                cobsLeft_ = b - 1;
+            } else {
+                append(b);
+                cobsLeft_--;
+            }
+        }
+    }
+
+    template<typename F>
+    void feedLengthPrefix(const uint8_t* data, size_t length, F& onFrame) {
+        size_t i = 0;
+        while (i < length) {
+            if (headerRead_ < prefixBytes_) {
+                header_[headerRead_++] = data[i++];
+                if (headerRead_ < prefixBytes_) continue;
+                payloadSize_ = 0;
+                for (int k = 0; k < prefixBytes_; k++) {
+                    int index = bigEndian_ ? k : prefixBytes_ - 1 - k;
+                    payloadSize_ = (payloadSize_ << 8) | header_[index];
+                }
+                frame_.clear();
+                discarding_ = payloadSize_ > maxFrameSize_;
+                if (!discarding_) frame_.reserve(payloadSize_);
+            }
+            size_t have = discarding_ ? skipped_ : frame_.size();
+            size_t n = std::min<size_t>(payloadSize_ - have, length - i);
+            if (discarding_) {
+                skipped_ += n;
+            } else {
+                frame_.insert(frame_.end(), data + i, data + i + n);
+            }
+            i += n;
+            if ((discarding_ ? skipped_ : frame_.size()) == payloadSize_) {
+                finish(onFrame);
+                headerRead_ = 0;
+                skipped_ = 0;
+            }
+        }
+    }
+
+    SerialFraming framing_ = SerialFraming::None;
+    size_t maxFrameSize_ = 64 * 1024;
+    std::vector<uint8_t> frame_;
+    bool discarding_ = false;
+    uint64_t dropped_ = 0;
+
+    // SLIP
+    bool escaped_ = false;
+
+    // COBS
+    uint8_t cobsCode_ = 0;
+    uint8_t cobsLeft_ = 0;
+
+    // LengthPrefix
+    int prefixBytes_ = 2;
+    bool bigEndian_ = false;
+    uint8_t header_[4] = {};
+    int headerRead_ = 0;
+    size_t payloadSize_ = 0;
+    size_t skipped_ = 0;
+};
+
+// ---------------------------------------------------------------------------
+// Encoding
+// ---------------------------------------------------------------------------
+
+// Append one encoded frame to out. LengthPrefix uses prefixBytes / bigEndian
+// (payloads longer than the prefix can express are truncated).
+inline void encodeSerialFrame(SerialFraming framing, const void* data, size_t length,
+                              std::vector<uint8_t>& out, int prefixBytes = 2, bool bigEndian = false) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    switch (framing) {
+        case SerialFraming::None:
+            out.insert(out.end(), p, p + length);
+            break;
+
+        case SerialFraming::Newline:
+            out.insert(out.end(), p, p + length);
+            out.push_back('\n');
+            break;
+
+        case SerialFraming::Slip:
+            out.reserve(out.size() + length + 2);
+            out.push_back(SerialFrameDecoder::kSlipEnd);    // Flushes line noise at the receiver
+            for (size_t i = 0; i < length; i++) {
+                if (p[i] == SerialFrameDecoder::kSlipEnd) {
+                    out.push_back(SerialFrameDecoder::kSlipEsc);
+                    out.push_back(SerialFrameDecoder::kSlipEscEnd);
+                } else if (p[i] == SerialFrameDecoder::kSlipEsc) {
+                    out.push_back(SerialFrameDecoder::kSlipEsc);
+                    out.push_back(SerialFrameDecoder::kSlipEscEsc);
+                } else {
+                    out.push_back(p[i]);
+                }
+            }
+            out.push_back(SerialFrameDecoder::kSlipEnd);
+            break;
+
+        case SerialFraming::Cobs: {
+            out.reserve(out.size() + length + length / 254 + 2);
+            size_t codeIndex = out.size();
+            out.push_back(0);
+            uint8_t code = 1;
+            for (size_t i = 0; i < length; i++) {
+                if (p[i] == 0) {
+                    out[codeIndex] = code;
+                    codeIndex = out.size();
+                    out.push_back(0);
+                    code = 1;
+                    continue;
+                }
+                out.push_back(p[i]);
+                if (++code == 0xFF) {
+                    out[codeIndex] = code;
+                    codeIndex = out.size();
+                    out.push_back(0);
+                    code = 1;
+                }
+            }
+            out[codeIndex] = code;
+            out.push_back(0);
+            break;
+        }
+
+        case SerialFraming::LengthPrefix: {
+            int bytes = (prefixBytes == 1 || prefixBytes == 2) ? prefixBytes : 4;
+            uint64_t limit = (uint64_t(1) << (bytes * 8)) - 1;
+            size_t n = static_cast<size_t>(std::min<uint64_t>(length, limit));
+            for (int k = 0; k < bytes; k++) {
+                int shift = bigEndian ? (bytes - 1 - k) * 8 : k * 8;
+                out.push_back(static_cast<uint8_t>(n >> shift));
+            }
+            out.insert(out.end(), p, p + n);
+            break;
+        }
+    }
+}
+
+} // namespace trussc
@@ -18,6 +18,7 @@ public:
     Event<void> setup;            // After setup completes
     Event<void> update;           // Before update each frame
     Event<void> draw;             // Before draw each frame
+    Event<void> afterDraw;        // After draw each frame (app and node tree drawn)
     Event<void> exit;             // On app exit
 
     // Exit request (can be cancelled)
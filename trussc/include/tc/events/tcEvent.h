@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <atomic>
 #include "tcEventListener.h"
 
 // ---------------------------------------------------------------------------
@@ -109,6 +110,7 @@ private:
             id = nextId_++;
             entries_.push_back({id, static_cast<int>(priority), std::move(callback)});
             sortEntries();
+            size_ = entries_.size();
         }
         // Set EventListener outside lock (removeListener() may be called when disconnecting existing)
         // Capture weak_ptr to check if Event is still alive before removing
@@ -145,10 +147,16 @@ public:
         return entries_.size();
     }
 
+    // Lock-free check for hot paths (skip building args when nobody listens)
+    bool empty() const {
+        return size_.load(std::memory_order_relaxed) == 0;
+    }
+
     // Remove all listeners
     void clear() {
         TC_LOCK_GUARD(mutex_);
         entries_.clear();
+        size_ = 0;
     }
 
 private:
@@ -165,6 +173,7 @@ private:
                 [id](const Entry& e) { return e.id == id; }),
             entries_.end()
         );
+        size_ = entries_.size();
     }
 
     void sortEntries() {
@@ -177,6 +186,7 @@ private:
     std::shared_ptr<bool> alive_;
     mutable TC_MUTEX mutex_;
     std::vector<Entry> entries_;
+    std::atomic<size_t> size_{0};
     uint64_t nextId_ = 0;
 };
 
@@ -240,6 +250,7 @@ private:
             id = nextId_++;
             entries_.push_back({id, static_cast<int>(priority), std::move(callback)});
             sortEntries();
+            size_ = entries_.size();
         }
         // Set EventListener outside lock (removeListener() may be called when disconnecting existing)
         // Capture weak_ptr to check if Event is still alive before removing
@@ -273,9 +284,15 @@ public:
         return entries_.size();
     }
 
+    // Lock-free check for hot paths (skip building args when nobody listens)
+    bool empty() const {
+        return size_.load(std::memory_order_relaxed) == 0;
+    }
+
     void clear() {
         TC_LOCK_GUARD(mutex_);
         entries_.clear();
+        size_ = 0;
     }
 
 private:
@@ -292,6 +309,7 @@ private:
                 [id](const Entry& e) { return e.id == id; }),
             entries_.end()
         );
+        size_ = entries_.size();
     }
 
     void sortEntries() {
@@ -304,6 +322,7 @@ private:
     std::shared_ptr<bool> alive_;
     mutable TC_MUTEX mutex_;
     std::vector<Entry> entries_;
+    std::atomic<size_t> size_{0};
     uint64_t nextId_ = 0;
 };
 
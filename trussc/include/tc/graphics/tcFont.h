@@ -38,6 +38,7 @@
 #include "stb/stb_truetype.h"
 
 #include "../utils/tcLog.h"
+#include "../utils/tcProfiler.h"
 #include "../types/tcDirection.h"
 #include "../types/tcRectangle.h"
 #include "../../tcMath.h"  // Vec2
@@ -579,6 +580,8 @@ private:
             return;
         }
 
+        TC_PROFILE_SCOPE("Font::updateAtlas");
+
         // Defer destruction of existing resources
         if (atlas.textureValid_) {
             pendingDestroys_.push_back({atlas.view_, atlas.texture_});
@@ -0,0 +1,684 @@
+#pragma once
+
+// =============================================================================
+// tcImageEncoder.h - Image encoding on worker threads
+// =============================================================================
+//
+// Usage:
+//   // One-off screenshot without stalling the frame
+//   saveScreenshotAsync("shot.png");
+//
+//   // Record an image sequence (frame_000000.png, frame_000001.png, ...)
+//   FrameRecorder recorder;
+//   recorder.start("capture", {ImageFormat::Qoi});
+//   void draw() { ...; recorder.captureFrame(); }
+//   recorder.stop();    // Waits until every frame is on disk
+//
+// Pixels are grabbed on the main thread and handed to an ImageEncoder,
+// whose worker threads compress and write them. The number of frames in
+// flight is bounded; when encoding falls behind, the producer waits instead
+// of dropping frames (FrameRecorder::setDropWhenFull() changes that).
+//
+// This file is included from TrussC.h
+//
+// =============================================================================
+
+#include <array>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <bit>
+
+// stb_image_write's zlib compressor (implemented in stb_impl.cpp)
+extern "C" unsigned char* stbi_zlib_compress(unsigned char* data, int data_len, int* out_len, int quality);
+
+namespace trussc {
+
+// ---------------------------------------------------------------------------
+// Formats
+// ---------------------------------------------------------------------------
+enum class ImageFormat {
+    Png,
+    Jpeg,
+    Bmp,
+    Qoi,    // Fast lossless (https://qoiformat.org), 3 or 4 channels
+    Raw     // Pixel bytes as-is, no header
+};
+
+struct ImageEncodeSettings {
+    ImageFormat format = ImageFormat::Png;
+    int pngCompression = 1;     // 0 = stored, 1-4 = fast single-pass deflate, 5-9 = stb zlib (smaller, slower)
+    int jpegQuality = 90;       // 1-100
+};
+
+// Format from file extension (.png .jpg .jpeg .bmp .qoi .raw), Png otherwise
+inline ImageFormat imageFormatFromPath(const fs::path& path) {
+    std::string ext = path.extension().string();
+    for (auto& c : ext) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    if (ext == ".jpg" || ext == ".jpeg") return ImageFormat::Jpeg;
+    if (ext == ".bmp") return ImageFormat::Bmp;
+    if (ext == ".qoi") return ImageFormat::Qoi;
+    if (ext == ".raw") return ImageFormat::Raw;
+    return ImageFormat::Png;
+}
+
+inline const char* imageFormatExtension(ImageFormat format) {
+    switch (format) {
+        case ImageFormat::Jpeg: return ".jpg";
+        case ImageFormat::Bmp: return ".bmp";
+        case ImageFormat::Qoi: return ".qoi";
+        case ImageFormat::Raw: return ".raw";
+        default: return ".png";
+    }
+}
+
+namespace image_encoder_internal {
+
+inline void put32be(std::vector<unsigned char>& out, uint32_t v) {
+    out.push_back(static_cast<unsigned char>(v >> 24));
+    out.push_back(static_cast<unsigned char>(v >> 16));
+    out.push_back(static_cast<unsigned char>(v >> 8));
+    out.push_back(static_cast<unsigned char>(v));
+}
+
+inline uint32_t crc32(const unsigned char* data, size_t len, uint32_t crc = 0) {
+    static const auto table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < len; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+inline uint32_t adler32(const unsigned char* data, size_t len) {
+    uint32_t a = 1, b = 0;
+    while (len > 0) {
+        size_t n = std::min<size_t>(len, 5552);    // Largest block without overflow
+        len -= n;
+        while (n--) {
+            a += *data++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return (b << 16) | a;
+}
+
+inline void writeChunk(std::vector<unsigned char>& out, const char* type, const unsigned char* data, size_t len) {
+    put32be(out, static_cast<uint32_t>(len));
+    size_t typePos = out.size();
+    out.insert(out.end(), type, type + 4);
+    if (len) out.insert(out.end(), data, data + len);
+    put32be(out, crc32(out.data() + typePos, len + 4));
+}
+
+// zlib stream made of stored (uncompressed) deflate blocks
+inline void zlibStore(const std::vector<unsigned char>& raw, std::vector<unsigned char>& out) {
+    out.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    out.push_back(0x78);
+    out.push_back(0x01);
+    size_t pos = 0;
+    do {
+        size_t n = std::min<size_t>(raw.size() - pos, 65535);
+        bool last = (pos + n == raw.size());
+        out.push_back(last ? 1 : 0);
+        out.push_back(static_cast<unsigned char>(n));
+        out.push_back(static_cast<unsigned char>(n >> 8));
+        out.push_back(static_cast<unsigned char>(~n));
+        out.push_back(static_cast<unsigned char>(~n >> 8));
+        out.insert(out.end(), raw.begin() + pos, raw.begin() + pos + n);
+        pos += n;
+    } while (pos < raw.size());
+    put32be(out, adler32(raw.data(), raw.size()));
+}
+
+// zlib stream for the low compression levels: greedy LZ77 with one hash
+// probe per position, written as a single fixed-Huffman block. stb's
+// compressor clamps its quality to 5 and walks hash chains, so it can't go
+// this cheap.
+inline void zlibFast(const std::vector<unsigned char>& raw, std::vector<unsigned char>& out) {
+    struct Code { uint16_t bits; uint8_t len; };
+    static const auto litCodes = [] {
+        std::array<Code, 288> t{};
+        for (int s = 0; s < 288; ++s) {
+            uint32_t code; int len;
+            if (s < 144)      { code = 0x30 + s;          len = 8; }
+            else if (s < 256) { code = 0x190 + (s - 144); len = 9; }
+            else if (s < 280) { code = s - 256;           len = 7; }
+            else              { code = 0xC0 + (s - 280);  len = 8; }
+            uint32_t rev = 0;   // Huffman codes go out MSB first
+            for (int i = 0; i < len; ++i) rev |= ((code >> i) & 1) << (len - 1 - i);
+            t[s] = {static_cast<uint16_t>(rev), static_cast<uint8_t>(len)};
+        }
+        return t;
+    }();
+    static const uint16_t lenBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                         35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    static const uint8_t lenExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                         3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    static const auto lenSymbols = [] {
+        std::array<uint8_t, 259> t{};
+        for (int i = 0; i < 29; ++i) {
+            int end = (i == 28) ? 259 : lenBase[i + 1];
+            for (int l = lenBase[i]; l < end; ++l) t[l] = static_cast<uint8_t>(i);
+        }
+        t[258] = 28;
+        return t;
+    }();
+
+    uint64_t acc = 0;
+    int accBits = 0;
+    auto put = [&](uint32_t v, int n) {
+        acc |= static_cast<uint64_t>(v) << accBits;
+        accBits += n;
+        while (accBits >= 8) {
+            out.push_back(static_cast<unsigned char>(acc));
+            acc >>= 8;
+            accBits -= 8;
+        }
+    };
+    auto putSymbol = [&](int s) { put(litCodes[s].bits, litCodes[s].len); };
+
+    out.clear();
+    out.reserve(raw.size() / 2 + 64);
+    out.push_back(0x78);
+    out.push_back(0x01);
+    put(1, 1);      // Final block
+    put(1, 2);      // Fixed Huffman
+
+    constexpr int HASH_BITS = 15;
+    constexpr size_t WINDOW = 32768;
+    std::vector<int32_t> head(size_t(1) << HASH_BITS, -1);
+    const unsigned char* p = raw.data();
+    size_t n = raw.size(), i = 0;
+
+    auto hash = [&](size_t at) {
+        return ((uint32_t(p[at]) << 16 | uint32_t(p[at + 1]) << 8 | p[at + 2]) * 2654435761u) >> (32 - HASH_BITS);
+    };
+
+    while (i + 3 <= n) {
+        uint32_t h = hash(i);
+        int32_t cand = head[h];
+        head[h] = static_cast<int32_t>(i);
+        if (cand >= 0 && i - cand <= WINDOW && std::memcmp(p + cand, p + i, 3) == 0) {
+            size_t maxLen = std::min<size_t>(258, n - i), len = 3;
+            while (len < maxLen && p[cand + len] == p[i + len]) ++len;
+
+            int ls = lenSymbols[len];
+            putSymbol(257 + ls);
+            if (lenExtra[ls]) put(static_cast<uint32_t>(len - lenBase[ls]), lenExtra[ls]);
+
+            // Distance: 5-bit fixed code (same reversed either way) + extra bits
+            uint32_t d1 = static_cast<uint32_t>(i - cand) - 1;
+            uint32_t code, extra = 0, extraBits = 0;
+            if (d1 < 4) {
+                code = d1;
+            } else {
+                int hb = std::bit_width(d1) - 1;
+                extraBits = hb - 1;
+                code = hb * 2 + ((d1 >> extraBits) & 1);
+                extra = d1 & ((1u << extraBits) - 1);
+            }
+            uint32_t rev = 0;
+            for (int b = 0; b < 5; ++b) rev |= ((code >> b) & 1) << (4 - b);
+            put(rev, 5);
+            if (extraBits) put(extra, extraBits);
+            i += len;
+            if (i + 2 <= n) head[hash(i - 1)] = static_cast<int32_t>(i - 1);    // Index the match tail too
+        } else {
+            putSymbol(p[i++]);
+        }
+    }
+    while (i < n) putSymbol(p[i++]);
+    putSymbol(256);     // End of block
+    if (accBits > 0) out.push_back(static_cast<unsigned char>(acc));
+    put32be(out, adler32(raw.data(), raw.size()));
+}
+
+// PNG with a single "Sub" filter for every row. stb_image_write tries all
+// five filters per row, which is several times slower for little gain on
+// rendered frames.
+inline bool encodePng(const Pixels& pixels, int compression, std::vector<unsigned char>& out) {
+    static const unsigned char colorTypes[] = {0, 0, 4, 2, 6};
+    int w = pixels.getWidth(), h = pixels.getHeight(), n = pixels.getChannels();
+    size_t stride = static_cast<size_t>(w) * n;
+
+    std::vector<unsigned char> filtered((stride + 1) * h);
+    const unsigned char* src = pixels.getData();
+    for (int y = 0; y < h; ++y) {
+        const unsigned char* row = src + stride * y;
+        unsigned char* dst = filtered.data() + (stride + 1) * y;
+        dst[0] = 1;     // Sub
+        std::memcpy(dst + 1, row, n);
+        for (size_t i = n; i < stride; ++i) dst[1 + i] = static_cast<unsigned char>(row[i] - row[i - n]);
+    }
+
+    std::vector<unsigned char> idat;
+    if (compression <= 0) {
+        zlibStore(filtered, idat);
+    } else if (compression < 5) {
+        zlibFast(filtered, idat);
+    } else {
+        int len = 0;
+        unsigned char* z = stbi_zlib_compress(filtered.data(), static_cast<int>(filtered.size()), &len, compression);
+        if (!z) return false;
+        idat.assign(z, z + len);
+        std::free(z);
+    }
+
+    static const unsigned char signature[] = {137, 80, 78, 71, 13, 10, 26, 10};
+    out.clear();
+    out.reserve(idat.size() + 64);
+    out.insert(out.end(), signature, signature + 8);
+
+    std::vector<unsigned char> ihdr;
+    put32be(ihdr, static_cast<uint32_t>(w));
+    put32be(ihdr, static_cast<uint32_t>(h));
+    ihdr.insert(ihdr.end(), {8, colorTypes[n], 0, 0, 0});
+    writeChunk(out, "IHDR", ihdr.data(), ihdr.size());
+    writeChunk(out, "IDAT", idat.data(), idat.size());
+    writeChunk(out, "IEND", nullptr, 0);
+    return true;
+}
+
+inline bool encodeQoi(const Pixels& pixels, std::vector<unsigned char>& out) {
+    int w = pixels.getWidth(), h = pixels.getHeight(), n = pixels.getChannels();
+    if (n != 3 && n != 4) return false;
+
+    out.clear();
+    out.reserve(14 + static_cast<size_t>(w) * h * (n + 1) / 2 + 8);
+    out.insert(out.end(), {'q', 'o', 'i', 'f'});
+    put32be(out, static_cast<uint32_t>(w));
+    put32be(out, static_cast<uint32_t>(h));
+    out.push_back(static_cast<unsigned char>(n));
+    out.push_back(0);   // sRGB with linear alpha
+
+    struct Px { unsigned char r, g, b, a; };
+    Px index[64] = {};
+    Px prev{0, 0, 0, 255};
+    int run = 0;
+    const unsigned char* p = pixels.getData();
+    size_t total = static_cast<size_t>(w) * h;
+
+    for (size_t i = 0; i < total; ++i, p += n) {
+        Px px{p[0], p[1], p[2], n == 4 ? p[3] : static_cast<unsigned char>(255)};
+        if (px.r == prev.r && px.g == prev.g && px.b == prev.b && px.a == prev.a) {
+            if (++run == 62 || i + 1 == total) {
+                out.push_back(static_cast<unsigned char>(0xC0 | (run - 1)));
+                run = 0;
+            }
+            continue;
+        }
+        if (run > 0) {
+            out.push_back(static_cast<unsigned char>(0xC0 | (run - 1)));
+            run = 0;
+        }
+
+        int hash = (px.r * 3 + px.g * 5 + px.b * 7 + px.a * 11) % 64;
+        const Px& cached = index[hash];
+        if (cached.r == px.r && cached.g == px.g && cached.b == px.b && cached.a == px.a) {
+            out.push_back(static_cast<unsigned char>(hash));
+        } else {
+            index[hash] = px;
+            if (px.a == prev.a) {
+                int8_t dr = static_cast<int8_t>(px.r - prev.r);
+                int8_t dg = static_cast<int8_t>(px.g - prev.g);
+                int8_t db = static_cast<int8_t>(px.b - prev.b);
+                int8_t drg = static_cast<int8_t>(dr - dg);
+                int8_t dbg = static_cast<int8_t>(db - dg);
+                if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2) {
+                    out.push_back(static_cast<unsigned char>(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                } else if (drg > -9 && drg < 8 && dg > -33 && dg < 32 && dbg > -9 && dbg < 8) {
+                    out.push_back(static_cast<unsigned char>(0x80 | (dg + 32)));
+                    out.push_back(static_cast<unsigned char>((drg + 8) << 4 | (dbg + 8)));
+                } else {
+                    out.insert(out.end(), {0xFE, px.r, px.g, px.b});
+                }
+            } else {
+                out.insert(out.end(), {0xFF, px.r, px.g, px.b, px.a});
+            }
+        }
+        prev = px;
+    }
+    out.insert(out.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+    return true;
+}
+
+inline bool writeFile(const fs::path& path, const std::vector<unsigned char>& bytes) {
+    FILE* file = std::fopen(path.string().c_str(), "wb");
+    if (!file) return false;
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return (std::fclose(file) == 0) && ok;
+}
+
+inline void appendToVector(void* context, void* data, int size) {
+    auto* out = static_cast<std::vector<unsigned char>*>(context);
+    auto* bytes = static_cast<unsigned char*>(data);
+    out->insert(out->end(), bytes, bytes + size);
+}
+
+} // namespace image_encoder_internal
+
+// ---------------------------------------------------------------------------
+// Synchronous encoding (thread-safe, usable from any thread)
+// ---------------------------------------------------------------------------
+inline bool encodeImage(const Pixels& pixels, const ImageEncodeSettings& settings, std::vector<unsigned char>& out) {
+    namespace ie = image_encoder_internal;
+    out.clear();
+    if (!pixels.isAllocated() || pixels.isFloat()) return false;
+    int w = pixels.getWidth(), h = pixels.getHeight(), n = pixels.getChannels();
+    if (w <= 0 || h <= 0 || n < 1 || n > 4) return false;
+
+    switch (settings.format) {
+        case ImageFormat::Png:
+            return ie::encodePng(pixels, settings.pngCompression, out);
+        case ImageFormat::Jpeg:
+            return stbi_write_jpg_to_func(ie::appendToVector, &out, w, h, n, pixels.getData(), settings.jpegQuality) != 0;
+        case ImageFormat::Bmp:
+            return stbi_write_bmp_to_func(ie::appendToVector, &out, w, h, n, pixels.getData()) != 0;
+        case ImageFormat::Qoi:
+            return ie::encodeQoi(pixels, out);
+        case ImageFormat::Raw:
+            out.assign(pixels.getData(), pixels.getData() + pixels.getTotalBytes());
+            return true;
+    }
+    return false;
+}
+
+inline bool writeImageFile(const Pixels& pixels, const fs::path& path, const ImageEncodeSettings& settings) {
+    std::vector<unsigned char> bytes;
+    return encodeImage(pixels, settings, bytes) && image_encoder_internal::writeFile(path, bytes);
+}
+
+// ---------------------------------------------------------------------------
+// ImageEncoder - worker pool with a bounded queue
+// ---------------------------------------------------------------------------
+class ImageEncoder {
+public:
+    // Called on an encoder thread
+    using SaveCallback = std::function<void(bool success, const fs::path& path)>;
+    using EncodeCallback = std::function<void(bool success, std::vector<unsigned char>& bytes)>;
+
+    // threads = 0: hardware threads - 1 (at least 1, at most 8)
+    explicit ImageEncoder(int threads = 0, size_t maxQueued = 8)
+        : threadCount_(threads), maxQueued_(std::max<size_t>(maxQueued, 1)) {}
+
+    ~ImageEncoder() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        jobReady_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+
+    ImageEncoder(const ImageEncoder&) = delete;
+    ImageEncoder& operator=(const ImageEncoder&) = delete;
+
+    // Max jobs waiting for a worker (in addition to the ones being encoded)
+    void setMaxQueued(size_t n) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        maxQueued_ = std::max<size_t>(n, 1);
+    }
+
+    // Encode and write a file. Blocks while the queue is full unless wait is
+    // false, in which case false is returned and pixels are left untouched.
+    bool save(Pixels&& pixels, const fs::path& path, const ImageEncodeSettings& settings,
+              SaveCallback onDone = nullptr, bool wait = true) {
+        Job job;
+        job.path = path;
+        job.settings = settings;
+        job.onSaved = std::move(onDone);
+        return submit(std::move(pixels), std::move(job), wait);
+    }
+
+    // Encode to memory (e.g. for Base64 transfer)
+    bool encode(Pixels&& pixels, const ImageEncodeSettings& settings, EncodeCallback onDone, bool wait = true) {
+        Job job;
+        job.settings = settings;
+        job.onEncoded = std::move(onDone);
+        return submit(std::move(pixels), std::move(job), wait);
+    }
+
+    // Wait until every submitted job has finished
+    void waitAll() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return queue_.empty() && active_ == 0; });
+    }
+
+    // Jobs queued or being encoded
+    size_t getPendingCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_.size() + active_;
+    }
+
+    // A buffer returned by a finished job (or an empty one); passing it to
+    // grabScreen() avoids reallocating frame-sized buffers every frame
+    Pixels acquirePixels() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (spare_.empty()) return Pixels();
+        Pixels p = std::move(spare_.back());
+        spare_.pop_back();
+        return p;
+    }
+
+private:
+    struct Job {
+        Pixels pixels;
+        fs::path path;
+        ImageEncodeSettings settings;
+        SaveCallback onSaved;
+        EncodeCallback onEncoded;
+    };
+
+    bool submit(Pixels&& pixels, Job&& job, bool wait) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        startWorkers();
+        if (wait) {
+            spaceFree_.wait(lock, [this] { return queue_.size() < maxQueued_; });
+        } else if (queue_.size() >= maxQueued_) {
+            return false;
+        }
+        job.pixels = std::move(pixels);
+        queue_.push_back(std::move(job));
+        lock.unlock();
+        jobReady_.notify_one();
+        return true;
+    }
+
+    void startWorkers() {
+        if (!workers_.empty()) return;
+        int n = threadCount_;
+        if (n <= 0) n = std::clamp(static_cast<int>(std::thread::hardware_concurrency()) - 1, 1, 8);
+        for (int i = 0; i < n; ++i) workers_.emplace_back([this] { workerLoop(); });
+    }
+
+    void workerLoop() {
+        std::vector<unsigned char> bytes;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            jobReady_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;     // Stopping and drained
+
+            Job job = std::move(queue_.front());
+            queue_.pop_front();
+            active_++;
+            lock.unlock();
+            spaceFree_.notify_one();
+
+            bool ok = encodeImage(job.pixels, job.settings, bytes);
+            if (job.onEncoded) {
+                job.onEncoded(ok, bytes);
+            } else {
+                if (ok) ok = image_encoder_internal::writeFile(job.path, bytes);
+                if (!ok) logError("ImageEncoder") << "Failed to save: " << job.path.string();
+                if (job.onSaved) job.onSaved(ok, job.path);
+            }
+
+            lock.lock();
+            active_--;
+            if (spare_.size() < maxQueued_) spare_.push_back(std::move(job.pixels));
+            if (queue_.empty() && active_ == 0) idle_.notify_all();
+        }
+    }
+
+    int threadCount_;
+    size_t maxQueued_;
+    bool stopping_ = false;
+    size_t active_ = 0;
+
+    mutable std::mutex mutex_;
+    std::condition_variable jobReady_;
+    std::condition_variable spaceFree_;
+    std::condition_variable idle_;
+    std::deque<Job> queue_;
+    std::vector<Pixels> spare_;
+    std::vector<std::thread> workers_;
+};
+
+// Shared encoder for screenshots
+inline ImageEncoder& imageEncoder() {
+    static ImageEncoder instance;
+    return instance;
+}
+
+// Grab the window now and encode/write it on a worker thread.
+// Format follows the extension; relative paths go to the data folder.
+// onDone is called on an encoder thread.
+inline bool saveScreenshotAsync(const fs::path& path, ImageEncoder::SaveCallback onDone = nullptr) {
+    Pixels pixels = imageEncoder().acquirePixels();
+    if (!grabScreen(pixels)) return false;
+    fs::path savePath = path.is_relative() ? fs::path(getDataPath(path.string())) : path;
+    ImageEncodeSettings settings;
+    settings.format = imageFormatFromPath(savePath);
+    return imageEncoder().save(std::move(pixels), savePath, settings, std::move(onDone));
+}
+
+// ---------------------------------------------------------------------------
+// FrameRecorder - numbered image sequence
+// ---------------------------------------------------------------------------
+class FrameRecorder {
+public:
+    FrameRecorder() = default;
+    ~FrameRecorder() { stop(); }
+
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    // Worker threads (0 = auto) and frames allowed to wait for a worker.
+    // Takes effect on the next start().
+    void setThreads(int threads) { threads_ = threads; }
+    void setMaxQueued(size_t frames) { maxQueued_ = frames; }
+
+    // false (default): addFrame() waits for a free slot, no frame is lost.
+    // true: frames arriving while the queue is full are skipped and counted.
+    void setDropWhenFull(bool drop) { dropWhenFull_ = drop; }
+
+    // Files are written as <directory>/<prefix><000000><ext>.
+    // Relative directories go to the data folder; created if missing.
+    bool start(const fs::path& directory, const ImageEncodeSettings& settings = {},
+               const std::string& prefix = "frame_") {
+        stop();
+        directory_ = directory.is_relative() ? fs::path(getDataPath(directory.string())) : directory;
+        std::error_code ec;
+        fs::create_directories(directory_, ec);
+        if (!fs::is_directory(directory_)) {
+            logError("FrameRecorder") << "Cannot create directory: " << directory_.string();
+            return false;
+        }
+        settings_ = settings;
+        prefix_ = prefix;
+        frameIndex_ = 0;
+        dropped_ = 0;
+        written_ = 0;
+        failed_ = 0;
+        encoder_ = std::make_unique<ImageEncoder>(threads_, maxQueued_);
+        return true;
+    }
+
+    // Waits until all queued frames are written
+    void stop() {
+        if (!encoder_) return;
+        encoder_->waitAll();
+        encoder_.reset();
+    }
+
+    bool isRecording() const { return encoder_ != nullptr; }
+
+    // Grab the window and queue it
+    bool captureFrame() {
+        if (!encoder_) return false;
+        Pixels pixels = encoder_->acquirePixels();
+        if (!grabScreen(pixels)) return false;
+        return addFrame(std::move(pixels));
+    }
+
+    // Queue a frame (from an Fbo readback, a video, ...)
+    bool addFrame(Pixels&& pixels) {
+        if (!encoder_) return false;
+        char name[32];
+        std::snprintf(name, sizeof(name), "%06llu", static_cast<unsigned long long>(frameIndex_));
+        fs::path path = directory_ / (prefix_ + name + imageFormatExtension(settings_.format));
+
+        bool queued = encoder_->save(std::move(pixels), path, settings_,
+            [this](bool ok, const fs::path&) { (ok ? written_ : failed_)++; },
+            !dropWhenFull_);
+        if (!queued) {
+            dropped_++;
+            return false;
+        }
+        frameIndex_++;
+        return true;
+    }
+
+    bool addFrame(const Pixels& pixels) {
+        if (!encoder_) return false;
+        Pixels copy = encoder_->acquirePixels();
+        if (copy.getWidth() != pixels.getWidth() || copy.getHeight() != pixels.getHeight() ||
+            copy.getChannels() != pixels.getChannels() || copy.getFormat() != pixels.getFormat()) {
+            copy.allocate(pixels.getWidth(), pixels.getHeight(), pixels.getChannels(), pixels.getFormat());
+        }
+        std::memcpy(copy.getDataVoid(), pixels.getDataVoid(), pixels.getTotalBytes());
+        return addFrame(std::move(copy));
+    }
+
+    uint64_t getFrameCount() const { return frameIndex_; }     // Queued so far
+    uint64_t getWrittenCount() const { return written_.load(); }
+    uint64_t getFailedCount() const { return failed_.load(); }
+    uint64_t getDroppedCount() const { return dropped_; }
+    size_t getPendingCount() const { return encoder_ ? encoder_->getPendingCount() : 0; }
+    const fs::path& getDirectory() const { return directory_; }
+
+private:
+    std::unique_ptr<ImageEncoder> encoder_;
+    fs::path directory_;
+    std::string prefix_;
+    ImageEncodeSettings settings_;
+    int threads_ = 0;
+    size_t maxQueued_ = 8;
+    bool dropWhenFull_ = false;
+
+    uint64_t frameIndex_ = 0;
+    uint64_t dropped_ = 0;
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> failed_{0};
+};
+
+} // namespace trussc
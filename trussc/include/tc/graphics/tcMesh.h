@@ -274,25 +274,9 @@ public:
 
     /// Apply transformation matrix to all vertices and normals
     void transform(const Mat4& m) {
-        for (auto& v : vertices_) {
-            v = m * v;
-        }
-        // Transform normals (rotation only, no translation)
-        for (auto& n : normals_) {
-            Vec3 transformed;
-            transformed.x = m.m[0] * n.x + m.m[1] * n.y + m.m[2] * n.z;
-            transformed.y = m.m[4] * n.x + m.m[5] * n.y + m.m[6] * n.z;
-            transformed.z = m.m[8] * n.x + m.m[9] * n.y + m.m[10] * n.z;
-            // Normalize
-            float len = std::sqrt(transformed.x * transformed.x +
-                                  transformed.y * transformed.y +
-                                  transformed.z * transformed.z);
-            if (len > 0.0001f) {
-                n.x = transformed.x / len;
-                n.y = transformed.y / len;
-                n.z = transformed.z / len;
-            }
-        }
+        transformPoints(m, vertices_, vertices_);
+        // Normals: rotation only, no translation
+        transformNormals(m, normals_, normals_);
     }
 
     // ---------------------------------------------------------------------------
@@ -441,84 +425,37 @@ public:
 
         const Material& material = *internal::currentMaterial;
 
+        // Light each vertex once (indexed meshes share vertices between
+        // triangles), transforming in stack-sized batches
+        constexpr size_t BATCH = 256;
+        Vec3 worldPositions[BATCH];
+        Vec3 worldNormals[BATCH];
+        size_t count = std::min(vertices_.size(), normals_.size());
+        std::vector<Color> litColors(count);
+        for (size_t start = 0; start < count; start += BATCH) {
+            size_t n = std::min(BATCH, count - start);
+            transformPoints(modelMatrix, std::span<const Vec3>(vertices_.data() + start, n),
+                            std::span<Vec3>(worldPositions, n));
+            transformNormals(modelMatrix, std::span<const Vec3>(normals_.data() + start, n),
+                             std::span<Vec3>(worldNormals, n));
+            for (size_t i = 0; i < n; i++) {
+                litColors[start + i] = calculateLighting(worldPositions[i], worldNormals[i], material);
+            }
+        }
+
         sgl_begin_triangles();
 
+        auto emit = [&](size_t i) {
+            const Color& c = litColors[i];
+            sgl_c4f(c.r, c.g, c.b, c.a);
+            sgl_v3f(vertices_[i].x, vertices_[i].y, vertices_[i].z);
+        };
         if (hasIndices()) {
             for (auto idx : indices_) {
-                if (idx < vertices_.size() && idx < normals_.size()) {
-                    const Vec3& localPos = vertices_[idx];
-                    const Vec3& localNormal = normals_[idx];
-
-                    // Transform to world coordinates
-                    Vec3 worldPos = modelMatrix * localPos;
-
-                    // Transform normal (apply rotation only, ignore translation)
-                    Vec3 worldNormal;
-                    worldNormal.x = modelMatrix.m[0] * localNormal.x +
-                                    modelMatrix.m[1] * localNormal.y +
-                                    modelMatrix.m[2] * localNormal.z;
-                    worldNormal.y = modelMatrix.m[4] * localNormal.x +
-                                    modelMatrix.m[5] * localNormal.y +
-                                    modelMatrix.m[6] * localNormal.z;
-                    worldNormal.z = modelMatrix.m[8] * localNormal.x +
-                                    modelMatrix.m[9] * localNormal.y +
-                                    modelMatrix.m[10] * localNormal.z;
-
-                    // Normalize normal
-                    float len = std::sqrt(worldNormal.x * worldNormal.x +
-                                          worldNormal.y * worldNormal.y +
-                                          worldNormal.z * worldNormal.z);
-                    if (len > 0.0001f) {
-                        worldNormal.x /= len;
-                        worldNormal.y /= len;
-                        worldNormal.z /= len;
-                    }
-
-                    // Lighting calculation
-                    Color litColor = calculateLighting(worldPos, worldNormal, material);
-
-                    sgl_c4f(litColor.r, litColor.g, litColor.b, litColor.a);
-                    sgl_v3f(localPos.x, localPos.y, localPos.z);
-                }
+                if (idx < count) emit(idx);
             }
         } else {
-            for (size_t i = 0; i < vertices_.size(); i++) {
-                if (i < normals_.size()) {
-                    const Vec3& localPos = vertices_[i];
-                    const Vec3& localNormal = normals_[i];
-
-                    // Transform to world coordinates
-                    Vec3 worldPos = modelMatrix * localPos;
-
-                    // Transform normal
-                    Vec3 worldNormal;
-                    worldNormal.x = modelMatrix.m[0] * localNormal.x +
-                                    modelMatrix.m[1] * localNormal.y +
-                                    modelMatrix.m[2] * localNormal.z;
-                    worldNormal.y = modelMatrix.m[4] * localNormal.x +
-                                    modelMatrix.m[5] * localNormal.y +
-                                    modelMatrix.m[6] * localNormal.z;
-                    worldNormal.z = modelMatrix.m[8] * localNormal.x +
-                                    modelMatrix.m[9] * localNormal.y +
-                                    modelMatrix.m[10] * localNormal.z;
-
-                    // Normalize normal
-                    float len = std::sqrt(worldNormal.x * worldNormal.x +
-                                          worldNormal.y * worldNormal.y +
-                                          worldNormal.z * worldNormal.z);
-                    if (len > 0.0001f) {
-                        worldNormal.x /= len;
-                        worldNormal.y /= len;
-                        worldNormal.z /= len;
-                    }
-
-                    // Lighting calculation
-                    Color litColor = calculateLighting(worldPos, worldNormal, material);
-
-                    sgl_c4f(litColor.r, litColor.g, litColor.b, litColor.a);
-                    sgl_v3f(localPos.x, localPos.y, localPos.z);
-                }
-            }
+            for (size_t i = 0; i < count; i++) emit(i);
         }
 
         sgl_end();
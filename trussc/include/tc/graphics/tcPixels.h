@@ -7,6 +7,7 @@
 // This file is included from TrussC.h
 
 #include <filesystem>
+#include <cstring>
 #include "stb/stb_image.h"
 #include "stb/stb_image_write.h"
 
@@ -46,6 +47,11 @@ public:
 
     // Allocate empty pixel buffer
     void allocate(int width, int height, int channels = 4, PixelFormat format = PixelFormat::U8) {
+        // Same layout: keep the buffer (avoids reallocating frame-sized buffers)
+        if (allocated_ && width == width_ && height == height_ && channels == channels_ && format == format_) {
+            std::memset(data_, 0, getTotalBytes());
+            return;
+        }
         clear();
 
         width_ = width;
@@ -10,6 +10,7 @@
 #include "tc/utils/tcLog.h"
 #include "tc/gui/tcImGuiHooks.h"
 #include "tc/gui/tcImGuiTools.h"
+#include "tc/gui/tcImGuiProfiler.h"
 
 namespace trussc {
 
@@ -0,0 +1,213 @@
+#pragma once
+
+// =============================================================================
+// tcImGuiProfiler.h - ImGui view for the frame profiler
+//
+// Call imguiDrawProfiler() between imguiBegin() and imguiEnd().
+// Shows frame times, a per-thread timeline (flame view) of the selected
+// frame and per-zone totals. Profiling is switched on the first time the
+// window is drawn; the app or the Record checkbox can turn it off again.
+// =============================================================================
+
+#include "imgui/imgui.h"
+#include "tc/utils/tcProfiler.h"
+#include "tc/utils/tcUtils.h"
+
+namespace trussc {
+namespace profiler_gui {
+
+// Stable color per zone name
+inline ImU32 zoneColor(const char* name) {
+    uint32_t hash = 2166136261u;
+    for (const char* p = name; *p; ++p) {
+        hash = (hash ^ static_cast<uint8_t>(*p)) * 16777619u;
+    }
+    float r, g, b;
+    ImGui::ColorConvertHSVtoRGB((hash % 360) / 360.0f, 0.5f, 0.85f, r, g, b);
+    return ImGui::ColorConvertFloat4ToU32(ImVec4(r, g, b, 1.0f));
+}
+
+struct State {
+    size_t selected = 0;        // Frame shown in timeline (0 = newest)
+    float zoom = 1.0f;
+    std::string message;
+    ProfileFrame frame;         // Reused copy of the selected frame
+    bool autoEnabled = false;   // Profiler switched on by the first draw
+};
+
+inline State& state() {
+    static State s;
+    return s;
+}
+
+inline void drawTimeline(const ProfileFrame& frame, const std::vector<std::string>& threadNames, float zoom) {
+    const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+    const float laneGap = 6.0f;
+    const float labelWidth = 80.0f;
+
+    // Deepest zone per thread (-1 = no zones this frame)
+    std::vector<int> maxDepth(threadNames.size(), -1);
+    for (auto& zone : frame.zones) {
+        if (zone.thread < maxDepth.size()) {
+            maxDepth[zone.thread] = std::max(maxDepth[zone.thread], static_cast<int>(zone.depth));
+        }
+    }
+    float height = 0.0f;
+    for (int depth : maxDepth) {
+        if (depth >= 0) height += (depth + 1) * rowHeight + laneGap;
+    }
+
+    ImGui::BeginChild("timeline", ImVec2(0, std::min(height + 24.0f, 280.0f)),
+                      ImGuiChildFlags_Borders, ImGuiWindowFlags_HorizontalScrollbar);
+
+    float width = std::max(100.0f, (ImGui::GetContentRegionAvail().x - labelWidth) * zoom);
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImGui::Dummy(ImVec2(labelWidth + width, height));
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ImVec2 mouse = ImGui::GetIO().MousePos;
+    bool windowHovered = ImGui::IsWindowHovered();
+    double span = frame.end > frame.start ? static_cast<double>(frame.end - frame.start) : 1.0;
+    const ProfileZone* hovered = nullptr;
+
+    float y = origin.y;
+    for (size_t t = 0; t < threadNames.size(); ++t) {
+        if (maxDepth[t] < 0) continue;
+        drawList->AddText(ImVec2(origin.x, y + 2.0f), ImGui::GetColorU32(ImGuiCol_TextDisabled), threadNames[t].c_str());
+
+        for (auto& zone : frame.zones) {
+            if (zone.thread != t || zone.end < frame.start || zone.start > frame.end) continue;
+
+            // Clip zones that started before / ended after the frame
+            double s = (std::max(zone.start, frame.start) - frame.start) / span;
+            double e = (std::min(zone.end, frame.end) - frame.start) / span;
+            float x0 = origin.x + labelWidth + static_cast<float>(s * width);
+            float x1 = std::max(origin.x + labelWidth + static_cast<float>(e * width), x0 + 1.0f);
+            float y0 = y + zone.depth * rowHeight;
+            ImVec2 p0(x0, y0);
+            ImVec2 p1(x1, y0 + rowHeight - 1.0f);
+
+            drawList->AddRectFilled(p0, p1, zoneColor(zone.name));
+            if (x1 - x0 > 24.0f) {
+                drawList->PushClipRect(p0, p1, true);
+                drawList->AddText(ImVec2(x0 + 3.0f, y0 + 2.0f), IM_COL32(0, 0, 0, 255), zone.name);
+                drawList->PopClipRect();
+            }
+            if (windowHovered && mouse.x >= x0 && mouse.x < x1 && mouse.y >= p0.y && mouse.y < p1.y) {
+                hovered = &zone;
+            }
+        }
+        y += (maxDepth[t] + 1) * rowHeight + laneGap;
+    }
+
+    if (hovered) {
+        ImGui::SetTooltip("%s\n%.3f ms", hovered->name, hovered->getDurationMs());
+    }
+    ImGui::EndChild();
+}
+
+} // namespace profiler_gui
+
+// ---------------------------------------------------------------------------
+// Profiler window
+// ---------------------------------------------------------------------------
+inline void imguiDrawProfiler(bool* open = nullptr) {
+    auto& prof = profiler();
+    auto& st = profiler_gui::state();
+    if (!st.autoEnabled) {
+        prof.setEnabled(true);
+        st.autoEnabled = true;
+    }
+
+    ImGui::SetNextWindowSize(ImVec2(720, 520), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Profiler", open)) {
+        ImGui::End();
+        return;
+    }
+
+    // --- Frame times ---
+    auto times = prof.getFrameTimesMs();
+    float avg = 0.0f, maxTime = 0.0f;
+    for (float t : times) {
+        avg += t;
+        maxTime = std::max(maxTime, t);
+    }
+    if (!times.empty()) avg /= times.size();
+    float last = times.empty() ? 0.0f : times.back();
+    ImGui::Text("Frame %.2f ms  (avg %.2f, max %.2f)", last, avg, maxTime);
+
+    bool enabled = prof.isEnabled();
+    if (ImGui::Checkbox("Record", &enabled)) {
+        prof.setEnabled(enabled);
+    }
+    ImGui::SameLine();
+    bool paused = prof.isPaused();
+    if (ImGui::Checkbox("Pause", &paused)) {
+        prof.setPaused(paused);
+        if (!paused) st.selected = 0;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Save Chrome Trace")) {
+        std::string path = getDataPath("profile_trace.json");
+        st.message = prof.saveChromeTrace(path) ? "Saved " + path : "Failed to save " + path;
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderFloat("Zoom", &st.zoom, 1.0f, 50.0f, "%.1fx", ImGuiSliderFlags_Logarithmic);
+    if (!st.message.empty()) {
+        ImGui::TextDisabled("%s", st.message.c_str());
+    }
+
+    ImGui::PlotHistogram("##frames", times.data(), static_cast<int>(times.size()), 0, nullptr,
+                         0.0f, std::max(maxTime, 16.7f), ImVec2(-1, 60));
+
+    // Click a bar to inspect that frame (pauses recording)
+    if (ImGui::IsItemHovered() && ImGui::IsMouseClicked(0) && !times.empty()) {
+        float rel = (ImGui::GetIO().MousePos.x - ImGui::GetItemRectMin().x) / ImGui::GetItemRectSize().x;
+        size_t index = static_cast<size_t>(std::clamp(rel, 0.0f, 0.999f) * times.size());
+        st.selected = times.size() - 1 - index;
+        prof.setPaused(true);
+    }
+    if (!prof.isPaused()) st.selected = 0;
+
+    // --- Timeline ---
+    if (prof.getFrame(st.selected, st.frame)) {
+        ImGui::Text("Frame #%llu  %.3f ms  (%zu zones)",
+                    static_cast<unsigned long long>(st.frame.index), st.frame.getDurationMs(), st.frame.zones.size());
+        profiler_gui::drawTimeline(st.frame, prof.getThreadNames(), st.zoom);
+    }
+
+    // --- Zone totals ---
+    if (ImGui::CollapsingHeader("Zones", ImGuiTreeNodeFlags_DefaultOpen)) {
+        auto stats = prof.getZoneStats();
+        ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY;
+        if (ImGui::BeginTable("zones", 4, flags, ImVec2(0, 200))) {
+            ImGui::TableSetupColumn("Zone");
+            ImGui::TableSetupColumn("Calls/frame");
+            ImGui::TableSetupColumn("Avg ms");
+            ImGui::TableSetupColumn("Max ms");
+            ImGui::TableHeadersRow();
+            for (auto& s : stats) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(s.name.c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", s.callsPerFrame);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", s.avgMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", s.maxMs);
+            }
+            ImGui::EndTable();
+        }
+    }
+
+    if (prof.getDroppedZoneCount() > 0) {
+        ImGui::TextDisabled("%llu zones dropped (thread buffer full)",
+                            static_cast<unsigned long long>(prof.getDroppedZoneCount()));
+    }
+
+    ImGui::End();
+}
+
+} // namespace trussc
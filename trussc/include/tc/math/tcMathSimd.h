@@ -0,0 +1,377 @@
+#pragma once
+
+// =============================================================================
+// tcMathSimd.h - 4x4 matrix and point kernels behind Mat4 (SSE2 / NEON)
+// =============================================================================
+// Raw float kernels used by tcMath.h. Matrices are row-major float[16]
+// (Mat4::m), points are packed x, y, z (Vec3). Every kernel has a scalar
+// version in math_detail::scalar, used on other CPUs, for tails and as the
+// reference in the math benchmark.
+//
+//   multiply()          out = a * b (out may alias a or b)
+//   invert()            false (out untouched) if the matrix is singular
+//   transformPoints()   out = m * p with perspective divide (Mat4 * Vec3)
+//   transformNormals()  upper 3x3 of m, renormalized
+//
+// NEON is used on AArch64 only (32-bit ARM has no vector divide / sqrt).
+// =============================================================================
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TC_MATH_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define TC_MATH_NEON 1
+#endif
+
+namespace trussc {
+
+namespace math_detail {
+
+// -----------------------------------------------------------------------------
+// Scalar kernels
+// -----------------------------------------------------------------------------
+
+namespace scalar {
+
+inline void multiply(const float* a, const float* b, float* out) {
+    float r[16];
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            float sum = 0;
+            for (int k = 0; k < 4; k++) {
+                sum += a[row * 4 + k] * b[k * 4 + col];
+            }
+            r[row * 4 + col] = sum;
+        }
+    }
+    for (int i = 0; i < 16; i++) out[i] = r[i];
+}
+
+inline bool invert(const float* m, float* out) {
+    float inv[16];
+
+    inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15]
+           + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+    inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15]
+           - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+    inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15]
+           + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+    inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11]
+           - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+
+    inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15]
+           - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+    inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15]
+           + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+    inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15]
+           - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+    inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11]
+           + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+
+    inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15]
+           + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+    inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15]
+           - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+    inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15]
+            + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+    inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11]
+            - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+
+    inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14]
+            - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+    inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14]
+            + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+    inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14]
+            - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+    inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10]
+            + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+    float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+    if (std::abs(det) < 1e-10f) return false;
+
+    float invDet = 1.0f / det;
+    for (int i = 0; i < 16; i++) {
+        out[i] = inv[i] * invDet;
+    }
+    return true;
+}
+
+inline void transformPoints(const float* m, const float* in, float* out, size_t count) {
+    for (size_t i = 0; i < count; i++, in += 3, out += 3) {
+        float x = in[0], y = in[1], z = in[2];
+        float w = m[12] * x + m[13] * y + m[14] * z + m[15];
+        out[0] = (m[0] * x + m[1] * y + m[2]  * z + m[3])  / w;
+        out[1] = (m[4] * x + m[5] * y + m[6]  * z + m[7])  / w;
+        out[2] = (m[8] * x + m[9] * y + m[10] * z + m[11]) / w;
+    }
+}
+
+inline void transformNormals(const float* m, const float* in, float* out, size_t count) {
+    for (size_t i = 0; i < count; i++, in += 3, out += 3) {
+        float x = in[0], y = in[1], z = in[2];
+        float nx = m[0] * x + m[1] * y + m[2]  * z;
+        float ny = m[4] * x + m[5] * y + m[6]  * z;
+        float nz = m[8] * x + m[9] * y + m[10] * z;
+        float len = std::sqrt(nx * nx + ny * ny + nz * nz);
+        if (len > 0.0001f) {
+            out[0] = nx / len;
+            out[1] = ny / len;
+            out[2] = nz / len;
+        } else {
+            // Degenerate: keep the input normal
+            out[0] = x;
+            out[1] = y;
+            out[2] = z;
+        }
+    }
+}
+
+} // namespace scalar
+
+// -----------------------------------------------------------------------------
+// 4-lane float
+// -----------------------------------------------------------------------------
+
+#if defined(TC_MATH_SSE2)
+
+using F4 = __m128;
+inline F4 load(const float* p) { return _mm_loadu_ps(p); }
+inline void store(float* p, F4 v) { _mm_storeu_ps(p, v); }
+inline F4 splat(float s) { return _mm_set1_ps(s); }
+inline F4 set(float a, float b, float c, float d) { return _mm_setr_ps(a, b, c, d); }
+inline F4 add(F4 a, F4 b) { return _mm_add_ps(a, b); }
+inline F4 sub(F4 a, F4 b) { return _mm_sub_ps(a, b); }
+inline F4 mul(F4 a, F4 b) { return _mm_mul_ps(a, b); }
+inline F4 div(F4 a, F4 b) { return _mm_div_ps(a, b); }
+inline F4 sqrt(F4 v) { return _mm_sqrt_ps(v); }
+inline float first(F4 v) { return _mm_cvtss_f32(v); }
+
+// a > b ? ifTrue : ifFalse per lane
+inline F4 selectGreater(F4 a, F4 b, F4 ifTrue, F4 ifFalse) {
+    F4 mask = _mm_cmpgt_ps(a, b);
+    return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+}
+
+// (a[i0], a[i1], b[i2], b[i3])
+template <int i0, int i1, int i2, int i3>
+inline F4 shuffle(F4 a, F4 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(i3, i2, i1, i0)); }
+
+// 4 packed points -> x, y, z lanes
+inline void loadXyz4(const float* p, F4& x, F4& y, F4& z) {
+    F4 a = _mm_loadu_ps(p);         // x0 y0 z0 x1
+    F4 b = _mm_loadu_ps(p + 4);     // y1 z1 x2 y2
+    F4 c = _mm_loadu_ps(p + 8);     // z2 x3 y3 z3
+    x = shuffle<0, 3, 0, 3>(a, shuffle<2, 3, 0, 1>(b, c));
+    y = shuffle<0, 2, 0, 2>(shuffle<1, 1, 0, 0>(a, b), shuffle<3, 3, 2, 2>(b, c));
+    z = shuffle<0, 2, 0, 2>(shuffle<2, 2, 1, 1>(a, b), shuffle<0, 0, 3, 3>(c, c));
+}
+
+inline void storeXyz4(float* p, F4 x, F4 y, F4 z) {
+    F4 xyLo = _mm_unpacklo_ps(x, y);            // x0 y0 x1 y1
+    F4 xyHi = _mm_unpackhi_ps(x, y);            // x2 y2 x3 y3
+    F4 zxy = shuffle<0, 1, 2, 3>(z, xyLo);      // z0 z1 x1 y1
+    F4 zHi = shuffle<2, 3, 2, 3>(z, xyHi);      // z2 z3 x3 y3
+    _mm_storeu_ps(p, shuffle<0, 1, 0, 2>(xyLo, zxy));
+    _mm_storeu_ps(p + 4, shuffle<3, 1, 0, 1>(zxy, xyHi));
+    _mm_storeu_ps(p + 8, shuffle<0, 2, 3, 1>(zHi, zHi));
+}
+
+#elif defined(TC_MATH_NEON)
+
+using F4 = float32x4_t;
+inline F4 load(const float* p) { return vld1q_f32(p); }
+inline void store(float* p, F4 v) { vst1q_f32(p, v); }
+inline F4 splat(float s) { return vdupq_n_f32(s); }
+inline F4 set(float a, float b, float c, float d) {
+    const float v[4] = {a, b, c, d};
+    return vld1q_f32(v);
+}
+inline F4 add(F4 a, F4 b) { return vaddq_f32(a, b); }
+inline F4 sub(F4 a, F4 b) { return vsubq_f32(a, b); }
+inline F4 mul(F4 a, F4 b) { return vmulq_f32(a, b); }
+inline F4 div(F4 a, F4 b) { return vdivq_f32(a, b); }
+inline F4 sqrt(F4 v) { return vsqrtq_f32(v); }
+inline float first(F4 v) { return vgetq_lane_f32(v, 0); }
+
+inline F4 selectGreater(F4 a, F4 b, F4 ifTrue, F4 ifFalse) {
+    return vbslq_f32(vcgtq_f32(a, b), ifTrue, ifFalse);
+}
+
+template <int i0, int i1, int i2, int i3>
+inline F4 shuffle(F4 a, F4 b) {
+    F4 r = vdupq_n_f32(vgetq_lane_f32(a, i0));
+    r = vsetq_lane_f32(vgetq_lane_f32(a, i1), r, 1);
+    r = vsetq_lane_f32(vgetq_lane_f32(b, i2), r, 2);
+    return vsetq_lane_f32(vgetq_lane_f32(b, i3), r, 3);
+}
+
+inline void loadXyz4(const float* p, F4& x, F4& y, F4& z) {
+    float32x4x3_t v = vld3q_f32(p);
+    x = v.val[0];
+    y = v.val[1];
+    z = v.val[2];
+}
+
+inline void storeXyz4(float* p, F4 x, F4 y, F4 z) {
+    float32x4x3_t v;
+    v.val[0] = x;
+    v.val[1] = y;
+    v.val[2] = z;
+    vst3q_f32(p, v);
+}
+
+#endif
+
+#if defined(TC_MATH_SSE2) || defined(TC_MATH_NEON)
+
+#define TC_MATH_SIMD 1
+
+template <int i0, int i1, int i2, int i3>
+inline F4 swizzle(F4 v) { return shuffle<i0, i1, i2, i3>(v, v); }
+
+// -----------------------------------------------------------------------------
+// SIMD kernels
+// -----------------------------------------------------------------------------
+
+inline void multiply(const float* a, const float* b, float* out) {
+    F4 b0 = load(b), b1 = load(b + 4), b2 = load(b + 8), b3 = load(b + 12);
+    F4 r[4];
+    for (int row = 0; row < 4; row++) {
+        const float* ar = a + row * 4;
+        r[row] = add(add(add(mul(splat(ar[0]), b0), mul(splat(ar[1]), b1)),
+                         mul(splat(ar[2]), b2)), mul(splat(ar[3]), b3));
+    }
+    for (int row = 0; row < 4; row++) store(out + row * 4, r[row]);
+}
+
+// 2x2 blocks as (m00, m01, m10, m11); adj() is the adjugate
+inline F4 mat2Mul(F4 a, F4 b) {         // a * b
+    return add(mul(a, swizzle<0, 3, 0, 3>(b)), mul(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+}
+inline F4 mat2AdjMul(F4 a, F4 b) {      // adj(a) * b
+    return sub(mul(swizzle<3, 3, 0, 0>(a), b), mul(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b)));
+}
+inline F4 mat2MulAdj(F4 a, F4 b) {      // a * adj(b)
+    return sub(mul(a, swizzle<3, 0, 3, 0>(b)), mul(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+}
+
+// Block-wise inverse: M = | A B |
+//                         | C D |
+inline bool invert(const float* m, float* out) {
+    F4 r0 = load(m), r1 = load(m + 4), r2 = load(m + 8), r3 = load(m + 12);
+    F4 a = shuffle<0, 1, 0, 1>(r0, r1);
+    F4 b = shuffle<2, 3, 2, 3>(r0, r1);
+    F4 c = shuffle<0, 1, 0, 1>(r2, r3);
+    F4 d = shuffle<2, 3, 2, 3>(r2, r3);
+
+    // (|A|, |B|, |C|, |D|)
+    F4 detSub = sub(mul(shuffle<0, 2, 0, 2>(r0, r2), shuffle<1, 3, 1, 3>(r1, r3)),
+                    mul(shuffle<1, 3, 1, 3>(r0, r2), shuffle<0, 2, 0, 2>(r1, r3)));
+    F4 detA = swizzle<0, 0, 0, 0>(detSub);
+    F4 detB = swizzle<1, 1, 1, 1>(detSub);
+    F4 detC = swizzle<2, 2, 2, 2>(detSub);
+    F4 detD = swizzle<3, 3, 3, 3>(detSub);
+
+    F4 dc = mat2AdjMul(d, c);
+    F4 ab = mat2AdjMul(a, b);
+    F4 x = sub(mul(detD, a), mat2Mul(b, dc));
+    F4 w = sub(mul(detA, d), mat2Mul(c, ab));
+    F4 y = sub(mul(detB, c), mat2MulAdj(d, ab));
+    F4 z = sub(mul(detC, b), mat2MulAdj(a, dc));
+
+    // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+    F4 tr = mul(ab, swizzle<0, 2, 1, 3>(dc));
+    tr = add(tr, swizzle<2, 3, 0, 1>(tr));
+    tr = add(tr, swizzle<1, 0, 3, 2>(tr));
+    F4 detM = sub(add(mul(detA, detD), mul(detB, detC)), tr);
+    if (std::abs(first(detM)) < 1e-10f) return false;
+
+    F4 rDet = div(set(1.0f, -1.0f, -1.0f, 1.0f), detM);
+    x = mul(x, rDet);
+    y = mul(y, rDet);
+    z = mul(z, rDet);
+    w = mul(w, rDet);
+
+    // Adjugate of each block, written back as rows
+    store(out, shuffle<3, 1, 3, 1>(x, y));
+    store(out + 4, shuffle<2, 0, 2, 0>(x, y));
+    store(out + 8, shuffle<3, 1, 3, 1>(z, w));
+    store(out + 12, shuffle<2, 0, 2, 0>(z, w));
+    return true;
+}
+
+// 4 points per step (x, y, z in separate lanes), scalar for the rest
+inline void transformPoints(const float* m, const float* in, float* out, size_t count) {
+    const F4 m0 = splat(m[0]), m1 = splat(m[1]), m2 = splat(m[2]), m3 = splat(m[3]);
+    const F4 m4 = splat(m[4]), m5 = splat(m[5]), m6 = splat(m[6]), m7 = splat(m[7]);
+    const F4 m8 = splat(m[8]), m9 = splat(m[9]), m10 = splat(m[10]), m11 = splat(m[11]);
+    // w is exactly 1 for affine matrices: skip the divide
+    const bool affine = m[12] == 0.0f && m[13] == 0.0f && m[14] == 0.0f && m[15] == 1.0f;
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        F4 x, y, z;
+        loadXyz4(in + i * 3, x, y, z);
+        F4 rx = add(add(add(mul(m0, x), mul(m1, y)), mul(m2, z)), m3);
+        F4 ry = add(add(add(mul(m4, x), mul(m5, y)), mul(m6, z)), m7);
+        F4 rz = add(add(add(mul(m8, x), mul(m9, y)), mul(m10, z)), m11);
+        if (!affine) {
+            F4 rw = add(add(add(mul(splat(m[12]), x), mul(splat(m[13]), y)),
+                            mul(splat(m[14]), z)), splat(m[15]));
+            rx = div(rx, rw);
+            ry = div(ry, rw);
+            rz = div(rz, rw);
+        }
+        storeXyz4(out + i * 3, rx, ry, rz);
+    }
+    scalar::transformPoints(m, in + i * 3, out + i * 3, count - i);
+}
+
+inline void transformNormals(const float* m, const float* in, float* out, size_t count) {
+    const F4 m0 = splat(m[0]), m1 = splat(m[1]), m2 = splat(m[2]);
+    const F4 m4 = splat(m[4]), m5 = splat(m[5]), m6 = splat(m[6]);
+    const F4 m8 = splat(m[8]), m9 = splat(m[9]), m10 = splat(m[10]);
+    const F4 minLength = splat(0.0001f);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        F4 x, y, z;
+        loadXyz4(in + i * 3, x, y, z);
+        F4 nx = add(add(mul(m0, x), mul(m1, y)), mul(m2, z));
+        F4 ny = add(add(mul(m4, x), mul(m5, y)), mul(m6, z));
+        F4 nz = add(add(mul(m8, x), mul(m9, y)), mul(m10, z));
+        F4 len = sqrt(add(add(mul(nx, nx), mul(ny, ny)), mul(nz, nz)));
+        nx = selectGreater(len, minLength, div(nx, len), x);
+        ny = selectGreater(len, minLength, div(ny, len), y);
+        nz = selectGreater(len, minLength, div(nz, len), z);
+        storeXyz4(out + i * 3, nx, ny, nz);
+    }
+    scalar::transformNormals(m, in + i * 3, out + i * 3, count - i);
+}
+
+inline const char* backendName() {
+#if defined(TC_MATH_SSE2)
+    return "SSE2";
+#else
+    return "NEON";
+#endif
+}
+
+#else
+
+using scalar::multiply;
+using scalar::invert;
+using scalar::transformPoints;
+using scalar::transformNormals;
+
+inline const char* backendName() { return "scalar"; }
+
+#endif
+
+} // namespace math_detail
+
+} // namespace trussc
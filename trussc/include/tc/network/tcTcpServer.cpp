@@ -5,6 +5,8 @@
 #include "tc/network/tcTcpServer.h"
 #include "tc/utils/tcLog.h"
 #include <cstring>
+#include <climits>
+#include <algorithm>
 
 #ifdef _WIN32
     #define CLOSE_SOCKET closesocket
@@ -17,6 +19,13 @@
     #define SOCKET_ERROR -1
 #endif
 
+// Writing to a socket the peer has closed must not raise SIGPIPE
+#ifdef MSG_NOSIGNAL
+    #define SEND_FLAGS MSG_NOSIGNAL
+#else
+    #define SEND_FLAGS 0
+#endif
+
 namespace trussc {
 
 std::atomic<int> TcpServer::instanceCount_{0};
@@ -186,6 +195,12 @@ void TcpServer::acceptThreadFunc() {
         inet_ntop(AF_INET, &clientAddr.sin_addr, hostStr, INET_ADDRSTRLEN);
         int clientPort = ntohs(clientAddr.sin_port);
 
+#ifdef SO_NOSIGPIPE
+        // macOS has no MSG_NOSIGNAL
+        int noSigPipe = 1;
+        setsockopt(clientSocket, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
         // Register client
         int clientId;
         {
@@ -196,6 +211,7 @@ void TcpServer::acceptThreadFunc() {
             client.host_ = hostStr;
             client.port_ = clientPort;
             client.socket_ = clientSocket;
+            client.sendState_ = std::make_shared<TcpServerClient::SendState>();
             clients_[clientId] = client;
         }
 
@@ -280,27 +296,29 @@ void TcpServer::clientThreadFunc(int clientId) {
 // Client management
 // =============================================================================
 void TcpServer::disconnectClient(int clientId) {
-    std::lock_guard<std::mutex> lock(clientsMutex_);
-    auto it = clients_.find(clientId);
-    if (it != clients_.end()) {
-#ifdef _WIN32
-        shutdown(it->second.socket_, SD_BOTH);
-        CLOSE_SOCKET(it->second.socket_);
-#else
-        shutdown(it->second.socket_, SHUT_RDWR);
-        CLOSE_SOCKET(it->second.socket_);
-#endif
-        clients_.erase(it);
-    }
+    TcpServerClient client;
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex_);
+        auto it = clients_.find(clientId);
+        if (it != clients_.end()) {
+            client = it->second;
+            found = true;
+            clients_.erase(it);
+        }
 
-    // Detach thread (let it self-terminate)
-    auto threadIt = clientThreads_.find(clientId);
-    if (threadIt != clientThreads_.end()) {
-        if (threadIt->second.joinable()) {
-            threadIt->second.detach();
+        // Detach thread (let it self-terminate)
+        auto threadIt = clientThreads_.find(clientId);
+        if (threadIt != clientThreads_.end()) {
+            if (threadIt->second.joinable()) {
+                threadIt->second.detach();
+            }
+            clientThreads_.erase(threadIt);
         }
-        clientThreads_.erase(threadIt);
     }
+
+    // Close outside clientsMutex_: may wait for a send in progress
+    if (found) closeClientSocket(client);
 }
 
 void TcpServer::disconnectAllClients() {
@@ -335,12 +353,35 @@ void TcpServer::disconnectAllClients() {
 }
 
 void TcpServer::removeClient(int clientId) {
-    std::lock_guard<std::mutex> lock(clientsMutex_);
-    auto it = clients_.find(clientId);
-    if (it != clients_.end()) {
-        CLOSE_SOCKET(it->second.socket_);
+    TcpServerClient client;
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex_);
+        auto it = clients_.find(clientId);
+        if (it == clients_.end()) return;
+        client = it->second;
         clients_.erase(it);
     }
+    closeClientSocket(client);
+}
+
+bool TcpServer::findClient(int clientId, TcpServerClient& out) const {
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    auto it = clients_.find(clientId);
+    if (it == clients_.end()) return false;
+    out = it->second;
+    return true;
+}
+
+void TcpServer::closeClientSocket(const TcpServerClient& client) {
+    // shutdown first: wakes a send() blocked on this socket so its lock frees up
+#ifdef _WIN32
+    shutdown(client.socket_, SD_BOTH);
+#else
+    shutdown(client.socket_, SHUT_RDWR);
+#endif
+    std::lock_guard<std::mutex> lock(client.sendState_->mutex);
+    client.sendState_->closed = true;
+    CLOSE_SOCKET(client.socket_);
 }
 
 int TcpServer::getClientCount() const {
@@ -370,18 +411,22 @@ const TcpServerClient* TcpServer::getClient(int clientId) const {
 // Data send
 // =============================================================================
 bool TcpServer::send(int clientId, const void* data, size_t size) {
-    std::lock_guard<std::mutex> lock(clientsMutex_);
-    auto it = clients_.find(clientId);
-    if (it == clients_.end()) {
+    // clientsMutex_ is not held while sending: a slow client must not stall
+    // accept, disconnect or sends to other clients
+    TcpServerClient client;
+    if (!findClient(clientId, client)) {
         notifyError("Client not found", 0, clientId);
         return false;
     }
 
+    std::lock_guard<std::mutex> lock(client.sendState_->mutex);
+    if (client.sendState_->closed) return false;
+
     const char* ptr = static_cast<const char*>(data);
     size_t remaining = size;
 
     while (remaining > 0) {
-        int sent = static_cast<int>(::send(it->second.socket_, ptr, remaining, 0));
+        int sent = static_cast<int>(::send(client.socket_, ptr, remaining, SEND_FLAGS));
         if (sent == SOCKET_ERROR) {
             notifyError("Send failed", SOCKET_ERROR_CODE, clientId);
             return false;
@@ -393,6 +438,42 @@ bool TcpServer::send(int clientId, const void* data, size_t size) {
     return true;
 }
 
+int TcpServer::trySend(int clientId, const void* data, size_t size) {
+    TcpServerClient client;
+    if (!findClient(clientId, client)) {
+        notifyError("Client not found", 0, clientId);
+        return -1;
+    }
+
+    std::unique_lock<std::mutex> lock(client.sendState_->mutex, std::try_to_lock);
+    if (!lock.owns_lock()) return 0;  // Blocking send() in progress
+    if (client.sendState_->closed) return -1;
+
+    size = std::min<size_t>(size, INT_MAX);
+#ifdef _WIN32
+    // No MSG_DONTWAIT: only send when select() reports the socket writable
+    fd_set writeSet;
+    FD_ZERO(&writeSet);
+    FD_SET(client.socket_, &writeSet);
+    timeval timeout = {0, 0};
+    if (select(0, nullptr, &writeSet, nullptr, &timeout) <= 0) return 0;
+    int sent = ::send(client.socket_, static_cast<const char*>(data), static_cast<int>(size), 0);
+#else
+    int sent = static_cast<int>(::send(client.socket_, data, size, SEND_FLAGS | MSG_DONTWAIT));
+#endif
+    if (sent == SOCKET_ERROR) {
+        int err = SOCKET_ERROR_CODE;
+#ifdef _WIN32
+        if (err == WSAEWOULDBLOCK) return 0;
+#else
+        if (err == EWOULDBLOCK || err == EAGAIN) return 0;
+#endif
+        notifyError("Send failed", err, clientId);
+        return -1;
+    }
+    return sent;
+}
+
 bool TcpServer::send(int clientId, const std::vector<char>& data) {
     return send(clientId, data.data(), data.size());
 }
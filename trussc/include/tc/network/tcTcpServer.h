@@ -50,6 +50,14 @@ private:
 #else
     int socket_;
 #endif
+
+    // Serializes sends with the socket close, so a send never writes to a
+    // closed (and possibly reused) descriptor. Shared with in-flight sends
+    struct SendState {
+        std::mutex mutex;
+        bool closed = false;
+    };
+    std::shared_ptr<SendState> sendState_;
 };
 
 // =============================================================================
@@ -142,11 +150,15 @@ public:
     // Data send
     // -------------------------------------------------------------------------
 
-    // Send data to specified client
+    // Send data to specified client (blocks until everything is written)
     bool send(int clientId, const void* data, size_t size);
     bool send(int clientId, const std::vector<char>& data);
     bool send(int clientId, const std::string& message);
 
+    // Send without blocking: returns bytes written (0 if the socket buffer
+    // is full or another send is in progress), -1 on error
+    int trySend(int clientId, const void* data, size_t size);
+
     // Broadcast to all clients
     void broadcast(const void* data, size_t size);
     void broadcast(const std::vector<char>& data);
@@ -171,6 +183,8 @@ private:
     void clientThreadFunc(int clientId);
     void notifyError(const std::string& msg, int code = 0, int clientId = -1);
     void removeClient(int clientId);
+    bool findClient(int clientId, TcpServerClient& out) const;
+    static void closeClientSocket(const TcpServerClient& client);
 
 #ifdef _WIN32
     SOCKET serverSocket_ = INVALID_SOCKET;
@@ -10,6 +10,7 @@
 #include "miniaudio.h"
 
 #include "tc/sound/tcSound.h"
+#include "tc/utils/tcProfiler.h"
 
 namespace trussc {
 
@@ -79,6 +80,12 @@ void AudioEngine::shutdown() {
 }
 
 void AudioEngine::mixAudio(float* buffer, int num_frames, int num_channels) {
+    static thread_local bool threadNamed = false;
+    if (!threadNamed && profiler().isEnabled()) {
+        profiler().setThreadName("Audio");
+        threadNamed = true;
+    }
+    TC_PROFILE_SCOPE("Audio::mix");
     mixAudioInternal(buffer, num_frames, num_channels);
 }
 
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "tcNode.h"
+#include <future>
+#include <chrono>
+
+namespace trussc {
+
+// =============================================================================
+// MeshNode - 3D node that draws a Mesh and hit tests its triangles
+// Ray hit tests go through a MeshBVH. For small meshes it is built on the
+// first test; for large ones call buildBVH() or buildBVHAsync() after
+// setMesh() so the first click doesn't stall the main thread.
+//
+// Node event dispatch (mousePressed etc.) casts screen-space rays
+// (Ray::fromScreenPoint2D), so it only hits a MeshNode drawn without a 3D
+// camera. Under a camera, pick with a world ray instead:
+//
+//   cam.begin();
+//   MeshRayHit hit = meshNode->raycastGlobal(screenToRay(getMousePos()));
+//   cam.end();
+// =============================================================================
+
+class MeshNode : public Node {
+public:
+    using Ptr = std::shared_ptr<MeshNode>;
+    using WeakPtr = std::weak_ptr<MeshNode>;
+
+    MeshNode() = default;
+    explicit MeshNode(Mesh mesh) : mesh_(std::move(mesh)) {}
+
+    // -------------------------------------------------------------------------
+    // Mesh
+    // -------------------------------------------------------------------------
+
+    // Waits for a pending buildBVHAsync() and drops its result
+    void setMesh(Mesh mesh) {
+        if (bvhPending_.valid()) bvhPending_.wait();
+        bvhPending_ = {};
+        mesh_ = std::move(mesh);
+        bvhValid_ = false;
+    }
+
+    // After editing through getMesh(): refitBVH() if only vertices moved,
+    // buildBVH() if triangles were added or removed
+    Mesh& getMesh() { return mesh_; }
+    const Mesh& getMesh() const { return mesh_; }
+
+    // -------------------------------------------------------------------------
+    // BVH
+    // -------------------------------------------------------------------------
+
+    // Build now on the calling thread (large meshes use several worker threads)
+    void buildBVH(bool parallel = true) {
+        if (bvhPending_.valid()) bvhPending_.wait();
+        bvhPending_ = {};
+        bvh_.build(mesh_, parallel);
+        bvhValid_ = true;
+    }
+
+    // Build in the background from a copy of the mesh. Until it finishes,
+    // raycasts and hit tests on this node miss instead of blocking
+    void buildBVHAsync(bool parallel = true) {
+        if (bvhPending_.valid()) bvhPending_.wait();
+        bvhValid_ = false;
+        bvhPending_ = std::async(std::launch::async, [mesh = mesh_, parallel] {
+            return MeshBVH(mesh, parallel);
+        });
+    }
+
+    // True once a BVH is available (picks up a finished async build)
+    bool isBVHReady() {
+        collectPendingBVH();
+        return bvhValid_;
+    }
+
+    bool isBuildingBVH() {
+        collectPendingBVH();
+        return bvhPending_.valid();
+    }
+
+    void refitBVH() {
+        if (isBVHReady()) {
+            bvh_.refit(mesh_);
+        }
+    }
+
+    // Builds on the calling thread if needed (waits for a pending async build)
+    const MeshBVH& getBVH() {
+        if (bvhPending_.valid()) {
+            bvh_ = bvhPending_.get();
+            bvhValid_ = true;
+        }
+        if (!bvhValid_) buildBVH();
+        return bvh_;
+    }
+
+    // Nearest triangle hit by a ray in local coordinates
+    MeshRayHit raycast(const Ray& localRay, bool cullBackFaces = false) {
+        collectPendingBVH();
+        if (bvhPending_.valid()) return {};
+        return getBVH().raycast(localRay, std::numeric_limits<float>::max(), cullBackFaces);
+    }
+
+    // Same with a world-space ray (e.g. from screenToRay()). The ray is moved
+    // into local coordinates, so the result (point, normal, distance) is local
+    MeshRayHit raycastGlobal(const Ray& globalRay, bool cullBackFaces = false) {
+        return raycast(globalRay.transformed(getGlobalMatrixInverse()), cullBackFaces);
+    }
+
+    // -------------------------------------------------------------------------
+    // Ray-based Hit Test
+    // -------------------------------------------------------------------------
+
+    bool hitTest(const Ray& localRay, float& outDistance) override {
+        // No hit if events are not enabled
+        if (!isEventsEnabled()) {
+            return false;
+        }
+        MeshRayHit hit = raycast(localRay);
+        if (!hit.hit()) {
+            return false;
+        }
+        outDistance = hit.distance;
+        return true;
+    }
+
+    // -------------------------------------------------------------------------
+    // Draw (wireframe when fill is disabled, like drawBox / drawSphere)
+    // -------------------------------------------------------------------------
+
+    void draw() override {
+        if (getDefaultContext().isFillEnabled()) {
+            mesh_.draw();
+        } else {
+            mesh_.drawWireframe();
+        }
+    }
+
+protected:
+    Mesh mesh_;
+    MeshBVH bvh_;
+    bool bvhValid_ = false;
+    std::future<MeshBVH> bvhPending_;
+
+    // Swap in a finished async build without waiting
+    void collectPendingBVH() {
+        if (bvhPending_.valid() &&
+            bvhPending_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            bvh_ = bvhPending_.get();
+            bvhValid_ = true;
+        }
+    }
+};
+
+} // namespace trussc
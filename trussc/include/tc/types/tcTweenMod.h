@@ -21,6 +21,9 @@ namespace trussc {
 //   // With callback
 //   tween->complete->addListener([](){ logNotice() << "done!"; });
 //
+// For thousands of concurrent tweens use tweens() (tcTweenSystem.h), which
+// updates all of them in one batch instead of one Mod per node.
+//
 // =============================================================================
 
 class TweenMod : public Mod {
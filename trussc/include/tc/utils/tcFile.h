@@ -5,9 +5,39 @@
 // =============================================================================
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <deque>
 #include <fstream>
+#include <sstream>
 #include <filesystem>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+#include <charconv>
+#include <type_traits>
+
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+    #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
 #include "tcLog.h"
 #include "tcUtils.h"
 
@@ -170,8 +200,22 @@ inline bool appendToFile(const std::string& path, const std::string& content) {
 }
 
 // =============================================================================
-// FileWriter - Streaming file writer with immediate flush
+// FileWriter - Streaming file writer
 // =============================================================================
+// Modes (chosen in open()):
+//   Immediate:  flushed after every write (default; nothing lost on a crash)
+//   Buffered:   collected in a user-space buffer, written when it is full and
+//               on flush() / close()
+//   Background: full buffers go to a writer thread; write() only copies into
+//               memory. At most 4 buffers are queued; a full queue makes
+//               write() wait (the disk is slower than the producer).
+// flush() hands everything to the OS, sync() also waits until it is on disk.
+
+enum class FileWriterMode {
+    Immediate,
+    Buffered,
+    Background
+};
 
 class FileWriter {
 public:
@@ -186,65 +230,103 @@ public:
     FileWriter& operator=(const FileWriter&) = delete;
 
     // Movable
-    FileWriter(FileWriter&& other) noexcept : file_(std::move(other.file_)) {}
+    FileWriter(FileWriter&& other) noexcept {
+        *this = std::move(other);
+    }
     FileWriter& operator=(FileWriter&& other) noexcept {
         if (this != &other) {
             close();
-            file_ = std::move(other.file_);
+            file_ = other.file_;
+            mode_ = other.mode_;
+            buffer_ = std::move(other.buffer_);
+            bufferSize_ = other.bufferSize_;
+            background_ = std::move(other.background_);
+            failed_ = other.failed_;
+            other.file_ = nullptr;
         }
         return *this;
     }
 
-    // Open file (append = true to append to existing file)
-    bool open(const std::string& path, bool append = false) {
+    // Open file (append = true to append to existing file).
+    // bufferSize: Buffered / Background buffer size in bytes
+    bool open(const std::string& path, bool append = false,
+              FileWriterMode mode = FileWriterMode::Immediate, size_t bufferSize = 1 << 20) {
         close();
         std::string fullPath = getDataPath(path);
-        auto mode = std::ios::out | std::ios::binary;
-        if (append) mode |= std::ios::app;
-
-        file_.open(fullPath, mode);
-        if (!file_.is_open()) {
+        file_ = std::fopen(fullPath.c_str(), append ? "ab" : "wb");
+        if (!file_) {
             logError() << "FileWriter: Cannot open file: " << path;
             return false;
         }
+
+        mode_ = mode;
+        failed_ = false;
+        if (mode_ != FileWriterMode::Immediate) {
+            // Our buffer replaces the C library's
+            std::setvbuf(file_, nullptr, _IONBF, 0);
+            bufferSize_ = std::max<size_t>(bufferSize, 4096);
+            buffer_.reserve(bufferSize_);
+        }
+        if (mode_ == FileWriterMode::Background) {
+            background_ = std::make_unique<Background>();
+            Background* bg = background_.get();
+            std::FILE* file = file_;
+            bg->thread = std::thread([bg, file]() { bg->run(file); });
+        }
         return true;
     }
 
-    // Close file
+    // Close file (buffered data is written first)
     void close() {
-        if (file_.is_open()) {
-            file_.close();
+        if (!file_) return;
+        flush();
+        if (background_) {
+            {
+                std::lock_guard<std::mutex> lock(background_->mutex);
+                background_->stop = true;
+            }
+            background_->cv.notify_all();
+            background_->thread.join();
+            background_.reset();
         }
+        std::fclose(file_);
+        file_ = nullptr;
+        buffer_ = std::vector<char>();
     }
 
     // Check if file is open
     bool isOpen() const {
-        return file_.is_open();
+        return file_ != nullptr;
     }
 
+    FileWriterMode getMode() const { return mode_; }
+
     // Write string
     FileWriter& write(const std::string& text) {
-        if (file_.is_open()) {
-            file_.write(text.data(), text.size());
-            file_.flush();
-        }
-        return *this;
+        return write(text.data(), text.size());
     }
 
     // Write single character
     FileWriter& write(char c) {
-        if (file_.is_open()) {
-            file_.put(c);
-            file_.flush();
-        }
-        return *this;
+        return write(&c, 1);
     }
 
     // Write binary data
     FileWriter& write(const void* data, size_t size) {
-        if (file_.is_open()) {
-            file_.write(static_cast<const char*>(data), size);
-            file_.flush();
+        if (!file_ || size == 0) return *this;
+        if (mode_ == FileWriterMode::Immediate) {
+            writeToFile(data, size);
+            std::fflush(file_);
+            return *this;
+        }
+
+        const char* p = static_cast<const char*>(data);
+        while (size > 0) {
+            size_t n = std::min(size, bufferSize_ - buffer_.size());
+            buffer_.insert(buffer_.end(), p, p + n);
+            p += n;
+            size -= n;
+            if (buffer_.size() >= bufferSize_) submitBuffer();
         }
         return *this;
     }
@@ -256,30 +338,146 @@ public:
         return *this;
     }
 
-    // Explicit flush (already done after each write, but available if needed)
+    // Hand everything written so far to the OS (waits for the writer thread)
     void flush() {
-        if (file_.is_open()) {
-            file_.flush();
-        }
+        if (!file_) return;
+        if (!buffer_.empty()) submitBuffer();
+        if (background_) background_->waitIdle();
+        std::fflush(file_);
     }
 
-    // Stream operator for convenience
+    // flush() and wait until the data is on disk (durability point)
+    bool sync() {
+        if (!file_) return false;
+        flush();
+#if defined(_WIN32)
+        return _commit(_fileno(file_)) == 0;
+#else
+        return fsync(fileno(file_)) == 0;
+#endif
+    }
+
+    // True if a write to the file has failed since open()
+    bool hasError() const {
+        return failed_ || (background_ && background_->failed.load());
+    }
+
+    // Stream operator for convenience (same text as std::ostream; strings
+    // and numbers skip the stream)
     template<typename T>
     FileWriter& operator<<(const T& value) {
-        if (file_.is_open()) {
-            file_ << value;
-            file_.flush();
+        if (!file_) return *this;
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            std::string_view text = value;
+            write(text.data(), text.size());
+        } else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> ||
+                             std::is_same_v<T, unsigned char>) {
+            write(static_cast<char>(value));
+        } else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+            char text[24];
+            auto result = std::to_chars(text, text + sizeof(text), value);
+            write(text, result.ptr - text);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            char text[32];
+            int n = std::snprintf(text, sizeof(text), "%g", static_cast<double>(value));
+            write(text, static_cast<size_t>(std::clamp(n, 0, static_cast<int>(sizeof(text)) - 1)));
+        } else {
+            format_.str(std::string());
+            format_ << value;
+            write(format_.str());
         }
         return *this;
     }
 
 private:
-    std::ofstream file_;
+    // Writer thread state (heap allocated so FileWriter stays movable)
+    struct Background {
+        static constexpr size_t kMaxQueued = 4;
+
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::vector<char>> queue;
+        std::vector<std::vector<char>> spare;    // Written buffers, reused
+        bool writing = false;
+        bool stop = false;
+        std::atomic<bool> failed{false};
+
+        void run(std::FILE* file) {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                cv.wait(lock, [this] { return stop || !queue.empty(); });
+                if (queue.empty()) return;          // stop, nothing left
+                std::vector<char> buffer = std::move(queue.front());
+                queue.pop_front();
+                writing = true;
+                lock.unlock();
+
+                if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+                    failed = true;
+                }
+
+                lock.lock();
+                writing = false;
+                buffer.clear();
+                spare.push_back(std::move(buffer));
+                cv.notify_all();
+            }
+        }
+
+        // Queue a full buffer, returns an empty one to fill next
+        std::vector<char> push(std::vector<char>&& buffer) {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] { return queue.size() < kMaxQueued; });
+            queue.push_back(std::move(buffer));
+            std::vector<char> next;
+            if (!spare.empty()) {
+                next = std::move(spare.back());
+                spare.pop_back();
+            }
+            cv.notify_all();
+            return next;
+        }
+
+        void waitIdle() {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] { return queue.empty() && !writing; });
+        }
+    };
+
+    void writeToFile(const void* data, size_t size) {
+        if (std::fwrite(data, 1, size, file_) != size && !failed_) {
+            failed_ = true;
+            logError() << "FileWriter: write failed";
+        }
+    }
+
+    void submitBuffer() {
+        if (background_) {
+            buffer_ = background_->push(std::move(buffer_));
+            buffer_.reserve(bufferSize_);
+        } else {
+            writeToFile(buffer_.data(), buffer_.size());
+            buffer_.clear();
+        }
+    }
+
+    std::FILE* file_ = nullptr;
+    FileWriterMode mode_ = FileWriterMode::Immediate;
+    std::vector<char> buffer_;
+    size_t bufferSize_ = 0;
+    std::unique_ptr<Background> background_;
+    bool failed_ = false;
+    std::ostringstream format_;
 };
 
 // =============================================================================
 // FileReader - Streaming file reader for large files
 // =============================================================================
+// open():       std::ifstream, reads copy into the caller's buffers
+// openMapped(): the whole file is memory-mapped; readLine(std::string_view&)
+//               and readRecord() return views into the mapping (no copies,
+//               valid until close()). The other read functions work too.
 
 class FileReader {
 public:
@@ -294,11 +492,20 @@ public:
     FileReader& operator=(const FileReader&) = delete;
 
     // Movable
-    FileReader(FileReader&& other) noexcept : file_(std::move(other.file_)) {}
+    FileReader(FileReader&& other) noexcept {
+        *this = std::move(other);
+    }
     FileReader& operator=(FileReader&& other) noexcept {
         if (this != &other) {
             close();
             file_ = std::move(other.file_);
+            mapped_ = other.mapped_;
+            map_ = other.map_;
+            mapSize_ = other.mapSize_;
+            pos_ = other.pos_;
+            other.mapped_ = false;
+            other.map_ = nullptr;
+            other.mapSize_ = 0;
         }
         return *this;
     }
@@ -315,37 +522,119 @@ public:
         return true;
     }
 
+    // Open file as a read-only memory mapping
+    bool openMapped(const std::string& path) {
+        close();
+        std::string fullPath = getDataPath(path);
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(fullPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                  nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            logError() << "FileReader: Cannot open file: " << path;
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            logError() << "FileReader: Cannot get file size: " << path;
+            return false;
+        }
+        if (size.QuadPart > 0) {
+            // The view keeps the mapping alive after the handles are closed
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                map_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                CloseHandle(mapping);
+            }
+            if (!map_) {
+                CloseHandle(file);
+                logError() << "FileReader: Cannot map file: " << path;
+                return false;
+            }
+        }
+        CloseHandle(file);
+        mapSize_ = static_cast<size_t>(size.QuadPart);
+#else
+        int fd = ::open(fullPath.c_str(), O_RDONLY);
+        if (fd == -1) {
+            logError() << "FileReader: Cannot open file: " << path;
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) == -1) {
+            ::close(fd);
+            logError() << "FileReader: Cannot get file size: " << path;
+            return false;
+        }
+        if (st.st_size > 0) {
+            void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                logError() << "FileReader: Cannot map file: " << path;
+                return false;
+            }
+            madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+            map_ = static_cast<const char*>(p);
+        }
+        ::close(fd);
+        mapSize_ = static_cast<size_t>(st.st_size);
+#endif
+        mapped_ = true;
+        pos_ = 0;
+        return true;
+    }
+
     // Close file
     void close() {
         if (file_.is_open()) {
             file_.close();
         }
+        if (map_) {
+#if defined(_WIN32)
+            UnmapViewOfFile(map_);
+#else
+            munmap(const_cast<char*>(map_), mapSize_);
+#endif
+        }
+        mapped_ = false;
+        map_ = nullptr;
+        mapSize_ = 0;
+        pos_ = 0;
     }
 
     // Check if file is open
     bool isOpen() const {
-        return file_.is_open();
+        return mapped_ || file_.is_open();
     }
 
+    bool isMapped() const { return mapped_; }
+
     // Check if at end of file
     bool eof() const {
+        if (mapped_) return pos_ >= mapSize_;
         return !file_.is_open() || file_.eof();
     }
 
+    // Whole mapped file (empty unless openMapped())
+    std::string_view getMappedData() const {
+        return std::string_view(map_, mapSize_);
+    }
+
     // Read single line (returns empty string at EOF)
     std::string readLine() {
         std::string line;
-        if (file_.is_open() && std::getline(file_, line)) {
-            // Remove \r if present (for Windows line endings)
-            if (!line.empty() && line.back() == '\r') {
-                line.pop_back();
-            }
-        }
+        readLine(line);
         return line;
     }
 
     // Read line into provided string (returns false at EOF)
     bool readLine(std::string& line) {
+        if (mapped_) {
+            std::string_view view;
+            if (!readLine(view)) return false;
+            line.assign(view.data(), view.size());
+            return true;
+        }
         if (!file_.is_open()) return false;
 
         if (std::getline(file_, line)) {
@@ -358,14 +647,45 @@ public:
         return false;
     }
 
+    // Mapped only: next line as a view into the file (returns false at EOF)
+    bool readLine(std::string_view& line) {
+        if (!mapped_ || pos_ >= mapSize_) return false;
+        const char* begin = map_ + pos_;
+        size_t left = mapSize_ - pos_;
+        const char* nl = static_cast<const char*>(std::memchr(begin, '\n', left));
+        size_t length = nl ? static_cast<size_t>(nl - begin) : left;
+        pos_ += nl ? length + 1 : length;
+        if (length > 0 && begin[length - 1] == '\r') length--;
+        line = std::string_view(begin, length);
+        return true;
+    }
+
+    // Mapped only: next size bytes as a view (fixed-size binary records).
+    // Returns false if fewer than size bytes are left.
+    bool readRecord(std::string_view& record, size_t size) {
+        if (!mapped_ || mapSize_ - pos_ < size) return false;
+        record = std::string_view(map_ + pos_, size);
+        pos_ += size;
+        return true;
+    }
+
     // Read single character (-1 at EOF)
     int readChar() {
+        if (mapped_) {
+            return pos_ < mapSize_ ? static_cast<unsigned char>(map_[pos_++]) : -1;
+        }
         if (!file_.is_open()) return -1;
         return file_.get();
     }
 
     // Read binary data (returns bytes actually read)
     size_t read(void* buffer, size_t size) {
+        if (mapped_) {
+            size_t n = std::min(size, mapSize_ - pos_);
+            if (n > 0) std::memcpy(buffer, map_ + pos_, n);
+            pos_ += n;
+            return n;
+        }
         if (!file_.is_open()) return 0;
         file_.read(static_cast<char*>(buffer), size);
         return static_cast<size_t>(file_.gcount());
@@ -373,19 +693,23 @@ public:
 
     // Seek to position
     void seek(size_t pos) {
-        if (file_.is_open()) {
+        if (mapped_) {
+            pos_ = std::min(pos, mapSize_);
+        } else if (file_.is_open()) {
             file_.seekg(pos);
         }
     }
 
     // Get current position
     size_t tell() {
+        if (mapped_) return pos_;
         if (!file_.is_open()) return 0;
         return static_cast<size_t>(file_.tellg());
     }
 
     // Get remaining bytes
     size_t remaining() {
+        if (mapped_) return mapSize_ - pos_;
         if (!file_.is_open()) return 0;
         auto current = file_.tellg();
         file_.seekg(0, std::ios::end);
@@ -396,6 +720,12 @@ public:
 
 private:
     std::ifstream file_;
+
+    // openMapped()
+    bool mapped_ = false;
+    const char* map_ = nullptr;
+    size_t mapSize_ = 0;
+    size_t pos_ = 0;
 };
 
 } // namespace trussc
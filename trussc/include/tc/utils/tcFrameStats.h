@@ -0,0 +1,245 @@
+#pragma once
+
+// =============================================================================
+// tcFrameStats.h - Always-on per-frame performance counters
+// =============================================================================
+//
+// Usage:
+//   const auto& t = frameStats().getLast();       // update/draw/present ms
+//   auto summary = frameStats().getSummary(120);  // avg/p95/max over 120 frames
+//   frameStats().getRenderStats().drawCalls;
+//   frameStats().getNodeStats().localMatrixUpdates;
+//
+// The main loop times the update/draw/present phases, present() records
+// sokol_gl / sokol_gfx counters and the scene graph counts nodes, timers,
+// mods and matrix recomputes while traversing. All counters are plain
+// integers touched on the main thread only, so they stay enabled.
+// Also exposed to MCP clients (get_frame_stats, get_render_stats, ...).
+//
+// =============================================================================
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+namespace trussc {
+
+// ---------------------------------------------------------------------------
+// Per-frame data
+// ---------------------------------------------------------------------------
+struct FrameTiming {
+    uint64_t index = 0;
+    float updateMs = 0.0f;      // All update steps run in this frame
+    float drawMs = 0.0f;
+    float presentMs = 0.0f;
+    float frameMs = 0.0f;       // Main loop CPU time of this frame
+    float intervalMs = 0.0f;    // Time since the previous frame started
+};
+
+// Rendering work submitted in the last drawn frame
+struct RenderStats {
+    uint32_t sglVertices = 0;       // sokol_gl (default context)
+    uint32_t sglCommands = 0;
+    uint32_t passes = 0;
+    uint32_t drawCalls = 0;
+    uint32_t pipelineSwitches = 0;
+    uint32_t bindingChanges = 0;
+    uint32_t uniformUploads = 0;
+    uint32_t textureUploads = 0;
+    uint32_t textureUploadBytes = 0;
+    uint32_t bufferUploads = 0;
+    uint32_t bufferUploadBytes = 0;
+};
+
+// Scene graph work in the last frame (summed over all update steps)
+struct NodeStats {
+    uint32_t updated = 0;               // Nodes visited by updateTree()
+    uint32_t drawn = 0;                 // Nodes visited by drawTree()
+    uint32_t timers = 0;                // Pending timers on updated nodes
+    uint32_t timersFired = 0;
+    uint32_t mods = 0;                  // Mods attached to updated nodes
+    uint32_t localMatrixUpdates = 0;
+    uint32_t globalMatrixUpdates = 0;
+};
+
+// Distribution of one timing over a range of frames
+struct TimingSummary {
+    float avg = 0.0f;
+    float min = 0.0f;
+    float max = 0.0f;
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+};
+
+struct FrameStatsSummary {
+    size_t frames = 0;
+    TimingSummary update;
+    TimingSummary draw;
+    TimingSummary present;
+    TimingSummary frame;
+    TimingSummary interval;
+};
+
+// ---------------------------------------------------------------------------
+// FrameStats
+// ---------------------------------------------------------------------------
+class FrameStats {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t DEFAULT_HISTORY_SIZE = 600;
+
+    // Accumulators for the frame in progress (incremented by the framework)
+    NodeStats nodes;
+
+    FrameStats() { history_.resize(DEFAULT_HISTORY_SIZE); }
+
+    // --- Frame boundaries (called by the main loop) ---
+
+    void beginFrame() {
+        if (inFrame_) return;
+        inFrame_ = true;
+        auto now = Clock::now();
+        current_.intervalMs = hasStarted_ ? toMs(now - frameStart_) : 0.0f;
+        frameStart_ = now;
+        hasStarted_ = true;
+    }
+
+    void endFrame() {
+        if (!inFrame_) return;
+        inFrame_ = false;
+        current_.index = frameCount_;
+        current_.frameMs = toMs(Clock::now() - frameStart_);
+
+        history_[frameCount_ % history_.size()] = current_;
+        frameCount_++;
+        lastNodes_ = nodes;
+
+        current_ = FrameTiming();
+        nodes = NodeStats();
+    }
+
+    // Phase timers (accumulate into the frame in progress)
+    enum class Phase { Update, Draw, Present };
+
+    class PhaseTimer {
+    public:
+        PhaseTimer(FrameStats& stats, Phase phase) : stats_(stats), phase_(phase), start_(Clock::now()) {}
+        ~PhaseTimer() { stats_.addPhaseTime(phase_, toMs(Clock::now() - start_)); }
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+    private:
+        FrameStats& stats_;
+        Phase phase_;
+        Clock::time_point start_;
+    };
+
+    void addPhaseTime(Phase phase, float ms) {
+        switch (phase) {
+            case Phase::Update: current_.updateMs += ms; break;
+            case Phase::Draw: current_.drawMs += ms; break;
+            case Phase::Present: current_.presentMs += ms; break;
+        }
+    }
+
+    void setRenderStats(const RenderStats& stats) { render_ = stats; }
+
+    // --- Queries ---
+
+    uint64_t getFrameCount() const { return frameCount_; }
+    size_t getHistorySize() const { return history_.size(); }
+
+    // Clears the history
+    void setHistorySize(size_t frames) {
+        history_.assign(std::max<size_t>(frames, 1), FrameTiming());
+        frameCount_ = 0;
+    }
+
+    // Most recently completed frame
+    const FrameTiming& getLast() const {
+        static const FrameTiming empty;
+        if (frameCount_ == 0) return empty;
+        return history_[(frameCount_ - 1) % history_.size()];
+    }
+
+    // Up to `frames` most recent frames, oldest first (0 = whole history)
+    std::vector<FrameTiming> getHistory(size_t frames = 0) const {
+        size_t available = static_cast<size_t>(std::min<uint64_t>(frameCount_, history_.size()));
+        size_t n = (frames == 0) ? available : std::min(frames, available);
+        std::vector<FrameTiming> result;
+        result.reserve(n);
+        for (uint64_t i = frameCount_ - n; i < frameCount_; ++i) {
+            result.push_back(history_[i % history_.size()]);
+        }
+        return result;
+    }
+
+    FrameStatsSummary getSummary(size_t frames = 0) const {
+        auto history = getHistory(frames);
+        FrameStatsSummary summary;
+        summary.frames = history.size();
+        if (history.empty()) return summary;
+
+        std::vector<float> values(history.size());
+        auto summarize = [&](float FrameTiming::*field) {
+            for (size_t i = 0; i < history.size(); ++i) values[i] = history[i].*field;
+            return summarizeValues(values);
+        };
+        summary.update = summarize(&FrameTiming::updateMs);
+        summary.draw = summarize(&FrameTiming::drawMs);
+        summary.present = summarize(&FrameTiming::presentMs);
+        summary.frame = summarize(&FrameTiming::frameMs);
+        summary.interval = summarize(&FrameTiming::intervalMs);
+        return summary;
+    }
+
+    const RenderStats& getRenderStats() const { return render_; }
+    const NodeStats& getNodeStats() const { return lastNodes_; }
+
+    // Sorts values in place
+    static TimingSummary summarizeValues(std::vector<float>& values) {
+        TimingSummary s;
+        if (values.empty()) return s;
+        std::sort(values.begin(), values.end());
+        double sum = 0.0;
+        for (float v : values) sum += v;
+        auto percentile = [&](double p) {
+            size_t i = static_cast<size_t>(p * (values.size() - 1) + 0.5);
+            return values[std::min(i, values.size() - 1)];
+        };
+        s.avg = static_cast<float>(sum / values.size());
+        s.min = values.front();
+        s.max = values.back();
+        s.p50 = percentile(0.50);
+        s.p95 = percentile(0.95);
+        s.p99 = percentile(0.99);
+        return s;
+    }
+
+private:
+    static float toMs(Clock::duration d) {
+        return std::chrono::duration<float, std::milli>(d).count();
+    }
+
+    std::vector<FrameTiming> history_;
+    uint64_t frameCount_ = 0;
+
+    FrameTiming current_;
+    Clock::time_point frameStart_;
+    bool inFrame_ = false;
+    bool hasStarted_ = false;
+
+    RenderStats render_;
+    NodeStats lastNodes_;
+};
+
+// ---------------------------------------------------------------------------
+// Global instance
+// ---------------------------------------------------------------------------
+inline FrameStats& frameStats() {
+    static FrameStats instance;
+    return instance;
+}
+
+} // namespace trussc
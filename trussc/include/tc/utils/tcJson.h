@@ -4,33 +4,50 @@
 // tcJson.h - JSON read/write
 // nlohmann/json wrapper
 // =============================================================================
+// Files are read through a memory mapping (FileReader::openMapped()).
+//   loadJson() / saveJson():             text, full DOM
+//   loadJsonItems():                     top-level elements one at a time
+//   loadJsonSax():                       SAX events, no DOM at all
+//   loadBinaryJson() / saveBinaryJson(): CBOR or MessagePack
+// =============================================================================
 
 #include <fstream>
 #include <string>
+#include <functional>
+#include <iomanip>
 #include "nlohmann/json.hpp"
 #include "tcLog.h"
 #include "tcUtils.h"
+#include "tcFile.h"
 
 namespace trussc {
 
 // Type alias to use nlohmann::json directly
 using Json = nlohmann::json;
 
+// SAX handler base for loadJsonSax() (override every callback)
+using JsonSax = nlohmann::json_sax<Json>;
+
+enum class JsonBinaryFormat {
+    Cbor,
+    MessagePack
+};
+
 // ---------------------------------------------------------------------------
 // JSON file loading
 // Relative paths are resolved via getDataPath (like oF)
 // ---------------------------------------------------------------------------
 inline Json loadJson(const std::string& path) {
-    std::string fullPath = getDataPath(path);
-    std::ifstream file(fullPath);
-    if (!file.is_open()) {
-        logError() << "Cannot open JSON file: " << path;
-        return Json();
+    FileReader reader;
+    if (!reader.openMapped(path)) {
+        return Json();      // Logged by FileReader
     }
 
     try {
-        Json j = Json::parse(file);
-        logVerbose() << "JSON loaded: " << fullPath;
+        // Pointer input is parsed much faster than an istream
+        std::string_view text = reader.getMappedData();
+        Json j = Json::parse(text.data(), text.data() + text.size());
+        logVerbose() << "JSON loaded: " << path;
         return j;
     } catch (const Json::parse_error& e) {
         logError() << "JSON parse error: " << path << " - " << e.what();
@@ -51,10 +68,13 @@ inline bool saveJson(const Json& j, const std::string& path, int indent = 2) {
     }
 
     try {
-        if (indent >= 0) {
-            file << j.dump(indent);
+        // Serialized straight into the file (no intermediate string)
+        if (indent > 0) {
+            file << std::setw(indent) << j;
+        } else if (indent == 0) {
+            file << j.dump(0);
         } else {
-            file << j.dump();  // Compact format
+            file << j;  // Compact format
         }
         logVerbose() << "JSON saved: " << fullPath;
         return true;
@@ -64,6 +84,186 @@ inline bool saveJson(const Json& j, const std::string& path, int indent = 2) {
     }
 }
 
+// ---------------------------------------------------------------------------
+// Streaming JSON loading
+// ---------------------------------------------------------------------------
+
+namespace json_detail {
+
+// Builds one DOM per member of the top-level array / object
+class ItemSax : public JsonSax {
+public:
+    using Callback = std::function<bool(const std::string& key, Json& value)>;
+
+    explicit ItemSax(const Callback& onItem) : onItem_(onItem) {}
+
+    bool null() override { return value(Json()); }
+    bool boolean(bool v) override { return value(Json(v)); }
+    bool number_integer(number_integer_t v) override { return value(Json(v)); }
+    bool number_unsigned(number_unsigned_t v) override { return value(Json(v)); }
+    bool number_float(number_float_t v, const string_t&) override { return value(Json(v)); }
+    bool string(string_t& v) override { return value(Json(std::move(v))); }
+    bool binary(binary_t& v) override {
+        return value(v.has_subtype() ? Json::binary(std::move(v), v.subtype()) : Json::binary(std::move(v)));
+    }
+
+    bool start_object(std::size_t) override { return open(Json::object()); }
+    bool start_array(std::size_t) override { return open(Json::array()); }
+    bool end_object() override { return close(); }
+    bool end_array() override { return close(); }
+
+    bool key(string_t& k) override {
+        if (depth_ == 1) itemKey_ = std::move(k);
+        else key_ = std::move(k);
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) override {
+        error_ = e.what();
+        return false;
+    }
+
+    bool stopped() const { return stopped_; }
+    const std::string& error() const { return error_; }
+
+private:
+    // Attach to the innermost open container
+    Json* add(Json&& v) {
+        Json& parent = *stack_.back();
+        if (parent.is_object()) {
+            Json& slot = parent[key_];
+            slot = std::move(v);
+            return &slot;
+        }
+        parent.push_back(std::move(v));
+        return &parent.back();
+    }
+
+    bool value(Json&& v) {
+        if (!stack_.empty()) {
+            add(std::move(v));
+            return true;
+        }
+        item_ = std::move(v);       // Scalar item (or a scalar document)
+        return emit();
+    }
+
+    bool open(Json&& container) {
+        if (depth_++ == 0) return true;     // The top-level container itself
+        if (stack_.empty()) {
+            item_ = std::move(container);
+            stack_.push_back(&item_);
+        } else {
+            stack_.push_back(add(std::move(container)));
+        }
+        return true;
+    }
+
+    bool close() {
+        if (--depth_ == 0) return true;
+        stack_.pop_back();
+        return stack_.empty() ? emit() : true;
+    }
+
+    bool emit() {
+        bool next = onItem_(itemKey_, item_);
+        item_ = Json();
+        stopped_ = !next;
+        return next;
+    }
+
+    const Callback& onItem_;
+    Json item_;
+    std::vector<Json*> stack_;      // Open containers inside item_
+    std::string itemKey_;           // Top-level object key of item_
+    std::string key_;               // Key for the next value inside item_
+    int depth_ = 0;
+    bool stopped_ = false;
+    std::string error_;
+};
+
+} // namespace json_detail
+
+// Calls onItem(key, value) for each element of a top-level array (key is
+// empty) or each member of a top-level object, without building the whole
+// document: memory stays at one item. Return false from onItem to stop.
+// Returns false if the file cannot be opened or parsed.
+inline bool loadJsonItems(const std::string& path,
+                          const std::function<bool(const std::string& key, Json& value)>& onItem) {
+    FileReader reader;
+    if (!reader.openMapped(path)) {
+        return false;
+    }
+
+    json_detail::ItemSax sax(onItem);
+    std::string_view text = reader.getMappedData();
+    if (!Json::sax_parse(text.data(), text.data() + text.size(), &sax) && !sax.stopped()) {
+        logError() << "JSON parse error: " << path << " - " << sax.error();
+        return false;
+    }
+    return true;
+}
+
+// Feeds the file to a SAX handler (no DOM). Returns the parser's result:
+// false on a parse error or when a callback returned false.
+inline bool loadJsonSax(const std::string& path, JsonSax& handler) {
+    FileReader reader;
+    if (!reader.openMapped(path)) {
+        return false;
+    }
+    std::string_view text = reader.getMappedData();
+    return Json::sax_parse(text.data(), text.data() + text.size(), &handler);
+}
+
+// ---------------------------------------------------------------------------
+// Binary JSON (CBOR / MessagePack)
+// Same data model, smaller files and no number <-> text conversion
+// ---------------------------------------------------------------------------
+inline bool saveBinaryJson(const Json& j, const std::string& path,
+                           JsonBinaryFormat format = JsonBinaryFormat::Cbor) {
+    std::string fullPath = getDataPath(path);
+    std::ofstream file(fullPath, std::ios::binary);
+    if (!file.is_open()) {
+        logError() << "Cannot create JSON file: " << path;
+        return false;
+    }
+
+    try {
+        if (format == JsonBinaryFormat::Cbor) {
+            Json::to_cbor(j, file);
+        } else {
+            Json::to_msgpack(j, file);
+        }
+        logVerbose() << "Binary JSON saved: " << fullPath;
+        return true;
+    } catch (const std::exception& e) {
+        logError() << "JSON write error: " << path << " - " << e.what();
+        return false;
+    }
+}
+
+inline Json loadBinaryJson(const std::string& path, JsonBinaryFormat format = JsonBinaryFormat::Cbor) {
+    FileReader reader;
+    if (!reader.openMapped(path)) {
+        return Json();
+    }
+
+    try {
+        std::string_view data = reader.getMappedData();
+        const uint8_t* begin = reinterpret_cast<const uint8_t*>(data.data());
+        const uint8_t* end = begin + data.size();
+        // CBOR tags (binary subtypes written by saveBinaryJson) are kept
+        Json j = format == JsonBinaryFormat::Cbor
+            ? Json::from_cbor(begin, end, true, true, Json::cbor_tag_handler_t::store)
+            : Json::from_msgpack(begin, end);
+        logVerbose() << "Binary JSON loaded: " << path;
+        return j;
+    } catch (const Json::exception& e) {
+        logError() << "JSON parse error: " << path << " - " << e.what();
+        return Json();
+    }
+}
+
 // ---------------------------------------------------------------------------
 // Parse JSON from string
 // ---------------------------------------------------------------------------
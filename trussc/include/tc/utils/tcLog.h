@@ -3,17 +3,41 @@
 // =============================================================================
 // tcLog.h - Logging system
 // =============================================================================
+//
+// Levels are checked before any formatting: a disabled logVerbose() costs
+// a branch. In async mode (tcSetLogAsync) log calls only push a record into
+// a lock-free queue; timestamping, formatting and batched console/file
+// writes happen on a background thread.
+//
+// =============================================================================
 
 #include <sstream>
 #include <fstream>
 #include <iostream>
-#include <iomanip>
 #include <chrono>
 #include <ctime>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <filesystem>
 // Uses Event system
 #include "../events/tcEvent.h"
 #include "../events/tcEventListener.h"
 
+// Async logging needs threads (not available in single-threaded Emscripten)
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define TC_LOG_ASYNC 0
+#else
+#define TC_LOG_ASYNC 1
+#include <thread>
+#include <condition_variable>
+#endif
+
 namespace trussc {
 
 // ---------------------------------------------------------------------------
@@ -41,6 +65,127 @@ inline const char* logLevelToString(LogLevel level) {
     return "UNKNOWN";
 }
 
+namespace log_internal {
+
+using Clock = std::chrono::system_clock;
+
+// Write "HH:MM:SS.mmm" into out (at least 13 bytes).
+// localtime is only called when the second changes
+inline void formatTimestamp(Clock::time_point time, char* out, size_t outSize) {
+    auto sinceEpoch = time.time_since_epoch();
+    long long secs = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch).count();
+    int ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(sinceEpoch).count() % 1000);
+
+    thread_local long long cachedSecs = -1;
+    thread_local char cachedHms[16] = {};
+    if (secs != cachedSecs) {
+        std::time_t t = static_cast<std::time_t>(secs);
+        std::tm tm_buf;
+#ifdef _WIN32
+        localtime_s(&tm_buf, &t);
+#else
+        localtime_r(&t, &tm_buf);
+#endif
+        std::strftime(cachedHms, sizeof(cachedHms), "%H:%M:%S", &tm_buf);
+        cachedSecs = secs;
+    }
+    std::snprintf(out, outSize, "%s.%03d", cachedHms, ms);
+}
+
+// Queued log record (formatted later)
+struct LogRecord {
+    LogLevel level = LogLevel::Notice;
+    Clock::time_point time;
+    std::string message;
+};
+
+// Append "[HH:MM:SS.mmm] [LEVEL] message\n"
+inline void appendLine(std::string& out, const LogRecord& record) {
+    char ts[16];
+    formatTimestamp(record.time, ts, sizeof(ts));
+    out += '[';
+    out += ts;
+    out += "] [";
+    out += logLevelToString(record.level);
+    out += "] ";
+    out += record.message;
+    out += '\n';
+}
+
+#if TC_LOG_ASYNC
+// ---------------------------------------------------------------------------
+// LogQueue - Bounded lock-free queue (multi-producer, single consumer)
+// Each cell carries a sequence number telling producers/consumer whose turn it is
+// ---------------------------------------------------------------------------
+class LogQueue {
+public:
+    explicit LogQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        cells_ = std::make_unique<Cell[]>(size);
+        mask_ = size - 1;
+        for (size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // Approximate number of queued records
+    size_t size() const {
+        size_t head = enqueuePos_.load(std::memory_order_relaxed);
+        size_t tail = dequeuePos_.load(std::memory_order_relaxed);
+        return head >= tail ? head - tail : 0;
+    }
+
+    // Returns false if full
+    bool push(LogRecord&& record) {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->record = std::move(record);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only
+    bool pop(LogRecord& record) {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[pos & mask_];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1) < 0) return false;
+        record = std::move(cell.record);
+        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        LogRecord record;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) std::atomic<size_t> dequeuePos_{0};
+};
+#endif // TC_LOG_ASYNC
+
+} // namespace log_internal
+
 // ---------------------------------------------------------------------------
 // LogEventArgs - Log event arguments
 // ---------------------------------------------------------------------------
@@ -49,24 +194,12 @@ struct LogEventArgs {
     std::string message;
     std::string timestamp;
 
-    LogEventArgs(LogLevel lvl, const std::string& msg)
+    LogEventArgs(LogLevel lvl, const std::string& msg,
+                 log_internal::Clock::time_point time = log_internal::Clock::now())
         : level(lvl), message(msg) {
-        // Generate timestamp
-        auto now = std::chrono::system_clock::now();
-        auto time = std::chrono::system_clock::to_time_t(now);
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now.time_since_epoch()) % 1000;
-
-        std::ostringstream oss;
-#ifdef _WIN32
-        std::tm tm_buf;
-        localtime_s(&tm_buf, &time);
-        oss << std::put_time(&tm_buf, "%H:%M:%S")
-#else
-        oss << std::put_time(std::localtime(&time), "%H:%M:%S")
-#endif
-            << '.' << std::setfill('0') << std::setw(3) << ms.count();
-        timestamp = oss.str();
+        char ts[16];
+        log_internal::formatTimestamp(time, ts, sizeof(ts));
+        timestamp = ts;
     }
 };
 
@@ -75,36 +208,55 @@ struct LogEventArgs {
 // ---------------------------------------------------------------------------
 class Logger {
 public:
-    // Log event (notifies all listeners)
+    // Log event (notifies all listeners, always on the logging thread).
+    // Receives every level while it has listeners
     Event<LogEventArgs> onLog;
 
-    Logger() {
-        // Register console listener by default
-        consoleListener_ = onLog.listen([this](LogEventArgs& e) {
-            if (e.level >= consoleLevel_ && consoleLevel_ != LogLevel::Silent) {
-                std::ostream& out = (e.level >= LogLevel::Warning) ? std::cerr : std::cout;
-                out << "[" << e.timestamp << "] "
-                    << "[" << logLevelToString(e.level) << "] "
-                    << e.message << std::endl;
-            }
-        });
-    }
+    Logger() = default;
 
     ~Logger() {
+        setAsync(false);
         closeFile();
     }
 
     // === Log output ===
 
-    void log(LogLevel level, const std::string& message) {
-        LogEventArgs args(level, message);
-        onLog.notify(args);
+    // True if a message of this level would go anywhere.
+    // Checked before formatting (lock-free)
+    bool isEnabled(LogLevel level) const {
+        return level >= minLevel_.load(std::memory_order_relaxed) || !onLog.empty();
+    }
+
+    void log(LogLevel level, std::string message) {
+        auto now = log_internal::Clock::now();
+
+        if (!onLog.empty()) {
+            LogEventArgs args(level, message, now);
+            onLog.notify(args);
+        }
+        if (level < minLevel_.load(std::memory_order_relaxed)) return;
+
+        log_internal::LogRecord record{level, now, std::move(message)};
+
+#if TC_LOG_ASYNC
+        // Counted in while enqueuing, so setAsync(false) can wait for us
+        // before its final drain (seq_cst pairs with the store there)
+        activeProducers_.fetch_add(1);
+        if (async_.load()) {
+            enqueue(std::move(record));
+            activeProducers_.fetch_sub(1);
+            return;
+        }
+        activeProducers_.fetch_sub(1);
+#endif
+        writeRecords(&record, 1, true);
     }
 
     // === Console settings ===
 
     void setConsoleLogLevel(LogLevel level) {
         consoleLevel_ = level;
+        updateMinLevel();
     }
 
     LogLevel getConsoleLogLevel() const {
@@ -116,38 +268,42 @@ public:
     bool setLogFile(const std::string& path) {
         closeFile();
 
-        fileStream_.open(path, std::ios::app);
-        if (!fileStream_.is_open()) {
+        {
+            TC_LOCK_GUARD(sinkMutex_);
+            fileStream_.open(path, std::ios::app | std::ios::binary);
+            if (fileStream_.is_open()) {
+                filePath_ = path;
+                std::error_code ec;
+                auto size = std::filesystem::file_size(path, ec);
+                fileBytes_ = ec ? 0 : static_cast<size_t>(size);
+                fileOpenedAt_ = std::chrono::steady_clock::now();
+            }
+        }
+        updateMinLevel();
+
+        if (!isFileOpen()) {
             log(LogLevel::Error, "Failed to open log file: " + path);
             return false;
         }
-
-        filePath_ = path;
-
-        // Register file listener
-        fileListener_ = onLog.listen([this](LogEventArgs& e) {
-            if (fileStream_.is_open() &&
-                e.level >= fileLevel_ && fileLevel_ != LogLevel::Silent) {
-                fileStream_ << "[" << e.timestamp << "] "
-                           << "[" << logLevelToString(e.level) << "] "
-                           << e.message << std::endl;
-                fileStream_.flush();
-            }
-        });
-
         return true;
     }
 
     void closeFile() {
-        fileListener_.disconnect();
-        if (fileStream_.is_open()) {
-            fileStream_.close();
+        flush();
+        {
+            TC_LOCK_GUARD(sinkMutex_);
+            if (fileStream_.is_open()) {
+                fileStream_.close();
+            }
+            filePath_.clear();
+            fileBytes_ = 0;
         }
-        filePath_.clear();
+        updateMinLevel();
     }
 
     void setFileLogLevel(LogLevel level) {
         fileLevel_ = level;
+        updateMinLevel();
     }
 
     LogLevel getFileLogLevel() const {
@@ -159,19 +315,299 @@ public:
     }
 
     bool isFileOpen() const {
-        return fileStream_.is_open();
+        return fileOpen_.load(std::memory_order_relaxed);
+    }
+
+    // Rotate the log file when it grows past maxBytes or has been open
+    // for maxSeconds (0 = no limit). Old files are kept as path.1 (newest)
+    // ... path.N, up to maxFiles.
+    // In async mode the writer thread also checks the time limit while idle,
+    // so a quiet log still rotates on time. In sync mode both limits are
+    // checked only when a line is written.
+    void setLogRotation(size_t maxBytes, double maxSeconds = 0.0, int maxFiles = 5) {
+        TC_LOCK_GUARD(sinkMutex_);
+        rotateBytes_ = maxBytes;
+        rotateSeconds_ = maxSeconds;
+        rotateFiles_ = maxFiles < 1 ? 1 : maxFiles;
+    }
+
+    // === Async mode ===
+
+    // Queue records (lock-free) and write them from a background thread.
+    // When the queue is full, records are dropped and counted
+    void setAsync(bool enabled, size_t queueCapacity = 8192) {
+#if TC_LOG_ASYNC
+        if (enabled == async_.load()) return;
+        if (enabled) {
+            if (!queue_ || queue_->capacity() < queueCapacity) {
+                queue_ = std::make_unique<log_internal::LogQueue>(queueCapacity);
+            }
+            writerRunning_ = true;
+            writerThread_ = std::thread(&Logger::writerThreadFunc, this);
+            async_.store(true, std::memory_order_release);
+        }
+        else {
+            // New log calls now write directly. Wait for producers that
+            // already saw async mode to finish pushing, so the drain below
+            // is the last one and nothing is left in the queue
+            async_.store(false);
+            while (activeProducers_.load() != 0) {
+                std::this_thread::yield();
+            }
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex_);
+                writerRunning_ = false;
+            }
+            wakeCv_.notify_one();
+            if (writerThread_.joinable()) writerThread_.join();
+
+            // Records the writer had not reached before it stopped
+            log_internal::LogRecord record;
+            while (queue_->pop(record)) {
+                writeRecords(&record, 1, true);
+                written_.fetch_add(1, std::memory_order_release);
+            }
+        }
+#else
+        (void)enabled;
+        (void)queueCapacity;
+#endif
+    }
+
+    bool isAsync() const {
+#if TC_LOG_ASYNC
+        return async_.load(std::memory_order_relaxed);
+#else
+        return false;
+#endif
+    }
+
+    // Block until queued records are written (no-op in sync mode)
+    void flush() {
+#if TC_LOG_ASYNC
+        if (!async_.load(std::memory_order_acquire)) return;
+        uint64_t target = enqueued_.load();
+        wakeWriter();
+        while (written_.load() < target && async_.load()) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+#endif
+    }
+
+    // Records dropped because the async queue was full
+    uint64_t getDroppedCount() const {
+        return dropped_.load(std::memory_order_relaxed);
     }
 
 private:
+    void updateMinLevel() {
+        bool fileOpen;
+        {
+            TC_LOCK_GUARD(sinkMutex_);
+            fileOpen = fileStream_.is_open();
+        }
+        fileOpen_ = fileOpen;
+
+        LogLevel level = LogLevel::Silent;
+        LogLevel console = consoleLevel_;
+        LogLevel file = fileLevel_;
+        if (console != LogLevel::Silent) level = console;
+        if (fileOpen && file != LogLevel::Silent && file < level) level = file;
+        minLevel_ = level;
+    }
+
+    // Format and write records to console and file in one batch.
+    // flushEach: flush after the batch (sync mode / end of async batch)
+    void writeRecords(const log_internal::LogRecord* records, size_t count, bool flushEach) {
+        TC_LOCK_GUARD(sinkMutex_);
+
+        LogLevel console = consoleLevel_;
+        LogLevel file = fileLevel_;
+        bool toFile = fileStream_.is_open() && file != LogLevel::Silent;
+
+        consoleOut_.clear();
+        consoleErr_.clear();
+        fileOut_.clear();
+        for (size_t i = 0; i < count; ++i) {
+            const auto& record = records[i];
+            line_.clear();
+            log_internal::appendLine(line_, record);
+            if (console != LogLevel::Silent && record.level >= console) {
+                (record.level >= LogLevel::Warning ? consoleErr_ : consoleOut_) += line_;
+            }
+            if (toFile && record.level >= file) {
+                fileOut_ += line_;
+            }
+        }
+
+        if (!consoleOut_.empty()) {
+            std::cout.write(consoleOut_.data(), consoleOut_.size());
+            if (flushEach) std::cout.flush();
+        }
+        if (!consoleErr_.empty()) {
+            std::cerr.write(consoleErr_.data(), consoleErr_.size());
+        }
+        if (!fileOut_.empty()) {
+            fileStream_.write(fileOut_.data(), fileOut_.size());
+            if (flushEach) fileStream_.flush();
+            fileBytes_ += fileOut_.size();
+            rotateIfNeeded();
+        }
+    }
+
+    // Requires sinkMutex_
+    void rotateIfNeeded() {
+        bool bySize = rotateBytes_ > 0 && fileBytes_ >= rotateBytes_;
+        bool byTime = rotateSeconds_ > 0.0 &&
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - fileOpenedAt_).count() >= rotateSeconds_;
+        if (!bySize && !byTime) return;
+
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        fileStream_.close();
+        fs::remove(filePath_ + "." + std::to_string(rotateFiles_), ec);
+        for (int i = rotateFiles_ - 1; i >= 1; --i) {
+            fs::rename(filePath_ + "." + std::to_string(i), filePath_ + "." + std::to_string(i + 1), ec);
+        }
+        fs::rename(filePath_, filePath_ + ".1", ec);
+
+        fileStream_.open(filePath_, std::ios::trunc | std::ios::binary);
+        fileBytes_ = 0;
+        fileOpenedAt_ = std::chrono::steady_clock::now();
+        fileOpen_ = fileStream_.is_open();
+    }
+
+    // Time-based rotation while nothing is written (async writer, idle)
+    void checkTimedRotation() {
+        TC_LOCK_GUARD(sinkMutex_);
+        if (rotateSeconds_ <= 0.0 || !fileStream_.is_open()) return;
+        if (fileBytes_ == 0) {
+            // Nothing to keep: restart the period instead of leaving empty files
+            if (std::chrono::duration<double>(std::chrono::steady_clock::now() - fileOpenedAt_).count() >= rotateSeconds_) {
+                fileOpenedAt_ = std::chrono::steady_clock::now();
+            }
+            return;
+        }
+        rotateIfNeeded();
+    }
+
+#if TC_LOG_ASYNC
+    void enqueue(log_internal::LogRecord&& record) {
+        LogLevel level = record.level;
+        if (!queue_->push(std::move(record))) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        enqueued_.fetch_add(1, std::memory_order_relaxed);
+
+        // Writer wakes on its own every WRITER_INTERVAL_MS; wake it early
+        // for important records or when the queue is filling up
+        if (level >= LogLevel::Warning || queue_->size() * 2 >= queue_->capacity()) {
+            wakeWriter();
+        }
+        if (level >= LogLevel::Fatal) flush();
+    }
+
+    void wakeWriter() {
+        // Only the first caller since the last wake-up takes the lock
+        if (wakeRequested_.exchange(true, std::memory_order_acq_rel)) return;
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+        }
+        wakeCv_.notify_one();
+    }
+
+    void writerThreadFunc() {
+        static constexpr int WRITER_INTERVAL_MS = 20;
+        static constexpr size_t MAX_BATCH = 1024;
+        static constexpr int ROTATION_CHECK_TICKS = 50;   // ~1 s of idle intervals
+
+        std::vector<log_internal::LogRecord> batch;
+        batch.reserve(MAX_BATCH);
+        uint64_t reportedDrops = dropped_.load();
+        auto lastDropReport = std::chrono::steady_clock::now();
+        log_internal::LogRecord record;
+        int idleTicks = 0;
+
+        while (true) {
+            while (batch.size() < MAX_BATCH && queue_->pop(record)) {
+                batch.push_back(std::move(record));
+            }
+            size_t popped = batch.size();
+
+            // Report dropped records at most once per second
+            uint64_t drops = dropped_.load();
+            auto now = std::chrono::steady_clock::now();
+            if (drops != reportedDrops && (now - lastDropReport >= std::chrono::seconds(1) || !writerRunning_)) {
+                batch.push_back({LogLevel::Warning, log_internal::Clock::now(),
+                                 std::to_string(drops - reportedDrops) + " log messages dropped (queue full)"});
+                reportedDrops = drops;
+                lastDropReport = now;
+            }
+
+            if (!batch.empty()) {
+                writeRecords(batch.data(), batch.size(), true);
+                batch.clear();
+                written_.fetch_add(popped, std::memory_order_release);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            if (!writerRunning_) break;
+            bool woken = wakeCv_.wait_for(lock, std::chrono::milliseconds(WRITER_INTERVAL_MS), [this]() {
+                return wakeRequested_.load() || !writerRunning_;
+            });
+            wakeRequested_ = false;
+            lock.unlock();
+
+            if (!woken && ++idleTicks >= ROTATION_CHECK_TICKS) {
+                idleTicks = 0;
+                checkTimedRotation();
+            }
+        }
+    }
+#endif
+
     // Console
-    EventListener consoleListener_;
-    LogLevel consoleLevel_ = LogLevel::Notice;
+    std::atomic<LogLevel> consoleLevel_{LogLevel::Notice};
 
     // File
-    EventListener fileListener_;
     std::ofstream fileStream_;
     std::string filePath_;
-    LogLevel fileLevel_ = LogLevel::Notice;
+    std::atomic<LogLevel> fileLevel_{LogLevel::Notice};
+    std::atomic<bool> fileOpen_{false};
+    size_t fileBytes_ = 0;
+    std::chrono::steady_clock::time_point fileOpenedAt_;
+
+    // Rotation
+    size_t rotateBytes_ = 0;
+    double rotateSeconds_ = 0.0;
+    int rotateFiles_ = 5;
+
+    // Lowest level any sink accepts
+    std::atomic<LogLevel> minLevel_{LogLevel::Notice};
+
+    // Sink state and reusable format buffers
+    mutable TC_MUTEX sinkMutex_;
+    std::string line_;
+    std::string consoleOut_;
+    std::string consoleErr_;
+    std::string fileOut_;
+
+    std::atomic<uint64_t> dropped_{0};
+
+#if TC_LOG_ASYNC
+    std::atomic<bool> async_{false};
+    std::unique_ptr<log_internal::LogQueue> queue_;
+    std::thread writerThread_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;
+    std::atomic<bool> wakeRequested_{false};
+    std::atomic<bool> writerRunning_{false};
+    std::atomic<int> activeProducers_{0};
+    std::atomic<uint64_t> enqueued_{0};
+    std::atomic<uint64_t> written_{0};
+#endif
 };
 
 // ---------------------------------------------------------------------------
@@ -201,30 +637,68 @@ inline void tcCloseLogFile() {
     tcGetLogger().closeFile();
 }
 
+inline void tcSetLogRotation(size_t maxBytes, double maxSeconds = 0.0, int maxFiles = 5) {
+    tcGetLogger().setLogRotation(maxBytes, maxSeconds, maxFiles);
+}
+
+inline void tcSetLogAsync(bool enabled, size_t queueCapacity = 8192) {
+    tcGetLogger().setAsync(enabled, queueCapacity);
+}
+
+inline void tcFlushLog() {
+    tcGetLogger().flush();
+}
+
 // ---------------------------------------------------------------------------
 // LogStream - Stream-based log output
+// Nothing is formatted when the level is disabled (the module name is a
+// string_view, so a literal doesn't allocate either)
 // ---------------------------------------------------------------------------
 class LogStream {
 public:
-    LogStream(LogLevel level, const std::string& module = "")
-        : level_(level), module_(module) {}
+    LogStream(LogLevel level, std::string_view module = {})
+        : level_(level) {
+        if (tcGetLogger().isEnabled(level)) {
+            // Reuse this thread's stream (constructing one is costly);
+            // nested logging while it is busy gets its own
+            auto& slot = threadStream();
+            if (!slot.inUse) {
+                slot.inUse = true;
+                stream_ = &slot.stream;
+                shared_ = true;
+            } else {
+                owned_ = std::make_unique<std::ostringstream>();
+                stream_ = owned_.get();
+            }
+            if (!module.empty()) {
+                *stream_ << '[' << module << "] ";
+            }
+        }
+    }
 
     ~LogStream() {
-        if (!moved_) {
-            std::string msg = stream_.str();
-            if (!module_.empty()) {
-                msg = "[" + module_ + "] " + msg;
-            }
-            tcGetLogger().log(level_, msg);
+        if (!stream_) return;
+        std::string message = std::move(*stream_).str();
+        if (shared_) {
+            // Reset for the next message on this thread
+            stream_->str(std::string());
+            stream_->clear();
+            stream_->flags(std::ios_base::dec | std::ios_base::skipws);
+            stream_->precision(6);
+            stream_->fill(' ');
+            threadStream().inUse = false;
         }
+        tcGetLogger().log(level_, std::move(message));
     }
 
     // Move only allowed
     LogStream(LogStream&& other) noexcept
         : level_(other.level_)
-        , module_(std::move(other.module_))
-        , stream_(std::move(other.stream_)) {
-        other.moved_ = true;
+        , stream_(other.stream_)
+        , owned_(std::move(other.owned_))
+        , shared_(other.shared_) {
+        other.stream_ = nullptr;
+        other.shared_ = false;
     }
 
     LogStream(const LogStream&) = delete;
@@ -233,21 +707,31 @@ public:
 
     template<typename T>
     LogStream& operator<<(const T& value) {
-        stream_ << value;
+        if (stream_) *stream_ << value;
         return *this;
     }
 
     // Support for manipulators like std::endl
     LogStream& operator<<(std::ostream& (*manip)(std::ostream&)) {
-        manip(stream_);
+        if (stream_) manip(*stream_);
         return *this;
     }
 
 private:
+    struct ThreadStream {
+        std::ostringstream stream;
+        bool inUse = false;
+    };
+
+    static ThreadStream& threadStream() {
+        thread_local ThreadStream slot;
+        return slot;
+    }
+
     LogLevel level_;
-    std::string module_;
-    std::ostringstream stream_;
-    bool moved_ = false;
+    std::ostringstream* stream_ = nullptr;          // nullptr = level disabled
+    std::unique_ptr<std::ostringstream> owned_;
+    bool shared_ = false;
 };
 
 // ---------------------------------------------------------------------------
@@ -262,33 +746,33 @@ inline LogStream tcLog(LogLevel level = LogLevel::Notice) {
     return LogStream(level);
 }
 
-inline LogStream logVerbose(const std::string& module = "") {
+inline LogStream logVerbose(std::string_view module = {}) {
     return LogStream(LogLevel::Verbose, module);
 }
 
-inline LogStream logNotice(const std::string& module = "") {
+inline LogStream logNotice(std::string_view module = {}) {
     return LogStream(LogLevel::Notice, module);
 }
 
-inline LogStream logWarning(const std::string& module = "") {
+inline LogStream logWarning(std::string_view module = {}) {
     return LogStream(LogLevel::Warning, module);
 }
 
-inline LogStream logError(const std::string& module = "") {
+inline LogStream logError(std::string_view module = {}) {
     return LogStream(LogLevel::Error, module);
 }
 
-inline LogStream logFatal(const std::string& module = "") {
+inline LogStream logFatal(std::string_view module = {}) {
     return LogStream(LogLevel::Fatal, module);
 }
 
 // ---------------------------------------------------------------------------
 // Backward compatibility aliases (deprecated, use non-prefixed versions)
 // ---------------------------------------------------------------------------
-inline LogStream tcLogVerbose(const std::string& module = "") { return logVerbose(module); }
-inline LogStream tcLogNotice(const std::string& module = "") { return logNotice(module); }
-inline LogStream tcLogWarning(const std::string& module = "") { return logWarning(module); }
-inline LogStream tcLogError(const std::string& module = "") { return logError(module); }
-inline LogStream tcLogFatal(const std::string& module = "") { return logFatal(module); }
+inline LogStream tcLogVerbose(std::string_view module = {}) { return logVerbose(module); }
+inline LogStream tcLogNotice(std::string_view module = {}) { return logNotice(module); }
+inline LogStream tcLogWarning(std::string_view module = {}) { return logWarning(module); }
+inline LogStream tcLogError(std::string_view module = {}) { return logError(module); }
+inline LogStream tcLogFatal(std::string_view module = {}) { return logFatal(module); }
 
 } // namespace trussc
@@ -44,12 +44,17 @@ struct ToolArg {
     bool required = true;
 };
 
+// Sends the result of an asynchronous tool. Must be called exactly once,
+// from any thread.
+using ToolReply = std::function<void(const json&)>;
+
 class Tool {
 public:
     std::string name;
     std::string description;
     std::vector<ToolArg> args;
     std::function<json(const json&)> handler;
+    std::function<void(const json&, ToolReply)> asyncHandler;  // Used instead of handler if set
 
     json getSchema() const {
         json schema = {
@@ -101,8 +106,31 @@ public:
         resources_[res.uri] = res;
     }
 
-    // --- Message Processing (returns JSON-RPC response string) ---
+    // --- Message Processing ---
+
+    // Reply receives the JSON-RPC response string (empty for notifications).
+    // Called immediately, except for asynchronous tools which reply when done.
+    using Reply = std::function<void(const std::string&)>;
 
+    void processMessage(const std::string& rawMessage, const Reply& reply) {
+        try {
+            auto j = json::parse(rawMessage);
+            if (j.value("method", "") == "tools/call" && j.contains("params")) {
+                auto params = j["params"];
+                auto it = tools_.find(params.value("name", ""));
+                if (it != tools_.end() && it->second.asyncHandler) {
+                    callAsyncTool(it->second, params, j.contains("id") ? j["id"] : json(nullptr), reply);
+                    return;
+                }
+            }
+        } catch (const std::exception&) {
+            // Reported by the synchronous path below
+        }
+        reply(processMessage(rawMessage));
+    }
+
+    // Synchronous variant (returns JSON-RPC response string).
+    // Blocks until asynchronous tools have replied.
     std::string processMessage(const std::string& rawMessage) {
         try {
             auto j = json::parse(rawMessage);
@@ -191,27 +219,45 @@ private:
             return makeError(id, -32601, "Tool not found: " + name);
         }
 
+        if (tools_[name].asyncHandler) {
+            auto promise = std::make_shared<std::promise<std::string>>();
+            auto future = promise->get_future();
+            callAsyncTool(tools_[name], params, id, [promise](const std::string& r) { promise->set_value(r); });
+            return future.get();
+        }
+
         try {
             // Execute tool handler
             json content = tools_[name].handler(args);
-
-            // Format result according to MCP spec
-            json result;
-            if (content.is_array() && content.size() > 0 && content[0].contains("type")) {
-                 result = {{"content", content}};
-            } else {
-                 result = {{"content", {{
-                     {"type", "text"},
-                     {"text", content.dump()}
-                 }}}};
-            }
-            return makeResult(id, result);
+            return makeResult(id, makeToolResult(content));
 
         } catch (const std::exception& e) {
             return makeError(id, -32000, std::string("Tool execution error: ") + e.what());
         }
     }
 
+    void callAsyncTool(const Tool& tool, const json& params, const json& id, const Reply& reply) {
+        json args = params.contains("arguments") ? params["arguments"] : json::object();
+        try {
+            tool.asyncHandler(args, [this, id, reply](const json& content) {
+                reply(makeResult(id, makeToolResult(content)));
+            });
+        } catch (const std::exception& e) {
+            reply(makeError(id, -32000, std::string("Tool execution error: ") + e.what()));
+        }
+    }
+
+    // Format tool output according to MCP spec
+    static json makeToolResult(const json& content) {
+        if (content.is_array() && content.size() > 0 && content[0].contains("type")) {
+            return {{"content", content}};
+        }
+        return {{"content", {{
+            {"type", "text"},
+            {"text", content.dump()}
+        }}}};
+    }
+
     std::string handleResourcesList(const json& req, const json& id) {
         json resList = json::array();
         for (const auto& [uri, res] : resources_) {
@@ -404,12 +450,12 @@ inline void stopHttpServer() {
 inline void processHttpQueue() {
     McpRequest req;
     while (detail::getHttpChannel().tryReceive(req)) {
-        std::string result = Server::instance().processMessage(req.body);
-        if (result.empty()) {
+        // The HTTP thread waits on the promise, so asynchronous tools may
+        // fulfil it later from a worker thread
+        Server::instance().processMessage(req.body, [response = req.response](const std::string& result) {
             // Return empty JSON-RPC response for notifications
-            result = "{}";
-        }
-        req.response->set_value(result);
+            response->set_value(result.empty() ? "{}" : result);
+        });
     }
 }
 
@@ -464,6 +510,13 @@ public:
         Server::instance().registerTool(tool_);
     }
 
+    // Asynchronous bind: the handler returns immediately and calls reply
+    // once the result is ready (e.g. from a worker thread)
+    void bindAsync(std::function<void(const json&, ToolReply)> func) {
+        tool_.asyncHandler = func;
+        Server::instance().registerTool(tool_);
+    }
+
     // Typed bind helpers (up to 4 args for simplicity)
 
     // 0 args
@@ -0,0 +1,438 @@
+#pragma once
+
+// =============================================================================
+// tcProfiler.h - Frame profiler (scoped CPU zones, per-frame timeline)
+// =============================================================================
+//
+// Usage:
+//   void update() {
+//       TC_PROFILE_SCOPE("physics");
+//       ...
+//   }
+//
+//   profiler().setEnabled(true);
+//   profiler().saveChromeTrace("trace.json");   // chrome://tracing, Perfetto
+//
+// Framework phases (event dispatch, update, updateTree, drawTree, present,
+// font atlas uploads, audio mix) are instrumented automatically.
+// Zones are recorded into per-thread lock-free buffers and collected into
+// frames on the main thread at the end of each frame.
+//
+// Zone names must outlive the profiler (string literals, __func__).
+// Define TC_DISABLE_PROFILER to compile all zones out.
+//
+// =============================================================================
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include "../events/tcEvent.h"
+
+namespace trussc {
+
+// ---------------------------------------------------------------------------
+// Recorded data
+// ---------------------------------------------------------------------------
+struct ProfileZone {
+    const char* name = "";
+    uint64_t start = 0;     // ns since profiler start
+    uint64_t end = 0;
+    uint32_t thread = 0;    // Index into Profiler::getThreadNames()
+    uint32_t depth = 0;     // Nesting level within its thread
+
+    double getDurationMs() const { return (end - start) / 1e6; }
+};
+
+struct ProfileFrame {
+    uint64_t index = 0;
+    uint64_t start = 0;     // ns since profiler start
+    uint64_t end = 0;
+    std::vector<ProfileZone> zones;     // Sorted by start time
+
+    double getDurationMs() const { return (end - start) / 1e6; }
+};
+
+struct ProfileZoneStats {
+    std::string name;
+    double callsPerFrame = 0.0;
+    double avgMs = 0.0;     // Average total time per frame
+    double maxMs = 0.0;     // Longest frame total
+};
+
+namespace profiler_internal {
+
+// Zones recorded by one thread (single producer: the owning thread,
+// single consumer: the main thread in Profiler::endFrame)
+struct ThreadBuffer {
+    static constexpr size_t CAPACITY = 8192;    // Power of two
+
+    ThreadBuffer() : zones(std::make_unique<ProfileZone[]>(CAPACITY)) {}
+
+    bool push(const ProfileZone& zone) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= CAPACITY) return false;
+        zones[h & (CAPACITY - 1)] = zone;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename Fn>
+    void drain(Fn&& fn) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t h = head.load(std::memory_order_acquire);
+        for (; t != h; ++t) fn(zones[t & (CAPACITY - 1)]);
+        tail.store(t, std::memory_order_release);
+    }
+
+    std::unique_ptr<ProfileZone[]> zones;
+    std::atomic<size_t> head{0};
+    std::atomic<size_t> tail{0};
+
+    uint32_t index = 0;
+    uint32_t depth = 0;     // Owning thread only
+    std::string name;
+};
+
+} // namespace profiler_internal
+
+// ---------------------------------------------------------------------------
+// Profiler
+// ---------------------------------------------------------------------------
+class Profiler {
+public:
+    static constexpr size_t DEFAULT_HISTORY_SIZE = 300;
+
+    Profiler() : epoch_(std::chrono::steady_clock::now()) {}
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    // -------------------------------------------------------------------------
+    // Settings
+    // -------------------------------------------------------------------------
+
+    // Zones cost one branch while disabled (default: disabled)
+    void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    // Keep recording zones but stop adding frames to history (for inspection)
+    void setPaused(bool paused) { paused_ = paused; }
+    bool isPaused() const { return paused_; }
+
+    // Number of frames kept in history
+    void setHistorySize(size_t frames) {
+        TC_LOCK_GUARD(mutex_);
+        historySize_ = std::max<size_t>(1, frames);
+        while (history_.size() > historySize_) history_.pop_front();
+    }
+    size_t getHistorySize() const { return historySize_; }
+
+    // Name the calling thread in timelines and traces
+    void setThreadName(const char* name) {
+        auto* buffer = threadBuffer();
+        if (buffer->name != name) {
+            TC_LOCK_GUARD(mutex_);
+            buffer->name = name;
+            threadNames_[buffer->index] = name;
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Frame boundaries (called by the framework on the main thread)
+    // -------------------------------------------------------------------------
+    void beginFrame() {
+        if (frameOpen_ || !isEnabled()) return;
+        if (!mainThreadNamed_) {
+            setThreadName("Main");
+            mainThreadNamed_ = true;
+        }
+        frameStart_ = now();
+        frameOpen_ = true;
+    }
+
+    void endFrame() {
+        if (!frameOpen_) return;
+        frameOpen_ = false;
+
+        TC_LOCK_GUARD(mutex_);
+
+        // Reuse the oldest frame's storage once history is full
+        ProfileFrame frame;
+        if (!paused_ && history_.size() >= historySize_) {
+            frame = std::move(history_.front());
+            history_.pop_front();
+        }
+        frame.index = frameIndex_++;
+        frame.start = frameStart_;
+        frame.end = now();
+        frame.zones.clear();
+
+        for (auto& buffer : buffers_) {
+            buffer->drain([&](const ProfileZone& zone) {
+                frame.zones.push_back(zone);
+            });
+        }
+
+        // Forget buffers of threads that have exited (drained above)
+        buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+            [](const std::shared_ptr<profiler_internal::ThreadBuffer>& b) { return b.use_count() == 1; }),
+            buffers_.end());
+
+        if (paused_) return;
+
+        std::sort(frame.zones.begin(), frame.zones.end(),
+            [](const ProfileZone& a, const ProfileZone& b) {
+                return a.start < b.start || (a.start == b.start && a.depth < b.depth);
+            });
+        history_.push_back(std::move(frame));
+    }
+
+    // -------------------------------------------------------------------------
+    // Zone recording (used by ProfileScope)
+    // -------------------------------------------------------------------------
+
+    // Nanoseconds since profiler start
+    uint64_t now() const {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch_).count());
+    }
+
+    profiler_internal::ThreadBuffer* threadBuffer() {
+        thread_local std::shared_ptr<profiler_internal::ThreadBuffer> buffer;
+        if (!buffer) {
+            buffer = std::make_shared<profiler_internal::ThreadBuffer>();
+            TC_LOCK_GUARD(mutex_);
+            buffer->index = static_cast<uint32_t>(threadNames_.size());
+            buffer->name = "Thread " + std::to_string(threadNames_.size());
+            threadNames_.push_back(buffer->name);
+            buffers_.push_back(buffer);
+        }
+        return buffer.get();
+    }
+
+    void addZone(profiler_internal::ThreadBuffer* buffer, const char* name,
+                 uint64_t start, uint64_t end, uint32_t depth) {
+        if (!buffer->push({name, start, end, buffer->index, depth})) {
+            droppedZones_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // History
+    // -------------------------------------------------------------------------
+    size_t getFrameCount() const {
+        TC_LOCK_GUARD(mutex_);
+        return history_.size();
+    }
+
+    // Copy of a frame; 0 = newest
+    bool getFrame(size_t indexFromNewest, ProfileFrame& out) const {
+        TC_LOCK_GUARD(mutex_);
+        if (indexFromNewest >= history_.size()) return false;
+        out = history_[history_.size() - 1 - indexFromNewest];
+        return true;
+    }
+
+    // Frame durations in ms, oldest first
+    std::vector<float> getFrameTimesMs() const {
+        TC_LOCK_GUARD(mutex_);
+        std::vector<float> times;
+        times.reserve(history_.size());
+        for (auto& frame : history_) times.push_back(static_cast<float>(frame.getDurationMs()));
+        return times;
+    }
+
+    // Per-zone totals over the newest `frames` frames (0 = whole history),
+    // sorted by average time
+    std::vector<ProfileZoneStats> getZoneStats(size_t frames = 0) const {
+        TC_LOCK_GUARD(mutex_);
+        size_t count = (frames == 0 || frames > history_.size()) ? history_.size() : frames;
+
+        struct Accum { size_t calls = 0; double total = 0.0; double max = 0.0; };
+        std::unordered_map<std::string, Accum> accum;
+        std::unordered_map<std::string, double> perFrame;
+
+        for (size_t i = history_.size() - count; i < history_.size(); ++i) {
+            perFrame.clear();
+            for (auto& zone : history_[i].zones) {
+                double ms = zone.getDurationMs();
+                perFrame[zone.name] += ms;
+                accum[zone.name].calls++;
+            }
+            for (auto& [name, ms] : perFrame) {
+                auto& a = accum[name];
+                a.total += ms;
+                a.max = std::max(a.max, ms);
+            }
+        }
+
+        std::vector<ProfileZoneStats> stats;
+        stats.reserve(accum.size());
+        for (auto& [name, a] : accum) {
+            ProfileZoneStats s;
+            s.name = name;
+            s.callsPerFrame = count ? static_cast<double>(a.calls) / count : 0.0;
+            s.avgMs = count ? a.total / count : 0.0;
+            s.maxMs = a.max;
+            stats.push_back(std::move(s));
+        }
+        std::sort(stats.begin(), stats.end(), [](const ProfileZoneStats& a, const ProfileZoneStats& b) {
+            return a.avgMs > b.avgMs;
+        });
+        return stats;
+    }
+
+    std::vector<std::string> getThreadNames() const {
+        TC_LOCK_GUARD(mutex_);
+        return threadNames_;
+    }
+
+    // Zones lost because a thread buffer was full
+    uint64_t getDroppedZoneCount() const { return droppedZones_.load(std::memory_order_relaxed); }
+
+    void clear() {
+        TC_LOCK_GUARD(mutex_);
+        history_.clear();
+    }
+
+    // -------------------------------------------------------------------------
+    // Chrome trace export (chrome://tracing, ui.perfetto.dev)
+    // -------------------------------------------------------------------------
+    std::string toChromeTrace() const {
+        TC_LOCK_GUARD(mutex_);
+        std::string out;
+        out.reserve(256 + history_.size() * 64);
+        out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+        char buf[256];
+        bool first = true;
+        auto sep = [&]() {
+            if (!first) out += ",\n";
+            first = false;
+        };
+
+        for (size_t i = 0; i < threadNames_.size(); ++i) {
+            sep();
+            out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":";
+            out += std::to_string(i);
+            out += ",\"args\":{\"name\":\"";
+            appendEscaped(out, threadNames_[i].c_str());
+            out += "\"}}";
+        }
+
+        for (auto& frame : history_) {
+            sep();
+            std::snprintf(buf, sizeof(buf),
+                "{\"name\":\"Frame %llu\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f}",
+                static_cast<unsigned long long>(frame.index), frame.start / 1e3, (frame.end - frame.start) / 1e3);
+            out += buf;
+
+            for (auto& zone : frame.zones) {
+                sep();
+                out += "{\"name\":\"";
+                appendEscaped(out, zone.name);
+                std::snprintf(buf, sizeof(buf), "\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    zone.thread, zone.start / 1e3, (zone.end - zone.start) / 1e3);
+                out += buf;
+            }
+        }
+        out += "\n]}\n";
+        return out;
+    }
+
+    bool saveChromeTrace(const std::string& path) const {
+        std::string json = toChromeTrace();
+        FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) return false;
+        bool ok = std::fwrite(json.data(), 1, json.size(), f) == json.size();
+        std::fclose(f);
+        return ok;
+    }
+
+private:
+    static void appendEscaped(std::string& out, const char* s) {
+        for (; *s; ++s) {
+            char c = *s;
+            if (c == '"' || c == '\\') { out += '\\'; out += c; }
+            else if (static_cast<unsigned char>(c) < 0x20) out += ' ';
+            else out += c;
+        }
+    }
+
+    std::chrono::steady_clock::time_point epoch_;
+    std::atomic<bool> enabled_{false};
+    std::atomic<uint64_t> droppedZones_{0};
+
+    // Main thread only
+    bool frameOpen_ = false;
+    bool mainThreadNamed_ = false;
+    uint64_t frameStart_ = 0;
+    uint64_t frameIndex_ = 0;
+
+    // Guarded by mutex_
+    mutable TC_MUTEX mutex_;
+    std::vector<std::shared_ptr<profiler_internal::ThreadBuffer>> buffers_;
+    std::vector<std::string> threadNames_;      // By thread index (never shrinks)
+    std::deque<ProfileFrame> history_;
+    size_t historySize_ = DEFAULT_HISTORY_SIZE;
+    bool paused_ = false;
+};
+
+// Global profiler
+inline Profiler& profiler() {
+    static Profiler instance;
+    return instance;
+}
+
+// ---------------------------------------------------------------------------
+// ProfileScope - Records one zone from construction to destruction
+// ---------------------------------------------------------------------------
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) {
+        auto& prof = profiler();
+        if (!prof.isEnabled()) return;
+        name_ = name;
+        buffer_ = prof.threadBuffer();
+        depth_ = buffer_->depth++;
+        start_ = prof.now();
+    }
+
+    ~ProfileScope() {
+        if (!buffer_) return;
+        auto& prof = profiler();
+        buffer_->depth--;
+        prof.addZone(buffer_, name_, start_, prof.now(), depth_);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    profiler_internal::ThreadBuffer* buffer_ = nullptr;
+    const char* name_ = nullptr;
+    uint64_t start_ = 0;
+    uint32_t depth_ = 0;
+};
+
+} // namespace trussc
+
+// ---------------------------------------------------------------------------
+// Macros
+// ---------------------------------------------------------------------------
+#ifndef TC_DISABLE_PROFILER
+#define TC_PROFILE_CONCAT_INNER(a, b) a##b
+#define TC_PROFILE_CONCAT(a, b) TC_PROFILE_CONCAT_INNER(a, b)
+#define TC_PROFILE_SCOPE(name) ::trussc::ProfileScope TC_PROFILE_CONCAT(tcProfileScope_, __LINE__)(name)
+#define TC_PROFILE_FUNCTION() TC_PROFILE_SCOPE(__func__)
+#else
+#define TC_PROFILE_SCOPE(name) ((void)0)
+#define TC_PROFILE_FUNCTION() ((void)0)
+#endif
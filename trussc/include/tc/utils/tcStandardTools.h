@@ -7,69 +7,256 @@
 #include "tcMCP.h"
 #include "tcUtils.h"
 #include "../events/tcCoreEvents.h"
-#include "stb/stb_image_write.h"
 #include "../graphics/tcPixels.h"
 #include "../gui/tcImGuiTools.h"
 #include <cstdlib>
 
-// Forward declaration for stbi_write_png_to_mem (missing in older stb_image_write.h headers)
-extern "C" unsigned char *stbi_write_png_to_mem(const unsigned char *pixels, int stride_bytes, int x, int y, int n, int *out_len);
 
 namespace trussc {
 namespace mcp {
 
 // ---------------------------------------------------------------------------
-// Inspection Tools (read-only, always available when MCP is enabled)
+// Performance Tools (frame stats, render/scene counters, profiler capture)
 // ---------------------------------------------------------------------------
 
-inline void registerInspectionTools() {
+namespace detail {
 
-    tool("get_screenshot", "Get screenshot as Base64 PNG")
-        .bind(std::function<json()>([]() -> json {
-            // Capture screen to pixels
-            Pixels pixels;
-            if (!grabScreen(pixels)) {
-                return json{{"status", "error"}, {"message", "Failed to grab screen"}};
-            }
+inline json toJson(const TimingSummary& s) {
+    return json{{"avg", s.avg}, {"min", s.min}, {"max", s.max},
+                {"p50", s.p50}, {"p95", s.p95}, {"p99", s.p99}};
+}
+
+inline json toJson(const std::vector<ProfileZoneStats>& stats) {
+    json zones = json::array();
+    for (auto& z : stats) {
+        zones.push_back({{"name", z.name}, {"callsPerFrame", z.callsPerFrame},
+                         {"avgMs", z.avgMs}, {"maxMs", z.maxMs}});
+    }
+    return zones;
+}
+
+// Profiler state saved by start_capture, restored by stop_capture
+struct CaptureState {
+    bool active = false;
+    bool wasEnabled = false;
+    size_t prevHistorySize = 0;
+    uint64_t startFrame = 0;
+};
+
+inline CaptureState& captureState() {
+    static CaptureState state;
+    return state;
+}
+
+} // namespace detail
 
-            // Encode to PNG in memory
-            int pngSize = 0;
-            unsigned char* pngData = stbi_write_png_to_mem(
-                pixels.getData(), 0,
-                pixels.getWidth(), pixels.getHeight(), pixels.getChannels(),
-                &pngSize);
+inline void registerPerformanceTools() {
 
-            if (!pngData) {
-                return json{{"status", "error"}, {"message", "Failed to encode PNG"}};
+    tool("get_frame_stats", "Get update/draw/present/frame times (ms) over the last N frames with a frame time histogram")
+        .arg<int>("frames", "Number of recent frames (default 120)", false)
+        .bind(std::function<json(const json&)>([](const json& args) -> json {
+            auto& stats = frameStats();
+            size_t frames = static_cast<size_t>(std::max(1, args.value("frames", 120)));
+            auto history = stats.getHistory(frames);
+            auto summary = stats.getSummary(frames);
+            const auto& last = stats.getLast();
+
+            // Frame time buckets (upper bounds in ms)
+            const float bounds[] = {4.0f, 8.0f, 16.7f, 33.3f, 50.0f, 100.0f};
+            json histogram = json::array();
+            size_t counted = 0;
+            for (float bound : bounds) {
+                size_t count = 0;
+                for (auto& f : history) {
+                    if (f.frameMs < bound) count++;
+                }
+                histogram.push_back({{"belowMs", bound}, {"frames", count - counted}});
+                counted = count;
             }
+            histogram.push_back({{"belowMs", nullptr}, {"frames", history.size() - counted}});
 
-            // Convert to Base64
-            std::string b64 = toBase64(pngData, pngSize);
+            return json{
+                {"frameCount", stats.getFrameCount()},
+                {"frames", summary.frames},
+                {"fps", summary.interval.avg > 0.0f ? 1000.0f / summary.interval.avg : 0.0f},
+                {"last", {
+                    {"updateMs", last.updateMs}, {"drawMs", last.drawMs},
+                    {"presentMs", last.presentMs}, {"frameMs", last.frameMs},
+                    {"intervalMs", last.intervalMs}
+                }},
+                {"updateMs", detail::toJson(summary.update)},
+                {"drawMs", detail::toJson(summary.draw)},
+                {"presentMs", detail::toJson(summary.present)},
+                {"frameMs", detail::toJson(summary.frame)},
+                {"intervalMs", detail::toJson(summary.interval)},
+                {"histogram", histogram},
+                {"memoryBytes", getMemoryUsage()}
+            };
+        }));
 
-            // Free PNG data
-            std::free(pngData);
+    tool("get_render_stats", "Get rendering counters of the last drawn frame")
+        .bind(std::function<json()>([]() -> json {
+            const auto& r = frameStats().getRenderStats();
+            return json{
+                {"sglVertices", r.sglVertices},
+                {"sglCommands", r.sglCommands},
+                {"passes", r.passes},
+                {"drawCalls", r.drawCalls},
+                {"pipelineSwitches", r.pipelineSwitches},
+                {"bindingChanges", r.bindingChanges},
+                {"uniformUploads", r.uniformUploads},
+                {"textureUploads", r.textureUploads},
+                {"textureUploadBytes", r.textureUploadBytes},
+                {"bufferUploads", r.bufferUploads},
+                {"bufferUploadBytes", r.bufferUploadBytes},
+                {"textures", getTextureCount()},
+                {"fbos", getFboCount()}
+            };
+        }));
 
+    tool("get_node_stats", "Get scene graph counters of the last frame")
+        .bind(std::function<json()>([]() -> json {
+            const auto& n = frameStats().getNodeStats();
             return json{
-                {"mimeType", "image/png"},
-                {"data", b64}
+                {"nodes", getNodeCount()},
+                {"updated", n.updated},
+                {"drawn", n.drawn},
+                {"timers", n.timers},
+                {"timersFired", n.timersFired},
+                {"mods", n.mods},
+                {"localMatrixUpdates", n.localMatrixUpdates},
+                {"globalMatrixUpdates", n.globalMatrixUpdates}
+            };
+        }));
+
+    tool("start_capture", "Start recording profiler zones")
+        .arg<int>("frames", "Maximum number of frames to keep (default 300)", false)
+        .bind(std::function<json(const json&)>([](const json& args) -> json {
+            auto& cap = detail::captureState();
+            auto& prof = profiler();
+            if (!cap.active) {
+                cap.wasEnabled = prof.isEnabled();
+                cap.prevHistorySize = prof.getHistorySize();
+            }
+            prof.setHistorySize(static_cast<size_t>(std::max(1, args.value("frames", 300))));
+            prof.clear();
+            prof.setPaused(false);
+            prof.setEnabled(true);
+            cap.active = true;
+            cap.startFrame = frameStats().getFrameCount();
+            return json{{"status", "ok"}};
+        }));
+
+    tool("stop_capture", "Stop recording profiler zones, return per-zone stats and optionally save a Chrome trace")
+        .arg<std::string>("path", "Chrome trace JSON output path (optional)", false)
+        .bind(std::function<json(const json&)>([](const json& args) -> json {
+            auto& cap = detail::captureState();
+            auto& prof = profiler();
+            if (!cap.active) {
+                return json{{"status", "error"}, {"message", "No capture in progress"}};
+            }
+
+            json result = {
+                {"status", "ok"},
+                {"frames", prof.getFrameCount()},
+                {"elapsedFrames", frameStats().getFrameCount() - cap.startFrame},
+                {"droppedZones", prof.getDroppedZoneCount()},
+                {"zones", detail::toJson(prof.getZoneStats())}
             };
+
+            std::string path = args.value("path", std::string());
+            if (!path.empty()) {
+                if (std::filesystem::path(path).is_relative()) path = getDataPath(path);
+                if (prof.saveChromeTrace(path)) {
+                    result["path"] = path;
+                } else {
+                    result["status"] = "error";
+                    result["message"] = "Failed to save trace: " + path;
+                }
+            }
+
+            prof.setEnabled(cap.wasEnabled);
+            prof.setHistorySize(cap.prevHistorySize);
+            cap.active = false;
+            return result;
         }));
+}
+
+// ---------------------------------------------------------------------------
+// Inspection Tools (read-only, always available when MCP is enabled)
+// ---------------------------------------------------------------------------
+
+inline void registerInspectionTools() {
+
+    // Pixels are grabbed on the main thread; PNG encoding and Base64 run on
+    // an encoder thread so large windows don't stall the app
+    tool("get_screenshot", "Get screenshot as Base64 PNG")
+        .bindAsync([](const json&, ToolReply reply) {
+            if (headless::isActive()) {
+                reply(json{{"status", "error"}, {"message", "No window in headless mode"}});
+                return;
+            }
+
+            // Capture screen to pixels
+            Pixels pixels = imageEncoder().acquirePixels();
+            if (!grabScreen(pixels)) {
+                reply(json{{"status", "error"}, {"message", "Failed to grab screen"}});
+                return;
+            }
+
+            ImageEncodeSettings settings;
+            settings.format = ImageFormat::Png;
+            imageEncoder().encode(std::move(pixels), settings,
+                [reply](bool ok, std::vector<unsigned char>& png) {
+                    if (!ok) {
+                        reply(json{{"status", "error"}, {"message", "Failed to encode PNG"}});
+                        return;
+                    }
+                    reply(json{
+                        {"mimeType", "image/png"},
+                        {"data", toBase64(png)}
+                    });
+                });
+        });
 
     tool("save_screenshot", "Save screenshot to file")
         .arg<std::string>("path", "File path")
-        .bind<std::string>([](std::string path) {
-            if (trussc::saveScreenshot(path)) {
-                return json{{"status", "ok"}, {"path", path}};
-            } else {
-                return json{{"status", "error"}, {"message", "Failed to save screenshot"}};
+        .bindAsync([](const json& args, ToolReply reply) {
+            if (headless::isActive()) {
+                reply(json{{"status", "error"}, {"message", "No window in headless mode"}});
+                return;
+            }
+            std::string path = args.at("path").get<std::string>();
+
+            // TIFF is only supported by the platform writer
+            std::string ext = toLower(std::filesystem::path(path).extension().string());
+            if (ext == ".tif" || ext == ".tiff") {
+                bool ok = trussc::saveScreenshot(path);
+                reply(ok ? json{{"status", "ok"}, {"path", path}}
+                         : json{{"status", "error"}, {"message", "Failed to save screenshot"}});
+                return;
+            }
+
+            bool queued = saveScreenshotAsync(path, [reply, path](bool ok, const fs::path&) {
+                reply(ok ? json{{"status", "ok"}, {"path", path}}
+                         : json{{"status", "error"}, {"message", "Failed to save screenshot"}});
+            });
+            if (!queued) {
+                reply(json{{"status", "error"}, {"message", "Failed to grab screen"}});
             }
         });
 
     tool("quit", "Quit the application gracefully")
         .bind(std::function<json()>([]() -> json {
-            sapp_request_quit();
+            if (headless::isActive()) {
+                headless::running = false;
+            } else {
+                sapp_request_quit();
+            }
             return json{{"status", "ok"}};
         }));
+
+    registerPerformanceTools();
 }
 
 // ---------------------------------------------------------------------------
@@ -109,6 +109,23 @@ inline uint64_t getElapsedTimeMicros() {
         internal::getElapsedClock().getElapsed()).count();
 }
 
+// ---------------------------------------------------------------------------
+// Timing
+// ---------------------------------------------------------------------------
+
+/// Milliseconds taken by func(), best of runs (quick benchmarks)
+template<typename Func>
+inline double measureMillis(Func&& func, int runs = 1) {
+    double best = 0;
+    for (int i = 0; i < runs; i++) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (i == 0 || ms < best) best = ms;
+    }
+    return best;
+}
+
 // ---------------------------------------------------------------------------
 // System time
 // ---------------------------------------------------------------------------
@@ -0,0 +1,178 @@
+#pragma once
+
+// =============================================================================
+// tcTimerQueue.h - Min-heap timer scheduler
+// =============================================================================
+//
+// Usage:
+//   TimerQueue timers;
+//   auto id = timers.add(now + 1.0, [] { ... });          // once
+//   timers.addRepeating(now + 0.5, 0.5, [] { ... });      // every 0.5s
+//   timers.cancel(id);
+//   timers.process(getElapsedTime());                     // once per frame
+//
+// Only due timers are touched: process() checks the top of the heap and pops
+// what is due. cancel() is O(1) (the heap entry is skipped when it surfaces).
+// Callbacks may add or cancel timers, including their own; timers added
+// during process() first fire on a later call.
+// Repeating timers stay on their original grid (no drift). After a stall
+// they fire once and skip the missed ticks instead of bursting.
+//
+// Used by Node::callAfter() / callEvery().
+//
+// =============================================================================
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+namespace trussc {
+
+class TimerQueue {
+public:
+    using Callback = std::function<void()>;
+
+    // Returns the timer id (pass an explicit id to share an id space)
+    uint64_t add(double triggerTime, Callback callback, uint64_t id = 0) {
+        return insert(triggerTime, 0.0, false, std::move(callback), id);
+    }
+
+    // interval <= 0 fires on every process() call
+    uint64_t addRepeating(double triggerTime, double interval, Callback callback, uint64_t id = 0) {
+        return insert(triggerTime, interval, true, std::move(callback), id);
+    }
+
+    bool cancel(uint64_t id) {
+        if (timers_.erase(id) == 0) return false;
+        compactIfNeeded();
+        return true;
+    }
+
+    void clear() {
+        timers_.clear();
+        heap_.clear();
+    }
+
+    bool contains(uint64_t id) const { return timers_.count(id) > 0; }
+    size_t size() const { return timers_.size(); }
+    bool empty() const { return timers_.empty(); }
+
+    // Fire due timers. Returns the number of callbacks invoked.
+    size_t process(double now) {
+        if (heap_.empty() || heap_.front().time > now) return 0;
+
+        // Collect due timers first so callbacks can modify the queue freely
+        std::vector<Entry> due;
+        while (!heap_.empty() && heap_.front().time <= now) {
+            Entry e = pop();
+            auto it = timers_.find(e.id);
+            // Skip cancelled timers and stale entries of re-added ids
+            if (it == timers_.end() || it->second.seq != e.seq) continue;
+            due.push_back(e);
+        }
+
+        size_t fired = 0;
+        for (const Entry& e : due) {
+            // Cancelled (or replaced) by an earlier callback
+            auto it = timers_.find(e.id);
+            if (it == timers_.end() || it->second.seq != e.seq) continue;
+
+            uint64_t id = e.id;
+            Timer& timer = it->second;
+            if (!timer.repeating) {
+                // Move out before erasing so the callback may re-add this id
+                Callback callback = std::move(timer.callback);
+                timers_.erase(it);
+                callback();
+            } else {
+                // Held outside the map: the callback may cancel its own timer
+                Callback callback = std::move(timer.callback);
+                callback();
+
+                auto again = timers_.find(id);
+                if (again != timers_.end() && again->second.seq == e.seq) {
+                    Timer& t = again->second;
+                    double next = now;
+                    if (t.interval > 0.0) {
+                        next = t.time + t.interval;
+                        if (next <= now) {
+                            next += std::floor((now - next) / t.interval + 1.0) * t.interval;
+                        }
+                    }
+                    t.callback = std::move(callback);
+                    t.time = next;
+                    t.seq = push(next, id);
+                }
+            }
+            fired++;
+        }
+
+        compactIfNeeded();
+        return fired;
+    }
+
+    // Earliest pending trigger time (a cancelled timer may make this early)
+    double getNextTriggerTime() const {
+        return heap_.empty() ? 0.0 : heap_.front().time;
+    }
+
+private:
+    struct Timer {
+        Callback callback;
+        double time;
+        double interval;
+        bool repeating;
+        uint64_t seq;   // Heap entry currently scheduling this timer
+    };
+
+    struct Entry {
+        double time;
+        uint64_t seq;   // FIFO order for equal trigger times
+        uint64_t id;
+    };
+
+    // std heap functions build a max-heap; invert for earliest-first
+    static bool later(const Entry& a, const Entry& b) {
+        return a.time != b.time ? a.time > b.time : a.seq > b.seq;
+    }
+
+    uint64_t insert(double time, double interval, bool repeating, Callback callback, uint64_t id) {
+        if (id == 0) id = nextId_++;
+        timers_[id] = Timer{std::move(callback), time, interval, repeating, push(time, id)};
+        return id;
+    }
+
+    uint64_t push(double time, uint64_t id) {
+        uint64_t seq = seq_++;
+        heap_.push_back(Entry{time, seq, id});
+        std::push_heap(heap_.begin(), heap_.end(), later);
+        return seq;
+    }
+
+    Entry pop() {
+        std::pop_heap(heap_.begin(), heap_.end(), later);
+        Entry e = heap_.back();
+        heap_.pop_back();
+        return e;
+    }
+
+    // Drop entries of cancelled timers once they dominate the heap
+    void compactIfNeeded() {
+        if (heap_.size() <= 64 || heap_.size() <= timers_.size() * 2) return;
+        heap_.erase(std::remove_if(heap_.begin(), heap_.end(), [this](const Entry& e) {
+            auto it = timers_.find(e.id);
+            return it == timers_.end() || it->second.seq != e.seq;
+        }), heap_.end());
+        std::make_heap(heap_.begin(), heap_.end(), later);
+    }
+
+    std::vector<Entry> heap_;
+    std::unordered_map<uint64_t, Timer> timers_;
+    uint64_t seq_ = 0;
+    uint64_t nextId_ = 1;
+};
+
+} // namespace trussc
@@ -0,0 +1,394 @@
+#pragma once
+
+// =============================================================================
+// tcMediaClock.h - Shared master clock for synchronized video playback
+// =============================================================================
+//
+// Usage:
+//   MediaClock clock;
+//   for (auto& v : videos) clock.add(v);    // VideoPlayer / HapPlayer
+//   clock.setLoop(true);
+//   clock.play();
+//
+//   void update() { clock.update(); }       // updates all players
+//
+// All players follow one media time. Players that support it (HapPlayer,
+// FFmpeg VideoPlayer) are slaved: each update() shows exactly the frame the
+// clock selects, so clips with the same frame rate present frame N together.
+// Other players (native backends) are kept in sync by nudging their speed,
+// with a hard seek when they drift too far.
+//
+// With setRefreshRate() the clock advances in whole display refreshes and
+// picks the frame covering the middle of the upcoming refresh, which removes
+// timer jitter and frame flip-flop when frame and refresh rates line up.
+// With setWaitForAll() the clock holds while any slaved player has not
+// decoded the next frame yet (after a seek, or when decoding falls behind).
+//
+// Deterministic stepping (headless tests, offline rendering):
+//   clock.update(frame / 60.0);             // explicit time source
+//
+// Players are updated by the clock; don't call their update() yourself.
+// A player removes itself from its clock when destroyed (moving an attached
+// player detaches it).
+//
+// =============================================================================
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "tcVideoPlayerBase.h"
+#include "tc/events/tcEvent.h"
+
+namespace trussc {
+
+class MediaClock {
+public:
+    // Fired when the group wraps around (loop)
+    Event<void> looped;
+
+    MediaClock() = default;
+    ~MediaClock() { clear(); }
+
+    MediaClock(const MediaClock&) = delete;
+    MediaClock& operator=(const MediaClock&) = delete;
+
+    // =========================================================================
+    // Players
+    // =========================================================================
+
+    void add(VideoPlayerBase& player) {
+        if (player.clock_ == this) return;
+        if (player.clock_) player.clock_->remove(player);
+        player.clock_ = this;
+        player.clockSlave_ = player.supportsClock();
+        player.clockTime_ = time_;
+        entries_.push_back(Entry{&player});
+    }
+
+    void remove(VideoPlayerBase& player) {
+        if (!forget(&player)) return;
+        // Back to free running at the group speed
+        if (!player.clockSlave_) player.setSpeed(static_cast<float>(speed_));
+        player.clockSlave_ = false;
+    }
+
+    void clear() {
+        while (!entries_.empty()) remove(*entries_.back().player);
+    }
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+
+    // =========================================================================
+    // Group transport
+    // =========================================================================
+
+    void play() {
+        for (auto& e : entries_) {
+            e.player->play();
+            e.resync = true;    // play() may rewind; move to the group time
+        }
+        playing_ = true;
+        paused_ = false;
+        finished_ = false;
+        stallTime_ = 0.0;
+    }
+
+    void stop() {
+        for (auto& e : entries_) e.player->stop();
+        playing_ = false;
+        paused_ = false;
+        finished_ = false;
+        time_ = 0.0;
+        loopCount_ = 0;
+    }
+
+    void setPaused(bool paused) {
+        if (paused == paused_) return;
+        for (auto& e : entries_) e.player->setPaused(paused);
+        paused_ = paused;
+        hasLastNow_ = false;    // No catch-up for the paused interval
+    }
+
+    void togglePause() { setPaused(!paused_); }
+
+    bool isPlaying() const { return playing_ && !paused_; }
+    bool isPaused() const { return paused_; }
+    bool isFinished() const { return finished_; }
+
+    // Jump all players to `seconds` (shown on the next update, also while paused)
+    void seek(double seconds) {
+        double duration = getDuration();
+        time_ = std::max(0.0, duration > 0.0 ? std::min(seconds, duration) : seconds);
+        finished_ = false;
+        stallTime_ = 0.0;
+        for (auto& e : entries_) e.resync = true;
+    }
+
+    // Frame index at the group frame rate
+    void setFrame(int frame) {
+        double fps = getFrameRate();
+        if (fps > 0.0) seek(std::max(0, frame) / fps);
+    }
+
+    void setLoop(bool loop) { loop_ = loop; }
+    bool isLoop() const { return loop_; }
+
+    void setSpeed(double speed) {
+        speed_ = std::max(0.0, speed);
+        for (auto& e : entries_) {
+            if (!e.player->clockSlave_) {
+                e.player->setSpeed(static_cast<float>(speed_));
+                e.appliedSpeed = speed_;
+            }
+        }
+    }
+    double getSpeed() const { return speed_; }
+
+    // =========================================================================
+    // Timing
+    // =========================================================================
+
+    // Group length (0 = longest player)
+    void setDuration(double seconds) { duration_ = std::max(0.0, seconds); }
+    double getDuration() const {
+        if (duration_ > 0.0) return duration_;
+        double longest = 0.0;
+        for (auto& e : entries_) longest = std::max(longest, (double)e.player->getDuration());
+        return longest;
+    }
+
+    // Frame rate for getFrame() / setFrame() (0 = first player's)
+    void setFrameRate(double fps) { frameRate_ = std::max(0.0, fps); }
+    double getFrameRate() const {
+        if (frameRate_ > 0.0) return frameRate_;
+        return entries_.empty() ? 0.0 : playerFrameRate(*entries_.front().player);
+    }
+
+    // Display refresh rate for vsync-aligned stepping (0 = off)
+    void setRefreshRate(double hz) {
+        refreshRate_ = std::max(0.0, hz);
+        refreshDebt_ = 0.0;
+    }
+    double getRefreshRate() const { return refreshRate_; }
+
+    // Hold the clock until every slaved player has the next frame decoded,
+    // for at most maxStall seconds at a time
+    void setWaitForAll(bool wait, double maxStall = 0.5) {
+        waitForAll_ = wait;
+        maxStall_ = maxStall;
+    }
+    bool isWaitForAll() const { return waitForAll_; }
+
+    // Drift correction for players that cannot be slaved
+    void setSyncThresholds(double nudge, double hardSeek) {
+        nudgeThreshold_ = nudge;
+        seekThreshold_ = hardSeek;
+    }
+
+    // Media time of the group (wraps when looping)
+    double getTime() const { return time_; }
+    int getFrame() const {
+        double fps = getFrameRate();
+        return fps > 0.0 ? static_cast<int>(std::floor(presentationTime() * fps)) : 0;
+    }
+
+    int getLoopCount() const { return loopCount_; }
+    uint64_t getStallCount() const { return stallCount_; }  // Updates the clock was held
+
+    // =========================================================================
+    // Update
+    // =========================================================================
+
+    // Advance by the app's elapsed time and update all players
+    void update() { update(getElapsedTime()); }
+
+    // Advance to `now` (any monotonic time source in seconds)
+    void update(double now) {
+        double dt = hasLastNow_ ? std::max(0.0, now - lastNow_) : 0.0;
+        lastNow_ = now;
+        hasLastNow_ = true;
+
+        if (playing_ && !paused_ && !finished_) advance(dt);
+        present();
+    }
+
+private:
+    struct Entry {
+        VideoPlayerBase* player;
+        double lastTime = -1.0;     // Last clip time handed to the player
+        double appliedSpeed = -1.0; // Last speed set on a free-running player
+        bool resync = true;         // Seek on the next present
+    };
+
+    friend class VideoPlayerBase;
+
+    // Drop a player without touching it (also called from its destructor)
+    bool forget(VideoPlayerBase* player) {
+        auto it = std::find_if(entries_.begin(), entries_.end(),
+                               [player](const Entry& e) { return e.player == player; });
+        if (it == entries_.end()) return false;
+        entries_.erase(it);
+        player->clock_ = nullptr;
+        return true;
+    }
+
+    static double playerFrameRate(const VideoPlayerBase& player) {
+        float duration = player.getDuration();
+        int frames = player.getTotalFrames();
+        return (duration > 0.0f && frames > 0) ? frames / (double)duration : 0.0;
+    }
+
+    // Time used to pick frames: the middle of the upcoming refresh (or just
+    // past time_ to absorb floating point error), wrapped like time_
+    double presentationTime() const {
+        double t = time_ + (refreshRate_ > 0.0 ? 0.5 / refreshRate_ : 1e-6);
+        double duration = getDuration();
+        if (duration > 0.0) t = loop_ ? std::fmod(t, duration) : std::min(t, duration);
+        return t;
+    }
+
+    void advance(double dt) {
+        // Whole refreshes only; the remainder carries over
+        if (refreshRate_ > 0.0) {
+            refreshDebt_ += dt * refreshRate_;
+            double steps = std::floor(refreshDebt_ + 0.5);
+            refreshDebt_ -= steps;
+            dt = steps / refreshRate_;
+        }
+        if (dt <= 0.0) return;
+
+        double next = time_ + dt * speed_;
+        double duration = getDuration();
+        if (waitForAll_ && !allReady(next, duration)) {
+            stallTime_ += dt;
+            if (stallTime_ < maxStall_) {
+                stallCount_++;
+                return;
+            }
+        }
+        stallTime_ = 0.0;
+        time_ = next;
+
+        if (duration > 0.0 && time_ >= duration) {
+            if (loop_) {
+                time_ = std::fmod(time_, duration);
+                loopCount_++;
+                looped.notify();
+            } else {
+                time_ = duration;
+                finished_ = true;
+            }
+        }
+    }
+
+    double clipTime(const VideoPlayerBase& player, double t) const {
+        double duration = player.getDuration();
+        if (duration <= 0.0) return t;
+        if (player.isLoop()) return std::fmod(t, duration);
+        return std::min(t, duration);
+    }
+
+    bool allReady(double t, double groupDuration) const {
+        if (groupDuration > 0.0 && loop_) t = std::fmod(t, groupDuration);
+        for (auto& e : entries_) {
+            if (!e.player->clockSlave_ || e.resync) continue;
+            double fps = playerFrameRate(*e.player);
+            double frame = fps > 0.0 ? 1.0 / fps : 0.0;
+            if (e.player->getBufferedTime() + frame < clipTime(*e.player, t)) return false;
+        }
+        return true;
+    }
+
+    void present() {
+        double presentTime = presentationTime();
+        for (auto& e : entries_) {
+            VideoPlayerBase& player = *e.player;
+            double t = clipTime(player, time_);
+
+            if (player.clockSlave_) {
+                // Middle of the selected frame, so any rounding in the
+                // player lands on the same frame index
+                double fps = playerFrameRate(player);
+                if (fps > 0.0) {
+                    int frames = player.getTotalFrames();
+                    int n = static_cast<int>(std::floor(clipTime(player, presentTime) * fps));
+                    n = std::clamp(n, 0, std::max(0, frames - 1));
+                    t = (n + 0.5) / fps;
+                }
+                // Discontinuities (seek, loop) need a real seek in the player
+                if (e.resync || t < e.lastTime || t > e.lastTime + 0.5) {
+                    player.setCurrentTime(static_cast<float>(t));
+                }
+                player.clockTime_ = t;
+            } else if (playing_ && !paused_) {
+                syncFreeRunning(e, t);
+            } else if (e.resync) {
+                player.setCurrentTime(static_cast<float>(t));
+            }
+
+            e.lastTime = t;
+            e.resync = false;
+            player.update();
+        }
+    }
+
+    void syncFreeRunning(Entry& e, double t) {
+        VideoPlayerBase& player = *e.player;
+        double drift = player.getCurrentTime() - t;
+        double speed = e.appliedSpeed;
+        if (e.resync || std::abs(drift) > seekThreshold_) {
+            player.setCurrentTime(static_cast<float>(t));
+            speed = speed_;
+        } else if (std::abs(drift) > nudgeThreshold_) {
+            // Catch up over about a second, within +-5% (1% steps, so
+            // native players see few speed changes)
+            speed = speed_ * (1.0 + std::round(std::clamp(-drift, -0.05, 0.05) * 100.0) / 100.0);
+        } else if (std::abs(drift) < nudgeThreshold_ * 0.25) {
+            // Caught up; keep the nudge until then (hysteresis)
+            speed = speed_;
+        }
+        if (std::abs(speed - e.appliedSpeed) > 1e-3) {
+            player.setSpeed(static_cast<float>(speed));
+            e.appliedSpeed = speed;
+        }
+    }
+
+    std::vector<Entry> entries_;
+
+    double time_ = 0.0;
+    double speed_ = 1.0;
+    double duration_ = 0.0;
+    double frameRate_ = 0.0;
+    double refreshRate_ = 0.0;
+    double refreshDebt_ = 0.0;      // Fractional refreshes not yet advanced
+
+    bool playing_ = false;
+    bool paused_ = false;
+    bool finished_ = false;
+    bool loop_ = false;
+    int loopCount_ = 0;
+
+    double lastNow_ = 0.0;
+    bool hasLastNow_ = false;
+
+    bool waitForAll_ = false;
+    double maxStall_ = 0.5;
+    double stallTime_ = 0.0;
+    uint64_t stallCount_ = 0;
+
+    double nudgeThreshold_ = 0.02;
+    double seekThreshold_ = 0.25;
+};
+
+// ---------------------------------------------------------------------------
+// VideoPlayerBase clock helpers
+// ---------------------------------------------------------------------------
+
+inline void VideoPlayerBase::detachFromClock() {
+    if (clock_) clock_->forget(this);
+    clockSlave_ = false;
+}
+
+} // namespace trussc
@@ -3,6 +3,14 @@
 // =============================================================================
 // tcVideoGrabber.h - Webcam input
 // =============================================================================
+//
+// Raw YUV output (Linux / V4L2 only, others stay RGBA):
+//   grabber.setPixelFormat(VideoPixelFormat::I420);  // before setup()
+//   Frames are uploaded in the camera's YUV layout and converted by a shader
+//   in draw(). getPixels() is nullptr and getTexture() is not updated; use
+//   getPlaneTexture() to access the planes. The actual layout (NV12 / I420)
+//   depends on the camera format, see getPixelFormat().
+// =============================================================================
 
 // This file is included from TrussC.h
 // Texture, HasTexture must be included first
@@ -11,6 +19,7 @@
 #include <string>
 #include <atomic>
 #include <mutex>
+#include "tcVideoPlanes.h"
 
 namespace trussc {
 
@@ -121,6 +130,8 @@ public:
         closePlatform();
 
         texture_.clear();
+        planes_.clear();
+        pixelFormat_ = VideoPixelFormat::RGBA;
 
         if (pixels_) {
             delete[] pixels_;
@@ -169,9 +180,14 @@ public:
 
         // Update texture if buffer was updated
         if (pixelsDirty_.exchange(false)) {
-            std::lock_guard<std::mutex> lock(mutex_);
-            texture_.loadData(pixels_, width_, height_, 4);
-            frameNew_ = true;
+            if (isYuv()) {
+                // Planes were uploaded by the platform
+                frameNew_ = true;
+            } else {
+                std::lock_guard<std::mutex> lock(mutex_);
+                texture_.loadData(pixels_, width_, height_, 4);
+                frameNew_ = true;
+            }
         }
     }
 
@@ -192,10 +208,36 @@ public:
     // Get current device name
     const std::string& getDeviceName() const { return deviceName_; }
 
+    // =========================================================================
+    // Pixel format
+    // =========================================================================
+
+    /// Request the frame layout (takes effect on the next setup()).
+    /// Backends without YUV output fall back to RGBA.
+    void setPixelFormat(VideoPixelFormat format) {
+        requestedPixelFormat_ = format;
+    }
+
+    /// Layout actually used by the camera
+    VideoPixelFormat getPixelFormat() const {
+        return pixelFormat_;
+    }
+
+    bool isYuv() const {
+        return pixelFormat_ != VideoPixelFormat::RGBA;
+    }
+
+    /// Plane textures in YUV mode (0 = Y, 1 = U or UV, 2 = V)
+    const Texture& getPlaneTexture(int index) const {
+        return planes_.getTexture(index);
+    }
+
     // =========================================================================
     // Pixel access
     // =========================================================================
 
+    // RGBA only (nullptr in YUV mode). Valid until the next update(); the
+    // Linux backend swaps buffers there, so fetch the pointer again after it
     unsigned char* getPixels() { return pixels_; }
     const unsigned char* getPixels() const { return pixels_; }
 
@@ -217,7 +259,21 @@ public:
     Texture& getTexture() override { return texture_; }
     const Texture& getTexture() const override { return texture_; }
 
-    // draw() uses HasTexture's default implementation
+    bool hasTexture() const override {
+        return isYuv() ? planes_.isAllocated() : texture_.isAllocated();
+    }
+
+    void draw(float x, float y) const override {
+        draw(x, y, static_cast<float>(width_), static_cast<float>(height_));
+    }
+
+    void draw(float x, float y, float w, float h) const override {
+        if (isYuv()) {
+            planes_.draw(x, y, w, h);
+        } else {
+            HasTexture::draw(x, y, w, h);
+        }
+    }
 
     // =========================================================================
     // Permissions (macOS)
@@ -255,6 +311,11 @@ private:
     // Texture (Stream mode)
     Texture texture_;
 
+    // Raw YUV output
+    VideoPixelFormat requestedPixelFormat_ = VideoPixelFormat::RGBA;
+    VideoPixelFormat pixelFormat_ = VideoPixelFormat::RGBA;
+    VideoPlanes planes_;
+
     // Platform-specific handle
     void* platformHandle_ = nullptr;
 
@@ -277,6 +338,9 @@ private:
         pixels_ = other.pixels_;
         pixelsDirty_.store(other.pixelsDirty_.load());
         texture_ = std::move(other.texture_);
+        requestedPixelFormat_ = other.requestedPixelFormat_;
+        pixelFormat_ = other.pixelFormat_;
+        planes_ = std::move(other.planes_);
         platformHandle_ = other.platformHandle_;
 
         // Invalidate source object
@@ -290,21 +354,26 @@ private:
 
     // Complete setup after permission is granted
     bool completeSetup() {
-        // Platform-specific setup (sets width_, height_)
+        // Platform-specific setup (sets width_, height_, pixelFormat_ if YUV)
+        pixelFormat_ = VideoPixelFormat::RGBA;
         if (!setupPlatform()) {
+            pixelFormat_ = VideoPixelFormat::RGBA;
             return false;
         }
 
-        // Allocate pixel buffer
-        size_t bufferSize = width_ * height_ * 4;
-        pixels_ = new unsigned char[bufferSize];
-        std::memset(pixels_, 0, bufferSize);
+        // YUV planes are allocated by the platform once the layout is known
+        if (!isYuv()) {
+            // Allocate pixel buffer
+            size_t bufferSize = width_ * height_ * 4;
+            pixels_ = new unsigned char[bufferSize];
+            std::memset(pixels_, 0, bufferSize);
 
-        // Set pixel buffer pointer for delegate
-        updateDelegatePixels();
+            // Set pixel buffer pointer for delegate
+            updateDelegatePixels();
 
-        // Create texture (Stream mode: for per-frame updates)
-        texture_.allocate(width_, height_, 4, TextureUsage::Stream);
+            // Create texture (Stream mode: for per-frame updates)
+            texture_.allocate(width_, height_, 4, TextureUsage::Stream);
+        }
 
         initialized_ = true;
         return true;
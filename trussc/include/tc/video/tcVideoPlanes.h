@@ -0,0 +1,147 @@
+#pragma once
+
+// =============================================================================
+// tcVideoPlanes.h - Planar YUV frames drawn through a conversion shader
+// =============================================================================
+// Shared by VideoPlayer and VideoGrabber. Frames stay in their native YUV
+// layout on the GPU and are converted to RGB in draw():
+//   NV12: plane 0 = Y, plane 1 = interleaved UV (RG8)
+//   I420: plane 0 = Y, plane 1 = U, plane 2 = V
+// Chroma planes may have any size (4:2:0, 4:2:2, 4:4:4); the shader samples
+// them with the same uv as the Y plane.
+// =============================================================================
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include "tc/gpu/shaders/video_yuv.glsl.h"
+
+namespace trussc {
+
+// Layout of decoded frames handed to the GPU
+enum class VideoPixelFormat {
+    RGBA,   // Converted on the CPU (default, all platforms)
+    NV12,   // Y plane + interleaved UV plane
+    I420    // Y, U, V planes
+};
+
+class VideoPlanes {
+public:
+    void allocate(VideoPixelFormat format, int width, int height, int chromaWidth, int chromaHeight) {
+        format_ = format;
+        planes_[0].allocate(width, height, TextureFormat::R8, TextureUsage::Stream);
+        if (format == VideoPixelFormat::NV12) {
+            planes_[1].allocate(chromaWidth, chromaHeight, TextureFormat::RG8, TextureUsage::Stream);
+            planes_[2].clear();
+        } else {
+            planes_[1].allocate(chromaWidth, chromaHeight, TextureFormat::R8, TextureUsage::Stream);
+            planes_[2].allocate(chromaWidth, chromaHeight, TextureFormat::R8, TextureUsage::Stream);
+        }
+        for (auto& plane : planes_) {
+            if (plane.isAllocated()) plane.setFilter(TextureFilter::Linear);
+        }
+    }
+
+    void clear() {
+        for (auto& plane : planes_) plane.clear();
+        format_ = VideoPixelFormat::RGBA;
+    }
+
+    bool isAllocated() const { return planes_[0].isAllocated(); }
+    VideoPixelFormat getFormat() const { return format_; }
+
+    /// 0 = Y, 1 = U or UV, 2 = V
+    const Texture& getTexture(int index) const {
+        return planes_[std::clamp(index, 0, 2)];
+    }
+
+    // Upload one frame (main thread). strides are in bytes per row.
+    void load(const uint8_t* const data[3], const int strides[3]) {
+        for (int i = 0; i < 3; ++i) {
+            Texture& plane = planes_[i];
+            if (!plane.isAllocated() || !data[i]) continue;
+            int w = plane.getWidth();
+            int h = plane.getHeight();
+            int rowBytes = w * plane.getChannels();
+            if (strides[i] == rowBytes) {
+                plane.loadData(data[i], w, h, plane.getChannels());
+                continue;
+            }
+            // Decoder rows are padded: pack them (buffer reused across frames)
+            scratch_.resize(static_cast<size_t>(rowBytes) * h);
+            for (int y = 0; y < h; ++y) {
+                std::memcpy(scratch_.data() + static_cast<size_t>(y) * rowBytes,
+                            data[i] + static_cast<size_t>(y) * strides[i], rowBytes);
+            }
+            plane.loadData(scratch_.data(), w, h, plane.getChannels());
+        }
+    }
+
+    // YUV -> RGB matrix with the range expansion folded in
+    void setColorSpace(bool bt709, bool fullRange) {
+        float kr = bt709 ? 1.5748f : 1.402f;
+        float kgu = bt709 ? 0.187324f : 0.344136f;
+        float kgv = bt709 ? 0.468124f : 0.714136f;
+        float kb = bt709 ? 1.8556f : 1.772f;
+        float ys = fullRange ? 1.0f : 255.0f / 219.0f;
+        float cs = fullRange ? 1.0f : 255.0f / 224.0f;
+        float params[16] = {
+            fullRange ? 0.0f : 16.0f / 255.0f, 128.0f / 255.0f, 128.0f / 255.0f, 0.0f,
+            ys, 0.0f, kr * cs, 0.0f,
+            ys, -kgu * cs, -kgv * cs, 0.0f,
+            ys, kb * cs, 0.0f, 0.0f,
+        };
+        std::memcpy(params_, params, sizeof(params));
+    }
+
+    void draw(float x, float y, float w, float h) const {
+        if (!isAllocated()) return;
+        if (!shader_.isLoaded() && !shader_.load(video_yuv_shader_desc)) {
+            return;
+        }
+
+        float vsParams[4] = {
+            static_cast<float>(getWindowWidth()), static_cast<float>(getWindowHeight()), 0.0f, 0.0f
+        };
+        float fsParams[16];
+        std::memcpy(fsParams, params_, sizeof(fsParams));
+        fsParams[3] = format_ == VideoPixelFormat::NV12 ? 1.0f : 0.0f;
+
+        pushShader(shader_);
+        // NV12 has no third plane; bind the UV plane so every slot is valid
+        const Texture& vPlane = planes_[2].isAllocated() ? planes_[2] : planes_[1];
+        shader_.setTexture(0, planes_[0].getView(), planes_[0].getSampler());
+        shader_.setTexture(1, planes_[1].getView(), planes_[1].getSampler());
+        shader_.setTexture(2, vPlane.getView(), vPlane.getSampler());
+        shader_.setUniform(0, vsParams, sizeof(vsParams));
+        shader_.setUniform(1, fsParams, sizeof(fsParams));
+
+        // Same transform handling as shader draws (ShaderWriter::end)
+        Color col = getDefaultContext().getColor();
+        Mat4 mat = getCurrentMatrix();
+        ShaderVertex verts[4] = {
+            {x, y, 0, 0.0f, 0.0f, col.r, col.g, col.b, col.a},
+            {x + w, y, 0, 1.0f, 0.0f, col.r, col.g, col.b, col.a},
+            {x + w, y + h, 0, 1.0f, 1.0f, col.r, col.g, col.b, col.a},
+            {x, y + h, 0, 0.0f, 1.0f, col.r, col.g, col.b, col.a},
+        };
+        for (auto& v : verts) {
+            Vec3 p = mat * Vec3(v.x, v.y, v.z);
+            v.x = p.x;
+            v.y = p.y;
+            v.z = p.z;
+        }
+        shader_.submitVertices(verts, 4, PrimitiveType::Quads);
+        popShader();
+    }
+
+private:
+    VideoPixelFormat format_ = VideoPixelFormat::RGBA;
+    Texture planes_[3];
+    std::vector<uint8_t> scratch_;  // Repacks padded rows
+    float params_[16] = {};         // video_yuv_fs_params (w of the first row set in draw)
+    mutable Shader shader_;
+};
+
+} // namespace trussc
@@ -18,9 +18,16 @@
 //   void draw() {
 //       video.draw(0, 0);
 //   }
+//
+// Planar YUV output (FFmpeg backend only, others stay RGBA):
+//   video.setPixelFormat(VideoPixelFormat::I420);  // before load()
+//   Frames stay in the decoder's NV12 / I420 layout and are converted to RGB
+//   by a shader in draw(). getPixels() / getTexture() are not updated; use
+//   getPlaneTexture() to access the planes.
 // =============================================================================
 
 #include "tcVideoPlayerBase.h"
+#include "tcVideoPlanes.h"
 #include "tc/graphics/tcPixels.h"
 
 namespace trussc {
@@ -62,8 +69,12 @@ public:
 
         // Create texture (Stream mode: for per-frame updates)
         if (width_ > 0 && height_ > 0) {
-            texture_.allocate(width_, height_, 4, TextureUsage::Stream);
-            clearTexture();
+            if (isYuv()) {
+                allocatePlanes();
+            } else {
+                texture_.allocate(width_, height_, 4, TextureUsage::Stream);
+                clearTexture();
+            }
         }
 
         initialized_ = true;
@@ -77,6 +88,8 @@ public:
         closePlatform();
 
         texture_.clear();
+        planes_.clear();
+        pixelFormat_ = VideoPixelFormat::RGBA;
 
         if (pixels_) {
             delete[] pixels_;
@@ -107,11 +120,16 @@ public:
 
         // Check for new frame from platform
         if (hasNewFramePlatform()) {
-            // Update texture from pixel buffer
-            std::lock_guard<std::mutex> lock(mutex_);
-            if (pixels_ && width_ > 0 && height_ > 0) {
-                texture_.loadData(pixels_, width_, height_, 4);
+            if (isYuv()) {
+                // Planes were uploaded by the platform (loadPlanes)
                 markFrameNew();
+            } else {
+                // Update texture from pixel buffer
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (pixels_ && width_ > 0 && height_ > 0) {
+                    texture_.loadData(pixels_, width_, height_, 4);
+                    markFrameNew();
+                }
             }
         }
 
@@ -180,10 +198,66 @@ public:
         return gammaCorrection_;
     }
 
+    // =========================================================================
+    // Pixel format
+    // =========================================================================
+
+    /// Request the frame layout (takes effect on the next load()).
+    /// Backends without planar output fall back to RGBA.
+    void setPixelFormat(VideoPixelFormat format) {
+        requestedPixelFormat_ = format;
+    }
+
+    /// Layout actually used by the loaded video
+    VideoPixelFormat getPixelFormat() const {
+        return pixelFormat_;
+    }
+
+    bool isYuv() const {
+        return pixelFormat_ != VideoPixelFormat::RGBA;
+    }
+
+    /// Plane textures in YUV mode (0 = Y, 1 = U or UV, 2 = V)
+    const Texture& getPlaneTexture(int index) const {
+        return planes_.getTexture(index);
+    }
+
+    // =========================================================================
+    // External clock
+    // =========================================================================
+
+    // FFmpeg backend only (native backends are synced by speed adjustments)
+    bool supportsClock() const override { return clockSupported_; }
+    double getBufferedTime() const override { return bufferedTime_; }
+
+    // =========================================================================
+    // Draw
+    // =========================================================================
+
+    bool hasTexture() const override {
+        return isYuv() ? planes_.isAllocated() : texture_.isAllocated();
+    }
+
+    void draw(float x, float y) const override {
+        draw(x, y, static_cast<float>(width_), static_cast<float>(height_));
+    }
+
+    void draw(float x, float y, float w, float h) const override {
+        if (!hasTexture()) return;
+        if (isYuv()) {
+            planes_.draw(x, y, w, h);
+        } else {
+            texture_.draw(x, y, w, h);
+        }
+    }
+
     // =========================================================================
     // Pixel access
     // =========================================================================
 
+    // RGBA only (nullptr in YUV mode). Holds the current frame until the
+    // next update(); the FFmpeg backend swaps buffers there instead of
+    // copying, so fetch the pointer again after each update()
     unsigned char* getPixels() override { return pixels_; }
     const unsigned char* getPixels() const override { return pixels_; }
 
@@ -244,6 +318,15 @@ private:
     // Gamma correction (1.0 = none)
     float gammaCorrection_ = 1.0f;
 
+    // Planar YUV output
+    VideoPixelFormat requestedPixelFormat_ = VideoPixelFormat::RGBA;
+    VideoPixelFormat pixelFormat_ = VideoPixelFormat::RGBA;
+    VideoPlanes planes_;
+
+    // External clock support (set by the platform)
+    bool clockSupported_ = false;
+    double bufferedTime_ = std::numeric_limits<double>::infinity();
+
     // Platform-specific handle
     void* platformHandle_ = nullptr;
 
@@ -266,6 +349,11 @@ private:
         pixels_ = other.pixels_;
         texture_ = std::move(other.texture_);
         platformHandle_ = other.platformHandle_;
+        requestedPixelFormat_ = other.requestedPixelFormat_;
+        pixelFormat_ = other.pixelFormat_;
+        planes_ = std::move(other.planes_);
+        clockSupported_ = other.clockSupported_;
+        other.detachFromClock();
 
         // Invalidate source
         other.pixels_ = nullptr;
@@ -275,6 +363,14 @@ private:
         other.height_ = 0;
     }
 
+    // -------------------------------------------------------------------------
+    // Planar YUV
+    // -------------------------------------------------------------------------
+
+    void allocatePlanes() {
+        planes_.allocate(pixelFormat_, width_, height_, (width_ + 1) / 2, (height_ + 1) / 2);
+    }
+
     // Clear texture to black (prevents old frame from showing)
     void clearTexture() {
         if (width_ > 0 && height_ > 0 && pixels_) {
@@ -360,6 +456,29 @@ public:
     static std::mutex& getMutex(VideoPlayer& player) {
         return player.mutex_;
     }
+    static VideoPixelFormat getRequestedPixelFormat(const VideoPlayer& player) {
+        return player.requestedPixelFormat_;
+    }
+    static void setPixelFormat(VideoPlayer& player, VideoPixelFormat format) {
+        player.pixelFormat_ = format;
+    }
+    static void setYuvColorSpace(VideoPlayer& player, bool bt709, bool fullRange) {
+        player.planes_.setColorSpace(bt709, fullRange);
+    }
+    static void loadPlanes(VideoPlayer& player, const uint8_t* const data[3], const int strides[3]) {
+        player.planes_.load(data, strides);
+    }
+    static void setClockSupported(VideoPlayer& player, bool supported) {
+        player.clockSupported_ = supported;
+    }
+    // True (and the time to show) while slaved to a MediaClock
+    static bool getClockTime(const VideoPlayer& player, double& seconds) {
+        seconds = player.clockTime_;
+        return player.clockSlave_;
+    }
+    static void setBufferedTime(VideoPlayer& player, double seconds) {
+        player.bufferedTime_ = seconds;
+    }
 };
 
 } // namespace trussc
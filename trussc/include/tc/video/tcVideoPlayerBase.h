@@ -8,17 +8,20 @@
 #include <string>
 #include <atomic>
 #include <mutex>
+#include <limits>
 #include "tc/gpu/tcHasTexture.h"
 
 namespace trussc {
 
+class MediaClock;
+
 // ---------------------------------------------------------------------------
 // VideoPlayerBase - Abstract base class for video playback
 // ---------------------------------------------------------------------------
 class VideoPlayerBase : public HasTexture {
 public:
     VideoPlayerBase() = default;
-    virtual ~VideoPlayerBase() = default;
+    virtual ~VideoPlayerBase() { detachFromClock(); }
 
     // Non-copyable
     VideoPlayerBase(const VideoPlayerBase&) = delete;
@@ -189,6 +192,20 @@ public:
     virtual int getAudioSampleRate() const { return 0; }
     virtual int getAudioChannels() const { return 0; }
 
+    // =========================================================================
+    // External clock (see MediaClock)
+    // =========================================================================
+
+    // True if update() can show the frame for a time given by a MediaClock.
+    // Other players are kept in sync by speed adjustments.
+    virtual bool supportsClock() const { return false; }
+
+    // Media time up to which frames are decoded and can be shown without
+    // waiting (players that decode on demand are always ready)
+    virtual double getBufferedTime() const { return std::numeric_limits<double>::infinity(); }
+
+    MediaClock* getClock() const { return clock_; }
+
     // =========================================================================
     // HasTexture implementation
     // =========================================================================
@@ -213,6 +230,11 @@ protected:
     float speed_ = 1.0f;
     float pan_ = 0.0f;
 
+    // External clock (set by MediaClock)
+    MediaClock* clock_ = nullptr;
+    bool clockSlave_ = false;       // update() follows clockTime_
+    double clockTime_ = 0.0;        // Media time to show on the next update()
+
     // Thread synchronization
     mutable std::mutex mutex_;
 
@@ -244,6 +266,13 @@ protected:
             playing_ = false;
         }
     }
+
+    // Leave the MediaClock, if any (defined in tcMediaClock.h)
+    void detachFromClock();
+
+    friend class MediaClock;
 };
 
 } // namespace trussc
+
+#include "tcMediaClock.h"
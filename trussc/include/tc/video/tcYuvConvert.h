@@ -0,0 +1,222 @@
+#pragma once
+
+// =============================================================================
+// tcYuvConvert.h - YUV 4:2:x -> RGBA conversion (BT.601, limited range)
+// =============================================================================
+// Used by the V4L2 VideoGrabber. 8 pixels per step with SSE2 / NEON, scalar
+// for the rest of the row and on other CPUs. All paths give identical
+// results (16-bit fixed point, same rounding).
+//
+//   convertYuyvToRgba()  YUYV (packed 4:2:2)
+//   convertNv12ToRgba()  NV12 (Y plane + interleaved UV plane, 4:2:0)
+//   splitYuyv()          YUYV -> Y plane + interleaved UV plane (for
+//                        VideoPlanes in NV12 layout, chroma at full height)
+// =============================================================================
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TC_YUV_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define TC_YUV_NEON 1
+#endif
+
+namespace trussc {
+
+namespace yuv_detail {
+
+inline uint8_t clampByte(int v) {
+    return static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+inline void pixel(int y, int u, int v, uint8_t* dst) {
+    int c = 298 * (y - 16) + 128;
+    int d = u - 128;
+    int e = v - 128;
+    dst[0] = clampByte((c + 409 * e) >> 8);
+    dst[1] = clampByte((c - 100 * d - 208 * e) >> 8);
+    dst[2] = clampByte((c + 516 * d) >> 8);
+    dst[3] = 255;
+}
+
+#if defined(TC_YUV_SSE2)
+
+// 8 pixels: y = 8 x Y (16-bit), uv = U0 V0 U1 V1 U2 V2 U3 V3 (16-bit)
+inline void pixels8(__m128i y, __m128i uv, uint8_t* dst) {
+    const __m128i lowMask = _mm_set1_epi32(0xFFFF);
+    __m128i u = _mm_and_si128(uv, lowMask);
+    __m128i v = _mm_srli_epi32(uv, 16);
+    u = _mm_or_si128(u, _mm_slli_epi32(u, 16));     // U0 U0 U1 U1 ...
+    v = _mm_or_si128(v, _mm_slli_epi32(v, 16));
+
+    __m128i c = _mm_sub_epi16(y, _mm_set1_epi16(16));
+    __m128i d = _mm_sub_epi16(u, _mm_set1_epi16(128));
+    __m128i e = _mm_sub_epi16(v, _mm_set1_epi16(128));
+
+    // ka * a + kb * b per pixel as exact 32-bit sums (madd on (a, b) pairs)
+    auto madd = [](__m128i a, __m128i b, int ka, int kb, __m128i& lo, __m128i& hi) {
+        __m128i k = _mm_set1_epi32(static_cast<int>((static_cast<uint32_t>(kb) << 16) |
+                                                    (static_cast<uint32_t>(ka) & 0xFFFF)));
+        lo = _mm_add_epi32(lo, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), k));
+        hi = _mm_add_epi32(hi, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), k));
+    };
+    auto narrow = [](__m128i lo, __m128i hi) {
+        return _mm_packs_epi32(_mm_srai_epi32(lo, 8), _mm_srai_epi32(hi, 8));
+    };
+
+    const __m128i round = _mm_set1_epi32(128);
+    __m128i rLo = round, rHi = round, gLo = round, gHi = round, bLo = round, bHi = round;
+    madd(c, e, 298, 409, rLo, rHi);
+    madd(c, d, 298, -100, gLo, gHi);
+    madd(e, _mm_setzero_si128(), -208, 0, gLo, gHi);
+    madd(c, d, 298, 516, bLo, bHi);
+    __m128i r = narrow(rLo, rHi);
+    __m128i g = narrow(gLo, gHi);
+    __m128i b = narrow(bLo, bHi);
+
+    __m128i rg = _mm_packus_epi16(r, g);            // R0..R7 G0..G7
+    __m128i ba = _mm_packus_epi16(b, _mm_set1_epi16(255));
+    __m128i rgInter = _mm_unpacklo_epi8(rg, _mm_srli_si128(rg, 8));
+    __m128i baInter = _mm_unpacklo_epi8(ba, _mm_srli_si128(ba, 8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi16(rgInter, baInter));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi16(rgInter, baInter));
+}
+
+inline void yuyv8(const uint8_t* src, uint8_t* dst) {
+    __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    pixels8(_mm_and_si128(p, _mm_set1_epi16(0xFF)), _mm_srli_epi16(p, 8), dst);
+}
+
+inline void nv12x8(const uint8_t* y, const uint8_t* uv, uint8_t* dst) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i y8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(y));
+    __m128i uv8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(uv));
+    pixels8(_mm_unpacklo_epi8(y8, zero), _mm_unpacklo_epi8(uv8, zero), dst);
+}
+
+#elif defined(TC_YUV_NEON)
+
+// 8 pixels: y = 8 x Y, uv = U0 V0 U1 V1 U2 V2 U3 V3
+inline void pixels8(uint8x8_t y, uint8x8_t uv, uint8_t* dst) {
+    uint8x8x2_t split = vuzp_u8(uv, uv);                // U0..U3 x2, V0..V3 x2
+    uint8x8_t u = vzip_u8(split.val[0], split.val[0]).val[0];   // U0 U0 U1 U1 ...
+    uint8x8_t v = vzip_u8(split.val[1], split.val[1]).val[0];
+
+    int16x8_t c = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(y)), vdupq_n_s16(16));
+    int16x8_t d = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u)), vdupq_n_s16(128));
+    int16x8_t e = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v)), vdupq_n_s16(128));
+
+    int32x4_t cLo = vmlal_n_s16(vdupq_n_s32(128), vget_low_s16(c), 298);
+    int32x4_t cHi = vmlal_n_s16(vdupq_n_s32(128), vget_high_s16(c), 298);
+
+    auto narrow = [](int32x4_t lo, int32x4_t hi) {
+        return vqmovun_s16(vcombine_s16(vqshrn_n_s32(lo, 8), vqshrn_n_s32(hi, 8)));
+    };
+
+    uint8x8x4_t out;
+    out.val[0] = narrow(vmlal_n_s16(cLo, vget_low_s16(e), 409),
+                        vmlal_n_s16(cHi, vget_high_s16(e), 409));
+    out.val[1] = narrow(vmlal_n_s16(vmlal_n_s16(cLo, vget_low_s16(d), -100), vget_low_s16(e), -208),
+                        vmlal_n_s16(vmlal_n_s16(cHi, vget_high_s16(d), -100), vget_high_s16(e), -208));
+    out.val[2] = narrow(vmlal_n_s16(cLo, vget_low_s16(d), 516),
+                        vmlal_n_s16(cHi, vget_high_s16(d), 516));
+    out.val[3] = vdup_n_u8(255);
+    vst4_u8(dst, out);
+}
+
+inline void yuyv8(const uint8_t* src, uint8_t* dst) {
+    uint8x8x2_t p = vld2_u8(src);                       // Y, UV
+    pixels8(p.val[0], p.val[1], dst);
+}
+
+inline void nv12x8(const uint8_t* y, const uint8_t* uv, uint8_t* dst) {
+    pixels8(vld1_u8(y), vld1_u8(uv), dst);
+}
+
+#endif
+
+} // namespace yuv_detail
+
+// YUYV (Y0 U Y1 V) -> RGBA. Strides in bytes.
+inline void convertYuyvToRgba(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride,
+                              int width, int height) {
+    for (int row = 0; row < height; row++) {
+        const uint8_t* s = src + static_cast<size_t>(row) * srcStride;
+        uint8_t* d = dst + static_cast<size_t>(row) * dstStride;
+        int x = 0;
+#if defined(TC_YUV_SSE2) || defined(TC_YUV_NEON)
+        for (; x + 8 <= width; x += 8) {
+            yuv_detail::yuyv8(s + x * 2, d + x * 4);
+        }
+#endif
+        for (; x + 1 < width; x += 2) {
+            const uint8_t* p = s + x * 2;
+            yuv_detail::pixel(p[0], p[1], p[3], d + x * 4);
+            yuv_detail::pixel(p[2], p[1], p[3], d + x * 4 + 4);
+        }
+        if (x < width) {
+            const uint8_t* p = s + x * 2;
+            yuv_detail::pixel(p[0], p[1], p[3], d + x * 4);
+        }
+    }
+}
+
+// NV12 (Y plane, UV plane at half width / height) -> RGBA. Strides in bytes.
+inline void convertNv12ToRgba(const uint8_t* y, int yStride, const uint8_t* uv, int uvStride,
+                              uint8_t* dst, int dstStride, int width, int height) {
+    for (int row = 0; row < height; row++) {
+        const uint8_t* ys = y + static_cast<size_t>(row) * yStride;
+        const uint8_t* uvs = uv + static_cast<size_t>(row / 2) * uvStride;
+        uint8_t* d = dst + static_cast<size_t>(row) * dstStride;
+        int x = 0;
+#if defined(TC_YUV_SSE2) || defined(TC_YUV_NEON)
+        for (; x + 8 <= width; x += 8) {
+            yuv_detail::nv12x8(ys + x, uvs + x, d + x * 4);
+        }
+#endif
+        for (; x < width; x++) {
+            const uint8_t* c = uvs + (x & ~1);
+            yuv_detail::pixel(ys[x], c[0], c[1], d + x * 4);
+        }
+    }
+}
+
+// YUYV -> Y plane (width x height) + UV plane (width / 2 x height, interleaved)
+inline void splitYuyv(const uint8_t* src, int srcStride, uint8_t* y, uint8_t* uv,
+                      int width, int height) {
+    int pairs = width / 2;
+    for (int row = 0; row < height; row++) {
+        const uint8_t* s = src + static_cast<size_t>(row) * srcStride;
+        uint8_t* yd = y + static_cast<size_t>(row) * width;
+        uint8_t* uvd = uv + static_cast<size_t>(row) * pairs * 2;
+        int i = 0;
+#if defined(TC_YUV_SSE2)
+        const __m128i mask = _mm_set1_epi16(0xFF);
+        for (; i + 8 <= pairs; i += 8) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i * 4));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i * 4 + 16));
+            __m128i ys = _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask));
+            __m128i cs = _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(yd + i * 2), ys);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(uvd + i * 2), cs);
+        }
+#elif defined(TC_YUV_NEON)
+        for (; i + 8 <= pairs; i += 8) {
+            uint8x16x2_t p = vld2q_u8(s + i * 4);
+            vst1q_u8(yd + i * 2, p.val[0]);
+            vst1q_u8(uvd + i * 2, p.val[1]);
+        }
+#endif
+        for (; i < pairs; i++) {
+            yd[i * 2] = s[i * 4];
+            uvd[i * 2] = s[i * 4 + 1];
+            yd[i * 2 + 1] = s[i * 4 + 2];
+            uvd[i * 2 + 1] = s[i * 4 + 3];
+        }
+    }
+}
+
+} // namespace trussc
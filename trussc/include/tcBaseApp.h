@@ -3,10 +3,12 @@
 #include "tcNode.h"
 #include "tc/types/tcMod.h"
 #include "tc/types/tcRectNode.h"
+#include "tc/types/tcMeshNode.h"
 #include "tc/types/tcLayoutMod.h"
 #include "tc/types/tcScrollContainer.h"
 #include "tc/types/tcScrollBar.h"
 #include "tc/types/tcTweenMod.h"
+#include "tc/animation/tcTweenSystem.h"
 #include <vector>
 #include <string>
 
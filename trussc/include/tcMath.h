@@ -3,6 +3,8 @@
 #include <cmath>
 #include <algorithm>
 #include <random>
+#include <span>
+#include "tc/math/tcMathSimd.h"
 
 // =============================================================================
 // TrussC Math Library
@@ -760,17 +762,13 @@ struct Mat4 {
     static Mat4 scale(float s) { return scale(s, s, s); }
     static Mat4 scale(const Vec3& s) { return scale(s.x, s.y, s.z); }
 
+    // translate(t) * rotation.toMatrix() * scale(s), without the two products
+    static Mat4 compose(const Vec3& t, const Quaternion& rotation, const Vec3& s);
+
     // Matrix multiplication
     Mat4 operator*(const Mat4& other) const {
         Mat4 result;
-        for (int row = 0; row < 4; row++) {
-            for (int col = 0; col < 4; col++) {
-                result.at(row, col) = 0;
-                for (int k = 0; k < 4; k++) {
-                    result.at(row, col) += at(row, k) * other.at(k, col);
-                }
-            }
-        }
+        math_detail::multiply(m, other.m, result.m);
         return result;
     }
 
@@ -803,53 +801,10 @@ struct Mat4 {
         );
     }
 
-    // Inverse (simple version for affine transformations)
+    // Inverse (identity if the matrix is singular)
     Mat4 inverted() const {
         Mat4 inv;
-
-        inv.m[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15]
-                 + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
-        inv.m[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15]
-                 - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
-        inv.m[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15]
-                 + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
-        inv.m[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11]
-                 - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
-
-        inv.m[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15]
-                 - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
-        inv.m[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15]
-                 + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
-        inv.m[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15]
-                 - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
-        inv.m[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11]
-                 + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
-
-        inv.m[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15]
-                 + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
-        inv.m[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15]
-                 - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
-        inv.m[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15]
-                  + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
-        inv.m[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11]
-                  - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
-
-        inv.m[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14]
-                  - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
-        inv.m[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14]
-                  + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
-        inv.m[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14]
-                  - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
-        inv.m[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10]
-                  + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
-
-        float det = m[0] * inv.m[0] + m[1] * inv.m[4] + m[2] * inv.m[8] + m[3] * inv.m[12];
-        if (std::abs(det) < 1e-10f) return Mat4();
-
-        float invDet = 1.0f / det;
-        for (int i = 0; i < 16; i++) {
-            inv.m[i] *= invDet;
-        }
+        if (!math_detail::invert(m, inv.m)) return Mat4();
         return inv;
     }
 
@@ -918,6 +873,54 @@ inline Mat4 Quaternion::toMatrix() const {
     );
 }
 
+inline Mat4 Mat4::compose(const Vec3& t, const Quaternion& rotation, const Vec3& s) {
+    Mat4 r = rotation.toMatrix();
+    r.m[0] *= s.x; r.m[1] *= s.y; r.m[2]  *= s.z; r.m[3]  = t.x;
+    r.m[4] *= s.x; r.m[5] *= s.y; r.m[6]  *= s.z; r.m[7]  = t.y;
+    r.m[8] *= s.x; r.m[9] *= s.y; r.m[10] *= s.z; r.m[11] = t.z;
+    return r;
+}
+
+// =============================================================================
+// Batch transforms (SSE2 / NEON, see tc/math/tcMathSimd.h)
+// =============================================================================
+// min(in.size(), out.size()) elements are processed; in and out may be the
+// same span.
+
+static_assert(sizeof(Vec3) == 3 * sizeof(float), "Vec3 must be packed x, y, z");
+static_assert(sizeof(Mat4) == 16 * sizeof(float), "Mat4 must be float[16]");
+
+// out[i] = m * in[i] (same as Mat4 * Vec3)
+inline void transformPoints(const Mat4& m, std::span<const Vec3> in, std::span<Vec3> out) {
+    math_detail::transformPoints(m.m, reinterpret_cast<const float*>(in.data()),
+                                 reinterpret_cast<float*>(out.data()), std::min(in.size(), out.size()));
+}
+
+// Upper 3x3 of m (no translation), renormalized; normals that collapse to
+// (near) zero length are left unchanged. Non-uniform scale needs the
+// inverse transpose: transformNormals(m.inverted().transposed(), ...)
+inline void transformNormals(const Mat4& m, std::span<const Vec3> in, std::span<Vec3> out) {
+    math_detail::transformNormals(m.m, reinterpret_cast<const float*>(in.data()),
+                                  reinterpret_cast<float*>(out.data()), std::min(in.size(), out.size()));
+}
+
+// out[i] = lhs * in[i] (e.g. parent * local for many children)
+inline void multiplyMatrices(const Mat4& lhs, std::span<const Mat4> in, std::span<Mat4> out) {
+    const Mat4 l = lhs;     // lhs may be one of the outputs
+    size_t count = std::min(in.size(), out.size());
+    for (size_t i = 0; i < count; i++) {
+        math_detail::multiply(l.m, in[i].m, out[i].m);
+    }
+}
+
+// out[i] = a[i] * b[i]
+inline void multiplyMatrices(std::span<const Mat4> a, std::span<const Mat4> b, std::span<Mat4> out) {
+    size_t count = std::min({a.size(), b.size(), out.size()});
+    for (size_t i = 0; i < count; i++) {
+        math_detail::multiply(a[i].m, b[i].m, out[i].m);
+    }
+}
+
 // =============================================================================
 // Utility functions
 // =============================================================================
@@ -2,6 +2,7 @@
 
 #include "TrussC.h"
 #include "tc/types/tcMod.h"
+#include "tc/utils/tcTimerQueue.h"
 #include <memory>
 #include <vector>
 #include <functional>
@@ -263,6 +264,17 @@ public:
     float getRotDeg() const { return rad2deg(getRot()); }
     void setRotDeg(float degrees) { setRot(deg2rad(degrees)); }
 
+    // 2D position + Z rotation as one change (one notification), for bulk
+    // updates such as physics sync
+    void setPosRot(float x, float y, float radians) {
+        Vec3 pos(x, y, 0.0f);
+        Quaternion rot = Quaternion::fromAxisAngle(Vec3(0, 0, 1), radians);
+        if (position_ == pos && rotation_ == rot) return;
+        position_ = pos;
+        rotation_ = rot;
+        notifyLocalMatrixChanged();
+    }
+
     // -------------------------------------------------------------------------
     // Transform - Scale
     // -------------------------------------------------------------------------
@@ -435,6 +447,11 @@ private:
             setup();
         }
 
+        auto& stats = frameStats().nodes;
+        stats.updated++;
+        if (timers_) stats.timers += static_cast<uint32_t>(timers_->size());
+        stats.mods += static_cast<uint32_t>(mods_.size());
+
         // Mod early update (before Node::update)
         for (auto& [type, mod] : mods_) {
             mod->earlyUpdate();
@@ -498,6 +515,7 @@ private:
             setup();
         }
 
+        frameStats().nodes.drawn++;
         pushMatrix();
 
         // Apply transforms using cached matrix
@@ -839,34 +857,33 @@ protected:
     // Timers
     // -------------------------------------------------------------------------
 
+    // Timers fire during this node's update (before update()), so they pause
+    // while the node is inactive. Ids are unique across all nodes.
+
     // Execute callback once after specified delay in seconds
     uint64_t callAfter(double delay, std::function<void()> callback) {
-        uint64_t id = nextTimerId_++;
-        double triggerTime = getElapsedTime() + delay;
-        timers_.push_back({id, triggerTime, 0.0, callback, false});
-        return id;
+        return timerQueue().add(getElapsedTime() + delay, std::move(callback), nextTimerId_++);
     }
 
-    // Execute callback repeatedly at specified interval
+    // Execute callback repeatedly at specified interval (stays on the
+    // interval grid; missed ticks after a stall are skipped)
     uint64_t callEvery(double interval, std::function<void()> callback) {
-        uint64_t id = nextTimerId_++;
-        double triggerTime = getElapsedTime() + interval;
-        timers_.push_back({id, triggerTime, interval, callback, true});
-        return id;
+        return timerQueue().addRepeating(getElapsedTime() + interval, interval, std::move(callback), nextTimerId_++);
     }
 
-    // Cancel timer
+    // Cancel timer (safe inside timer callbacks)
     void cancelTimer(uint64_t id) {
-        timers_.erase(
-            std::remove_if(timers_.begin(), timers_.end(),
-                [id](const Timer& t) { return t.id == id; }),
-            timers_.end()
-        );
+        if (timers_) timers_->cancel(id);
     }
 
     // Cancel all timers
     void cancelAllTimers() {
-        timers_.clear();
+        if (timers_) timers_->clear();
+    }
+
+    // Number of pending timers
+    size_t getTimerCount() const {
+        return timers_ ? timers_->size() : 0;
     }
 
 private:
@@ -897,11 +914,13 @@ private:
     mutable bool globalMatrixDirty_ = true;
 
     void updateLocalMatrix() const {
-        localMatrix_ = Mat4::translate(position_) * rotation_.toMatrix() * Mat4::scale(scale_);
+        frameStats().nodes.localMatrixUpdates++;
+        localMatrix_ = Mat4::compose(position_, rotation_, scale_);
         localMatrixDirty_ = false;
     }
 
     void updateGlobalMatrix() const {
+        frameStats().nodes.globalMatrixUpdates++;
         if (auto p = parent_.lock()) {
             globalMatrix_ = p->getGlobalMatrix() * getLocalMatrix();
         } else {
@@ -929,46 +948,26 @@ private:
     void notifyLocalMatrixChanged() {
         markMatrixDirty();
         onLocalMatrixChanged();
-        localMatrixChanged.notify();
+        if (!localMatrixChanged.empty()) localMatrixChanged.notify();
     }
 
 protected:
     // Override for custom behavior when local matrix changes
     virtual void onLocalMatrixChanged() {}
 
-    // Timer structure
-    struct Timer {
-        uint64_t id;
-        double triggerTime;
-        double interval;
-        std::function<void()> callback;
-        bool repeating;
-    };
-
-    std::vector<Timer> timers_;
+    // Allocated on first use (most nodes never schedule timers)
+    std::unique_ptr<TimerQueue> timers_;
     inline static uint64_t nextTimerId_ = 1;
 
-    // Process timers (called within updateRecursive)
-    void processTimers() {
-        double currentTime = getElapsedTime();
-        std::vector<Timer> toRemove;
-
-        for (auto& timer : timers_) {
-            if (currentTime >= timer.triggerTime) {
-                timer.callback();
-
-                if (timer.repeating) {
-                    timer.triggerTime = currentTime + timer.interval;
-                } else {
-                    toRemove.push_back(timer);
-                }
-            }
-        }
+    TimerQueue& timerQueue() {
+        if (!timers_) timers_ = std::make_unique<TimerQueue>();
+        return *timers_;
+    }
 
-        // Remove completed non-repeating timers
-        for (const auto& t : toRemove) {
-            cancelTimer(t.id);
-        }
+    // Process timers (called within updateTree). Only due timers are touched.
+    void processTimers() {
+        if (!timers_ || timers_->empty()) return;
+        frameStats().nodes.timersFired += static_cast<uint32_t>(timers_->process(getElapsedTime()));
     }
 };
 
@@ -114,7 +114,7 @@ bool saveScreenshot(const std::filesystem::path& path) {
     }
 
     // Use stb_image_write to save
-    std::string ext = path.extension().string();
+    std::string ext = toLower(path.extension().string());
     std::string pathStr = path.string();
 
     int width = pixels.getWidth();
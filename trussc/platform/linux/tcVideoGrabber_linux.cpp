@@ -2,12 +2,19 @@
 // tcVideoGrabber_linux.cpp - Linux V4L2 implementation
 // =============================================================================
 // Uses Video4Linux2 (V4L2) for webcam capture.
-// Supports YUYV and MJPEG formats, converts to RGBA.
+// Supports MJPEG, YUYV and NV12 formats, converts to RGBA or hands the YUV
+// planes to the GPU (setPixelFormat()).
+// MJPEG is decoded with libjpeg-turbo when available (TC_HAS_TURBOJPEG),
+// stb_image otherwise.
+// Frames are decoded on the capture thread into a back buffer and handed to
+// the main thread by swapping buffers (no per-frame copy). A buffer that
+// leaves getPixels() is held back for one update() before capture reuses it.
 // =============================================================================
 
 #ifdef __linux__
 
 #include "TrussC.h"
+#include "tc/video/tcYuvConvert.h"
 
 #include <linux/videodev2.h>
 #include <sys/ioctl.h>
@@ -19,8 +26,11 @@
 #include <thread>
 #include <atomic>
 
+#ifdef TC_HAS_TURBOJPEG
+#include <turbojpeg.h>
+#endif
+
 // For MJPEG decoding
-#define STB_IMAGE_IMPLEMENTATION_ALREADY_DONE
 #include <stb/stb_image.h>
 
 namespace trussc {
@@ -39,15 +49,27 @@ struct VideoGrabberPlatformData {
     Buffer* buffers = nullptr;
     unsigned int bufferCount = 0;
 
-    // Back buffer for double buffering
-    unsigned char* backBuffer = nullptr;
+    // Decoded frame: RGBA, or the Y plane followed by the chroma plane(s)
+    struct Frame {
+        unsigned char* data = nullptr;
+        int chromaWidth = 0;    // YUV: size of the U / V (NV12: UV) plane
+        int chromaHeight = 0;
+    };
+
+    // Triple buffering: the capture thread decodes into back and swaps it
+    // with ready; the main thread swaps ready with pixels_ (RGBA) or front (YUV)
+    Frame back;
+    Frame ready;
+    Frame front;
+    unsigned char* retired = nullptr;   // RGBA: previous pixels_, not yet back in ready
+    bool frameReady = false;
+    std::mutex frameMutex;
     int bufferWidth = 0;
     int bufferHeight = 0;
 
     // Capture thread
     std::thread captureThread;
     std::atomic<bool> running{false};
-    std::atomic<bool> bufferReady{false};
 
     // Resize notification
     std::atomic<bool> needsResize{false};
@@ -56,11 +78,12 @@ struct VideoGrabberPlatformData {
 
     // Format info
     uint32_t pixelFormat = 0;
+    int bytesPerLine = 0;
+    bool yuvOutput = false;
 
-    // Pointer to VideoGrabber members
-    unsigned char* targetPixels = nullptr;
-    std::atomic<bool>* pixelsDirty = nullptr;
-    std::mutex* mutex = nullptr;
+#ifdef TC_HAS_TURBOJPEG
+    tjhandle jpeg = nullptr;
+#endif
 };
 
 // =============================================================================
@@ -75,46 +98,35 @@ static int xioctl(int fd, unsigned long request, void* arg) {
     return r;
 }
 
-// Convert YUYV (YUV422) to RGBA
-static void convertYUYVtoRGBA(const unsigned char* src, unsigned char* dst, int width, int height) {
-    for (int i = 0; i < width * height; i += 2) {
-        int y0 = src[0];
-        int u  = src[1];
-        int y1 = src[2];
-        int v  = src[3];
-        src += 4;
-
-        // YUV to RGB conversion
-        int c = y0 - 16;
-        int d = u - 128;
-        int e = v - 128;
-
-        int r = (298 * c + 409 * e + 128) >> 8;
-        int g = (298 * c - 100 * d - 208 * e + 128) >> 8;
-        int b = (298 * c + 516 * d + 128) >> 8;
-
-        dst[0] = (r < 0) ? 0 : (r > 255) ? 255 : r;
-        dst[1] = (g < 0) ? 0 : (g > 255) ? 255 : g;
-        dst[2] = (b < 0) ? 0 : (b > 255) ? 255 : b;
-        dst[3] = 255;
-        dst += 4;
-
-        c = y1 - 16;
-        r = (298 * c + 409 * e + 128) >> 8;
-        g = (298 * c - 100 * d - 208 * e + 128) >> 8;
-        b = (298 * c + 516 * d + 128) >> 8;
-
-        dst[0] = (r < 0) ? 0 : (r > 255) ? 255 : r;
-        dst[1] = (g < 0) ? 0 : (g > 255) ? 255 : g;
-        dst[2] = (b < 0) ? 0 : (b > 255) ? 255 : b;
-        dst[3] = 255;
-        dst += 4;
-    }
+static std::string fourccToString(uint32_t fourcc) {
+    char s[4] = {char(fourcc & 0xFF), char((fourcc >> 8) & 0xFF),
+                 char((fourcc >> 16) & 0xFF), char((fourcc >> 24) & 0xFF)};
+    return std::string(s, 4);
 }
 
-// Decode MJPEG to RGBA using stb_image
-static bool decodeMJPEGtoRGBA(const unsigned char* src, size_t srcSize,
-                               unsigned char* dst, int width, int height) {
+// Decode MJPEG to RGBA straight into dst
+static bool decodeMJPEGtoRGBA(VideoGrabberPlatformData* data, const unsigned char* src,
+                              size_t srcSize, unsigned char* dst) {
+    int width = data->bufferWidth;
+    int height = data->bufferHeight;
+
+#ifdef TC_HAS_TURBOJPEG
+    if (data->jpeg) {
+        int w, h, subsamp, colorspace;
+        if (tjDecompressHeader3(data->jpeg, src, srcSize, &w, &h, &subsamp, &colorspace) != 0 ||
+            w != width || h != height) {
+            return false;
+        }
+        // Webcam JPEGs often trigger warnings (extraneous bytes); the image is fine
+        if (tjDecompress2(data->jpeg, src, srcSize, dst, width, width * 4, height,
+                          TJPF_RGBA, TJFLAG_FASTDCT) != 0) {
+            return tjGetErrorCode(data->jpeg) == TJERR_WARNING;
+        }
+        return true;
+    }
+#endif
+
+    // stb_image fallback
     int w, h, channels;
     unsigned char* decoded = stbi_load_from_memory(src, srcSize, &w, &h, &channels, 4);
 
@@ -122,13 +134,106 @@ static bool decodeMJPEGtoRGBA(const unsigned char* src, size_t srcSize,
         return false;
     }
 
-    if (w == width && h == height) {
+    bool ok = (w == width && h == height);
+    if (ok) {
         memcpy(dst, decoded, width * height * 4);
     }
 
     stbi_image_free(decoded);
+    return ok;
+}
+
+#ifdef TC_HAS_TURBOJPEG
+// Decode MJPEG to Y, U, V planes (chroma size follows the JPEG subsampling)
+static bool decodeMJPEGtoYUV(VideoGrabberPlatformData* data, const unsigned char* src,
+                             size_t srcSize, VideoGrabberPlatformData::Frame& frame) {
+    int width = data->bufferWidth;
+    int height = data->bufferHeight;
+    int w, h, subsamp, colorspace;
+    if (tjDecompressHeader3(data->jpeg, src, srcSize, &w, &h, &subsamp, &colorspace) != 0 ||
+        w != width || h != height) {
+        return false;
+    }
+
+    // Grayscale: 1x1 neutral chroma planes
+    bool gray = (subsamp == TJSAMP_GRAY);
+    int cw = gray ? 1 : tjPlaneWidth(1, width, subsamp);
+    int ch = gray ? 1 : tjPlaneHeight(1, height, subsamp);
+    if (cw <= 0 || ch <= 0) return false;
+
+    size_t ySize = static_cast<size_t>(width) * height;
+    unsigned char* planes[3] = {frame.data, frame.data + ySize, frame.data + ySize + static_cast<size_t>(cw) * ch};
+    int strides[3] = {width, cw, cw};
+    if (tjDecompressToYUVPlanes(data->jpeg, src, srcSize, planes, width, strides, height,
+                                TJFLAG_FASTDCT) != 0 &&
+        tjGetErrorCode(data->jpeg) != TJERR_WARNING) {
+        return false;
+    }
+    if (gray) {
+        planes[1][0] = 128;
+        planes[2][0] = 128;
+    }
+
+    frame.chromaWidth = cw;
+    frame.chromaHeight = ch;
     return true;
 }
+#endif
+
+// Decode one camera buffer into frame (RGBA or YUV planes)
+static bool decodeFrame(VideoGrabberPlatformData* data, const unsigned char* src, size_t srcSize,
+                        VideoGrabberPlatformData::Frame& frame) {
+    int width = data->bufferWidth;
+    int height = data->bufferHeight;
+    int stride = data->bytesPerLine;
+    unsigned char* dst = frame.data;
+    size_t ySize = static_cast<size_t>(width) * height;
+
+    switch (data->pixelFormat) {
+        case V4L2_PIX_FMT_YUYV:
+            if (srcSize < static_cast<size_t>(stride) * height) return false;
+            if (data->yuvOutput) {
+                // Y plane + interleaved UV plane at half width, full height
+                splitYuyv(src, stride, dst, dst + ySize, width, height);
+                frame.chromaWidth = width / 2;
+                frame.chromaHeight = height;
+            } else {
+                convertYuyvToRgba(src, stride, dst, width * 4, width, height);
+            }
+            return true;
+
+        case V4L2_PIX_FMT_NV12: {
+            const unsigned char* uv = src + static_cast<size_t>(stride) * height;
+            int cw = (width + 1) / 2;
+            int ch = (height + 1) / 2;
+            if (srcSize < static_cast<size_t>(stride) * (height + ch)) return false;
+            if (data->yuvOutput) {
+                // Packed copy of both planes (driver rows may be padded)
+                for (int y = 0; y < height; y++) {
+                    memcpy(dst + static_cast<size_t>(y) * width, src + static_cast<size_t>(y) * stride, width);
+                }
+                unsigned char* uvDst = dst + ySize;
+                for (int y = 0; y < ch; y++) {
+                    memcpy(uvDst + static_cast<size_t>(y) * cw * 2, uv + static_cast<size_t>(y) * stride, cw * 2);
+                }
+                frame.chromaWidth = cw;
+                frame.chromaHeight = ch;
+            } else {
+                convertNv12ToRgba(src, stride, uv, stride, dst, width * 4, width, height);
+            }
+            return true;
+        }
+
+        case V4L2_PIX_FMT_MJPEG:
+#ifdef TC_HAS_TURBOJPEG
+            if (data->yuvOutput) {
+                return decodeMJPEGtoYUV(data, src, srcSize, frame);
+            }
+#endif
+            return decodeMJPEGtoRGBA(data, src, srcSize, dst);
+    }
+    return false;
+}
 
 // =============================================================================
 // Capture thread function
@@ -165,33 +270,26 @@ static void captureThreadFunc(VideoGrabberPlatformData* data) {
             break;
         }
 
-        // Convert frame to RGBA
-        if (data->backBuffer && buf.index < data->bufferCount) {
+        // Decode into the back buffer
+        bool decoded = false;
+        if (data->back.data && buf.index < data->bufferCount) {
             const unsigned char* src = (const unsigned char*)data->buffers[buf.index].start;
-
-            if (data->pixelFormat == V4L2_PIX_FMT_YUYV) {
-                convertYUYVtoRGBA(src, data->backBuffer, data->bufferWidth, data->bufferHeight);
-            } else if (data->pixelFormat == V4L2_PIX_FMT_MJPEG) {
-                decodeMJPEGtoRGBA(src, buf.bytesused, data->backBuffer,
-                                  data->bufferWidth, data->bufferHeight);
-            }
-
-            // Copy to target buffer
-            if (data->targetPixels && data->mutex) {
-                std::lock_guard<std::mutex> lock(*data->mutex);
-                memcpy(data->targetPixels, data->backBuffer,
-                       data->bufferWidth * data->bufferHeight * 4);
-            }
-
-            if (data->pixelsDirty) {
-                data->pixelsDirty->store(true);
-            }
+            size_t size = (data->pixelFormat == V4L2_PIX_FMT_MJPEG)
+                ? buf.bytesused : data->buffers[buf.index].length;
+            decoded = decodeFrame(data, src, size, data->back);
         }
 
         // Re-queue buffer
         if (xioctl(data->fd, VIDIOC_QBUF, &buf) == -1) {
             break;
         }
+
+        // Publish (the main thread picks it up in updatePlatform)
+        if (decoded) {
+            std::lock_guard<std::mutex> lock(data->frameMutex);
+            std::swap(data->back, data->ready);
+            data->frameReady = true;
+        }
     }
 }
 
@@ -235,34 +333,62 @@ bool VideoGrabber::setupPlatform() {
     deviceName_ = std::string((char*)cap.card);
     logNotice("VideoGrabber") << "Device: " << deviceName_;
 
-    // Set format
+    // Set format: MJPEG first (USB bandwidth), then raw YUV.
+    // Drivers may substitute another format, so check what was accepted.
     struct v4l2_format fmt = {};
-    fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    fmt.fmt.pix.width = requestedWidth_;
-    fmt.fmt.pix.height = requestedHeight_;
-    fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_MJPEG;  // Try MJPEG first
-    fmt.fmt.pix.field = V4L2_FIELD_NONE;
-
-    if (xioctl(data->fd, VIDIOC_S_FMT, &fmt) == -1) {
-        // Try YUYV
-        fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_YUYV;
-        if (xioctl(data->fd, VIDIOC_S_FMT, &fmt) == -1) {
-            logError("VideoGrabber") << "Failed to set format";
-            ::close(data->fd);
-            delete data;
-            platformHandle_ = nullptr;
-            return false;
+    bool formatSet = false;
+    for (uint32_t pixelFormat : {V4L2_PIX_FMT_MJPEG, V4L2_PIX_FMT_YUYV, V4L2_PIX_FMT_NV12}) {
+        fmt = {};
+        fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        fmt.fmt.pix.width = requestedWidth_;
+        fmt.fmt.pix.height = requestedHeight_;
+        fmt.fmt.pix.pixelformat = pixelFormat;
+        fmt.fmt.pix.field = V4L2_FIELD_NONE;
+        if (xioctl(data->fd, VIDIOC_S_FMT, &fmt) == 0 && fmt.fmt.pix.pixelformat == pixelFormat) {
+            formatSet = true;
+            break;
         }
     }
 
+    if (!formatSet) {
+        logError("VideoGrabber") << "Failed to set format";
+        ::close(data->fd);
+        delete data;
+        platformHandle_ = nullptr;
+        return false;
+    }
+
     width_ = fmt.fmt.pix.width;
     height_ = fmt.fmt.pix.height;
     data->bufferWidth = width_;
     data->bufferHeight = height_;
     data->pixelFormat = fmt.fmt.pix.pixelformat;
+    data->bytesPerLine = fmt.fmt.pix.bytesperline;
+    if (data->bytesPerLine <= 0) {
+        data->bytesPerLine = (data->pixelFormat == V4L2_PIX_FMT_YUYV) ? width_ * 2 : width_;
+    }
+
+    bool mjpeg = (data->pixelFormat == V4L2_PIX_FMT_MJPEG);
+#ifdef TC_HAS_TURBOJPEG
+    bool yuvAvailable = true;
+#else
+    bool yuvAvailable = !mjpeg;
+#endif
+
+    // Raw YUV output: YUYV / NV12 -> NV12 layout, MJPEG -> I420 layout
+    if (requestedPixelFormat_ != VideoPixelFormat::RGBA) {
+        if (yuvAvailable) {
+            data->yuvOutput = true;
+            pixelFormat_ = mjpeg ? VideoPixelFormat::I420 : VideoPixelFormat::NV12;
+            // BT.601; JPEG is full range
+            planes_.setColorSpace(false, mjpeg);
+        } else {
+            logWarning("VideoGrabber") << "YUV output for MJPEG needs libjpeg-turbo, using RGBA";
+        }
+    }
 
     logNotice("VideoGrabber") << "Format: " << width_ << "x" << height_
-                                << " (" << (char*)&data->pixelFormat << ")";
+                                << " (" << fourccToString(data->pixelFormat) << ")";
 
     // Set frame rate if specified
     if (desiredFrameRate_ > 0) {
@@ -327,8 +453,24 @@ bool VideoGrabber::setupPlatform() {
         }
     }
 
-    // Allocate back buffer
-    data->backBuffer = new unsigned char[width_ * height_ * 4];
+    // Allocate frame buffers (YUV: room for 4:4:4 planes)
+    size_t frameBytes = static_cast<size_t>(width_) * height_ * (data->yuvOutput ? 3 : 4);
+    data->back.data = new unsigned char[frameBytes];
+    data->ready.data = new unsigned char[frameBytes];
+    if (data->yuvOutput) {
+        data->front.data = new unsigned char[frameBytes];
+    } else {
+        data->retired = new unsigned char[frameBytes];
+    }
+
+#ifdef TC_HAS_TURBOJPEG
+    if (mjpeg) {
+        data->jpeg = tjInitDecompress();
+        if (!data->jpeg) {
+            logError("VideoGrabber") << "Failed to create JPEG decoder: " << tjGetErrorStr();
+        }
+    }
+#endif
 
     // Queue buffers
     for (unsigned int i = 0; i < data->bufferCount; i++) {
@@ -351,7 +493,13 @@ bool VideoGrabber::setupPlatform() {
             munmap(data->buffers[i].start, data->buffers[i].length);
         }
         delete[] data->buffers;
-        delete[] data->backBuffer;
+        delete[] data->back.data;
+        delete[] data->ready.data;
+        delete[] data->front.data;
+        delete[] data->retired;
+#ifdef TC_HAS_TURBOJPEG
+        if (data->jpeg) tjDestroy(data->jpeg);
+#endif
         ::close(data->fd);
         delete data;
         platformHandle_ = nullptr;
@@ -393,10 +541,17 @@ void VideoGrabber::closePlatform() {
         delete[] data->buffers;
     }
 
-    // Free back buffer
-    if (data->backBuffer) {
-        delete[] data->backBuffer;
+    // Free frame buffers (pixels_ holds one of the RGBA frames, freed by close())
+    delete[] data->back.data;
+    delete[] data->ready.data;
+    delete[] data->front.data;
+    delete[] data->retired;
+
+#ifdef TC_HAS_TURBOJPEG
+    if (data->jpeg) {
+        tjDestroy(data->jpeg);
     }
+#endif
 
     // Close device
     if (data->fd != -1) {
@@ -408,16 +563,51 @@ void VideoGrabber::closePlatform() {
 }
 
 void VideoGrabber::updatePlatform() {
-    // Nothing special needed - capture thread handles everything
-}
-
-void VideoGrabber::updateDelegatePixels() {
     if (!platformHandle_) return;
 
     auto data = static_cast<VideoGrabberPlatformData*>(platformHandle_);
-    data->targetPixels = pixels_;
-    data->pixelsDirty = &pixelsDirty_;
-    data->mutex = &mutex_;
+
+    // Take the latest decoded frame (buffer swap, no copy)
+    {
+        std::lock_guard<std::mutex> lock(data->frameMutex);
+        if (!data->frameReady) return;
+        data->frameReady = false;
+        if (data->yuvOutput) {
+            std::swap(data->front, data->ready);
+        } else {
+            // The old pixels_ rests in retired; the buffer retired last
+            // time goes back to the capture thread
+            std::lock_guard<std::mutex> pixelsLock(mutex_);
+            std::swap(pixels_, data->ready.data);
+            std::swap(data->ready.data, data->retired);
+        }
+    }
+
+    if (data->yuvOutput) {
+        const auto& frame = data->front;
+        int cw = frame.chromaWidth;
+        int ch = frame.chromaHeight;
+
+        // Chroma size is known with the first frame (JPEG subsampling)
+        const Texture& chroma = planes_.getTexture(1);
+        if (!planes_.isAllocated() || chroma.getWidth() != cw || chroma.getHeight() != ch) {
+            planes_.allocate(pixelFormat_, width_, height_, cw, ch);
+        }
+
+        bool nv12 = (pixelFormat_ == VideoPixelFormat::NV12);
+        size_t ySize = static_cast<size_t>(width_) * height_;
+        const uint8_t* planes[3] = {
+            frame.data, frame.data + ySize, nv12 ? nullptr : frame.data + ySize + static_cast<size_t>(cw) * ch
+        };
+        int strides[3] = {width_, nv12 ? cw * 2 : cw, cw};
+        planes_.load(planes, strides);
+    }
+
+    pixelsDirty_ = true;
+}
+
+void VideoGrabber::updateDelegatePixels() {
+    // Frames are handed over in updatePlatform() by swapping buffers
 }
 
 std::vector<VideoDeviceInfo> VideoGrabber::listDevicesPlatform() {
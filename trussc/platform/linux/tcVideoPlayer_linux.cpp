@@ -2,7 +2,17 @@
 // tcVideoPlayer_linux.cpp - Linux VideoPlayer implementation using FFmpeg
 // =============================================================================
 // Uses libavcodec/libavformat for video decoding.
-// Frames are converted to RGBA and uploaded to sokol_gfx texture.
+// Decoded frames go through a fixed pool of slots (no per-frame allocation):
+//   RGBA: sws_scale writes straight into a slot buffer, which is then swapped
+//         with the player's pixel buffer (no copies before the texture upload).
+//         The buffer it replaces rests for one update() before it is reused,
+//         so getPixels() is never written while the next update() runs
+//   YUV:  slots keep a reference to the decoder's NV12 / I420 frame and the
+//         planes are uploaded as separate textures (converted in a shader)
+// Decoding uses FFmpeg's frame/slice threads. Seeks are frame-accurate: the
+// demuxer jumps to the keyframe at or before the target (from the container
+// index, or an index scanned in the background) and the decoder runs forward
+// to the exact frame without converting the frames in between.
 // =============================================================================
 
 #ifdef __linux__
@@ -19,8 +29,10 @@ extern "C" {
 
 #include <thread>
 #include <atomic>
-#include <queue>
 #include <condition_variable>
+#include <vector>
+#include <algorithm>
+#include <limits>
 
 using namespace trussc;
 
@@ -38,6 +50,7 @@ public:
     void stop();
     void setPaused(bool paused);
     void update(VideoPlayer* player);
+    double getBufferedTime();
 
     bool hasNewFrame() const { return hasNewFrame_; }
     bool isFinished() const { return isFinished_; }
@@ -60,19 +73,48 @@ public:
     int getHeight() const { return height_; }
 
 private:
+    void presentFrames(VideoPlayer* player, bool slaved, double clockTime);
     void decodeThread();
     bool decodeNextFrame();
-    void seekToTime(double seconds);
+    bool receiveFrame();                // Next decoded frame into frame_; false at end of stream
+    bool queueFrame();                  // Convert frame_ into a pool slot and queue it
+    void seekAndDecode(double target, bool present);
+    void seekToTime(double seconds, bool present = true);
+
+    // Timestamps (stream time base, relative to the stream start)
+    double tsToSeconds(int64_t ts) const { return (ts - startTs_) * av_q2d(timeBase_); }
+    int64_t secondsToTs(double seconds) const { return startTs_ + (int64_t)(seconds / av_q2d(timeBase_) + 0.5); }
+    int64_t frameTimestamp(const AVFrame* frame) const;
+
+    // Keyframe index
+    void buildIndexFromContainer();
+    void scanIndexThread(std::string path);
+    bool findKeyframe(int64_t ts, int64_t& keyframe);
+
+    // Frame pool
+    struct FrameSlot {
+        uint8_t* rgba = nullptr;    // RGBA: width * height * 4 (new[], swapped with the player)
+        AVFrame* frame = nullptr;   // YUV: decoded frame (reference or own converted buffer)
+        double pts = 0.0;
+    };
+
+    bool allocatePool();
+    void freePool();
+    int acquireSlot();                  // Decode thread; -1 if none free
+    void releaseSlot(int index);        // Caller holds mutex_
+    void clearReadyFrames();            // Caller holds mutex_
+    void presentSlot(FrameSlot& slot, VideoPlayer* player);
 
     // FFmpeg context
     AVFormatContext* formatCtx_ = nullptr;
     AVCodecContext* codecCtx_ = nullptr;
     SwsContext* swsCtx_ = nullptr;
     AVFrame* frame_ = nullptr;
-    AVFrame* frameRGBA_ = nullptr;
     AVPacket* packet_ = nullptr;
 
     int videoStreamIndex_ = -1;
+    bool draining_ = false;                         // Flush packet sent at end of stream
+    int64_t decodedTs_ = AV_NOPTS_VALUE;            // Last frame that left the decoder
 
     // Video properties
     int width_ = 0;
@@ -80,6 +122,7 @@ private:
     double duration_ = 0.0;
     double frameRate_ = 30.0;
     AVRational timeBase_ = {1, 1};
+    int64_t startTs_ = 0;
 
     // Playback state
     std::atomic<bool> isLoaded_{false};
@@ -91,6 +134,9 @@ private:
     std::atomic<bool> shouldStop_{false};
     std::atomic<bool> seekRequested_{false};
     std::atomic<double> seekTarget_{0.0};
+    std::atomic<bool> seekInProgress_{false};   // Requested until handled by the decode thread
+    std::atomic<bool> seekPresent_{true};       // Show the target frame even when paused
+    std::atomic<bool> seekFramePending_{false}; // Target frame queued, update() presents it
 
     float volume_ = 1.0f;
     float speed_ = 1.0f;
@@ -100,22 +146,32 @@ private:
     std::mutex mutex_;
     std::condition_variable cv_;
 
-    // Frame queue
-    struct FrameData {
-        std::vector<uint8_t> pixels;
-        double pts;
-    };
-    std::queue<FrameData> frameQueue_;
+    // Keyframe timestamps, sorted (container index or background scan)
+    std::vector<int64_t> keyframes_;
+    std::mutex indexMutex_;
+    std::atomic<bool> indexReady_{false};
+    std::atomic<bool> stopIndexScan_{false};
+    std::thread indexThread_;
+
+    // Output layout
+    VideoPixelFormat pixelFormat_ = VideoPixelFormat::RGBA;
+    AVPixelFormat yuvFormat_ = AV_PIX_FMT_NONE;     // Pool layout in YUV mode
+    bool yuvConvert_ = false;                       // Decoder output needs sws_scale
+
+    // Decoded frames ready for display, in PTS order (ring of slot indices)
     static constexpr size_t MAX_QUEUE_SIZE = 4;
+    static constexpr size_t POOL_SIZE = MAX_QUEUE_SIZE + 1;
+    std::vector<FrameSlot> slots_;
+    std::vector<int> freeSlots_;
+    uint8_t* retiredPixels_ = nullptr;  // Previously shown RGBA buffer, not yet back in the pool
+    int readyQueue_[POOL_SIZE] = {};
+    size_t readyHead_ = 0;
+    size_t readyCount_ = 0;
 
     // Timing
     double currentPts_ = 0.0;
     double playbackStartTime_ = 0.0;
     double pausedTime_ = 0.0;
-
-    // Pixel buffer
-    uint8_t* rgbaBuffer_ = nullptr;
-    int rgbaBufferSize_ = 0;
 };
 
 // =============================================================================
@@ -176,6 +232,12 @@ bool TCVideoPlayerImpl::load(const std::string& path, VideoPlayer* player) {
         return false;
     }
 
+    // Decode on all cores: frame threads where the codec supports them
+    // (H.264, HEVC, VP9, ...), slice threads otherwise
+    codecCtx_->thread_count = 0;    // Auto
+    codecCtx_->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+    codecCtx_->pkt_timebase = videoStream->time_base;
+
     // Open codec
     if (avcodec_open2(codecCtx_, codec, nullptr) < 0) {
         logError("VideoPlayer") << "Failed to open codec";
@@ -188,6 +250,7 @@ bool TCVideoPlayerImpl::load(const std::string& path, VideoPlayer* player) {
     width_ = codecCtx_->width;
     height_ = codecCtx_->height;
     timeBase_ = videoStream->time_base;
+    startTs_ = videoStream->start_time != AV_NOPTS_VALUE ? videoStream->start_time : 0;
 
     // Calculate frame rate
     if (videoStream->avg_frame_rate.num > 0 && videoStream->avg_frame_rate.den > 0) {
@@ -207,45 +270,216 @@ bool TCVideoPlayerImpl::load(const std::string& path, VideoPlayer* player) {
                                << " @ " << frameRate_ << " fps, "
                                << duration_ << " sec";
 
-    // Create scaler context (convert to RGBA)
-    swsCtx_ = sws_getContext(
-        width_, height_, codecCtx_->pix_fmt,
-        width_, height_, AV_PIX_FMT_RGBA,
-        SWS_BILINEAR, nullptr, nullptr, nullptr
-    );
+    // Output layout: keep native NV12 / I420 when planar output is requested,
+    // convert anything else once into I420
+    AVPixelFormat srcFormat = codecCtx_->pix_fmt;
+    AVPixelFormat dstFormat = AV_PIX_FMT_RGBA;
+    if (player && VideoPlayerPlatformAccess::getRequestedPixelFormat(*player) != VideoPixelFormat::RGBA) {
+        if (srcFormat == AV_PIX_FMT_NV12) {
+            pixelFormat_ = VideoPixelFormat::NV12;
+            dstFormat = AV_PIX_FMT_NV12;
+        } else {
+            pixelFormat_ = VideoPixelFormat::I420;
+            dstFormat = AV_PIX_FMT_YUV420P;
+        }
+        yuvFormat_ = dstFormat;
+        yuvConvert_ = srcFormat != dstFormat && srcFormat != AV_PIX_FMT_YUVJ420P;
+
+        bool fullRange = codecCtx_->color_range == AVCOL_RANGE_JPEG || srcFormat == AV_PIX_FMT_YUVJ420P;
+        bool bt709 = codecCtx_->colorspace == AVCOL_SPC_BT709 ||
+                     (codecCtx_->colorspace == AVCOL_SPC_UNSPECIFIED && height_ >= 720);
+        VideoPlayerPlatformAccess::setPixelFormat(*player, pixelFormat_);
+        VideoPlayerPlatformAccess::setYuvColorSpace(*player, bt709, fullRange);
+    }
 
-    if (!swsCtx_) {
-        logError("VideoPlayer") << "Failed to create scaler context";
-        avcodec_free_context(&codecCtx_);
-        avformat_close_input(&formatCtx_);
-        return false;
+    // Scaler context (RGBA output, or YUV from an unsupported layout)
+    if (pixelFormat_ == VideoPixelFormat::RGBA || yuvConvert_) {
+        swsCtx_ = sws_getContext(
+            width_, height_, srcFormat,
+            width_, height_, dstFormat,
+            SWS_BILINEAR, nullptr, nullptr, nullptr
+        );
+
+        if (!swsCtx_) {
+            logError("VideoPlayer") << "Failed to create scaler context";
+            avcodec_free_context(&codecCtx_);
+            avformat_close_input(&formatCtx_);
+            return false;
+        }
     }
 
     // Allocate frames
     frame_ = av_frame_alloc();
-    frameRGBA_ = av_frame_alloc();
     packet_ = av_packet_alloc();
 
-    if (!frame_ || !frameRGBA_ || !packet_) {
+    if (!frame_ || !packet_ || !allocatePool()) {
         logError("VideoPlayer") << "Failed to allocate frames";
         close();
         return false;
     }
 
-    // Allocate RGBA buffer
-    rgbaBufferSize_ = av_image_get_buffer_size(AV_PIX_FMT_RGBA, width_, height_, 1);
-    rgbaBuffer_ = (uint8_t*)av_malloc(rgbaBufferSize_);
-
-    av_image_fill_arrays(
-        frameRGBA_->data, frameRGBA_->linesize,
-        rgbaBuffer_, AV_PIX_FMT_RGBA,
-        width_, height_, 1
-    );
+    // Keyframe index: the container's own (MP4/MOV), otherwise scan the
+    // packets in the background without decoding
+    buildIndexFromContainer();
+    if (!indexReady_) {
+        stopIndexScan_ = false;
+        indexThread_ = std::thread(&TCVideoPlayerImpl::scanIndexThread, this, path);
+    }
 
     isLoaded_ = true;
+
+    // Decode thread idles until play() or a seek (setFrame() works before play())
+    shouldStop_ = false;
+    decodeThread_ = std::thread(&TCVideoPlayerImpl::decodeThread, this);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Keyframe index
+// ---------------------------------------------------------------------------
+
+void TCVideoPlayerImpl::buildIndexFromContainer() {
+    AVStream* stream = formatCtx_->streams[videoStreamIndex_];
+    int count = avformat_index_get_entries_count(stream);
+
+    std::vector<int64_t> keyframes;
+    for (int i = 0; i < count; i++) {
+        const AVIndexEntry* entry = avformat_index_get_entry(stream, i);
+        if (entry && (entry->flags & AVINDEX_KEYFRAME)) keyframes.push_back(entry->timestamp);
+    }
+    // A single entry is what some demuxers record while probing; not an index
+    if (keyframes.size() < 2) return;
+
+    std::sort(keyframes.begin(), keyframes.end());
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    keyframes_ = std::move(keyframes);
+    indexReady_ = true;
+}
+
+void TCVideoPlayerImpl::scanIndexThread(std::string path) {
+    // Own demuxer so the decode thread is never blocked
+    AVFormatContext* ctx = nullptr;
+    if (avformat_open_input(&ctx, path.c_str(), nullptr, nullptr) < 0) return;
+
+    AVPacket* packet = av_packet_alloc();
+    std::vector<int64_t> keyframes;
+    bool complete = false;
+    if (packet) {
+        while (!stopIndexScan_) {
+            if (av_read_frame(ctx, packet) < 0) {
+                complete = true;
+                break;
+            }
+            if (packet->stream_index == videoStreamIndex_ && (packet->flags & AV_PKT_FLAG_KEY)) {
+                int64_t ts = packet->pts != AV_NOPTS_VALUE ? packet->pts : packet->dts;
+                if (ts != AV_NOPTS_VALUE) keyframes.push_back(ts);
+            }
+            av_packet_unref(packet);
+        }
+        av_packet_free(&packet);
+    }
+    avformat_close_input(&ctx);
+
+    if (!complete) return;
+    std::sort(keyframes.begin(), keyframes.end());
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    keyframes_ = std::move(keyframes);
+    indexReady_ = true;
+}
+
+// Latest keyframe at or before ts; false while no index is available
+bool TCVideoPlayerImpl::findKeyframe(int64_t ts, int64_t& keyframe) {
+    if (!indexReady_) return false;
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    auto it = std::upper_bound(keyframes_.begin(), keyframes_.end(), ts);
+    if (it == keyframes_.begin()) return false;
+    keyframe = *(it - 1);
     return true;
 }
 
+// ---------------------------------------------------------------------------
+// Frame pool
+// ---------------------------------------------------------------------------
+
+bool TCVideoPlayerImpl::allocatePool() {
+    slots_.resize(POOL_SIZE);
+    freeSlots_.clear();
+    for (size_t i = 0; i < POOL_SIZE; i++) {
+        FrameSlot& slot = slots_[i];
+        if (pixelFormat_ == VideoPixelFormat::RGBA) {
+            slot.rgba = new uint8_t[(size_t)width_ * height_ * 4];
+        } else {
+            slot.frame = av_frame_alloc();
+            if (!slot.frame) return false;
+            if (yuvConvert_) {
+                // Own buffer, written by sws_scale
+                slot.frame->format = yuvFormat_;
+                slot.frame->width = width_;
+                slot.frame->height = height_;
+                if (av_frame_get_buffer(slot.frame, 0) < 0) return false;
+            }
+        }
+        freeSlots_.push_back((int)i);
+    }
+    if (pixelFormat_ == VideoPixelFormat::RGBA) {
+        retiredPixels_ = new uint8_t[(size_t)width_ * height_ * 4];
+    }
+    readyHead_ = 0;
+    readyCount_ = 0;
+    return true;
+}
+
+void TCVideoPlayerImpl::freePool() {
+    for (auto& slot : slots_) {
+        delete[] slot.rgba;
+        if (slot.frame) av_frame_free(&slot.frame);
+    }
+    slots_.clear();
+    freeSlots_.clear();
+    delete[] retiredPixels_;
+    retiredPixels_ = nullptr;
+    readyCount_ = 0;
+}
+
+int TCVideoPlayerImpl::acquireSlot() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (freeSlots_.empty()) return -1;
+    int index = freeSlots_.back();
+    freeSlots_.pop_back();
+    return index;
+}
+
+void TCVideoPlayerImpl::releaseSlot(int index) {
+    // Drop the decoder reference (own converted buffers are kept)
+    if (!yuvConvert_ && slots_[index].frame) av_frame_unref(slots_[index].frame);
+    freeSlots_.push_back(index);
+}
+
+void TCVideoPlayerImpl::clearReadyFrames() {
+    while (readyCount_ > 0) {
+        releaseSlot(readyQueue_[readyHead_]);
+        readyHead_ = (readyHead_ + 1) % POOL_SIZE;
+        readyCount_--;
+    }
+}
+
+// Hand a decoded frame to the player (main thread)
+void TCVideoPlayerImpl::presentSlot(FrameSlot& slot, VideoPlayer* player) {
+    if (pixelFormat_ == VideoPixelFormat::RGBA) {
+        // Swap buffers instead of copying. The player's old buffer is retired
+        // and the one retired last time joins the pool, so a pointer from
+        // getPixels() is not overwritten before the update() after next.
+        std::lock_guard<std::mutex> lock(VideoPlayerPlatformAccess::getMutex(*player));
+        unsigned char*& pixels = VideoPlayerPlatformAccess::getPixelBufferRef(*player);
+        std::swap(pixels, slot.rgba);
+        std::swap(slot.rgba, retiredPixels_);
+    } else {
+        const uint8_t* planes[3] = { slot.frame->data[0], slot.frame->data[1], slot.frame->data[2] };
+        int strides[3] = { slot.frame->linesize[0], slot.frame->linesize[1], slot.frame->linesize[2] };
+        VideoPlayerPlatformAccess::loadPlanes(*player, planes, strides);
+    }
+}
+
 void TCVideoPlayerImpl::close() {
     // Stop decode thread
     shouldStop_ = true;
@@ -255,30 +489,22 @@ void TCVideoPlayerImpl::close() {
         decodeThread_.join();
     }
 
-    // Clear frame queue
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        while (!frameQueue_.empty()) {
-            frameQueue_.pop();
-        }
+    stopIndexScan_ = true;
+    if (indexThread_.joinable()) {
+        indexThread_.join();
     }
+    keyframes_.clear();
+    indexReady_ = false;
 
-    // Free FFmpeg resources
-    if (rgbaBuffer_) {
-        av_free(rgbaBuffer_);
-        rgbaBuffer_ = nullptr;
-    }
+    // Free frame pool
+    freePool();
 
+    // Free FFmpeg resources
     if (packet_) {
         av_packet_free(&packet_);
         packet_ = nullptr;
     }
 
-    if (frameRGBA_) {
-        av_frame_free(&frameRGBA_);
-        frameRGBA_ = nullptr;
-    }
-
     if (frame_) {
         av_frame_free(&frame_);
         frame_ = nullptr;
@@ -304,15 +530,22 @@ void TCVideoPlayerImpl::close() {
     isPaused_ = false;
     hasNewFrame_ = false;
     isFinished_ = false;
+    seekRequested_ = false;
+    seekInProgress_ = false;
+    seekFramePending_ = false;
+    draining_ = false;
+    decodedTs_ = AV_NOPTS_VALUE;
     width_ = 0;
     height_ = 0;
+    pixelFormat_ = VideoPixelFormat::RGBA;
+    yuvFormat_ = AV_PIX_FMT_NONE;
+    yuvConvert_ = false;
 }
 
 void TCVideoPlayerImpl::play() {
     if (!isLoaded_) return;
 
     // Reset state
-    isFinished_ = false;
     shouldStop_ = false;
 
     // Seek to beginning if finished
@@ -326,8 +559,13 @@ void TCVideoPlayerImpl::play() {
     }
 
     playbackStartTime_ = av_gettime_relative() / 1000000.0 - currentPts_;
-    isPlaying_ = true;
-    isPaused_ = false;
+    {
+        // Under the lock so a decode thread parked at the end can't miss it
+        std::lock_guard<std::mutex> lock(mutex_);
+        isFinished_ = false;
+        isPlaying_ = true;
+        isPaused_ = false;
+    }
     cv_.notify_all();
 }
 
@@ -335,17 +573,15 @@ void TCVideoPlayerImpl::stop() {
     isPlaying_ = false;
     isPaused_ = false;
 
-    // Seek to beginning
-    seekToTime(0.0);
-    currentPts_ = 0.0;
-
     // Clear frame queue
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        while (!frameQueue_.empty()) {
-            frameQueue_.pop();
-        }
+        clearReadyFrames();
     }
+
+    // Seek to beginning; frame 0 stays queued and is shown by play()
+    seekToTime(0.0, false);
+    currentPts_ = 0.0;
 }
 
 void TCVideoPlayerImpl::setPaused(bool paused) {
@@ -365,37 +601,71 @@ void TCVideoPlayerImpl::setPaused(bool paused) {
 void TCVideoPlayerImpl::update(VideoPlayer* player) {
     hasNewFrame_ = false;
 
-    if (!isLoaded_ || !isPlaying_ || isPaused_) return;
+    if (!isLoaded_) return;
+
+    // Slaved to a MediaClock: show the frame for the clock's time
+    double clockTime = 0.0;
+    bool slaved = player && VideoPlayerPlatformAccess::getClockTime(*player, clockTime);
+
+    presentFrames(player, slaved, clockTime);
+
+    if (player) VideoPlayerPlatformAccess::setBufferedTime(*player, getBufferedTime());
+}
+
+void TCVideoPlayerImpl::presentFrames(VideoPlayer* player, bool slaved, double clockTime) {
+    // Seek target frame: shown right away (also while paused) and playback
+    // continues from its exact timestamp
+    if (seekFramePending_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (readyCount_ > 0) {
+            int index = readyQueue_[readyHead_];
+            readyHead_ = (readyHead_ + 1) % POOL_SIZE;
+            readyCount_--;
+            seekFramePending_ = false;
+            if (player) {
+                presentSlot(slots_[index], player);
+                hasNewFrame_ = true;
+            }
+            currentPts_ = slots_[index].pts;
+            playbackStartTime_ = av_gettime_relative() / 1000000.0 - currentPts_ / speed_;
+            pausedTime_ = av_gettime_relative() / 1000000.0;
+            releaseSlot(index);
+            cv_.notify_all();
+        }
+        return;
+    }
+
+    if (!isPlaying_ || isPaused_) return;
 
     // Calculate target PTS based on elapsed time
     double elapsed = av_gettime_relative() / 1000000.0 - playbackStartTime_;
-    double targetPts = elapsed * speed_;
+    double targetPts = slaved ? clockTime : elapsed * speed_;
 
-    // Get frame from queue if available and PTS is right
+    // Take the newest frame that is due; older due frames are dropped
+    // without being touched
     std::lock_guard<std::mutex> lock(mutex_);
 
-    while (!frameQueue_.empty()) {
-        FrameData& front = frameQueue_.front();
+    int due = -1;
+    while (readyCount_ > 0) {
+        int index = readyQueue_[readyHead_];
+        if (slots_[index].pts > targetPts) break;  // Frame is in the future, wait
+        if (due >= 0) releaseSlot(due);
+        due = index;
+        readyHead_ = (readyHead_ + 1) % POOL_SIZE;
+        readyCount_--;
+    }
 
-        if (front.pts <= targetPts) {
-            // Copy pixels to VideoPlayer's buffer
-            if (player) {
-                unsigned char* playerPixels = player->getPixels();
-                if (playerPixels && front.pixels.size() == (size_t)(width_ * height_ * 4)) {
-                    memcpy(playerPixels, front.pixels.data(), front.pixels.size());
-                    hasNewFrame_ = true;
-                    currentPts_ = front.pts;
-                }
-            }
-            frameQueue_.pop();
-        } else {
-            // Frame is in the future, wait
-            break;
+    if (due >= 0) {
+        if (player) {
+            presentSlot(slots_[due], player);
+            hasNewFrame_ = true;
+            currentPts_ = slots_[due].pts;
         }
+        releaseSlot(due);
     }
 
-    // Check if finished
-    if (frameQueue_.empty() && isFinished_) {
+    // Check if finished (a clock seeks slaved players itself when looping)
+    if (readyCount_ == 0 && isFinished_ && !slaved) {
         if (isLoop_) {
             seekToTime(0.0);
             playbackStartTime_ = av_gettime_relative() / 1000000.0;
@@ -409,14 +679,27 @@ void TCVideoPlayerImpl::update(VideoPlayer* player) {
     cv_.notify_all();
 }
 
+// Media time decoded so far (-inf while a seek is in flight, +inf at the end)
+double TCVideoPlayerImpl::getBufferedTime() {
+    if (seekInProgress_) return -std::numeric_limits<double>::infinity();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (readyCount_ > 0) {
+        return slots_[readyQueue_[(readyHead_ + readyCount_ - 1) % POOL_SIZE]].pts;
+    }
+    if (seekFramePending_) return -std::numeric_limits<double>::infinity();
+    if (isFinished_) return std::numeric_limits<double>::infinity();
+    return currentPts_;
+}
+
 void TCVideoPlayerImpl::decodeThread() {
     while (!shouldStop_) {
-        // Wait if paused or queue is full
+        // Wait if paused, the queue is full or the stream has ended (a
+        // slaved player keeps isPlaying_ at the end; a seek wakes it)
         {
             std::unique_lock<std::mutex> lock(mutex_);
             cv_.wait(lock, [this] {
                 return shouldStop_ ||
-                       (isPlaying_ && !isPaused_ && frameQueue_.size() < MAX_QUEUE_SIZE) ||
+                       (isPlaying_ && !isPaused_ && !isFinished_ && !seekFramePending_ && !freeSlots_.empty()) ||
                        seekRequested_;
             });
         }
@@ -426,21 +709,17 @@ void TCVideoPlayerImpl::decodeThread() {
         // Handle seek request
         if (seekRequested_) {
             double target = seekTarget_;
+            bool present = seekPresent_;
             seekRequested_ = false;
 
-            int64_t timestamp = (int64_t)(target / av_q2d(timeBase_));
-            av_seek_frame(formatCtx_, videoStreamIndex_, timestamp, AVSEEK_FLAG_BACKWARD);
-            avcodec_flush_buffers(codecCtx_);
-
-            // Clear queue
             {
                 std::lock_guard<std::mutex> lock(mutex_);
-                while (!frameQueue_.empty()) {
-                    frameQueue_.pop();
-                }
+                clearReadyFrames();
+                seekFramePending_ = false;
             }
-
-            currentPts_ = target;
+            isFinished_ = false;
+            seekAndDecode(target, present);
+            if (!seekRequested_) seekInProgress_ = false;
             continue;
         }
 
@@ -452,64 +731,148 @@ void TCVideoPlayerImpl::decodeThread() {
 }
 
 bool TCVideoPlayerImpl::decodeNextFrame() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (freeSlots_.empty()) return true;  // Pool exhausted, wait for update()
+    }
+    if (!receiveFrame()) return false;
+    queueFrame();
+    return true;
+}
+
+// Send / receive loop. With frame threads the decoder holds several packets
+// before the first frame comes out; at end of stream it is drained so the
+// last frames are not lost.
+bool TCVideoPlayerImpl::receiveFrame() {
     while (true) {
-        int ret = av_read_frame(formatCtx_, packet_);
-        if (ret < 0) {
-            // End of file or error
+        int ret = avcodec_receive_frame(codecCtx_, frame_);
+        if (ret == 0) {
+            decodedTs_ = frameTimestamp(frame_);
+            return true;
+        }
+        if (ret != AVERROR(EAGAIN) || draining_) {
+            // End of stream or decoder error
             return false;
         }
 
-        if (packet_->stream_index != videoStreamIndex_) {
-            av_packet_unref(packet_);
+        ret = av_read_frame(formatCtx_, packet_);
+        if (ret < 0) {
+            // End of file: flush the remaining frames
+            avcodec_send_packet(codecCtx_, nullptr);
+            draining_ = true;
             continue;
         }
 
-        ret = avcodec_send_packet(codecCtx_, packet_);
+        if (packet_->stream_index == videoStreamIndex_) {
+            avcodec_send_packet(codecCtx_, packet_);    // Broken packets are skipped
+        }
         av_packet_unref(packet_);
+    }
+}
 
-        if (ret < 0) {
-            continue;
-        }
+bool TCVideoPlayerImpl::queueFrame() {
+    int slotIndex = acquireSlot();
+    if (slotIndex < 0) {
+        av_frame_unref(frame_);
+        return false;
+    }
+    FrameSlot& slot = slots_[slotIndex];
+
+    // Convert straight into the slot (or keep the decoder's planes)
+    if (pixelFormat_ == VideoPixelFormat::RGBA) {
+        uint8_t* dst[4] = { slot.rgba, nullptr, nullptr, nullptr };
+        int dstStride[4] = { width_ * 4, 0, 0, 0 };
+        sws_scale(swsCtx_, frame_->data, frame_->linesize, 0, height_, dst, dstStride);
+    } else if (yuvConvert_) {
+        sws_scale(swsCtx_, frame_->data, frame_->linesize, 0, height_,
+                  slot.frame->data, slot.frame->linesize);
+    } else {
+        av_frame_ref(slot.frame, frame_);
+    }
 
-        ret = avcodec_receive_frame(codecCtx_, frame_);
-        if (ret == AVERROR(EAGAIN)) {
-            continue;
-        }
-        if (ret < 0) {
-            return false;
-        }
+    int64_t ts = frameTimestamp(frame_);
+    slot.pts = ts != AV_NOPTS_VALUE ? tsToSeconds(ts) : 0.0;
+    av_frame_unref(frame_);
 
-        // Convert to RGBA
-        sws_scale(
-            swsCtx_,
-            frame_->data, frame_->linesize,
-            0, height_,
-            frameRGBA_->data, frameRGBA_->linesize
-        );
+    // Add to queue
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        readyQueue_[(readyHead_ + readyCount_) % POOL_SIZE] = slotIndex;
+        readyCount_++;
+    }
+    return true;
+}
 
-        // Calculate PTS
-        double pts = 0.0;
-        if (frame_->pts != AV_NOPTS_VALUE) {
-            pts = frame_->pts * av_q2d(timeBase_);
+int64_t TCVideoPlayerImpl::frameTimestamp(const AVFrame* frame) const {
+    return frame->best_effort_timestamp != AV_NOPTS_VALUE ? frame->best_effort_timestamp : frame->pts;
+}
+
+// Frame-accurate seek (decode thread)
+void TCVideoPlayerImpl::seekAndDecode(double target, bool present) {
+    int64_t targetTs = secondsToTs(target);
+    // Frames within half a frame of the target count as the target
+    int64_t tolerance = (int64_t)(0.5 / (frameRate_ * av_q2d(timeBase_)));
+
+    // Keep decoding forward when the target lies in the current GOP or a
+    // later one with no keyframe in between (stepping, forward scrubbing)
+    int64_t keyframe = 0;
+    bool haveKeyframe = findKeyframe(targetTs, keyframe);
+    bool needSeek = !(haveKeyframe && !draining_ && decodedTs_ != AV_NOPTS_VALUE &&
+                      decodedTs_ < targetTs - tolerance && keyframe <= decodedTs_);
+
+    int64_t seekTs = haveKeyframe ? keyframe : targetTs;
+    int retries = 0;
+    bool firstFrame = false;
+
+    while (!shouldStop_) {
+        if (needSeek) {
+            av_seek_frame(formatCtx_, videoStreamIndex_, seekTs, AVSEEK_FLAG_BACKWARD);
+            avcodec_flush_buffers(codecCtx_);
+            draining_ = false;
+            decodedTs_ = AV_NOPTS_VALUE;
+            needSeek = false;
+            firstFrame = true;
         }
 
-        // Add to queue
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            FrameData data;
-            data.pixels.resize(width_ * height_ * 4);
-            memcpy(data.pixels.data(), rgbaBuffer_, data.pixels.size());
-            data.pts = pts;
-            frameQueue_.push(std::move(data));
+        if (!receiveFrame()) {
+            // Target past the last frame
+            isFinished_ = true;
+            return;
+        }
+        int64_t ts = decodedTs_;
+
+        // The demuxer landed after the target (no index, or an index of
+        // decode timestamps); back off
+        if (firstFrame && ts != AV_NOPTS_VALUE &&
+            ts > targetTs + tolerance && seekTs > startTs_ && retries < 4) {
+            retries++;
+            seekTs = std::max(startTs_, seekTs - (int64_t)(retries / av_q2d(timeBase_)));
+            needSeek = true;
+            av_frame_unref(frame_);
+            continue;
+        }
+        firstFrame = false;
+
+        if (ts == AV_NOPTS_VALUE || ts >= targetTs - tolerance) {
+            // Without present the frame waits in the queue and is the first
+            // one shown once playback starts (stop() rewinds this way)
+            if (queueFrame() && present) seekFramePending_ = true;
+            return;
         }
 
+        // Frame before the target: no conversion
         av_frame_unref(frame_);
-        return true;
+
+        // A newer seek (scrubbing) supersedes this one
+        if (seekRequested_) return;
     }
 }
 
-void TCVideoPlayerImpl::seekToTime(double seconds) {
-    seekTarget_ = seconds;
+void TCVideoPlayerImpl::seekToTime(double seconds, bool present) {
+    seekTarget_ = std::max(0.0, seconds);
+    seekPresent_ = present;
+    seekInProgress_ = true;
+    currentPts_ = seekTarget_;     // Frame stepping before the frame arrives
     seekRequested_ = true;
     cv_.notify_all();
 }
@@ -547,7 +910,7 @@ void TCVideoPlayerImpl::setLoop(bool loop) {
 
 int TCVideoPlayerImpl::getCurrentFrame() const {
     if (frameRate_ <= 0) return 0;
-    return static_cast<int>(currentPts_ * frameRate_);
+    return static_cast<int>(currentPts_ * frameRate_ + 0.5);
 }
 
 int TCVideoPlayerImpl::getTotalFrames() const {
@@ -558,23 +921,20 @@ int TCVideoPlayerImpl::getTotalFrames() const {
 void TCVideoPlayerImpl::setFrame(int frame) {
     if (frameRate_ > 0) {
         double time = frame / frameRate_;
-        setPosition(static_cast<float>(time / duration_));
+        seekToTime(time);
+        playbackStartTime_ = av_gettime_relative() / 1000000.0 - time / speed_;
     }
 }
 
 void TCVideoPlayerImpl::nextFrame() {
     if (frameRate_ > 0) {
-        double frameTime = 1.0 / frameRate_;
-        seekToTime(currentPts_ + frameTime);
+        setFrame(getCurrentFrame() + 1);
     }
 }
 
 void TCVideoPlayerImpl::previousFrame() {
     if (frameRate_ > 0) {
-        double frameTime = 1.0 / frameRate_;
-        double newTime = currentPts_ - frameTime;
-        if (newTime < 0) newTime = 0;
-        seekToTime(newTime);
+        setFrame(std::max(0, getCurrentFrame() - 1));
     }
 }
 
@@ -593,11 +953,12 @@ bool VideoPlayer::loadPlatform(const std::string& path) {
     }
 
     platformHandle_ = impl;
+    clockSupported_ = true;
     width_ = impl->getWidth();
     height_ = impl->getHeight();
 
-    // Allocate pixel buffer
-    if (width_ > 0 && height_ > 0) {
+    // Allocate pixel buffer (RGBA only; planar frames go to plane textures)
+    if (width_ > 0 && height_ > 0 && getPixelFormat() == VideoPixelFormat::RGBA) {
         pixels_ = new unsigned char[width_ * height_ * 4];
         std::memset(pixels_, 0, width_ * height_ * 4);
     }
@@ -187,7 +187,7 @@ bool saveScreenshot(const std::filesystem::path& path) {
     }
 
     // ファイル拡張子から形式を判定
-    std::string ext = path.extension().string();
+    std::string ext = toLower(path.extension().string());
     NSBitmapImageFileType fileType = NSBitmapImageFileTypePNG;
     if (ext == ".jpg" || ext == ".jpeg") {
         fileType = NSBitmapImageFileTypeJPEG;
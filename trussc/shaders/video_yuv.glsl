@@ -0,0 +1,65 @@
+// =============================================================================
+// video_yuv.glsl - Planar YUV to RGB conversion for VideoPlayer
+// =============================================================================
+// Draws decoded video frames kept in their native planar layout:
+//   I420: yTex = Y, uTex = U, vTex = V   (U/V at half resolution)
+//   NV12: yTex = Y, uTex = interleaved UV (RG), vTex unused
+// The color matrix and range offsets are computed on the CPU
+// (BT.601 / BT.709, limited / full range).
+// =============================================================================
+
+@vs vs_video_yuv
+layout(location=0) in vec3 position;
+layout(location=1) in vec2 texcoord0;
+layout(location=2) in vec4 color0;
+
+layout(binding=0) uniform video_yuv_vs_params {
+    vec2 screenSize;
+    vec2 _pad;
+};
+
+out vec2 uv;
+out vec4 vertColor;
+
+void main() {
+    // Convert screen coordinates to NDC
+    vec2 ndc = (position.xy / screenSize) * 2.0 - 1.0;
+    ndc.y = -ndc.y;
+    gl_Position = vec4(ndc, position.z, 1.0);
+    uv = texcoord0;
+    vertColor = color0;
+}
+@end
+
+@fs fs_video_yuv
+in vec2 uv;
+in vec4 vertColor;
+
+layout(binding=0) uniform texture2D yuv_y_tex;
+layout(binding=1) uniform texture2D yuv_u_tex;
+layout(binding=2) uniform texture2D yuv_v_tex;
+layout(binding=0) uniform sampler yuv_y_smp;
+layout(binding=1) uniform sampler yuv_u_smp;
+layout(binding=2) uniform sampler yuv_v_smp;
+
+layout(binding=1) uniform video_yuv_fs_params {
+    vec4 offset;    // xyz: subtracted from (Y, U, V), w: 1 = NV12
+    vec4 rRow;
+    vec4 gRow;
+    vec4 bRow;
+};
+
+out vec4 frag_color;
+
+void main() {
+    float y = texture(sampler2D(yuv_y_tex, yuv_y_smp), uv).r;
+    vec2 c = texture(sampler2D(yuv_u_tex, yuv_u_smp), uv).rg;
+    float v = texture(sampler2D(yuv_v_tex, yuv_v_smp), uv).r;
+    vec3 yuv = vec3(y, c.x, offset.w > 0.5 ? c.y : v) - offset.xyz;
+
+    vec3 rgb = vec3(dot(rRow.xyz, yuv), dot(gRow.xyz, yuv), dot(bRow.xyz, yuv));
+    frag_color = vec4(clamp(rgb, 0.0, 1.0), 1.0) * vertColor;
+}
+@end
+
+@program video_yuv vs_video_yuv fs_video_yuv